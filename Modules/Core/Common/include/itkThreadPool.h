@@ -106,6 +106,12 @@ public:
   /** The approximate number of idle threads. */
   int GetNumberOfCurrentlyIdleThreads() const;
 
+  /** Whether the calling thread is one of the pool's threads, that is
+   * whether it is executing a job submitted with AddWork. A job that
+   * waits for other jobs it submitted may deadlock the pool, so
+   * nested parallel sections should run in the calling thread. */
+  static bool IsCurrentThreadInPool();
+
   /** Set/Get wait for threads.
   This function should be used carefully, probably only during static
   initialization phase to disable waiting for threads when ITK is built as a
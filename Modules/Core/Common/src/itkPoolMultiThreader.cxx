@@ -84,6 +84,19 @@ void PoolMultiThreader::SingleMethodExecute()
   // obey the global maximum number of threads limit
   m_NumberOfWorkUnits = std::min( this->GetGlobalMaximumNumberOfThreads(), m_NumberOfWorkUnits );
 
+  if ( ThreadPool::IsCurrentThreadInPool() )
+    {
+    // Called from a job of the pool: waiting for other jobs could
+    // deadlock the pool, so execute the work units in this thread.
+    for ( threadLoop = 0; threadLoop < m_NumberOfWorkUnits; ++threadLoop )
+      {
+      m_ThreadInfoArray[threadLoop].UserData = m_SingleData;
+      m_ThreadInfoArray[threadLoop].NumberOfWorkUnits = m_NumberOfWorkUnits;
+      m_SingleMethod( (void *)( &m_ThreadInfoArray[threadLoop] ) );
+      }
+    return;
+    }
+
   bool exceptionOccurred = false;
   std::string exceptionDetails;
   for ( threadLoop = 1; threadLoop < m_NumberOfWorkUnits; ++threadLoop )
@@ -166,7 +179,7 @@ PoolMultiThreader
 {
   MultiThreaderBase::HandleFilterProgress(filter, 0.0f);
 
-  if ( firstIndex + 1 < lastIndexPlus1 )
+  if ( firstIndex + 1 < lastIndexPlus1 && !ThreadPool::IsCurrentThreadInPool() )
     {
     SizeValueType chunkSize = ( lastIndexPlus1 - firstIndex ) / m_NumberOfWorkUnits;
     if ((lastIndexPlus1 - firstIndex) % m_NumberOfWorkUnits > 0)
@@ -202,11 +215,14 @@ PoolMultiThreader
         }
       }
     }
-  else if ( firstIndex + 1 == lastIndexPlus1 )
+  else
     {
-    aFunc( firstIndex );
+    // A single index, or a nested call from a job of the pool
+    for ( SizeValueType i = firstIndex; i < lastIndexPlus1; i++ )
+      {
+      aFunc( i );
+      }
     }
-  // else nothing needs to be executed
 
   MultiThreaderBase::HandleFilterProgress(filter, 1.0f);
 }
@@ -222,7 +238,8 @@ PoolMultiThreader
 {
   MultiThreaderBase::HandleFilterProgress(filter, 0.0f);
 
-  if ( m_NumberOfWorkUnits == 1 ) // no multi-threading wanted
+  if ( m_NumberOfWorkUnits == 1 // no multi-threading wanted
+       || ThreadPool::IsCurrentThreadInPool() ) // nested in a job of the pool
     {
     funcP( index, size ); //process whole region
     }
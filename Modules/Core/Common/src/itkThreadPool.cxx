@@ -98,6 +98,10 @@ private:
 
 // Takes care of cleaning up the ThreadPoolGlobals
 static ThreadPoolGlobalsInitializer ThreadPoolGlobalsInstance;
+
+// Set in the threads created by the pool
+thread_local bool s_IsPoolThread = false;
+
 // Initialized by the compiler to zero
 ::itk::ThreadPoolGlobals *
     ThreadPoolGlobalsInitializer::m_ThreadPoolGlobals;
@@ -212,6 +216,13 @@ ThreadPool
   return int(m_Threads.size()) - int(m_WorkQueue.size()); // lousy approximation
 }
 
+bool
+ThreadPool
+::IsCurrentThreadInPool()
+{
+  return s_IsPoolThread;
+}
+
 ThreadPool
 ::~ThreadPool()
 {
@@ -256,6 +267,7 @@ ThreadPool
 {
   //plain pointer does not increase reference count
   ThreadPool* threadPool = m_ThreadPoolGlobals->m_ThreadPoolInstance.GetPointer();
+  s_IsPoolThread = true;
 
   while ( true )
     {
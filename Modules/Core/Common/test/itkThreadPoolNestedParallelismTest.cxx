@@ -0,0 +1,107 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPoolMultiThreader.h"
+#include "itkThreadPool.h"
+#include "itkTestingMacros.h"
+
+#include <atomic>
+#include <vector>
+
+// Run parallel sections from jobs of the thread pool, more jobs than
+// there are threads in the pool, and check that they complete in the
+// calling pool thread instead of waiting for jobs queued behind them.
+
+namespace
+{
+
+struct SingleMethodData
+{
+  std::atomic< int > m_NumberOfCalls;
+};
+
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+CountCalls( void * arg )
+{
+  auto * info = static_cast< itk::MultiThreaderBase::WorkUnitInfo * >( arg );
+  ++static_cast< SingleMethodData * >( info->UserData )->m_NumberOfCalls;
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+
+bool
+RunNestedSections()
+{
+  if ( !itk::ThreadPool::IsCurrentThreadInPool() )
+    {
+    return false;
+    }
+  itk::MultiThreaderBase::Pointer threader = itk::PoolMultiThreader::New().GetPointer();
+  threader->SetNumberOfWorkUnits( 4 );
+
+  std::vector< int > values( 100, 0 );
+  threader->ParallelizeArray( 0, values.size(), [&values]( itk::SizeValueType i ) { values[i] = 1; }, nullptr );
+
+  itk::ImageRegion< 2 > region;
+  region.SetSize( 0, 10 );
+  region.SetSize( 1, 10 );
+  std::atomic< itk::SizeValueType > numberOfPixels( 0 );
+  threader->ParallelizeImageRegion< 2 >( region,
+    [&numberOfPixels]( const itk::ImageRegion< 2 > & subregion )
+      {
+      numberOfPixels += subregion.GetNumberOfPixels();
+      },
+    nullptr );
+
+  SingleMethodData data;
+  data.m_NumberOfCalls = 0;
+  threader->SetSingleMethod( CountCalls, &data );
+  threader->SingleMethodExecute();
+
+  int sum = 0;
+  for ( int value : values )
+    {
+    sum += value;
+    }
+  return sum == 100 && numberOfPixels == 100 && data.m_NumberOfCalls == 4;
+}
+
+}
+
+int itkThreadPoolNestedParallelismTest( int, char *[] )
+{
+  TEST_EXPECT_TRUE( !itk::ThreadPool::IsCurrentThreadInPool() );
+
+  itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+  TEST_EXPECT_TRUE( pool->AddWork( []() { return itk::ThreadPool::IsCurrentThreadInPool(); } ).get() );
+
+  std::vector< std::future< bool > > results;
+  for ( itk::ThreadIdType i = 0; i < 2 * pool->GetMaximumNumberOfThreads() + 1; ++i )
+    {
+    results.push_back( pool->AddWork( RunNestedSections ) );
+    }
+  for ( auto & result : results )
+    {
+    TEST_EXPECT_TRUE( result.get() );
+    }
+
+  // Outside of the pool, the sections are still parallel
+  TEST_EXPECT_TRUE( !itk::ThreadPool::IsCurrentThreadInPool() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -61,6 +61,22 @@ namespace itk
  * subclass it to a specific instance that supplies a function and Halt()
  * method.
  *
+ * \par Temporal blocking
+ * By default, each iteration streams the whole output through a change
+ * calculation pass and an update pass.  When UseTemporalBlocking is on,
+ * the requested region is instead split into tiles which fit in the
+ * cache, and up to NumberOfIterationsPerBlock iterations are computed in
+ * each tile, from a copy of the tile padded by the radius of the
+ * function times the number of iterations.  The results are identical,
+ * but the output is read and written once for all the iterations of a
+ * block.  As the padding is computed again by the neighboring tiles, this
+ * pays off when the iterations are limited by the memory bandwidth, on
+ * large images with many threads.  This requires a time step which does
+ * not depend on the image, and the iterations of a block share a single
+ * call to InitializeIteration(), so subclasses enable it by overriding
+ * GetMaximumNumberOfIterationsPerBlock(); otherwise the iterations are
+ * computed as usual.
+ *
  * \ingroup ImageFilters
  * \sa FiniteDifferenceImageFilter
  * \ingroup ITKFiniteDifference
@@ -102,6 +118,27 @@ public:
   /** The container type for the update buffer. */
   using UpdateBufferType = OutputImageType;
 
+  /** The size type of the tiles. */
+  using SizeType = typename OutputImageType::SizeType;
+
+  /** Set/Get whether the iterations are computed tile by tile, several
+   * iterations at a time (temporal blocking). It has no effect when the
+   * subclass does not support it. Default is off. */
+  itkSetMacro(UseTemporalBlocking, bool);
+  itkBooleanMacro(UseTemporalBlocking);
+  itkGetConstMacro(UseTemporalBlocking, bool);
+
+  /** Set/Get the maximum number of iterations computed in a tile with
+   * temporal blocking. Default is 4. */
+  itkSetClampMacro(NumberOfIterationsPerBlock, unsigned int, 1, NumericTraits< unsigned int >::max());
+  itkGetConstMacro(NumberOfIterationsPerBlock, unsigned int);
+
+  /** Set/Get the size of the tiles with temporal blocking. The size is
+   * selected automatically along the dimensions where it is zero, which
+   * is the default. */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputTimesDoubleCheck,
@@ -117,7 +154,10 @@ public:
 
 protected:
   DenseFiniteDifferenceImageFilter()
-  { m_UpdateBuffer = UpdateBufferType::New(); }
+  {
+    m_UpdateBuffer = UpdateBufferType::New();
+    m_TileSize.Fill(0);
+  }
   ~DenseFiniteDifferenceImageFilter() override = default;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
@@ -141,6 +181,21 @@ protected:
    * mechanism. Returns value is a time step to be used for the update. */
   TimeStepType CalculateChange() override;
 
+  /** This method computes several iterations tile by tile when temporal
+   * blocking is enabled and supported, and a single iteration with
+   * CalculateChange() and ApplyUpdate() otherwise. */
+  IdentifierType ComputeIterations() override;
+
+  /** Maximum number of iterations, from the current one, which can be
+   * computed with temporal blocking after a single call to
+   * InitializeIteration().  The time step of the function must not depend
+   * on the image, and ComputeUpdate() must only depend on the
+   * neighborhood.  The default, zero, disables temporal blocking, as the
+   * subclasses may compute global values or redefine the change
+   * calculation and update methods. */
+  virtual IdentifierType GetMaximumNumberOfIterationsPerBlock() const
+  { return 0; }
+
   /** This method allocates storage in m_UpdateBuffer.  It is called from
    * Superclass::GenerateData(). */
   void AllocateUpdateBuffer() override;
@@ -175,6 +230,26 @@ private:
     std::vector< bool > ValidTimeStepList;
   };
 
+  /** Structure for passing the tiles of a temporal block to the static
+   * callback method. */
+  struct DenseFDTileThreadStruct {
+    DenseFiniteDifferenceImageFilter *Filter;
+    IdentifierType NumberOfIterations;
+    std::vector< ThreadRegionType > Tiles;
+  };
+
+  /** Split the output requested region into tiles whose padded size
+   * fits in the cache, for the given number of iterations. */
+  std::vector< ThreadRegionType > SplitRequestedRegionIntoTiles(IdentifierType numberOfIterations) const;
+
+  /** Compute the iterations of a tile in the tile and update images, and
+   * write the tile to the update buffer. */
+  void ComputeTileIterations(const ThreadRegionType & tile, IdentifierType numberOfIterations,
+                             OutputImageType *tileImage, UpdateBufferType *tileUpdate);
+
+  /** This callback method computes the iterations of a share of the tiles. */
+  static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION ComputeTilesThreaderCallback(void *arg);
+
   /** This callback method uses ImageSource::SplitRequestedRegion to acquire an
    * output region that it passes to ThreadedApplyUpdate for processing. */
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION ApplyUpdateThreaderCallback(void *arg);
@@ -185,6 +260,10 @@ private:
 
   /** The buffer that holds the updates for an iteration of the algorithm. */
   typename UpdateBufferType::Pointer m_UpdateBuffer;
+
+  bool         m_UseTemporalBlocking{ false };
+  unsigned int m_NumberOfIterationsPerBlock{ 4 };
+  SizeType     m_TileSize;
 };
 } // end namespace itk
 
@@ -20,6 +20,8 @@
 #include "itkDenseFiniteDifferenceImageFilter.h"
 
 #include <list>
+#include <algorithm>
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
 #include "itkNeighborhoodAlgorithm.h"
@@ -228,7 +230,6 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >::TimeStepType
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::ThreadedCalculateChange(const ThreadRegionType & regionToProcess, ThreadIdType)
 {
-  using SizeType = typename OutputImageType::SizeType;
   using NeighborhoodIteratorType = typename FiniteDifferenceFunctionType::NeighborhoodType;
 
   using UpdateIteratorType = ImageRegionIterator< UpdateBufferType >;
@@ -297,12 +298,246 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   return timeStep;
 }
 
+template< typename TInputImage, typename TOutputImage >
+IdentifierType
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ComputeIterations()
+{
+  IdentifierType numberOfIterations = 0;
+  if ( m_UseTemporalBlocking )
+    {
+    numberOfIterations = std::min< IdentifierType >( m_NumberOfIterationsPerBlock,
+                                                      this->GetMaximumNumberOfIterationsPerBlock() );
+    if ( this->GetNumberOfIterations() > this->GetElapsedIterations() )
+      {
+      numberOfIterations = std::min( numberOfIterations,
+                                     this->GetNumberOfIterations() - this->GetElapsedIterations() );
+      }
+    }
+  if ( numberOfIterations == 0 )
+    {
+    return Superclass::ComputeIterations();
+    }
+
+  // Set up for multithreaded processing.
+  DenseFDTileThreadStruct str;
+
+  str.Filter = this;
+  str.NumberOfIterations = numberOfIterations;
+  str.Tiles = this->SplitRequestedRegionIntoTiles( numberOfIterations );
+  this->GetMultiThreader()->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  this->GetMultiThreader()->SetSingleMethod(this->ComputeTilesThreaderCallback,
+                                            &str);
+  // Multithread the execution
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // The tiles were written to the update buffer, which holds the new
+  // solution: exchange the buffers of the output and the update buffer.
+  typename OutputImageType::Pointer output = this->GetOutput();
+  typename OutputImageType::PixelContainerPointer solution = m_UpdateBuffer->GetPixelContainer();
+  m_UpdateBuffer->SetPixelContainer( output->GetPixelContainer() );
+  output->SetPixelContainer( solution );
+  output->Modified();
+
+  return numberOfIterations;
+}
+
+template< typename TInputImage, typename TOutputImage >
+std::vector< typename DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >::ThreadRegionType >
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::SplitRequestedRegionIntoTiles(IdentifierType numberOfIterations) const
+{
+  const ThreadRegionType region = this->GetOutput()->GetRequestedRegion();
+  const SizeType         radius = this->GetDifferenceFunction()->GetRadius();
+
+  std::vector< ThreadRegionType > tiles;
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return tiles;
+    }
+
+  // The tile and update images of a tile should fit in the cache, and be
+  // large enough for the padding to add little computation
+  const SizeValueType maximumNumberOfPixels =
+    std::max< SizeValueType >( 1, ( 1024 * 1024 ) / sizeof( PixelType ) );
+  const SizeValueType numberOfWorkUnits = this->GetNumberOfWorkUnits();
+
+  SizeType tileSize;
+  bool     automatic[ImageDimension];
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    automatic[d] = ( m_TileSize[d] == 0 );
+    tileSize[d] = automatic[d] ? region.GetSize(d) : std::min( m_TileSize[d], region.GetSize(d) );
+    }
+
+  // Halve the largest automatic tile dimension, the last one first to keep
+  // long lines, until the padded tile fits in the cache, as long as the
+  // padding stays smaller than the tile, then until there are enough tiles
+  // for the work units.
+  for ( unsigned int pass = 0; pass < 2; ++pass )
+    {
+    while ( true )
+      {
+      SizeValueType numberOfPaddedPixels = 1;
+      SizeValueType numberOfTiles = 1;
+      unsigned int  largest = ImageDimension;
+      for ( unsigned int d = 0; d < ImageDimension; ++d )
+        {
+        const SizeValueType halo = numberOfIterations * radius[d];
+        numberOfPaddedPixels *= tileSize[d] + 2 * halo;
+        numberOfTiles *= ( region.GetSize(d) + tileSize[d] - 1 ) / tileSize[d];
+        const SizeValueType minimumSize = ( pass == 0 ) ? std::max< SizeValueType >( 4 * halo, 2 ) : 2;
+        if ( automatic[d] && tileSize[d] >= minimumSize
+             && ( largest == ImageDimension || tileSize[d] >= tileSize[largest] ) )
+          {
+          largest = d;
+          }
+        }
+      const bool done = ( pass == 0 ) ? numberOfPaddedPixels <= maximumNumberOfPixels
+                                      : numberOfTiles >= numberOfWorkUnits;
+      if ( done || largest == ImageDimension )
+        {
+        break;
+        }
+      tileSize[largest] = ( tileSize[largest] + 1 ) / 2;
+      }
+    }
+
+  typename ThreadRegionType::IndexType tileIndex = region.GetIndex();
+  while ( true )
+    {
+    ThreadRegionType tile( tileIndex, tileSize );
+    tile.Crop( region );
+    tiles.push_back( tile );
+
+    unsigned int d = 0;
+    for ( ; d < ImageDimension; ++d )
+      {
+      tileIndex[d] += tileSize[d];
+      if ( tileIndex[d] < region.GetIndex(d) + static_cast< IndexValueType >( region.GetSize(d) ) )
+        {
+        break;
+        }
+      tileIndex[d] = region.GetIndex(d);
+      }
+    if ( d == ImageDimension )
+      {
+      break;
+      }
+    }
+  return tiles;
+}
+
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ComputeTilesThreaderCallback(void *arg)
+{
+  ThreadIdType threadId = ( (MultiThreaderBase::WorkUnitInfo *)( arg ) )->WorkUnitID;
+  ThreadIdType threadCount = ( (MultiThreaderBase::WorkUnitInfo *)( arg ) )->NumberOfWorkUnits;
+
+  auto * str = (DenseFDTileThreadStruct *) ( ( (MultiThreaderBase::WorkUnitInfo *)( arg ) )->UserData );
+
+  // The images of the tiles are reused by all the tiles of the work unit.
+  typename OutputImageType::Pointer tileImage = OutputImageType::New();
+  typename UpdateBufferType::Pointer tileUpdate = UpdateBufferType::New();
+  tileImage->CopyInformation( str->Filter->GetOutput() );
+  tileUpdate->CopyInformation( str->Filter->GetOutput() );
+
+  for ( size_t t = threadId; t < str->Tiles.size(); t += threadCount )
+    {
+    str->Filter->ComputeTileIterations( str->Tiles[t], str->NumberOfIterations, tileImage, tileUpdate );
+    }
+
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ComputeTileIterations(const ThreadRegionType & tile, IdentifierType numberOfIterations,
+                        OutputImageType *tileImage, UpdateBufferType *tileUpdate)
+{
+  using NeighborhoodIteratorType = typename FiniteDifferenceFunctionType::NeighborhoodType;
+  using FaceCalculatorType = NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< OutputImageType >;
+  using FaceListType = typename FaceCalculatorType::FaceListType;
+
+  const OutputImageType * output = this->GetOutput();
+  const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+  const SizeType radius = df->GetRadius();
+
+  // Copy the tile padded by the radius of the function for each iteration.
+  // Each iteration computes the solution over a region smaller by the
+  // radius, except at the boundaries of the output, where the boundary
+  // condition applies as for the whole output.
+  auto paddedTile = [&](IdentifierType numberOfRadii)
+    {
+    ThreadRegionType padded = tile;
+    SizeType         padding;
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      padding[d] = numberOfRadii * radius[d];
+      }
+    padded.PadByRadius( padding );
+    padded.Crop( output->GetBufferedRegion() );
+    return padded;
+    };
+
+  const ThreadRegionType padded = paddedTile( numberOfIterations );
+  tileImage->SetBufferedRegion( padded );
+  tileImage->SetRequestedRegion( padded );
+  tileImage->Allocate();
+  tileUpdate->SetBufferedRegion( padded );
+  tileUpdate->SetRequestedRegion( padded );
+  tileUpdate->Allocate();
+  ImageAlgorithm::Copy( output, tileImage, padded, padded );
+
+  FaceCalculatorType faceCalculator;
+  for ( IdentifierType iteration = 1; iteration <= numberOfIterations; ++iteration )
+    {
+    const ThreadRegionType region = paddedTile( numberOfIterations - iteration );
+
+    void * globalData = df->GetGlobalDataPointer();
+
+    FaceListType faceList = faceCalculator( tileImage, region, radius );
+    for ( auto fIt = faceList.begin(); fIt != faceList.end(); ++fIt )
+      {
+      NeighborhoodIteratorType             nD( radius, tileImage, *fIt );
+      ImageRegionIterator< UpdateBufferType > nU( tileUpdate, *fIt );
+      while ( !nD.IsAtEnd() )
+        {
+        nU.Value() = df->ComputeUpdate( nD, globalData );
+        ++nD;
+        ++nU;
+        }
+      }
+
+    const TimeStepType dt = df->ComputeGlobalTimeStep( globalData );
+    df->ReleaseGlobalDataPointer( globalData );
+
+    ImageRegionIterator< UpdateBufferType > u( tileUpdate, region );
+    ImageRegionIterator< OutputImageType >  o( tileImage, region );
+    while ( !u.IsAtEnd() )
+      {
+      o.Value() += static_cast< PixelType >( u.Value() * dt );
+      ++o;
+      ++u;
+      }
+    }
+
+  ImageAlgorithm::Copy( tileImage, m_UpdateBuffer.GetPointer(), tile, tile );
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseTemporalBlocking: " << ( m_UseTemporalBlocking ? "On" : "Off" ) << std::endl;
+  os << indent << "NumberOfIterationsPerBlock: " << m_NumberOfIterationsPerBlock << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
 }
 } // end namespace itk
 
@@ -247,6 +247,14 @@ protected:
    * calculated from this method. */
   virtual TimeStepType CalculateChange() = 0;
 
+  /** This method computes the next iterations of the solution, following
+   * a call to InitializeIteration(), and returns their number.  The
+   * default implementation computes a single iteration with
+   * CalculateChange() and ApplyUpdate().  Subclasses may compute several
+   * iterations at once when they do not need a new initialization in
+   * between. */
+  virtual IdentifierType ComputeIterations();
+
   /** This method can be defined in subclasses as needed to copy the input
    * to the output. See DenseFiniteDifferenceImageFilter for an
    * implementation. */
@@ -87,18 +87,20 @@ FiniteDifferenceImageFilter< TInputImage, TOutputImage >
                                  // global values, or otherwise setting up
                                  // for the next iteration
 
-    TimeStepType dt = this->CalculateChange();
+    const IdentifierType numberOfIterations = this->ComputeIterations();
 
-    this->ApplyUpdate(dt);
-    ++m_ElapsedIterations;
-
-    // Invoke the iteration event.
-    this->InvokeEvent( IterationEvent() );
-    if ( this->GetAbortGenerateData() )
+    for ( IdentifierType i = 0; i < numberOfIterations; ++i )
       {
+      ++m_ElapsedIterations;
+
+      // Invoke the iteration event.
       this->InvokeEvent( IterationEvent() );
-      this->ResetPipeline();
-      throw ProcessAborted(__FILE__, __LINE__);
+      if ( this->GetAbortGenerateData() )
+        {
+        this->InvokeEvent( IterationEvent() );
+        this->ResetPipeline();
+        throw ProcessAborted(__FILE__, __LINE__);
+        }
       }
     }
 
@@ -173,6 +175,18 @@ FiniteDifferenceImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+IdentifierType
+FiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ComputeIterations()
+{
+  TimeStepType dt = this->CalculateChange();
+
+  this->ApplyUpdate(dt);
+
+  return 1;
+}
+
 template< typename TInputImage, typename TOutputImage >
 typename FiniteDifferenceImageFilter< TInputImage, TOutputImage >::TimeStepType
 FiniteDifferenceImageFilter< TInputImage, TOutputImage >
@@ -147,6 +147,11 @@ protected:
   /** Prepare for the iteration process. */
   void InitializeIteration() override;
 
+  /** The iterations can be computed tile by tile up to the next update
+   * of the conductance scaling, or without limit when the average
+   * gradient magnitude is fixed. */
+  IdentifierType GetMaximumNumberOfIterationsPerBlock() const override;
+
   bool m_GradientMagnitudeIsFixed;
 
 private:
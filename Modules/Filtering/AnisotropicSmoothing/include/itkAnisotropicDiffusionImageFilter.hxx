@@ -107,6 +107,19 @@ AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+IdentifierType
+AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::GetMaximumNumberOfIterationsPerBlock() const
+{
+  if ( m_GradientMagnitudeIsFixed || m_ConductanceScalingUpdateInterval == 0 )
+    {
+    return NumericTraits< IdentifierType >::max();
+    }
+  return m_ConductanceScalingUpdateInterval
+         - this->GetElapsedIterations() % m_ConductanceScalingUpdateInterval;
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkCurvatureAnisotropicDiffusionImageFilter.h"
+#include "itkVectorGradientAnisotropicDiffusionImageFilter.h"
+#include "itkMinMaxCurvatureFlowImageFilter.h"
+#include "itkCommand.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+
+// Compute the iterations of anisotropic diffusion and curvature flow
+// filters tile by tile, several iterations at a time, with automatic and
+// given tile sizes, and compare with the iterations over the whole image.
+
+namespace
+{
+
+template< typename TImage >
+typename TImage::Pointer
+MakeImage( const typename TImage::IndexType & index, const typename TImage::SizeType & size )
+{
+  using PixelType = typename TImage::PixelType;
+  using TraitsType = itk::DefaultConvertPixelTraits< PixelType >;
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 5678 + size[0] );
+
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( typename TImage::RegionType( index, size ) );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    // A noisy checkerboard of blocks of 6 pixels
+    unsigned int block = 0;
+    for ( unsigned int d = 0; d < TImage::ImageDimension; ++d )
+      {
+      block += static_cast< unsigned int >( it.GetIndex()[d] - index[d] ) / 6;
+      }
+    PixelType value;
+    for ( unsigned int c = 0; c < TraitsType::GetNumberOfComponents(); ++c )
+      {
+      TraitsType::SetNthComponent( c, value,
+        static_cast< typename TraitsType::ComponentType >( 100.0 * ( ( block + c ) % 2 )
+                                                           + generator->GetNormalVariate( 0.0, 400.0 ) ) );
+      }
+    it.Set( value );
+    }
+  return image;
+}
+
+void
+CountIterations( itk::Object *, const itk::EventObject &, void * count )
+{
+  ++*static_cast< unsigned int * >( count );
+}
+
+template< typename TFilter >
+int
+CompareIterations( TFilter * filter, unsigned int numberOfIterations, const char * name )
+{
+  using ImageType = typename TFilter::OutputImageType;
+  using TraitsType = itk::DefaultConvertPixelTraits< typename ImageType::PixelType >;
+  using TileSizeType = typename TFilter::SizeType;
+  std::cout << name << std::endl;
+
+  filter->SetNumberOfIterations( numberOfIterations );
+  filter->UseTemporalBlockingOff();
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  typename ImageType::Pointer expected = filter->GetOutput();
+  expected->DisconnectPipeline();
+
+  unsigned int numberOfIterationEvents = 0;
+  itk::CStyleCommand::Pointer command = itk::CStyleCommand::New();
+  command->SetClientData( &numberOfIterationEvents );
+  command->SetCallback( CountIterations );
+  const unsigned long tag = filter->AddObserver( itk::IterationEvent(), command );
+
+  TileSizeType automaticTileSize;
+  automaticTileSize.Fill( 0 );
+  TileSizeType givenTileSize;
+  for ( unsigned int d = 0; d < ImageType::ImageDimension; ++d )
+    {
+    givenTileSize[d] = ( d == 1 ) ? 0 : 5 + 3 * d;
+    }
+  for ( const TileSizeType & tileSize : { automaticTileSize, givenTileSize } )
+    {
+    for ( unsigned int numberOfIterationsPerBlock : { 1, 3, 4 } )
+      {
+      filter->UseTemporalBlockingOn();
+      filter->SetTileSize( tileSize );
+      filter->SetNumberOfIterationsPerBlock( numberOfIterationsPerBlock );
+      numberOfIterationEvents = 0;
+      TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+      TEST_EXPECT_EQUAL( filter->GetElapsedIterations(), numberOfIterations );
+      TEST_EXPECT_EQUAL( numberOfIterationEvents, numberOfIterations );
+
+      const ImageType * image = filter->GetOutput();
+      TEST_EXPECT_EQUAL( image->GetBufferedRegion(), expected->GetBufferedRegion() );
+      itk::ImageRegionConstIteratorWithIndex< ImageType > it( expected, expected->GetBufferedRegion() );
+      for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+        {
+        const typename ImageType::PixelType value = image->GetPixel( it.GetIndex() );
+        for ( unsigned int c = 0; c < TraitsType::GetNumberOfComponents(); ++c )
+          {
+          const double component = TraitsType::GetNthComponent( c, value );
+          const double expectedComponent = TraitsType::GetNthComponent( c, it.Get() );
+          if ( std::abs( component - expectedComponent ) > 1e-4 * ( 1.0 + std::abs( expectedComponent ) ) )
+            {
+            std::cerr << "Tile size " << tileSize << ", " << numberOfIterationsPerBlock
+                      << " iterations per block: wrong value at " << it.GetIndex() << ": " << value
+                      << " expected " << it.Get() << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+  filter->RemoveObserver( tag );
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkAnisotropicDiffusionImageFilterTemporalBlockingTest( int, char *[] )
+{
+  using ImageType = itk::Image< float, 3 >;
+  ImageType::IndexType index;
+  index[0] = -4;
+  index[1] = 7;
+  index[2] = 0;
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+  size[2] = 23;
+  ImageType::Pointer image = MakeImage< ImageType >( index, size );
+
+  using GradientFilterType = itk::GradientAnisotropicDiffusionImageFilter< ImageType, ImageType >;
+  GradientFilterType::Pointer gradientFilter = GradientFilterType::New();
+  gradientFilter->SetInput( image );
+  gradientFilter->SetTimeStep( 0.0625 );
+  gradientFilter->SetConductanceParameter( 2.0 );
+  TEST_SET_GET_BOOLEAN( gradientFilter, UseTemporalBlocking, false );
+  TEST_SET_GET_VALUE( 4, gradientFilter->GetNumberOfIterationsPerBlock() );
+  GradientFilterType::SizeType tileSize;
+  tileSize.Fill( 0 );
+  TEST_SET_GET_VALUE( tileSize, gradientFilter->GetTileSize() );
+
+  // The average gradient magnitude is computed over the whole image before
+  // each iteration, then every third iteration, then it is fixed
+  if ( CompareIterations( gradientFilter.GetPointer(), 7, "Gradient" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  gradientFilter->SetConductanceScalingUpdateInterval( 3 );
+  if ( CompareIterations( gradientFilter.GetPointer(), 7, "Gradient, conductance scaling interval" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  gradientFilter->SetFixedAverageGradientMagnitude( 50.0 );
+  if ( CompareIterations( gradientFilter.GetPointer(), 10, "Gradient, fixed average gradient" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  using Image2DType = itk::Image< float, 2 >;
+  Image2DType::IndexType index2D;
+  index2D[0] = 3;
+  index2D[1] = -2;
+  Image2DType::SizeType size2D;
+  size2D[0] = 71;
+  size2D[1] = 45;
+  Image2DType::Pointer image2D = MakeImage< Image2DType >( index2D, size2D );
+
+  using CurvatureFilterType = itk::CurvatureAnisotropicDiffusionImageFilter< Image2DType, Image2DType >;
+  CurvatureFilterType::Pointer curvatureFilter = CurvatureFilterType::New();
+  curvatureFilter->SetInput( image2D );
+  curvatureFilter->SetTimeStep( 0.1 );
+  curvatureFilter->SetConductanceScalingUpdateInterval( 2 );
+  if ( CompareIterations( curvatureFilter.GetPointer(), 6, "Curvature" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  using VectorImageType = itk::Image< itk::Vector< float, 2 >, 2 >;
+  VectorImageType::Pointer vectorImage = MakeImage< VectorImageType >( index2D, size2D );
+  using VectorFilterType = itk::VectorGradientAnisotropicDiffusionImageFilter< VectorImageType, VectorImageType >;
+  VectorFilterType::Pointer vectorFilter = VectorFilterType::New();
+  vectorFilter->SetInput( vectorImage );
+  vectorFilter->SetTimeStep( 0.1 );
+  vectorFilter->SetFixedAverageGradientMagnitude( 80.0 );
+  if ( CompareIterations( vectorFilter.GetPointer(), 5, "Vector gradient" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The stencil radius of the min/max curvature flow is 2
+  using MinMaxFilterType = itk::MinMaxCurvatureFlowImageFilter< Image2DType, Image2DType >;
+  MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
+  minMaxFilter->SetInput( image2D );
+  minMaxFilter->SetTimeStep( 0.05 );
+  minMaxFilter->SetStencilRadius( 2 );
+  if ( CompareIterations( minMaxFilter.GetPointer(), 6, "Min/max curvature flow" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -40,6 +40,17 @@ namespace itk
  * of the kernel image and treats them as identical to those in the
  * input image.
  *
+ * By default the whole input is padded and transformed at once. With
+ * OverlapSave on, the output is instead computed in tiles of TileSize
+ * pixels, each convolved separately with the same Fourier transform of
+ * the kernel, keeping only the part of the tile that is not affected
+ * by the circular wrap-around. The tiles are processed in parallel,
+ * the memory needed is bounded by the tile size, and only the part of
+ * the input needed for the requested output region is requested, so
+ * that the filter can be streamed, by a StreamingImageFilter for
+ * example. Subclasses whose GenerateData() does not support this mode
+ * override UsesOverlapSave() to return false.
+ *
  * This code was adapted from the Insight Journal contribution:
  *
  * "FFT Based Convolution"
@@ -105,6 +116,18 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get whether the output is computed tile by tile with the
+   * overlap-save method. Defaults to off. */
+  itkSetMacro(OverlapSave, bool);
+  itkGetConstMacro(OverlapSave, bool);
+  itkBooleanMacro(OverlapSave);
+
+  /** Set/Get the size of the tiles transformed in overlap-save mode,
+   * kernel margins included. A size of zero along a dimension, the
+   * default, lets ComputeTileSize() choose it. */
+  itkSetMacro(TileSize, InputSizeType);
+  itkGetConstReferenceMacro(TileSize, InputSizeType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -128,6 +151,24 @@ protected:
   /** This filter uses a minipipeline to compute the output. */
   void GenerateData() override;
 
+  /** Compute the requested output region tile by tile. */
+  void OverlapSaveGenerateData();
+
+  /** Whether the output is computed in overlap-save mode, requesting only
+   * part of the input: OverlapSave by default. */
+  virtual bool UsesOverlapSave() const
+  {
+    return m_OverlapSave;
+  }
+
+  /** Choose the size of the tiles used to compute the given output
+   * region in overlap-save mode. The size minimizes an estimate of the
+   * time taken by the Fourier transforms of the tiles, processed
+   * NumberOfWorkUnits at a time, among the sizes whose greatest prime
+   * factor is at most SizeGreatestPrimeFactor and whose number of
+   * pixels is at most 2^21. Sizes set in TileSize are kept. */
+  virtual InputSizeType ComputeTileSize(const OutputRegionType & outputRegion) const;
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -161,6 +202,13 @@ protected:
                      InternalComplexImagePointerType & preparedKernel,
                      ProgressAccumulator * progress, float progressWeight);
 
+  /** Normalize the kernel if requested, pad it to padSize, shift it
+   * and take its Fourier transform. */
+  void TransformKernel(const KernelImageType * kernel,
+                       const InputSizeType & padSize,
+                       InternalComplexImagePointerType & transformedKernel,
+                       ProgressAccumulator * progress, float progressWeight);
+
   /** Produce output from the final Fourier domain image. */
   void ProduceOutput(InternalComplexImageType * paddedOutput,
                      ProgressAccumulator * progress,
@@ -189,6 +237,8 @@ protected:
 
 private:
   SizeValueType m_SizeGreatestPrimeFactor;
+  bool          m_OverlapSave{ false };
+  InputSizeType m_TileSize;
 };
 }
 
@@ -26,11 +26,15 @@
 #include "itkConstantPadImageFilter.h"
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
 
+#include <functional>
+
 namespace itk
 {
 
@@ -39,6 +43,7 @@ FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPre
 ::FFTConvolutionImageFilter()
 {
   m_SizeGreatestPrimeFactor = FFTFilterType::New()->GetSizeGreatestPrimeFactor();
+  m_TileSize.Fill( 0 );
 }
 
 template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
@@ -46,6 +51,29 @@ void
 FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
 ::GenerateInputRequestedRegion()
 {
+  if ( this->UsesOverlapSave() && this->GetInput() && this->GetKernelImage() )
+    {
+    // Request the part of the input the requested output region
+    // depends on, extended by the boundary condition.
+    typename InputImageType::Pointer imagePtr =
+      const_cast< InputImageType * >( this->GetInput() );
+    const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+    InputRegionType neededRegion = this->GetOutput()->GetRequestedRegion();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+      neededRegion.SetIndex( i, neededRegion.GetIndex( i )
+                                - static_cast< typename InputIndexType::IndexValueType >( kernelSize[i] - 1 - kernelSize[i] / 2 ) );
+      neededRegion.SetSize( i, neededRegion.GetSize( i ) + kernelSize[i] - 1 );
+      }
+    imagePtr->SetRequestedRegion(
+      this->GetBoundaryCondition()->GetInputRequestedRegion( imagePtr->GetLargestPossibleRegion(), neededRegion ) );
+
+    typename KernelImageType::Pointer kernelPtr =
+      const_cast< KernelImageType * >( this->GetKernelImage() );
+    kernelPtr->SetRequestedRegionToLargestPossibleRegion();
+    return;
+    }
+
   // Request the largest possible region for both input images.
   if ( this->GetInput() )
     {
@@ -69,6 +97,12 @@ void
 FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
 ::GenerateData()
 {
+  if ( this->UsesOverlapSave() )
+    {
+    this->OverlapSaveGenerateData();
+    return;
+    }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter( this );
@@ -98,6 +132,230 @@ FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPre
   this->ProduceOutput( multiplyFilter->GetOutput(), progress, 0.2 );
 }
 
+template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
+void
+FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
+::OverlapSaveGenerateData()
+{
+  this->AllocateOutputs();
+
+  OutputImageType * output = this->GetOutput();
+  const OutputRegionType outputRegion = output->GetRequestedRegion();
+  if ( outputRegion.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const InputImageType * input = this->GetInput();
+  const KernelImageType * kernel = this->GetKernelImage();
+  const KernelSizeType kernelSize = kernel->GetLargestPossibleRegion().GetSize();
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+    if ( m_TileSize[i] > 0 && m_TileSize[i] < kernelSize[i] )
+      {
+      itkExceptionMacro( "The tile size " << m_TileSize << " is smaller than the kernel size " << kernelSize );
+      }
+    }
+  const InputSizeType tileSize = this->ComputeTileSize( outputRegion );
+  itkDebugMacro( "Tile size: " << tileSize );
+
+  // Each tile yields validSize output pixels not affected by the
+  // circular wrap-around, from the input pixels lowerMargin before
+  // them to kernelSize - 1 - lowerMargin after them.
+  using InputIndexValueType = typename InputIndexType::IndexValueType;
+  InputSizeType   validSize;
+  InputIndexType  lowerMargin;
+  InputSizeType   numberOfTilesAlong;
+  InputRegionType neededRegion = outputRegion;
+  SizeValueType   numberOfTiles = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+    validSize[i] = tileSize[i] - kernelSize[i] + 1;
+    lowerMargin[i] = static_cast< InputIndexValueType >( kernelSize[i] - 1 - kernelSize[i] / 2 );
+    neededRegion.SetIndex( i, outputRegion.GetIndex( i ) - lowerMargin[i] );
+    neededRegion.SetSize( i, outputRegion.GetSize( i ) + kernelSize[i] - 1 );
+    numberOfTilesAlong[i] = ( outputRegion.GetSize( i ) + validSize[i] - 1 ) / validSize[i];
+    numberOfTiles *= numberOfTilesAlong[i];
+    }
+
+  // The Fourier transform of the kernel is shared by all the tiles
+  ProgressAccumulator::Pointer progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter( this );
+  InternalComplexImagePointerType transformedKernel;
+  this->TransformKernel( kernel, tileSize, transformedKernel, progress, 1.0f );
+  const InternalComplexType * kernelBuffer = transformedKernel->GetBufferPointer();
+
+  const InputRegionType & largestRegion = input->GetLargestPossibleRegion();
+  const BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+  const bool xDimensionIsOdd = ( tileSize[0] % 2 != 0 );
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfTiles,
+    [&](SizeValueType tile)
+    {
+      OutputRegionType validRegion;
+      InputIndexType   tileIndex;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+        const SizeValueType position = tile % numberOfTilesAlong[i];
+        tile /= numberOfTilesAlong[i];
+        validRegion.SetIndex( i, outputRegion.GetIndex( i ) + static_cast< InputIndexValueType >( position * validSize[i] ) );
+        validRegion.SetSize( i, std::min( validSize[i], outputRegion.GetSize( i ) - position * validSize[i] ) );
+        tileIndex[i] = validRegion.GetIndex( i ) - lowerMargin[i];
+        }
+
+      // Fill the tile with the input pixels needed, through the
+      // boundary condition outside of the input. The other pixels only
+      // contribute to the discarded part of the tile and are left to
+      // zero.
+      InternalImagePointerType tileImage = InternalImageType::New();
+      tileImage->SetRegions( tileSize );
+      tileImage->Allocate( true );
+      InputRegionType fillRegion( tileIndex, tileSize );
+      fillRegion.Crop( neededRegion );
+      InputRegionType insideRegion = fillRegion;
+      if ( insideRegion.Crop( largestRegion ) )
+        {
+        InputRegionType tileInsideRegion = insideRegion;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+          tileInsideRegion.SetIndex( i, insideRegion.GetIndex( i ) - tileIndex[i] );
+          }
+        ImageAlgorithm::Copy( input, tileImage.GetPointer(), insideRegion, tileInsideRegion );
+        }
+      if ( !largestRegion.IsInside( fillRegion ) )
+        {
+        InputRegionType tileFillRegion = fillRegion;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+          tileFillRegion.SetIndex( i, fillRegion.GetIndex( i ) - tileIndex[i] );
+          }
+        ImageRegionIteratorWithIndex< InternalImageType > it( tileImage, tileFillRegion );
+        for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+          {
+          InputIndexType index = it.GetIndex();
+          for (unsigned int i = 0; i < ImageDimension; ++i)
+            {
+            index[i] += tileIndex[i];
+            }
+          if ( !largestRegion.IsInside( index ) )
+            {
+            it.Set( static_cast< TInternalPrecision >( boundaryCondition->GetPixel( index, input ) ) );
+            }
+          }
+        }
+
+      // The tiles are processed in parallel, one thread each
+      typename FFTFilterType::Pointer tileFFTFilter = FFTFilterType::New();
+      tileFFTFilter->SetNumberOfWorkUnits( 1 );
+      tileFFTFilter->SetInput( tileImage );
+      tileFFTFilter->Update();
+      InternalComplexImagePointerType transformedTile = tileFFTFilter->GetOutput();
+      transformedTile->DisconnectPipeline();
+      tileFFTFilter = nullptr;
+      tileImage = nullptr;
+
+      InternalComplexType * tileBuffer = transformedTile->GetBufferPointer();
+      const SizeValueType numberOfFrequencies = transformedTile->GetBufferedRegion().GetNumberOfPixels();
+      for ( SizeValueType j = 0; j < numberOfFrequencies; ++j )
+        {
+        tileBuffer[j] *= kernelBuffer[j];
+        }
+
+      typename IFFTFilterType::Pointer tileIFFTFilter = IFFTFilterType::New();
+      tileIFFTFilter->SetActualXDimensionIsOdd( xDimensionIsOdd );
+      tileIFFTFilter->SetNumberOfWorkUnits( 1 );
+      tileIFFTFilter->SetInput( transformedTile );
+      tileIFFTFilter->Update();
+
+      InputRegionType tileValidRegion = validRegion;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+        {
+        tileValidRegion.SetIndex( i, validRegion.GetIndex( i ) - tileIndex[i] );
+        }
+      ImageAlgorithm::Copy( tileIFFTFilter->GetOutput(), output, tileValidRegion, validRegion );
+    },
+    this );
+}
+
+template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
+typename FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >::InputSizeType
+FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
+::ComputeTileSize(const OutputRegionType & outputRegion) const
+{
+  const SizeValueType maximumNumberOfPixels = 1 << 21;
+  const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+  const double numberOfWorkUnits = std::max( this->GetNumberOfWorkUnits(), 1u );
+
+  // The candidate sizes along each dimension, from the kernel size to
+  // the first one covering the output region with its margins. Any
+  // size is allowed if SizeGreatestPrimeFactor is not set, but only
+  // sizes with small prime factors are considered.
+  const SizeValueType greatestPrimeFactor = m_SizeGreatestPrimeFactor > 1 ? m_SizeGreatestPrimeFactor : 5;
+  std::vector< SizeValueType > candidates[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+    if ( m_TileSize[i] > 0 )
+      {
+      candidates[i].push_back( m_TileSize[i] );
+      continue;
+      }
+    const SizeValueType coveringSize = outputRegion.GetSize( i ) + kernelSize[i] - 1;
+    for ( SizeValueType size = kernelSize[i]; candidates[i].empty() || candidates[i].back() < coveringSize; ++size )
+      {
+      if ( Math::GreatestPrimeFactor( size ) <= greatestPrimeFactor )
+        {
+        candidates[i].push_back( size );
+        }
+      }
+    }
+
+  // Estimate the time taken by the Fourier transforms of all the tiles
+  // for each combination of candidates within the pixel budget.
+  InputSizeType tileSize;
+  InputSizeType bestTileSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+    bestTileSize[i] = candidates[i].front();
+    }
+  double bestCost = NumericTraits< double >::max();
+  std::function< void(unsigned int, SizeValueType) > search =
+    [&](unsigned int dimension, SizeValueType numberOfPixels)
+    {
+      if ( dimension == ImageDimension )
+        {
+        double numberOfTiles = 1.0;
+        for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+          const SizeValueType validSize = tileSize[i] - kernelSize[i] + 1;
+          numberOfTiles *= static_cast< double >( ( outputRegion.GetSize( i ) + validSize - 1 ) / validSize );
+          }
+        const auto tilePixels = static_cast< double >( numberOfPixels );
+        const double cost = std::ceil( numberOfTiles / numberOfWorkUnits ) * tilePixels
+                            * std::log2( std::max( tilePixels, 2.0 ) );
+        if ( cost < bestCost )
+          {
+          bestCost = cost;
+          bestTileSize = tileSize;
+          }
+        return;
+        }
+      for ( const SizeValueType size : candidates[dimension] )
+        {
+        if ( numberOfPixels * size > maximumNumberOfPixels && size != candidates[dimension].front() )
+          {
+          break;
+          }
+        tileSize[dimension] = size;
+        search( dimension + 1, numberOfPixels * size );
+        }
+    };
+  search( 0, 1 );
+
+  return bestTileSize;
+}
+
 template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
 void
 FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
@@ -204,11 +462,43 @@ FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPre
 ::PrepareKernel(const KernelImageType * kernel,
                 InternalComplexImagePointerType & preparedKernel,
                 ProgressAccumulator * progress, float progressWeight)
+{
+  InternalComplexImagePointerType transformedKernel;
+  this->TransformKernel( kernel, this->GetPadSize(), transformedKernel, progress, 0.999f * progressWeight );
+
+  using InfoFilterType = ChangeInformationImageFilter< InternalComplexImageType >;
+  typename InfoFilterType::Pointer kernelInfoFilter = InfoFilterType::New();
+  kernelInfoFilter->ChangeRegionOn();
+
+  using InfoOffsetValueType = typename InfoFilterType::OutputImageOffsetValueType;
+  const InputSizeType & inputLowerBound = this->GetPadLowerBound();
+  const InputIndexType & inputIndex = this->GetInput()->GetLargestPossibleRegion().GetIndex();
+  const KernelIndexType & kernelIndex = kernel->GetLargestPossibleRegion().GetIndex();
+  InfoOffsetValueType kernelOffset[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+    kernelOffset[i] = static_cast< InfoOffsetValueType >( inputIndex[i] - inputLowerBound[i] - kernelIndex[i] );
+    }
+  kernelInfoFilter->SetOutputOffset( kernelOffset );
+  kernelInfoFilter->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  kernelInfoFilter->SetInput( transformedKernel );
+  progress->RegisterInternalFilter( kernelInfoFilter, 0.001f * progressWeight );
+  kernelInfoFilter->Update();
+
+  preparedKernel = kernelInfoFilter->GetOutput();
+}
+
+template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
+void
+FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPrecision >
+::TransformKernel(const KernelImageType * kernel,
+                  const InputSizeType & padSize,
+                  InternalComplexImagePointerType & transformedKernel,
+                  ProgressAccumulator * progress, float progressWeight)
 {
   KernelRegionType kernelRegion = kernel->GetLargestPossibleRegion();
   KernelSizeType kernelSize = kernelRegion.GetSize();
 
-  InputSizeType padSize = this->GetPadSize();
   typename KernelImageType::SizeType kernelUpperBound;
   for (unsigned int i = 0; i < ImageDimension; ++i)
     {
@@ -276,29 +566,11 @@ FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPre
   typename FFTFilterType::Pointer kernelFFTFilter = FFTFilterType::New();
   kernelFFTFilter->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
   kernelFFTFilter->SetInput( kernelShifter->GetOutput() );
-  progress->RegisterInternalFilter( kernelFFTFilter, 0.699f * progressWeight );
+  progress->RegisterInternalFilter( kernelFFTFilter, 0.7f * progressWeight );
   kernelFFTFilter->Update();
 
-  using InfoFilterType = ChangeInformationImageFilter< InternalComplexImageType >;
-  typename InfoFilterType::Pointer kernelInfoFilter = InfoFilterType::New();
-  kernelInfoFilter->ChangeRegionOn();
-
-  using InfoOffsetValueType = typename InfoFilterType::OutputImageOffsetValueType;
-  const InputSizeType & inputLowerBound = this->GetPadLowerBound();
-  const InputIndexType & inputIndex = this->GetInput()->GetLargestPossibleRegion().GetIndex();
-  const KernelIndexType & kernelIndex = kernel->GetLargestPossibleRegion().GetIndex();
-  InfoOffsetValueType kernelOffset[ImageDimension];
-  for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-    kernelOffset[i] = static_cast< InfoOffsetValueType >( inputIndex[i] - inputLowerBound[i] - kernelIndex[i] );
-    }
-  kernelInfoFilter->SetOutputOffset( kernelOffset );
-  kernelInfoFilter->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
-  kernelInfoFilter->SetInput( kernelFFTFilter->GetOutput() );
-  progress->RegisterInternalFilter( kernelInfoFilter, 0.001f * progressWeight );
-  kernelInfoFilter->Update();
-
-  preparedKernel = kernelInfoFilter->GetOutput();
+  transformedKernel = kernelFFTFilter->GetOutput();
+  transformedKernel->DisconnectPipeline();
 }
 
 template< typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision >
@@ -425,6 +697,8 @@ FFTConvolutionImageFilter< TInputImage, TKernelImage, TOutputImage, TInternalPre
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "OverlapSave: " << m_OverlapSave << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
 }
 
 }
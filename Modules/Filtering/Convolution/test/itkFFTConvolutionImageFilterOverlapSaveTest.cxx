@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Convolve an image tile by tile with the overlap-save method, with
+// automatic and given tile sizes, in the SAME and VALID output region
+// modes, with another boundary condition and through a
+// StreamingImageFilter, and compare with the whole image convolution.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image< float, Dimension >;
+using FilterType = itk::FFTConvolutionImageFilter< ImageType >;
+
+ImageType::Pointer
+MakeImage( const ImageType::IndexType & index, const ImageType::SizeType & size )
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 + size[0] );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( ImageType::RegionType( index, size ) );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( generator->GetUniformVariate( -1.0, 2.0 ) ) );
+    }
+  return image;
+}
+
+ImageType::Pointer
+Convolve( FilterType * filter, unsigned int numberOfStreamDivisions )
+{
+  using StreamingFilterType = itk::StreamingImageFilter< ImageType, ImageType >;
+  StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+int
+Compare( const ImageType * expected, const ImageType * image, const char * name )
+{
+  std::cout << name << std::endl;
+  TEST_EXPECT_EQUAL( image->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( image->GetBufferedRegion(), expected->GetBufferedRegion() );
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( expected, expected->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const float value = image->GetPixel( it.GetIndex() );
+    if ( std::abs( value - it.Get() ) > 1e-4f * ( 1.0f + std::abs( it.Get() ) ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << value << " expected " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkFFTConvolutionImageFilterOverlapSaveTest( int, char *[] )
+{
+  ImageType::IndexType imageIndex;
+  imageIndex[0] = -3;
+  imageIndex[1] = 5;
+  imageIndex[2] = 0;
+  ImageType::SizeType imageSize;
+  imageSize[0] = 61;
+  imageSize[1] = 47;
+  imageSize[2] = 23;
+  ImageType::Pointer image = MakeImage( imageIndex, imageSize );
+
+  ImageType::IndexType kernelIndex;
+  kernelIndex[0] = 2;
+  kernelIndex[1] = 0;
+  kernelIndex[2] = -1;
+  ImageType::SizeType kernelSize;
+  kernelSize[0] = 7;
+  kernelSize[1] = 4;
+  kernelSize[2] = 3;
+  ImageType::Pointer kernel = MakeImage( kernelIndex, kernelSize );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetKernelImage( kernel );
+  TEST_SET_GET_BOOLEAN( filter, OverlapSave, false );
+  FilterType::InputSizeType tileSize;
+  tileSize.Fill( 0 );
+  TEST_SET_GET_VALUE( tileSize, filter->GetTileSize() );
+
+  itk::PeriodicBoundaryCondition< ImageType > periodicBoundaryCondition;
+  struct
+  {
+    const char * m_Name;
+    bool         m_Valid;
+    bool         m_Normalize;
+    bool         m_Periodic;
+  } configurations[] = { { "Same", false, false, false },
+                         { "Valid", true, false, false },
+                         { "SameNormalizedPeriodic", false, true, true } };
+  for ( const auto & configuration : configurations )
+    {
+    filter->SetOverlapSave( false );
+    filter->SetTileSize( tileSize );
+    if ( configuration.m_Valid )
+      {
+      filter->SetOutputRegionModeToValid();
+      }
+    else
+      {
+      filter->SetOutputRegionModeToSame();
+      }
+    filter->SetNormalize( configuration.m_Normalize );
+    if ( configuration.m_Periodic )
+      {
+      filter->SetBoundaryCondition( &periodicBoundaryCondition );
+      }
+    ImageType::Pointer expected = Convolve( filter, 1 );
+    std::cout << configuration.m_Name << std::endl;
+
+    filter->OverlapSaveOn();
+    if ( Compare( expected, Convolve( filter, 1 ), "Automatic tile size" ) != EXIT_SUCCESS
+         || Compare( expected, Convolve( filter, 7 ), "Automatic tile size, streamed" ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+
+    FilterType::InputSizeType givenTileSize;
+    givenTileSize[0] = 16;
+    givenTileSize[1] = 0;
+    givenTileSize[2] = 9;
+    filter->SetTileSize( givenTileSize );
+    if ( Compare( expected, Convolve( filter, 1 ), "Given tile size" ) != EXIT_SUCCESS
+         || Compare( expected, Convolve( filter, 5 ), "Given tile size, streamed" ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The tiles cannot be smaller than the kernel
+  tileSize.Fill( 3 );
+  filter->SetTileSize( tileSize );
+  TRY_EXPECT_EXCEPTION( filter->Update() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
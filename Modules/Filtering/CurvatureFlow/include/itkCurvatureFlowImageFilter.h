@@ -178,6 +178,11 @@ protected:
    * Progress feeback is implemented as part of this method. */
   void InitializeIteration() override;
 
+  /** The time step is fixed, so any number of iterations can be computed
+   * tile by tile. */
+  IdentifierType GetMaximumNumberOfIterationsPerBlock() const override
+  { return NumericTraits< IdentifierType >::max(); }
+
   /** To support streaming, this filter produces a output which is
    * larger than the original requested region. The output is padding
    * by m_NumberOfIterations pixels on edge. */
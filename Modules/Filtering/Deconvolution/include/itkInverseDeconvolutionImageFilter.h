@@ -111,6 +111,13 @@ protected:
   /** This filter uses a minipipeline to compute the output. */
   void GenerateData() override;
 
+  /** The deconvolution is computed over the whole image, OverlapSave
+   * is ignored. */
+  bool UsesOverlapSave() const override
+  {
+    return false;
+  }
+
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
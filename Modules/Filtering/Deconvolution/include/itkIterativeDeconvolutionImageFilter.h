@@ -127,6 +127,12 @@ protected:
    * ThreadedGenerateData is not overridden. */
   void GenerateData() override;
 
+  /** The iterations run over the whole image, OverlapSave is ignored. */
+  bool UsesOverlapSave() const override
+  {
+    return false;
+  }
+
   /** Discrete Fourier transform of the padded kernel. */
   InternalComplexImagePointerType m_TransferFunction;
 
@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkInverseDeconvolutionImageFilter.h"
+#include "itkLandweberDeconvolutionImageFilter.h"
+#include "itkRandomImageSource.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTikhonovDeconvolutionImageFilter.h"
+#include "itkWienerDeconvolutionImageFilter.h"
+
+#include <cmath>
+
+// Deconvolve a streamed output with OverlapSave on, which the
+// deconvolution filters ignore, and check that they still request the
+// whole input and give the same output as without it.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image< float, Dimension >;
+using SourceType = itk::RandomImageSource< ImageType >;
+
+ImageType::Pointer
+MakeKernel()
+{
+  ImageType::SizeType size;
+  size.Fill( 5 );
+  ImageType::Pointer kernel = ImageType::New();
+  kernel->SetRegions( size );
+  kernel->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( kernel, kernel->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const double x = it.GetIndex()[0] - 2.0;
+    const double y = it.GetIndex()[1] - 2.0;
+    it.Set( static_cast< float >( std::exp( -0.5 * ( x * x + y * y ) ) ) );
+    }
+  return kernel;
+}
+
+ImageType::Pointer
+Deconvolve( itk::ImageSource< ImageType > * filter, unsigned int numberOfStreamDivisions )
+{
+  using StreamingFilterType = itk::StreamingImageFilter< ImageType, ImageType >;
+  StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+template< typename TFilter >
+int
+CheckOverlapSaveIgnored( SourceType * source, const ImageType * kernel, const char * name )
+{
+  std::cout << name << std::endl;
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput( source->GetOutput() );
+  filter->SetKernelImage( kernel );
+  filter->NormalizeOn();
+  ImageType::Pointer expected = Deconvolve( filter, 1 );
+
+  // Let the source produce only the requested region of its output
+  filter->OverlapSaveOn();
+  source->Modified();
+  ImageType::Pointer image = Deconvolve( filter, 4 );
+  TEST_EXPECT_EQUAL( source->GetOutput()->GetBufferedRegion(), source->GetOutput()->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( image->GetBufferedRegion(), expected->GetBufferedRegion() );
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( expected, expected->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const float value = image->GetPixel( it.GetIndex() );
+    if ( std::abs( value - it.Get() ) > 1e-4f * ( 1.0f + std::abs( it.Get() ) ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << value << " expected " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkDeconvolutionOverlapSaveTest( int, char *[] )
+{
+  ImageType::SizeValueType size[Dimension] = { 40, 30 };
+  SourceType::Pointer source = SourceType::New();
+  source->SetSize( size );
+  source->SetMin( 0.0 );
+  source->SetMax( 100.0 );
+
+  ImageType::Pointer kernel = MakeKernel();
+
+  using InverseFilterType = itk::InverseDeconvolutionImageFilter< ImageType >;
+  using TikhonovFilterType = itk::TikhonovDeconvolutionImageFilter< ImageType >;
+  using WienerFilterType = itk::WienerDeconvolutionImageFilter< ImageType >;
+  using LandweberFilterType = itk::LandweberDeconvolutionImageFilter< ImageType >;
+  if ( CheckOverlapSaveIgnored< InverseFilterType >( source, kernel, "Inverse" ) != EXIT_SUCCESS
+       || CheckOverlapSaveIgnored< TikhonovFilterType >( source, kernel, "Tikhonov" ) != EXIT_SUCCESS
+       || CheckOverlapSaveIgnored< WienerFilterType >( source, kernel, "Wiener" ) != EXIT_SUCCESS
+       || CheckOverlapSaveIgnored< LandweberFilterType >( source, kernel, "Landweber" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
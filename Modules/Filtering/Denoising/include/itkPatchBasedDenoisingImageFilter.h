@@ -183,6 +183,25 @@ public:
   itkBooleanMacro(UseFastTensorComputations);
   itkGetConstMacro(UseFastTensorComputations, bool);
 
+  /** Set/Get flag indicating whether the fast patch distance computations should be used.
+   *
+   *  When this flag is true or On, the components of the image are copied at the start of
+   *  each iteration to a contiguous buffer of float values, on which the distances between
+   *  the patch of each pixel and its selected patches are computed without going through
+   *  neighborhood iterators. When, in addition, the sampler is a SpatialNeighborSubsampler,
+   *  i.e. all the patches within its radius are selected, and all the patch weights are
+   *  equal, which requires UseSmoothDiscPatchWeights to be false, the distances to the
+   *  patches translated by a given offset are computed at once for all the pixels, as box
+   *  sums of the squared differences between the image and its translate. Their cost then no
+   *  longer depends on the size of the patches.
+   *
+   *  The denoised image is the same as without this flag, up to the precision of the float
+   *  values. This flag is ignored in the RIEMANNIAN component space. Defaults to false.
+   */
+  itkSetMacro(UseFastPatchDistances, bool);
+  itkBooleanMacro(UseFastPatchDistances);
+  itkGetConstMacro(UseFastPatchDistances, bool);
+
   /** Maximum number of Newton-Raphson iterations for sigma update. */
   static constexpr unsigned int MaxSigmaUpdateIterations = 20;
 
@@ -412,6 +431,30 @@ protected:
                                                BaseSamplerPointer& sampler,
                                                ThreadDataStruct& threadData);
 
+  /** Work buffers of ComputeGradientJointEntropyFromPatchFeatures. */
+  struct PatchFeaturesStruct
+    {
+    std::vector<OffsetValueType> offsets;
+    std::vector<SizeValueType>   lengths;
+    std::vector<float>           weights;
+    std::vector<float>           values;
+    std::vector<float>           norms;
+    std::vector<RealValueType>   gradient;
+    };
+
+  /** Compute the gradient of the joint entropy at a pixel as ComputeGradientJointEntropy
+   *  does, from the float copy of the image made when UseFastPatchDistances is On. */
+  virtual RealType ComputeGradientJointEntropyFromPatchFeatures(const typename OutputImageType::IndexType& index,
+                                                                BaseSamplerPointer& sampler,
+                                                                PatchFeaturesStruct& features);
+
+  /** Compute the gradients of the joint entropy at all the pixels of a region, stored
+   *  component by component in the order of an ImageRegionIterator, with box sums of the
+   *  squared differences between the image and its translates by each offset within the
+   *  radius of the SpatialNeighborSubsampler. */
+  virtual void ComputeGradientJointEntropyWithBoxSums(const InputImageRegionType& region,
+                                                      std::vector<RealValueType>& gradients);
+
   void ApplyUpdate() override;
 
   virtual void ThreadedApplyUpdate(const InputImageRegionType& regionToProcess,
@@ -423,6 +466,10 @@ protected:
 
   virtual ThreadDataStruct GetThreadData(int threadId);
 
+  /** Copy the components of the output image to the float buffer on which the fast
+   *  patch distances are computed. */
+  virtual void CachePatchFeatures();
+
 private:
   /** This callback method uses ImageSource::SplitRequestedRegion to acquire an
    * output region that it passes to ComputeSigma for processing. */
@@ -507,6 +554,18 @@ private:
 
   bool m_UseFastTensorComputations{ true };
 
+  bool m_UseFastPatchDistances{ false };
+
+  /** Whether the current iteration computes the patch distances with box sums. */
+  bool m_UseBoxSumPatchDistances{ false };
+
+  /** Float copy of the components of the output image, offsets in this copy of
+   *  the pixels of a patch relative to its center, and their squared weights. */
+  std::vector<float>                                m_PatchFeatures;
+  std::vector<OffsetValueType>                      m_PatchFeatureOffsets;
+  std::vector<float>                                m_PatchFeatureWeights;
+  std::vector<typename OutputImageType::OffsetType> m_PatchIndexOffsets;
+
   RealArrayType  m_KernelBandwidthSigma;
   bool           m_KernelBandwidthSigmaIsSet{ false };
   RealArrayType  m_IntensityRescaleInvFactor;
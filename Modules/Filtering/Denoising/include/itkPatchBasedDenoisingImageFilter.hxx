@@ -28,10 +28,14 @@
 #include "itkGaussianOperator.h"
 #include "itkImageAlgorithm.h"
 #include "itkVectorImageToImageAdaptor.h"
+#include "itkImageScanlineIterator.h"
+#include "itkSummedAreaTable.h"
 #include "itkSpatialNeighborSubsampler.h"
 #include "itkMacro.h"
 #include "itkMath.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -1407,6 +1411,80 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
     m_ThreadData[thread].sampler->SetSample(searchList);
     m_ThreadData[thread].sampler->SetSampleRegion(searchList->GetRegion() );
     }
+
+  // Prepare the fast patch distances. All the translations of the patches
+  // within the radius of a SpatialNeighborSubsampler are selected, so that
+  // their distances can be computed with box sums when all the patch weights
+  // are equal.
+  m_UseBoxSumPatchDistances = false;
+  if( m_UseFastPatchDistances && this->GetComponentSpace() == Superclass::EUCLIDEAN )
+    {
+    this->CachePatchFeatures();
+
+    using SpatialNeighborSamplerType =
+        itk::Statistics::SpatialNeighborSubsampler< PatchSampleType, InputImageRegionType >;
+    const bool uniformPatchWeights =
+      std::all_of( m_PatchFeatureWeights.begin(), m_PatchFeatureWeights.end(),
+                   [this](float weight) { return weight == m_PatchFeatureWeights[0]; } );
+    m_UseBoxSumPatchDistances = uniformPatchWeights &&
+      dynamic_cast<SpatialNeighborSamplerType *>( m_Sampler.GetPointer() ) != nullptr &&
+      std::string( m_Sampler->GetNameOfClass() ) == "SpatialNeighborSubsampler";
+    }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::CachePatchFeatures()
+{
+  const OutputImageType *    output = this->m_OutputImage;
+  const InputImageRegionType region = output->GetBufferedRegion();
+  const unsigned int         numberOfComponents = m_NumPixelComponents;
+
+  m_PatchFeatures.resize( region.GetNumberOfPixels() * numberOfComponents );
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this, output, numberOfComponents](const InputImageRegionType & subregion)
+      {
+      ImageScanlineConstIterator<OutputImageType> it( output, subregion );
+      while( !it.IsAtEnd() )
+        {
+        float *feature = m_PatchFeatures.data() + output->ComputeOffset( it.GetIndex() ) * numberOfComponents;
+        while( !it.IsAtEndOfLine() )
+          {
+          const PixelType pixel = it.Get();
+          for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+            {
+            *feature++ = static_cast<float>( this->GetComponent( pixel, pc ) );
+            }
+          ++it;
+          }
+        it.NextLine();
+        }
+      },
+    nullptr );
+
+  // Offsets and squared weights of the pixels of a patch, in the order of
+  // the patch weights
+  Neighborhood<float, ImageDimension> patch;
+  patch.SetRadius( this->GetPatchRadiusInVoxels() );
+  const PatchWeightsType patchWeights = this->GetPatchWeights();
+  const typename OutputImageType::OffsetValueType *offsetTable = output->GetOffsetTable();
+
+  m_PatchIndexOffsets.resize( patch.Size() );
+  m_PatchFeatureOffsets.resize( patch.Size() );
+  m_PatchFeatureWeights.resize( patch.Size() );
+  for( unsigned int jj = 0; jj < patch.Size(); ++jj )
+    {
+    m_PatchIndexOffsets[jj] = patch.GetOffset( jj );
+    OffsetValueType offset = 0;
+    for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      offset += m_PatchIndexOffsets[jj][dim] * offsetTable[dim];
+      }
+    m_PatchFeatureOffsets[jj] = offset * numberOfComponents;
+    m_PatchFeatureWeights[jj] = static_cast<float>( patchWeights[jj] * patchWeights[jj] );
+    }
 }
 
 template<typename TInputImage, typename TOutputImage>
@@ -2081,6 +2159,18 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   // of boundary conditions, the rest with boundary conditions.  We operate
   // on the output region because input has been copied to output
 
+  // With UseFastPatchDistances, the gradients of the joint entropy are
+  // computed from the float copy of the image, for the whole region at once
+  // when the patch distances are computed with box sums.
+  const bool useFastPatchDistances = m_UseFastPatchDistances &&
+    this->GetComponentSpace() == Superclass::EUCLIDEAN;
+  PatchFeaturesStruct        patchFeatures;
+  std::vector<RealValueType> boxSumGradients;
+  if( m_UseBoxSumPatchDistances && this->GetSmoothingWeight() > 0 )
+    {
+    this->ComputeGradientJointEntropyWithBoxSums( regionToProcess, boxSumGradients );
+    }
+
   FaceCalculatorType faceCalculator;
 
   FaceListType faceList = faceCalculator(output, regionToProcess, radius);
@@ -2119,9 +2209,35 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
       if( smoothingWeight > 0 )
         {
         // Get intensity update driven by patch-based denoiser
-        const RealType gradientJointEntropy =
-          this->ComputeGradientJointEntropy(sampleIt.GetInstanceIdentifier(), inList, sampler,
-          threadData);
+        RealType gradientJointEntropy;
+        if( m_UseBoxSumPatchDistances )
+          {
+          const typename OutputImageType::IndexType index = outputIt.GetIndex();
+          SizeValueType position = 0;
+          SizeValueType stride = 1;
+          for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+            {
+            position += static_cast<SizeValueType>( index[dim] - regionToProcess.GetIndex(dim) ) * stride;
+            stride *= regionToProcess.GetSize(dim);
+            }
+          gradientJointEntropy = m_ZeroPixel;
+          for( unsigned int pc = 0; pc < m_NumPixelComponents; ++pc )
+            {
+            this->SetComponent(gradientJointEntropy, pc,
+                               boxSumGradients[position * m_NumPixelComponents + pc]);
+            }
+          }
+        else if( useFastPatchDistances )
+          {
+          gradientJointEntropy =
+            this->ComputeGradientJointEntropyFromPatchFeatures(outputIt.GetIndex(), sampler, patchFeatures);
+          }
+        else
+          {
+          gradientJointEntropy =
+            this->ComputeGradientJointEntropy(sampleIt.GetInstanceIdentifier(), inList, sampler,
+            threadData);
+          }
 
         constexpr RealValueType stepSizeSmoothing  = 0.2;
         result = AddUpdate(result,  gradientJointEntropy * (smoothingWeight * stepSizeSmoothing) );
@@ -2471,11 +2587,367 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
   return gradientJointEntropy;
 }
 
+template <typename TInputImage, typename TOutputImage>
+typename PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>::RealType
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::ComputeGradientJointEntropyFromPatchFeatures(const typename OutputImageType::IndexType& nIndex,
+                                               BaseSamplerPointer& sampler,
+                                               PatchFeaturesStruct& features)
+{
+  const OutputImageType *  output = this->m_OutputImage;
+  const InstanceIdentifier currentPatchId = output->ComputeOffset(nIndex);
+
+  // Select the patches as ComputeGradientJointEntropy does
+  typename OutputImageType::RegionType region =
+    this->m_InputImage->GetLargestPossibleRegion();
+  typename OutputImageType::IndexType rIndex;
+  typename OutputImageType::SizeType rSize = region.GetSize();
+  const PatchRadiusType radius = this->GetPatchRadiusInVoxels();
+  for( unsigned int dim = 0; dim < OutputImageType::ImageDimension; ++dim )
+    {
+    rIndex[dim] = std::min(nIndex[dim], static_cast<IndexValueType>(radius[dim]) );
+    rSize[dim]  = std::max(nIndex[dim], static_cast<IndexValueType>(rSize[dim] - radius[dim] - 1) )
+      - rIndex[dim] + 1;
+    }
+  region.SetIndex(rIndex);
+  region.SetSize(rSize);
+
+  typename BaseSamplerType::SubsamplePointer selectedPatches =
+    BaseSamplerType::SubsampleType::New();
+
+  sampler->SetRegionConstraint(region);
+  sampler->CanSelectQueryOn();
+  sampler->Search(currentPatchId, selectedPatches);
+
+  // Keep the values and squared weights of the pixels of the current patch
+  // which are in bounds and have a nonzero weight, by runs of pixels
+  // contiguous in the image. The selected patches are at least as in bounds
+  // as the current patch.
+  const unsigned int numberOfComponents = m_NumPixelComponents;
+  const float *      currentFeatures = m_PatchFeatures.data() + currentPatchId * numberOfComponents;
+  const typename OutputImageType::RegionType & bufferedRegion = output->GetBufferedRegion();
+
+  features.offsets.clear();
+  features.lengths.clear();
+  features.weights.clear();
+  features.values.clear();
+  bool            inRun = false;
+  OffsetValueType runEnd = 0;
+  for( unsigned int jj = 0; jj < m_PatchIndexOffsets.size(); ++jj )
+    {
+    if( m_PatchFeatureWeights[jj] == 0.0f || !bufferedRegion.IsInside( nIndex + m_PatchIndexOffsets[jj] ) )
+      {
+      inRun = false;
+      continue;
+      }
+    const OffsetValueType offset = m_PatchFeatureOffsets[jj];
+    if( inRun && offset == runEnd )
+      {
+      ++features.lengths.back();
+      }
+    else
+      {
+      features.offsets.push_back( offset );
+      features.lengths.push_back( 1 );
+      }
+    inRun = true;
+    runEnd = offset + numberOfComponents;
+    features.weights.push_back( m_PatchFeatureWeights[jj] );
+    for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+      {
+      features.values.push_back( currentFeatures[offset + pc] );
+      }
+    }
+  features.norms.resize( numberOfComponents );
+  features.gradient.assign( numberOfComponents, 0.0 );
+
+  const SizeValueType numberOfRuns = features.offsets.size();
+  RealValueType       sumOfGaussiansJointEntropy = 0.0;
+
+  for( const InstanceIdentifier selectedPatchId : selectedPatches->GetIdHolder() )
+    {
+    const float *selectedFeatures = m_PatchFeatures.data() + selectedPatchId * numberOfComponents;
+    const float *currentValue = features.values.data();
+    const float *weight = features.weights.data();
+    if( numberOfComponents == 1 )
+      {
+      float norm = 0.0f;
+      for( SizeValueType run = 0; run < numberOfRuns; ++run )
+        {
+        const float *       selectedValue = selectedFeatures + features.offsets[run];
+        const SizeValueType length = features.lengths[run];
+        for( SizeValueType ii = 0; ii < length; ++ii )
+          {
+          const float diff = selectedValue[ii] - currentValue[ii];
+          norm += weight[ii] * diff * diff;
+          }
+        currentValue += length;
+        weight += length;
+        }
+      features.norms[0] = norm;
+      }
+    else
+      {
+      std::fill( features.norms.begin(), features.norms.end(), 0.0f );
+      for( SizeValueType run = 0; run < numberOfRuns; ++run )
+        {
+        const float *       selectedValue = selectedFeatures + features.offsets[run];
+        const SizeValueType length = features.lengths[run];
+        for( SizeValueType ii = 0; ii < length; ++ii )
+          {
+          for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+            {
+            const float diff = *selectedValue++ - *currentValue++;
+            features.norms[pc] += weight[ii] * diff * diff;
+            }
+          }
+        weight += length;
+        }
+      }
+
+    // The kernel is evaluated as in ComputeGradientJointEntropy
+    RealValueType distanceJointEntropy = 0.0;
+    RealValueType gaussianJointEntropy = 0.0;
+    for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+      {
+      distanceJointEntropy += features.norms[ic] / itk::Math::sqr(m_KernelBandwidthSigma[ic]);
+
+      gaussianJointEntropy = std::exp( -distanceJointEntropy / 2.0 );
+      sumOfGaussiansJointEntropy += gaussianJointEntropy;
+      }
+    for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+      {
+      features.gradient[pc] += ( selectedFeatures[pc] - currentFeatures[pc] ) * gaussianJointEntropy;
+      }
+    }
+
+  RealType gradientJointEntropy = m_ZeroPixel;
+  for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+    {
+    this->SetComponent(gradientJointEntropy, pc,
+                       features.gradient[pc] / (sumOfGaussiansJointEntropy + m_MinProbability) );
+    }
+  return gradientJointEntropy;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
+::ComputeGradientJointEntropyWithBoxSums(const InputImageRegionType& region,
+                                         std::vector<RealValueType>& gradients)
+{
+  using IndexType = typename OutputImageType::IndexType;
+  using OffsetType = typename OutputImageType::OffsetType;
+  using SpatialNeighborSamplerType =
+      itk::Statistics::SpatialNeighborSubsampler< PatchSampleType, InputImageRegionType >;
+  using DifferenceImageType = Image<float, ImageDimension>;
+  using DifferenceIteratorType = ImageScanlineIterator<DifferenceImageType>;
+
+  const unsigned int numberOfComponents = m_NumPixelComponents;
+  gradients.assign( region.GetNumberOfPixels() * numberOfComponents, 0.0 );
+  if( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const OutputImageType *                    output = this->m_OutputImage;
+  const InputImageRegionType &               bufferedRegion = output->GetBufferedRegion();
+  const typename OutputImageType::SizeType   imageSize = this->m_InputImage->GetLargestPossibleRegion().GetSize();
+  const typename OutputImageType::OffsetValueType *offsetTable = output->GetOffsetTable();
+  const PatchRadiusType                      patchRadius = this->GetPatchRadiusInVoxels();
+  const typename SpatialNeighborSamplerType::RadiusType searchRadius =
+    static_cast<SpatialNeighborSamplerType *>( m_Sampler.GetPointer() )->GetRadius();
+  const float patchWeight = m_PatchFeatureWeights[0];
+
+  RealArrayType inverseSquaredSigma( m_NumIndependentComponents );
+  for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+    {
+    inverseSquaredSigma[ic] = 1.0 / itk::Math::sqr(m_KernelBandwidthSigma[ic]);
+    }
+
+  std::vector<RealValueType> sumOfGaussians( region.GetNumberOfPixels(), 0.0 );
+  std::vector<RealValueType> distances;
+  std::vector<RealValueType> gaussians;
+  std::vector<unsigned char> selected;
+
+  // Moves index to the next pixel of a region, in the order of an
+  // ImageRegionIterator
+  auto nextIndex = [](IndexType & index, const InputImageRegionType & indexRegion)
+    {
+    for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      if( ++index[dim] < indexRegion.GetIndex(dim) + static_cast<IndexValueType>( indexRegion.GetSize(dim) ) )
+        {
+        return;
+        }
+      index[dim] = indexRegion.GetIndex(dim);
+      }
+    };
+
+  // The region is processed by chunks of slices, to bound the memory of the
+  // squared differences and of their summed area table
+  constexpr unsigned int lastDim = ImageDimension - 1;
+  const SizeValueType    slicePixels = region.GetNumberOfPixels() / region.GetSize(lastDim);
+  const SizeValueType    chunkSlices = std::max( static_cast<SizeValueType>( ( 1 << 20 ) / slicePixels ),
+                                                 static_cast<SizeValueType>( 8 * patchRadius[lastDim] + 4 ) );
+
+  typename DifferenceImageType::Pointer differences = DifferenceImageType::New();
+  SummedAreaTable<double, ImageDimension> table;
+
+  for( SizeValueType chunkStart = 0; chunkStart < region.GetSize(lastDim); chunkStart += chunkSlices )
+    {
+    InputImageRegionType chunk = region;
+    chunk.SetIndex( lastDim, region.GetIndex(lastDim) + static_cast<IndexValueType>( chunkStart ) );
+    chunk.SetSize( lastDim, std::min( chunkSlices, region.GetSize(lastDim) - chunkStart ) );
+    const SizeValueType chunkPixels = chunk.GetNumberOfPixels();
+    const SizeValueType chunkPosition = chunkStart * slicePixels;
+
+    InputImageRegionType tableRegion = chunk;
+    tableRegion.PadByRadius( patchRadius );
+    tableRegion.Crop( bufferedRegion );
+    differences->SetRegions( tableRegion );
+    differences->Allocate();
+
+    distances.resize( chunkPixels );
+    gaussians.resize( chunkPixels );
+    selected.resize( chunkPixels );
+
+    OffsetType translation;
+    for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+      {
+      translation[dim] = -static_cast<OffsetValueType>( searchRadius[dim] );
+      }
+    bool remainingTranslations = true;
+    while( remainingTranslations )
+      {
+      OffsetValueType featureTranslation = 0;
+      for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        featureTranslation += translation[dim] * offsetTable[dim];
+        }
+      featureTranslation *= numberOfComponents;
+
+      // The translated patch is selected for the pixels whose region
+      // constraint, computed as in ComputeGradientJointEntropy, contains the
+      // translated pixel
+      bool anySelected = false;
+      IndexType index = chunk.GetIndex();
+      for( SizeValueType position = 0; position < chunkPixels; ++position )
+        {
+        bool isSelected = true;
+        for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+          {
+          const IndexValueType lower = std::min( index[dim], static_cast<IndexValueType>( patchRadius[dim] ) );
+          const IndexValueType upper = std::max( index[dim],
+            static_cast<IndexValueType>( imageSize[dim] - patchRadius[dim] - 1 ) );
+          const IndexValueType translated = index[dim] + translation[dim];
+          isSelected = isSelected && translated >= lower && translated <= upper;
+          }
+        selected[position] = isSelected;
+        anySelected = anySelected || isSelected;
+        nextIndex( index, chunk );
+        }
+
+      if( anySelected )
+        {
+        for( unsigned int ic = 0; ic < m_NumIndependentComponents; ++ic )
+          {
+          // Weighted squared differences between the image and its
+          // translate, zero where the translate is outside of the image.
+          // The patches of the selected pixels only cover the others.
+          DifferenceIteratorType dIt( differences, tableRegion );
+          while( !dIt.IsAtEnd() )
+            {
+            const IndexType lineIndex = dIt.GetIndex();
+            bool            lineInside = true;
+            for( unsigned int dim = 1; dim < ImageDimension; ++dim )
+              {
+              const IndexValueType translated = lineIndex[dim] + translation[dim];
+              lineInside = lineInside && translated >= bufferedRegion.GetIndex(dim) &&
+                translated < bufferedRegion.GetIndex(dim) + static_cast<IndexValueType>( bufferedRegion.GetSize(dim) );
+              }
+            const float *  feature = m_PatchFeatures.data() + output->ComputeOffset( lineIndex ) * numberOfComponents + ic;
+            IndexValueType translated = lineIndex[0] + translation[0];
+            while( !dIt.IsAtEndOfLine() )
+              {
+              float value = 0.0f;
+              if( lineInside && translated >= bufferedRegion.GetIndex(0) &&
+                  translated < bufferedRegion.GetIndex(0) + static_cast<IndexValueType>( bufferedRegion.GetSize(0) ) )
+                {
+                const float diff = feature[featureTranslation] - feature[0];
+                value = patchWeight * diff * diff;
+                }
+              dIt.Set( value );
+              ++dIt;
+              feature += numberOfComponents;
+              ++translated;
+              }
+            dIt.NextLine();
+            }
+          table.Compute( differences.GetPointer(), tableRegion, [](float value) { return value; } );
+
+          // The kernel is evaluated as in ComputeGradientJointEntropy
+          SizeValueType position = 0;
+          table.ForEachBoxSum( chunk, patchRadius,
+            [&](double squaredNorm, SizeValueType)
+              {
+              if( selected[position] )
+                {
+                const RealValueType distance = ( ic == 0 ? 0.0 : distances[position] ) +
+                  squaredNorm * inverseSquaredSigma[ic];
+                distances[position] = distance;
+                gaussians[position] = std::exp( -distance / 2.0 );
+                sumOfGaussians[chunkPosition + position] += gaussians[position];
+                }
+              ++position;
+              } );
+          }
+
+        index = chunk.GetIndex();
+        for( SizeValueType position = 0; position < chunkPixels; ++position )
+          {
+          if( selected[position] )
+            {
+            const float *  currentFeatures = m_PatchFeatures.data() + output->ComputeOffset( index ) * numberOfComponents;
+            RealValueType *gradient = gradients.data() + ( chunkPosition + position ) * numberOfComponents;
+            for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+              {
+              gradient[pc] += ( currentFeatures[featureTranslation + pc] - currentFeatures[pc] ) * gaussians[position];
+              }
+            }
+          nextIndex( index, chunk );
+          }
+        }
+
+      remainingTranslations = false;
+      for( unsigned int dim = 0; dim < ImageDimension; ++dim )
+        {
+        if( ++translation[dim] <= static_cast<OffsetValueType>( searchRadius[dim] ) )
+          {
+          remainingTranslations = true;
+          break;
+          }
+        translation[dim] = -static_cast<OffsetValueType>( searchRadius[dim] );
+        }
+      }
+    }
+
+  for( SizeValueType position = 0; position < sumOfGaussians.size(); ++position )
+    {
+    for( unsigned int pc = 0; pc < numberOfComponents; ++pc )
+      {
+      gradients[position * numberOfComponents + pc] /= sumOfGaussians[position] + m_MinProbability;
+      }
+    }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
 ::PostProcessOutput()
 {
+  // Release the float copy of the image
+  std::vector<float>().swap( m_PatchFeatures );
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -2519,6 +2991,15 @@ PatchBasedDenoisingImageFilter<TInputImage, TOutputImage>
     os << indent << "UseFastTensorComputations: Off" << std::endl;
     }
 
+  if( m_UseFastPatchDistances )
+    {
+    os << indent << "UseFastPatchDistances: On" << std::endl;
+    }
+  else
+    {
+    os << indent << "UseFastPatchDistances: Off" << std::endl;
+    }
+
   os << indent << "Kernel bandwidth sigma: "
      << m_KernelBandwidthSigma << std::endl;
   if( m_KernelBandwidthSigmaIsSet )
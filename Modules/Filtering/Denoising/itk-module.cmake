@@ -6,6 +6,7 @@ itk_module(ITKDenoising
     ITKImageGrid
     ITKImageStatistics
     ITKIOImageBase
+    ITKSmoothing
     ITKStatistics
   TEST_DEPENDS
     ITKTestKernel
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkGaussianRandomSpatialNeighborSubsampler.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkPatchBasedDenoisingImageFilter.h"
+#include "itkVector.h"
+#include "itkTestingMacros.h"
+
+// Denoise noisy checkerboards with and without the fast patch distances,
+// with box sums for a SpatialNeighborSubsampler and uniform patch weights,
+// and from the float copy of the image for smooth disc patch weights and
+// for a random sampler, and compare the results.
+
+namespace
+{
+
+template< typename TImage >
+typename TImage::Pointer
+MakeCheckerboard( const typename TImage::SizeType & size )
+{
+  using TraitsType = itk::DefaultConvertPixelTraits< typename TImage::PixelType >;
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    unsigned int parity = 0;
+    for ( unsigned int d = 0; d < TImage::ImageDimension; ++d )
+      {
+      parity += it.GetIndex()[d] / 6;
+      }
+    typename TImage::PixelType pixel;
+    for ( unsigned int c = 0; c < TraitsType::GetNumberOfComponents(); ++c )
+      {
+      const double value = ( ( parity + c ) % 2 ) ? 100.0 : 20.0;
+      TraitsType::SetNthComponent( c, pixel, static_cast< float >( value + generator->GetNormalVariate( 0.0, 100.0 ) ) );
+      }
+    it.Set( pixel );
+    }
+  return image;
+}
+
+template< typename TImage >
+int
+CompareDenoising( const TImage * image, bool useSmoothDiscPatchWeights,
+                  typename itk::PatchBasedDenoisingImageFilter< TImage, TImage >::BaseSamplerType * sampler,
+                  const char * name )
+{
+  using FilterType = itk::PatchBasedDenoisingImageFilter< TImage, TImage >;
+  using TraitsType = itk::DefaultConvertPixelTraits< typename TImage::PixelType >;
+  std::cout << name << std::endl;
+
+  typename TImage::Pointer outputs[2];
+  for ( unsigned int fast = 0; fast < 2; ++fast )
+    {
+    typename FilterType::Pointer filter = FilterType::New();
+    filter->SetInput( image );
+    filter->SetPatchRadius( 2 );
+    filter->SetUseSmoothDiscPatchWeights( useSmoothDiscPatchWeights );
+    filter->SetNumberOfIterations( 2 );
+    filter->SetNoiseModel( FilterType::GAUSSIAN );
+    filter->SetNoiseModelFidelityWeight( 0.1 );
+    filter->SetSampler( sampler );
+    filter->SetNumberOfWorkUnits( 2 );
+    filter->SetUseFastPatchDistances( fast != 0 );
+    TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+    outputs[fast] = filter->GetOutput();
+    outputs[fast]->DisconnectPipeline();
+    }
+
+  // The denoised pixels differ by the precision of the float patch
+  // distances, the range of the image is about 400
+  double maximumDifference = 0.0;
+  double maximumChange = 0.0;
+  itk::ImageRegionConstIteratorWithIndex< TImage > it( outputs[0], outputs[0]->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const typename TImage::PixelType fast = outputs[1]->GetPixel( it.GetIndex() );
+    const typename TImage::PixelType noisy = image->GetPixel( it.GetIndex() );
+    for ( unsigned int c = 0; c < TraitsType::GetNumberOfComponents(); ++c )
+      {
+      const double expected = TraitsType::GetNthComponent( c, it.Get() );
+      maximumDifference = std::max( maximumDifference, std::abs( TraitsType::GetNthComponent( c, fast ) - expected ) );
+      maximumChange = std::max( maximumChange, std::abs( TraitsType::GetNthComponent( c, noisy ) - expected ) );
+      }
+    }
+  std::cout << "  Maximum difference: " << maximumDifference << ", maximum change: " << maximumChange << std::endl;
+  TEST_EXPECT_TRUE( maximumChange > 1.0 );
+  TEST_EXPECT_TRUE( maximumDifference < 0.01 );
+  return EXIT_SUCCESS;
+}
+
+template< typename TImage >
+int
+CompareSamplers( const TImage * image )
+{
+  using FilterType = itk::PatchBasedDenoisingImageFilter< TImage, TImage >;
+  using DenseSamplerType = itk::Statistics::SpatialNeighborSubsampler< typename FilterType::PatchSampleType,
+                                                                       typename TImage::RegionType >;
+  using RandomSamplerType = itk::Statistics::GaussianRandomSpatialNeighborSubsampler<
+    typename FilterType::PatchSampleType, typename TImage::RegionType >;
+
+  typename DenseSamplerType::Pointer denseSampler = DenseSamplerType::New();
+  denseSampler->SetRadius( 4 );
+  typename RandomSamplerType::Pointer randomSampler = RandomSamplerType::New();
+  randomSampler->SetVariance( 100 );
+  randomSampler->SetRadius( 20 );
+  randomSampler->SetNumberOfResultsRequested( 50 );
+
+  if ( CompareDenoising< TImage >( image, false, denseSampler, "Box sums" ) != EXIT_SUCCESS
+       || CompareDenoising< TImage >( image, true, denseSampler, "Smooth disc patch weights" ) != EXIT_SUCCESS
+       || CompareDenoising< TImage >( image, false, randomSampler, "Random sampler" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkPatchBasedDenoisingImageFilterFastTest( int, char *[] )
+{
+  using ImageType = itk::Image< float, 2 >;
+  using FilterType = itk::PatchBasedDenoisingImageFilter< ImageType, ImageType >;
+  FilterType::Pointer filter = FilterType::New();
+  TEST_SET_GET_BOOLEAN( filter, UseFastPatchDistances, false );
+
+  ImageType::SizeType size;
+  size[0] = 45;
+  size[1] = 38;
+  if ( CompareSamplers< ImageType >( MakeCheckerboard< ImageType >( size ) ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  using VectorImageType = itk::Image< itk::Vector< float, 2 >, 2 >;
+  std::cout << "Vector image" << std::endl;
+  if ( CompareSamplers< VectorImageType >( MakeCheckerboard< VectorImageType >( size ) ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  using Image3DType = itk::Image< float, 3 >;
+  Image3DType::SizeType size3D;
+  size3D[0] = 21;
+  size3D[1] = 17;
+  size3D[2] = 14;
+  std::cout << "3-D image" << std::endl;
+  if ( CompareSamplers< Image3DType >( MakeCheckerboard< Image3DType >( size3D ) ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
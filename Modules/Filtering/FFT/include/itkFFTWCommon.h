@@ -33,7 +33,11 @@
 
 #endif
 
+#include <chrono>
+#include <memory>
 #include <mutex>
+#include <sstream>
+#include <type_traits>
 
 namespace itk
 {
@@ -373,11 +377,67 @@ public:
     return plan;
   }
 
+  /** Shared ownership of a plan, destroyed with DestroyPlan(). */
+  using PlanPointer = std::shared_ptr< std::remove_pointer< PlanType >::type >;
+
+  /** Get the plan of a transform from the process wide plan cache of
+   * FFTWGlobalConfiguration, or create and cache it if none matches.
+   * The cached plans are shared by all the filters: they must be run
+   * with the new-array Execute methods below, which are thread safe,
+   * and never destroyed explicitly. */
+  static PlanPointer GetCachedPlan_dft_c2r(int rank,
+                                           const int *n,
+                                           ComplexType *in,
+                                           PixelType *out,
+                                           unsigned flags,
+                                           int threads=1,
+                                           bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "c2r", 0, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); } );
+  }
+
+  static PlanPointer GetCachedPlan_dft_r2c(int rank,
+                                           const int *n,
+                                           PixelType *in,
+                                           ComplexType *out,
+                                           unsigned flags,
+                                           int threads=1,
+                                           bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "r2c", 0, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); } );
+  }
+
+  static PlanPointer GetCachedPlan_dft(int rank,
+                                       const int *n,
+                                       ComplexType *in,
+                                       ComplexType *out,
+                                       int sign,
+                                       unsigned flags,
+                                       int threads=1,
+                                       bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "dft", sign, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); } );
+  }
 
   static void Execute(PlanType p)
   {
     fftwf_execute(p);
   }
+  static void Execute_dft_c2r(PlanType p, ComplexType *in, PixelType *out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void Execute_dft_r2c(PlanType p, PixelType *in, ComplexType *out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+  static void Execute_dft(PlanType p, ComplexType *in, ComplexType *out)
+  {
+    fftwf_execute_dft(p, in, out);
+  }
   static void DestroyPlan(PlanType p)
   {
 #ifndef ITK_USE_CUFFTW
@@ -385,6 +445,61 @@ public:
 #endif
     fftwf_destroy_plan(p);
   }
+
+private:
+  template< typename TInput, typename TOutput, typename TCreatePlan >
+  static PlanPointer GetCachedPlan(const char *kind,
+                                   int sign,
+                                   int rank,
+                                   const int *n,
+                                   TInput *in,
+                                   TOutput *out,
+                                   unsigned flags,
+                                   int threads,
+                                   TCreatePlan createPlan)
+  {
+#ifndef ITK_USE_CUFFTW
+    std::string key;
+    if( FFTWGlobalConfiguration::GetPlanCaching() )
+      {
+      // The new-array execute functions require the same kind of
+      // transform on arrays with the same alignment and placement.
+      std::ostringstream keyStream;
+      keyStream << "float " << kind << ' ' << sign << ' ' << flags << ' ' << threads << ' '
+                << ( static_cast< void * >( in ) == static_cast< void * >( out ) ) << ' '
+                << fftwf_alignment_of( reinterpret_cast< PixelType * >( in ) ) << ' '
+                << fftwf_alignment_of( reinterpret_cast< PixelType * >( out ) );
+      for( int i = 0; i < rank; i++ )
+        {
+        keyStream << ' ' << n[i];
+        }
+      key = keyStream.str();
+      const std::shared_ptr< void > cached = FFTWGlobalConfiguration::GetCachedPlan( key );
+      if( cached )
+        {
+        return std::static_pointer_cast< PlanPointer::element_type >( cached );
+        }
+      }
+    const auto start = std::chrono::steady_clock::now();
+    PlanPointer plan( createPlan(), &Self::DestroyPlan );
+    if( !key.empty() )
+      {
+      const std::chrono::duration< double > planningTime = std::chrono::steady_clock::now() - start;
+      FFTWGlobalConfiguration::AddCachedPlan( key, plan, planningTime.count() );
+      }
+    return plan;
+#else
+    (void)kind;
+    (void)sign;
+    (void)rank;
+    (void)n;
+    (void)in;
+    (void)out;
+    (void)flags;
+    (void)threads;
+    return PlanPointer( createPlan(), &Self::DestroyPlan );
+#endif
+  }
 };
 
 #endif // ITK_USE_FFTWF
@@ -700,11 +815,67 @@ public:
     return plan;
   }
 
+  /** Shared ownership of a plan, destroyed with DestroyPlan(). */
+  using PlanPointer = std::shared_ptr< std::remove_pointer< PlanType >::type >;
+
+  /** Get the plan of a transform from the process wide plan cache of
+   * FFTWGlobalConfiguration, or create and cache it if none matches.
+   * The cached plans are shared by all the filters: they must be run
+   * with the new-array Execute methods below, which are thread safe,
+   * and never destroyed explicitly. */
+  static PlanPointer GetCachedPlan_dft_c2r(int rank,
+                                           const int *n,
+                                           ComplexType *in,
+                                           PixelType *out,
+                                           unsigned flags,
+                                           int threads=1,
+                                           bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "c2r", 0, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); } );
+  }
+
+  static PlanPointer GetCachedPlan_dft_r2c(int rank,
+                                           const int *n,
+                                           PixelType *in,
+                                           ComplexType *out,
+                                           unsigned flags,
+                                           int threads=1,
+                                           bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "r2c", 0, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); } );
+  }
+
+  static PlanPointer GetCachedPlan_dft(int rank,
+                                       const int *n,
+                                       ComplexType *in,
+                                       ComplexType *out,
+                                       int sign,
+                                       unsigned flags,
+                                       int threads=1,
+                                       bool canDestroyInput=false)
+  {
+    return GetCachedPlan( "dft", sign, rank, n, in, out, flags, threads,
+                          [=]() { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); } );
+  }
 
   static void Execute(PlanType p)
   {
     fftw_execute(p);
   }
+  static void Execute_dft_c2r(PlanType p, ComplexType *in, PixelType *out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void Execute_dft_r2c(PlanType p, PixelType *in, ComplexType *out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+  static void Execute_dft(PlanType p, ComplexType *in, ComplexType *out)
+  {
+    fftw_execute_dft(p, in, out);
+  }
   static void DestroyPlan(PlanType p)
   {
 #ifndef ITK_USE_CUFFTW
@@ -712,6 +883,61 @@ public:
 #endif
     fftw_destroy_plan(p);
   }
+
+private:
+  template< typename TInput, typename TOutput, typename TCreatePlan >
+  static PlanPointer GetCachedPlan(const char *kind,
+                                   int sign,
+                                   int rank,
+                                   const int *n,
+                                   TInput *in,
+                                   TOutput *out,
+                                   unsigned flags,
+                                   int threads,
+                                   TCreatePlan createPlan)
+  {
+#ifndef ITK_USE_CUFFTW
+    std::string key;
+    if( FFTWGlobalConfiguration::GetPlanCaching() )
+      {
+      // The new-array execute functions require the same kind of
+      // transform on arrays with the same alignment and placement.
+      std::ostringstream keyStream;
+      keyStream << "double " << kind << ' ' << sign << ' ' << flags << ' ' << threads << ' '
+                << ( static_cast< void * >( in ) == static_cast< void * >( out ) ) << ' '
+                << fftw_alignment_of( reinterpret_cast< PixelType * >( in ) ) << ' '
+                << fftw_alignment_of( reinterpret_cast< PixelType * >( out ) );
+      for( int i = 0; i < rank; i++ )
+        {
+        keyStream << ' ' << n[i];
+        }
+      key = keyStream.str();
+      const std::shared_ptr< void > cached = FFTWGlobalConfiguration::GetCachedPlan( key );
+      if( cached )
+        {
+        return std::static_pointer_cast< PlanPointer::element_type >( cached );
+        }
+      }
+    const auto start = std::chrono::steady_clock::now();
+    PlanPointer plan( createPlan(), &Self::DestroyPlan );
+    if( !key.empty() )
+      {
+      const std::chrono::duration< double > planningTime = std::chrono::steady_clock::now() - start;
+      FFTWGlobalConfiguration::AddCachedPlan( key, plan, planningTime.count() );
+      }
+    return plan;
+#else
+    (void)kind;
+    (void)sign;
+    (void)rank;
+    (void)n;
+    (void)in;
+    (void)out;
+    (void)flags;
+    (void)threads;
+    return PlanPointer( createPlan(), &Self::DestroyPlan );
+#endif
+  }
 };
 
 #endif
@@ -96,7 +96,6 @@ FFTWForwardFFTImageFilter< TInputImage, TOutputImage >
   fftwOutput->SetRegions( fftwOutputRegion );
   fftwOutput->Allocate();
 
-  typename FFTWProxyType::PlanType plan;
   auto * in = const_cast<InputPixelType*>(inputPtr->GetBufferPointer());
   int flags = m_PlanRigor;
   if( !m_CanUseDestructiveAlgorithm )
@@ -112,12 +111,11 @@ FFTWForwardFFTImageFilter< TInputImage, TOutputImage >
     sizes[(ImageDimension - 1) - i] = inputSize[i];
     }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension, sizes, in,
-                                     (typename FFTWProxyType::ComplexType*)
-                                     fftwOutput->GetBufferPointer(), flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  auto * out = (typename FFTWProxyType::ComplexType*) fftwOutput->GetBufferPointer();
+  typename FFTWProxyType::PlanPointer plan =
+    FFTWProxyType::GetCachedPlan_dft_r2c(ImageDimension, sizes, in, out, flags,
+                                         MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  FFTWProxyType::Execute_dft_r2c(plan.get(), in, out);
 
   // Expand the half image to the full image size
   using HalfToFullFilterType = HalfToFullHermitianImageFilter< OutputImageType >;
@@ -35,6 +35,9 @@
 #endif
 #include <algorithm>
 #include <cctype>
+#include <map>
+#include <memory>
+#include <vector>
 
 //* The fftw utilities help control the various strategies
 //available for controlling optimizations for the FFTW library.
@@ -290,6 +293,48 @@ public:
   static bool ImportDefaultWisdomFile();
   static bool ExportDefaultWisdomFile();
 
+  /**
+   * \brief Set/Get whether the FFTW filters share their plans through
+   * the process wide plan cache.
+   *
+   * A cached plan is reused by all the transforms of the same kind,
+   * size, flags, number of threads and data alignment, which saves
+   * the planning and its lock on each execution. Enabled by default,
+   * unless the environmental variable "ITK_FFTW_PLAN_CACHE" is set to
+   * NO, OFF or 0. Disabling it clears the cache.
+   */
+  static void SetPlanCaching( const bool & v );
+  static bool GetPlanCaching();
+
+  /** Set/Get the maximum number of cached plans. The least recently
+   * used plans are released first. Defaults to 32. */
+  static void SetPlanCacheMaximumSize( const SizeValueType & v );
+  static SizeValueType GetPlanCacheMaximumSize();
+
+  /** Get the number of plans in the cache. */
+  static SizeValueType GetPlanCacheSize();
+
+  /** Release all the cached plans. The plans still in use are
+   * destroyed once their execution is completed. */
+  static void ClearPlanCache();
+
+  /** Get the number of plans found in the cache, the number of plans
+   * created because none matched, and the total time in seconds spent
+   * creating them, since the start or the last call to
+   * ResetPlanCacheStatistics(). */
+  static SizeValueType GetPlanCacheHits();
+  static SizeValueType GetPlanCacheMisses();
+  static double GetPlanningTime();
+  static void ResetPlanCacheStatistics();
+
+  /** Get the plan cached with the given key, or nullptr if there is
+   * none. The plans are stored with their own deleter by
+   * fftw::Proxy, which builds the keys. */
+  static std::shared_ptr< void > GetCachedPlan( const std::string & key );
+
+  /** Add a plan to the cache, with the time spent creating it. */
+  static void AddCachedPlan( const std::string & key, const std::shared_ptr< void > & plan, double planningTime );
+
 private:
   FFTWGlobalConfiguration(); //This will process env variables
   ~FFTWGlobalConfiguration() override; //This will write cache file if requested.
@@ -315,6 +360,27 @@ private:
   //m_WriteWisdomCache Controls the behavior of default
   //wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  struct CachedPlan
+  {
+    std::shared_ptr< void > m_Plan;
+    SizeValueType           m_LastUse;
+  };
+  using PlanCacheType = std::map< std::string, CachedPlan >;
+
+  /** Remove the least recently used plans beyond the maximum size. The
+   * plans are moved to released so that they are destroyed outside of
+   * m_PlanCacheLock. */
+  void TrimPlanCache( std::vector< std::shared_ptr< void > > & released );
+
+  std::mutex                    m_PlanCacheLock;
+  PlanCacheType                 m_PlanCache;
+  bool                          m_PlanCaching;
+  SizeValueType                 m_PlanCacheMaximumSize;
+  SizeValueType                 m_PlanCacheUses;
+  SizeValueType                 m_PlanCacheHits;
+  SizeValueType                 m_PlanCacheMisses;
+  double                        m_PlanningTime;
 };
 }
 #endif
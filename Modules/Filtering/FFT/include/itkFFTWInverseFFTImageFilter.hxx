@@ -86,7 +86,6 @@ FFTWInverseFFTImageFilter< TInputImage, TOutputImage >
   auto * in = (typename FFTWProxyType::ComplexType *) fullToHalfFilter->GetOutput()->GetBufferPointer();
 
   OutputPixelType * out = outputPtr->GetBufferPointer();
-  typename FFTWProxyType::PlanType plan;
 
   int sizes[ImageDimension];
   for( unsigned int i = 0; i < ImageDimension; i++ )
@@ -94,13 +93,11 @@ FFTWInverseFFTImageFilter< TInputImage, TOutputImage >
     sizes[(ImageDimension - 1) - i] = outputSize[i];
     }
 
-  plan = FFTWProxyType::Plan_dft_c2r( ImageDimension, sizes, in, out, m_PlanRigor,
-                                      MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
-                                      false );
-  FFTWProxyType::Execute( plan );
-
-  // Some cleanup.
-  FFTWProxyType::DestroyPlan( plan );
+  typename FFTWProxyType::PlanPointer plan =
+    FFTWProxyType::GetCachedPlan_dft_c2r( ImageDimension, sizes, in, out, m_PlanRigor,
+                                          MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                          false );
+  FFTWProxyType::Execute_dft_c2r( plan.get(), in, out );
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeComplexToComplexFFTImageFilter_hxx
+#define itkNativeComplexToComplexFFTImageFilter_hxx
+
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeFFTCommon.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+
+template< typename TImage >
+NativeComplexToComplexFFTImageFilter< TImage >
+::NativeComplexToComplexFFTImageFilter()
+{
+  this->DynamicMultiThreadingOn();
+}
+
+
+template <typename TImage>
+void
+NativeComplexToComplexFFTImageFilter< TImage >
+::BeforeThreadedGenerateData()
+{
+  const ImageType * input = this->GetInput();
+  ImageType * output = this->GetOutput();
+
+  const typename ImageType::RegionType bufferedRegion = input->GetBufferedRegion();
+
+  // Copy the input to the output, and we will work in place on the output.
+  ImageAlgorithm::Copy< ImageType, ImageType >( input, output, bufferedRegion, bufferedRegion );
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  NativeFFTCommon::ComplexToComplex( output->GetBufferPointer(), bufferedRegion.GetSize(),
+                                     this->GetTransformDirection() == Superclass::INVERSE, multiThreader );
+}
+
+
+template <typename TImage>
+void
+NativeComplexToComplexFFTImageFilter< TImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType& outputRegionForThread)
+{
+  // Normalize the output if backward transform
+  if ( this->GetTransformDirection() == Superclass::INVERSE )
+    {
+    using IteratorType = ImageRegionIterator< OutputImageType >;
+    const typename PixelType::value_type scale = 1.0 / this->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
+    IteratorType it(this->GetOutput(), outputRegionForThread);
+    while( !it.IsAtEnd() )
+      {
+      it.Set( it.Value() * scale );
+      ++it;
+      }
+    }
+}
+
+} // end namespace itk
+
+#endif // itkNativeComplexToComplexFFTImageFilter_hxx
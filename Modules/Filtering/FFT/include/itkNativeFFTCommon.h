@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_h
+#define itkNativeFFTCommon_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace itk
+{
+
+/** \class NativeFFTCommon
+ * \brief Common routines of the native FFT implementation.
+ *
+ * The one dimensional transforms are computed with a mixed radix
+ * Stockham algorithm, in the precision of the pixels. The lines are
+ * transformed by batches of up to MaximumNumberOfLanes lines, stored
+ * as separate real and imaginary arrays where the value t of the line
+ * b is at t * lanes + b, so that the inner loops of the butterflies
+ * run over contiguous values and are vectorized by the compiler.
+ * The sizes with a prime factor greater than 13 are transformed with
+ * the Bluestein algorithm, so any size is supported.
+ *
+ * The multidimensional transforms process the lines of each
+ * dimension in parallel with the MultiThreaderBase. The complex
+ * backward transform is not normalized, the half complex to real one
+ * is.
+ *
+ * \ingroup ITKFFT
+ */
+struct NativeFFTCommon
+{
+  /** Any size is supported, but the transforms are faster for sizes
+   * whose prime factors are 2, 3 and 5. */
+  static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
+
+  /** Maximum number of lines transformed together. */
+  static constexpr SizeValueType MaximumNumberOfLanes = 8;
+
+  /** \class ComplexTransform
+   * \brief One dimensional complex transform of a given size.
+   * \ingroup ITKFFT
+   */
+  template< typename TReal >
+  class ComplexTransform
+  {
+  public:
+    explicit ComplexTransform( SizeValueType size );
+
+    SizeValueType GetSize() const
+    {
+      return m_Size;
+    }
+
+    /** Number of values of the work buffer of Transform(). */
+    SizeValueType GetWorkSize( SizeValueType lanes ) const;
+
+    /** Compute in place the forward transform, or the backward
+     * transform, of lanes lines. */
+    void Transform( TReal * re, TReal * im, SizeValueType lanes, bool inverse, TReal * work ) const;
+
+  private:
+    void Forward( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const;
+    void Stockham( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const;
+    void Bluestein( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const;
+
+    /** Butterflies of a Stockham stage of radix 2, 3, 4, 5 and of any
+     * other radix, from x to y. */
+    static void Radix2( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+                        SizeValueType stride, const TReal * wr, const TReal * wi );
+    static void Radix3( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+                        SizeValueType stride, const TReal * wr, const TReal * wi );
+    static void Radix4( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+                        SizeValueType stride, const TReal * wr, const TReal * wi );
+    static void Radix5( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+                        SizeValueType stride, const TReal * wr, const TReal * wi );
+    static void RadixGeneric( SizeValueType radix, const TReal * xr, const TReal * xi, TReal * yr, TReal * yi,
+                              SizeValueType m, SizeValueType stride, const TReal * wr, const TReal * wi );
+
+    SizeValueType                       m_Size;
+    std::vector< SizeValueType >        m_Factors;
+    std::vector< TReal >                m_TwiddleRe;
+    std::vector< TReal >                m_TwiddleIm;
+
+    SizeValueType                       m_BluesteinSize;
+    std::unique_ptr< ComplexTransform > m_BluesteinTransform;
+    std::vector< TReal >                m_ChirpRe;
+    std::vector< TReal >                m_ChirpIm;
+    std::vector< TReal >                m_ChirpFilterRe;
+    std::vector< TReal >                m_ChirpFilterIm;
+  };
+
+  /** \class RealTransform
+   * \brief One dimensional transform of a real signal of a given size
+   * to its size / 2 + 1 first Fourier coefficients, and back.
+   * \ingroup ITKFFT
+   */
+  template< typename TReal >
+  class RealTransform
+  {
+  public:
+    explicit RealTransform( SizeValueType size );
+
+    SizeValueType GetSize() const
+    {
+      return m_Size;
+    }
+
+    /** Number of values of the work buffer of Forward() and Backward(). */
+    SizeValueType GetWorkSize( SizeValueType lanes ) const;
+
+    /** Compute the forward transform of lanes real lines. */
+    void Forward( const TReal * input, TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const;
+
+    /** Compute the backward transform of lanes half complex lines,
+     * which are overwritten. The imaginary parts of the coefficients
+     * which must be real are ignored. */
+    void Backward( TReal * re, TReal * im, TReal * output, SizeValueType lanes, TReal * work ) const;
+
+  private:
+    SizeValueType              m_Size;
+    ComplexTransform< TReal >  m_Transform;
+    std::vector< TReal >       m_TwiddleRe;
+    std::vector< TReal >       m_TwiddleIm;
+  };
+
+  /** Compute in place the transform of a complex image of the given
+   * size. */
+  template< typename TReal, unsigned int VDimension >
+  static void ComplexToComplex( std::complex< TReal > * data, const Size< VDimension > & size, bool inverse,
+                                MultiThreaderBase * threader );
+
+  /** Compute the half transform of a real image of the given size. The
+   * output has size[0] / 2 + 1 values along the first dimension. */
+  template< typename TReal, unsigned int VDimension >
+  static void RealToHalfHermitian( const TReal * input, std::complex< TReal > * output, const Size< VDimension > & size,
+                                   MultiThreaderBase * threader );
+
+  /** Compute the normalized backward transform of a half complex
+   * image to a real image of the given size. The input is overwritten. */
+  template< typename TReal, unsigned int VDimension >
+  static void HalfHermitianToReal( std::complex< TReal > * input, TReal * output, const Size< VDimension > & size,
+                                   MultiThreaderBase * threader );
+
+private:
+  /** Transform in place the lines of a complex image along a direction. */
+  template< typename TReal, unsigned int VDimension >
+  static void TransformLines( std::complex< TReal > * data, const Size< VDimension > & size, unsigned int direction,
+                              bool inverse, MultiThreaderBase * threader );
+
+  /** Call function with the index of the first line and the number of
+   * lines of each batch of lines of a region along a direction. The
+   * lines of a batch are consecutive along the lane direction. */
+  template< unsigned int VDimension, typename TFunction >
+  static void ForEachBatch( const ImageRegion< VDimension > & region, unsigned int direction,
+                            unsigned int laneDirection, TFunction function );
+
+  template< unsigned int VDimension >
+  static Offset< VDimension > ComputeStrides( const Size< VDimension > & size );
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkNativeFFTCommon.hxx"
+#endif
+
+#endif // itkNativeFFTCommon_h
@@ -0,0 +1,981 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTCommon_hxx
+#define itkNativeFFTCommon_hxx
+
+#include "itkNativeFFTCommon.h"
+#include "itkMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template< typename TReal >
+NativeFFTCommon::ComplexTransform< TReal >
+::ComplexTransform( SizeValueType size ):
+  m_Size( size ),
+  m_BluesteinSize( 0 )
+{
+  // Factorize the size, with as many radix 4 stages as possible.
+  SizeValueType remaining = size;
+  while ( remaining % 4 == 0 && remaining > 1 )
+    {
+    m_Factors.push_back( 4 );
+    remaining /= 4;
+    }
+  for ( SizeValueType factor = 2; factor * factor <= remaining; ++factor )
+    {
+    while ( remaining % factor == 0 )
+      {
+      m_Factors.push_back( factor );
+      remaining /= factor;
+      }
+    }
+  if ( remaining > 1 )
+    {
+    m_Factors.push_back( remaining );
+    }
+
+  if ( !m_Factors.empty() && *std::max_element( m_Factors.begin(), m_Factors.end() ) > 13 )
+    {
+    // Compute the transform as the convolution with a chirp, through
+    // transforms of the smallest size with only 2, 3 and 5 as prime
+    // factors able to hold it.
+    m_Factors.clear();
+    const auto isSmooth = []( SizeValueType n )
+      {
+      for ( SizeValueType factor = 2; factor <= 5; ++factor )
+        {
+        while ( n % factor == 0 )
+          {
+          n /= factor;
+          }
+        }
+      return n == 1;
+      };
+    m_BluesteinSize = 2 * size - 1;
+    while ( !isSmooth( m_BluesteinSize ) )
+      {
+      ++m_BluesteinSize;
+      }
+    m_BluesteinTransform.reset( new ComplexTransform( m_BluesteinSize ) );
+
+    m_ChirpRe.resize( size );
+    m_ChirpIm.resize( size );
+    m_ChirpFilterRe.assign( m_BluesteinSize, TReal( 0 ) );
+    m_ChirpFilterIm.assign( m_BluesteinSize, TReal( 0 ) );
+    for ( SizeValueType k = 0; k < size; ++k )
+      {
+      // exp( -i pi k^2 / size ), with k^2 reduced modulo 2 size to keep
+      // the precision of the angle.
+      const double angle = Math::pi * static_cast< double >( ( k * k ) % ( 2 * size ) ) / size;
+      m_ChirpRe[k] = static_cast< TReal >( std::cos( angle ) );
+      m_ChirpIm[k] = static_cast< TReal >( -std::sin( angle ) );
+      const TReal filterRe = static_cast< TReal >( std::cos( angle ) / m_BluesteinSize );
+      const TReal filterIm = static_cast< TReal >( std::sin( angle ) / m_BluesteinSize );
+      m_ChirpFilterRe[k] = filterRe;
+      m_ChirpFilterIm[k] = filterIm;
+      if ( k > 0 )
+        {
+        m_ChirpFilterRe[m_BluesteinSize - k] = filterRe;
+        m_ChirpFilterIm[m_BluesteinSize - k] = filterIm;
+        }
+      }
+    std::vector< TReal > work( m_BluesteinTransform->GetWorkSize( 1 ) );
+    m_BluesteinTransform->Transform( m_ChirpFilterRe.data(), m_ChirpFilterIm.data(), 1, false, work.data() );
+    return;
+    }
+
+  // Twiddle factors exp( -2 i pi p j / n ) of each stage, followed by
+  // the roots of unity of the radix for the radices without a
+  // dedicated butterfly.
+  SizeValueType n = size;
+  for ( const SizeValueType radix : m_Factors )
+    {
+    const SizeValueType m = n / radix;
+    for ( SizeValueType p = 0; p < m; ++p )
+      {
+      for ( SizeValueType j = 1; j < radix; ++j )
+        {
+        const double angle = 2.0 * Math::pi * static_cast< double >( ( p * j ) % n ) / n;
+        m_TwiddleRe.push_back( static_cast< TReal >( std::cos( angle ) ) );
+        m_TwiddleIm.push_back( static_cast< TReal >( -std::sin( angle ) ) );
+        }
+      }
+    if ( radix > 5 )
+      {
+      for ( SizeValueType t = 0; t < radix; ++t )
+        {
+        const double angle = 2.0 * Math::pi * static_cast< double >( t ) / radix;
+        m_TwiddleRe.push_back( static_cast< TReal >( std::cos( angle ) ) );
+        m_TwiddleIm.push_back( static_cast< TReal >( -std::sin( angle ) ) );
+        }
+      }
+    n = m;
+    }
+}
+
+template< typename TReal >
+SizeValueType
+NativeFFTCommon::ComplexTransform< TReal >
+::GetWorkSize( SizeValueType lanes ) const
+{
+  if ( m_BluesteinSize > 0 )
+    {
+    return 2 * m_BluesteinSize * lanes + m_BluesteinTransform->GetWorkSize( lanes );
+    }
+  return 2 * m_Size * lanes;
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Transform( TReal * re, TReal * im, SizeValueType lanes, bool inverse, TReal * work ) const
+{
+  if ( m_Size < 2 )
+    {
+    return;
+    }
+  // The backward transform is the conjugate of the forward transform
+  // of the conjugate.
+  const SizeValueType count = m_Size * lanes;
+  if ( inverse )
+    {
+    for ( SizeValueType i = 0; i < count; ++i )
+      {
+      im[i] = -im[i];
+      }
+    }
+  this->Forward( re, im, lanes, work );
+  if ( inverse )
+    {
+    for ( SizeValueType i = 0; i < count; ++i )
+      {
+      im[i] = -im[i];
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Forward( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const
+{
+  if ( m_BluesteinSize > 0 )
+    {
+    this->Bluestein( re, im, lanes, work );
+    }
+  else
+    {
+    this->Stockham( re, im, lanes, work );
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Stockham( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const
+{
+  // Each stage of radix r splits the sequences of length n, with
+  // their values stride apart, in r interleaved sequences of length
+  // n / r. The values of the lines of a batch are interleaved, so
+  // all the lines are processed by the same loops.
+  TReal * xr = re;
+  TReal * xi = im;
+  TReal * yr = work;
+  TReal * yi = work + m_Size * lanes;
+  SizeValueType n = m_Size;
+  SizeValueType stride = lanes;
+  const TReal * wr = m_TwiddleRe.data();
+  const TReal * wi = m_TwiddleIm.data();
+  for ( const SizeValueType radix : m_Factors )
+    {
+    const SizeValueType m = n / radix;
+    switch ( radix )
+      {
+      case 2:
+        Radix2( xr, xi, yr, yi, m, stride, wr, wi );
+        break;
+      case 3:
+        Radix3( xr, xi, yr, yi, m, stride, wr, wi );
+        break;
+      case 4:
+        Radix4( xr, xi, yr, yi, m, stride, wr, wi );
+        break;
+      case 5:
+        Radix5( xr, xi, yr, yi, m, stride, wr, wi );
+        break;
+      default:
+        RadixGeneric( radix, xr, xi, yr, yi, m, stride, wr, wi );
+        wr += radix;
+        wi += radix;
+        break;
+      }
+    wr += m * ( radix - 1 );
+    wi += m * ( radix - 1 );
+    n = m;
+    stride *= radix;
+    std::swap( xr, yr );
+    std::swap( xi, yi );
+    }
+  if ( xr != re )
+    {
+    std::copy( xr, xr + m_Size * lanes, re );
+    std::copy( xi, xi + m_Size * lanes, im );
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Radix2( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+          SizeValueType stride, const TReal * wr, const TReal * wi )
+{
+  for ( SizeValueType p = 0; p < m; ++p )
+    {
+    const TReal * x0r = xr + stride * p;
+    const TReal * x0i = xi + stride * p;
+    const TReal * x1r = xr + stride * ( p + m );
+    const TReal * x1i = xi + stride * ( p + m );
+    TReal * y0r = yr + stride * 2 * p;
+    TReal * y0i = yi + stride * 2 * p;
+    TReal * y1r = y0r + stride;
+    TReal * y1i = y0i + stride;
+    const TReal w1r = wr[p];
+    const TReal w1i = wi[p];
+    for ( SizeValueType u = 0; u < stride; ++u )
+      {
+      const TReal ar = x0r[u];
+      const TReal ai = x0i[u];
+      const TReal br = x1r[u];
+      const TReal bi = x1i[u];
+      y0r[u] = ar + br;
+      y0i[u] = ai + bi;
+      const TReal dr = ar - br;
+      const TReal di = ai - bi;
+      y1r[u] = dr * w1r - di * w1i;
+      y1i[u] = dr * w1i + di * w1r;
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Radix3( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+          SizeValueType stride, const TReal * wr, const TReal * wi )
+{
+  // sin( 2 pi / 3 )
+  const TReal s = static_cast< TReal >( 0.866025403784438646763723170753 );
+  for ( SizeValueType p = 0; p < m; ++p )
+    {
+    const TReal * x0r = xr + stride * p;
+    const TReal * x0i = xi + stride * p;
+    const TReal * x1r = xr + stride * ( p + m );
+    const TReal * x1i = xi + stride * ( p + m );
+    const TReal * x2r = xr + stride * ( p + 2 * m );
+    const TReal * x2i = xi + stride * ( p + 2 * m );
+    TReal * y0r = yr + stride * 3 * p;
+    TReal * y0i = yi + stride * 3 * p;
+    TReal * y1r = y0r + stride;
+    TReal * y1i = y0i + stride;
+    TReal * y2r = y1r + stride;
+    TReal * y2i = y1i + stride;
+    const TReal w1r = wr[2 * p];
+    const TReal w1i = wi[2 * p];
+    const TReal w2r = wr[2 * p + 1];
+    const TReal w2i = wi[2 * p + 1];
+    for ( SizeValueType u = 0; u < stride; ++u )
+      {
+      const TReal tr = x1r[u] + x2r[u];
+      const TReal ti = x1i[u] + x2i[u];
+      const TReal dr = s * ( x1r[u] - x2r[u] );
+      const TReal di = s * ( x1i[u] - x2i[u] );
+      const TReal cr = x0r[u] - TReal( 0.5 ) * tr;
+      const TReal ci = x0i[u] - TReal( 0.5 ) * ti;
+      y0r[u] = x0r[u] + tr;
+      y0i[u] = x0i[u] + ti;
+      const TReal b1r = cr + di;
+      const TReal b1i = ci - dr;
+      const TReal b2r = cr - di;
+      const TReal b2i = ci + dr;
+      y1r[u] = b1r * w1r - b1i * w1i;
+      y1i[u] = b1r * w1i + b1i * w1r;
+      y2r[u] = b2r * w2r - b2i * w2i;
+      y2i[u] = b2r * w2i + b2i * w2r;
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Radix4( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+          SizeValueType stride, const TReal * wr, const TReal * wi )
+{
+  for ( SizeValueType p = 0; p < m; ++p )
+    {
+    const TReal * x0r = xr + stride * p;
+    const TReal * x0i = xi + stride * p;
+    const TReal * x1r = xr + stride * ( p + m );
+    const TReal * x1i = xi + stride * ( p + m );
+    const TReal * x2r = xr + stride * ( p + 2 * m );
+    const TReal * x2i = xi + stride * ( p + 2 * m );
+    const TReal * x3r = xr + stride * ( p + 3 * m );
+    const TReal * x3i = xi + stride * ( p + 3 * m );
+    TReal * y0r = yr + stride * 4 * p;
+    TReal * y0i = yi + stride * 4 * p;
+    TReal * y1r = y0r + stride;
+    TReal * y1i = y0i + stride;
+    TReal * y2r = y1r + stride;
+    TReal * y2i = y1i + stride;
+    TReal * y3r = y2r + stride;
+    TReal * y3i = y2i + stride;
+    const TReal w1r = wr[3 * p];
+    const TReal w1i = wi[3 * p];
+    const TReal w2r = wr[3 * p + 1];
+    const TReal w2i = wi[3 * p + 1];
+    const TReal w3r = wr[3 * p + 2];
+    const TReal w3i = wi[3 * p + 2];
+    for ( SizeValueType u = 0; u < stride; ++u )
+      {
+      const TReal t0r = x0r[u] + x2r[u];
+      const TReal t0i = x0i[u] + x2i[u];
+      const TReal t1r = x0r[u] - x2r[u];
+      const TReal t1i = x0i[u] - x2i[u];
+      const TReal t2r = x1r[u] + x3r[u];
+      const TReal t2i = x1i[u] + x3i[u];
+      const TReal t3r = x1r[u] - x3r[u];
+      const TReal t3i = x1i[u] - x3i[u];
+      y0r[u] = t0r + t2r;
+      y0i[u] = t0i + t2i;
+      const TReal b1r = t1r + t3i;
+      const TReal b1i = t1i - t3r;
+      const TReal b2r = t0r - t2r;
+      const TReal b2i = t0i - t2i;
+      const TReal b3r = t1r - t3i;
+      const TReal b3i = t1i + t3r;
+      y1r[u] = b1r * w1r - b1i * w1i;
+      y1i[u] = b1r * w1i + b1i * w1r;
+      y2r[u] = b2r * w2r - b2i * w2i;
+      y2i[u] = b2r * w2i + b2i * w2r;
+      y3r[u] = b3r * w3r - b3i * w3i;
+      y3i[u] = b3r * w3i + b3i * w3r;
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Radix5( const TReal * xr, const TReal * xi, TReal * yr, TReal * yi, SizeValueType m,
+          SizeValueType stride, const TReal * wr, const TReal * wi )
+{
+  // cos and sin of 2 pi / 5 and 4 pi / 5
+  const TReal c1 = static_cast< TReal >( 0.309016994374947424102293417183 );
+  const TReal c2 = static_cast< TReal >( -0.809016994374947424102293417183 );
+  const TReal s1 = static_cast< TReal >( 0.951056516295153572116439333379 );
+  const TReal s2 = static_cast< TReal >( 0.587785252292473129168705954639 );
+  for ( SizeValueType p = 0; p < m; ++p )
+    {
+    const TReal * x0r = xr + stride * p;
+    const TReal * x0i = xi + stride * p;
+    const TReal * x1r = xr + stride * ( p + m );
+    const TReal * x1i = xi + stride * ( p + m );
+    const TReal * x2r = xr + stride * ( p + 2 * m );
+    const TReal * x2i = xi + stride * ( p + 2 * m );
+    const TReal * x3r = xr + stride * ( p + 3 * m );
+    const TReal * x3i = xi + stride * ( p + 3 * m );
+    const TReal * x4r = xr + stride * ( p + 4 * m );
+    const TReal * x4i = xi + stride * ( p + 4 * m );
+    TReal * y0r = yr + stride * 5 * p;
+    TReal * y0i = yi + stride * 5 * p;
+    TReal * y1r = y0r + stride;
+    TReal * y1i = y0i + stride;
+    TReal * y2r = y1r + stride;
+    TReal * y2i = y1i + stride;
+    TReal * y3r = y2r + stride;
+    TReal * y3i = y2i + stride;
+    TReal * y4r = y3r + stride;
+    TReal * y4i = y3i + stride;
+    const TReal w1r = wr[4 * p];
+    const TReal w1i = wi[4 * p];
+    const TReal w2r = wr[4 * p + 1];
+    const TReal w2i = wi[4 * p + 1];
+    const TReal w3r = wr[4 * p + 2];
+    const TReal w3i = wi[4 * p + 2];
+    const TReal w4r = wr[4 * p + 3];
+    const TReal w4i = wi[4 * p + 3];
+    for ( SizeValueType u = 0; u < stride; ++u )
+      {
+      const TReal t14r = x1r[u] + x4r[u];
+      const TReal t14i = x1i[u] + x4i[u];
+      const TReal t23r = x2r[u] + x3r[u];
+      const TReal t23i = x2i[u] + x3i[u];
+      const TReal d14r = x1r[u] - x4r[u];
+      const TReal d14i = x1i[u] - x4i[u];
+      const TReal d23r = x2r[u] - x3r[u];
+      const TReal d23i = x2i[u] - x3i[u];
+      y0r[u] = x0r[u] + t14r + t23r;
+      y0i[u] = x0i[u] + t14i + t23i;
+      const TReal a1r = x0r[u] + c1 * t14r + c2 * t23r;
+      const TReal a1i = x0i[u] + c1 * t14i + c2 * t23i;
+      const TReal a2r = x0r[u] + c2 * t14r + c1 * t23r;
+      const TReal a2i = x0i[u] + c2 * t14i + c1 * t23i;
+      const TReal e1r = s1 * d14r + s2 * d23r;
+      const TReal e1i = s1 * d14i + s2 * d23i;
+      const TReal e2r = s2 * d14r - s1 * d23r;
+      const TReal e2i = s2 * d14i - s1 * d23i;
+      const TReal b1r = a1r + e1i;
+      const TReal b1i = a1i - e1r;
+      const TReal b4r = a1r - e1i;
+      const TReal b4i = a1i + e1r;
+      const TReal b2r = a2r + e2i;
+      const TReal b2i = a2i - e2r;
+      const TReal b3r = a2r - e2i;
+      const TReal b3i = a2i + e2r;
+      y1r[u] = b1r * w1r - b1i * w1i;
+      y1i[u] = b1r * w1i + b1i * w1r;
+      y2r[u] = b2r * w2r - b2i * w2i;
+      y2i[u] = b2r * w2i + b2i * w2r;
+      y3r[u] = b3r * w3r - b3i * w3i;
+      y3i[u] = b3r * w3i + b3i * w3r;
+      y4r[u] = b4r * w4r - b4i * w4i;
+      y4i[u] = b4r * w4i + b4i * w4r;
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::RadixGeneric( SizeValueType radix, const TReal * xr, const TReal * xi, TReal * yr, TReal * yi,
+                SizeValueType m, SizeValueType stride, const TReal * wr, const TReal * wi )
+{
+  // The roots of unity of the radix follow the twiddle factors.
+  const TReal * rootRe = wr + m * ( radix - 1 );
+  const TReal * rootIm = wi + m * ( radix - 1 );
+  for ( SizeValueType p = 0; p < m; ++p )
+    {
+    const TReal * x0r = xr + stride * p;
+    const TReal * x0i = xi + stride * p;
+    for ( SizeValueType j = 0; j < radix; ++j )
+      {
+      TReal * yjr = yr + stride * ( radix * p + j );
+      TReal * yji = yi + stride * ( radix * p + j );
+      std::copy( x0r, x0r + stride, yjr );
+      std::copy( x0i, x0i + stride, yji );
+      for ( SizeValueType k = 1; k < radix; ++k )
+        {
+        const TReal * xkr = xr + stride * ( p + k * m );
+        const TReal * xki = xi + stride * ( p + k * m );
+        const TReal cr = rootRe[( j * k ) % radix];
+        const TReal ci = rootIm[( j * k ) % radix];
+        for ( SizeValueType u = 0; u < stride; ++u )
+          {
+          yjr[u] += xkr[u] * cr - xki[u] * ci;
+          yji[u] += xkr[u] * ci + xki[u] * cr;
+          }
+        }
+      if ( j > 0 )
+        {
+        const TReal w1r = wr[( radix - 1 ) * p + j - 1];
+        const TReal w1i = wi[( radix - 1 ) * p + j - 1];
+        for ( SizeValueType u = 0; u < stride; ++u )
+          {
+          const TReal br = yjr[u];
+          const TReal bi = yji[u];
+          yjr[u] = br * w1r - bi * w1i;
+          yji[u] = br * w1i + bi * w1r;
+          }
+        }
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::ComplexTransform< TReal >
+::Bluestein( TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const
+{
+  // X_j = c_j sum_k ( x_k c_k ) conj( c_{j-k} ) with c_k = exp( -i pi k^2 / n )
+  const SizeValueType size = m_BluesteinSize * lanes;
+  TReal * ar = work;
+  TReal * ai = work + size;
+  TReal * subWork = work + 2 * size;
+  for ( SizeValueType t = 0; t < m_Size; ++t )
+    {
+    const TReal cr = m_ChirpRe[t];
+    const TReal ci = m_ChirpIm[t];
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      const SizeValueType i = t * lanes + b;
+      ar[i] = re[i] * cr - im[i] * ci;
+      ai[i] = re[i] * ci + im[i] * cr;
+      }
+    }
+  std::fill( ar + m_Size * lanes, ar + size, TReal( 0 ) );
+  std::fill( ai + m_Size * lanes, ai + size, TReal( 0 ) );
+
+  m_BluesteinTransform->Transform( ar, ai, lanes, false, subWork );
+  for ( SizeValueType t = 0; t < m_BluesteinSize; ++t )
+    {
+    const TReal fr = m_ChirpFilterRe[t];
+    const TReal fi = m_ChirpFilterIm[t];
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      const SizeValueType i = t * lanes + b;
+      const TReal vr = ar[i];
+      const TReal vi = ai[i];
+      ar[i] = vr * fr - vi * fi;
+      ai[i] = vr * fi + vi * fr;
+      }
+    }
+  m_BluesteinTransform->Transform( ar, ai, lanes, true, subWork );
+
+  for ( SizeValueType t = 0; t < m_Size; ++t )
+    {
+    const TReal cr = m_ChirpRe[t];
+    const TReal ci = m_ChirpIm[t];
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      const SizeValueType i = t * lanes + b;
+      re[i] = ar[i] * cr - ai[i] * ci;
+      im[i] = ar[i] * ci + ai[i] * cr;
+      }
+    }
+}
+
+template< typename TReal >
+NativeFFTCommon::RealTransform< TReal >
+::RealTransform( SizeValueType size ):
+  m_Size( size ),
+  m_Transform( size % 2 == 0 ? size / 2 : size )
+{
+  if ( size % 2 == 0 )
+    {
+    // exp( -2 i pi k / size ) for k in [0, size / 2]
+    const SizeValueType half = size / 2;
+    m_TwiddleRe.resize( half + 1 );
+    m_TwiddleIm.resize( half + 1 );
+    for ( SizeValueType k = 0; k <= half; ++k )
+      {
+      const double angle = 2.0 * Math::pi * static_cast< double >( k ) / size;
+      m_TwiddleRe[k] = static_cast< TReal >( std::cos( angle ) );
+      m_TwiddleIm[k] = static_cast< TReal >( -std::sin( angle ) );
+      }
+    }
+}
+
+template< typename TReal >
+SizeValueType
+NativeFFTCommon::RealTransform< TReal >
+::GetWorkSize( SizeValueType lanes ) const
+{
+  return 2 * m_Transform.GetSize() * lanes + m_Transform.GetWorkSize( lanes );
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::RealTransform< TReal >
+::Forward( const TReal * input, TReal * re, TReal * im, SizeValueType lanes, TReal * work ) const
+{
+  const SizeValueType n = m_Transform.GetSize();
+  TReal * zr = work;
+  TReal * zi = work + n * lanes;
+  TReal * transformWork = work + 2 * n * lanes;
+  if ( m_Size % 2 != 0 )
+    {
+    std::copy( input, input + n * lanes, zr );
+    std::fill( zi, zi + n * lanes, TReal( 0 ) );
+    m_Transform.Transform( zr, zi, lanes, false, transformWork );
+    const SizeValueType count = ( m_Size / 2 + 1 ) * lanes;
+    std::copy( zr, zr + count, re );
+    std::copy( zi, zi + count, im );
+    return;
+    }
+
+  // Transform the even values as the real parts and the odd values as
+  // the imaginary parts of a signal of half the size, and separate
+  // their transforms E and O: X_k = E_k + exp( -2 i pi k / size ) O_k.
+  for ( SizeValueType k = 0; k < n; ++k )
+    {
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      zr[k * lanes + b] = input[2 * k * lanes + b];
+      zi[k * lanes + b] = input[( 2 * k + 1 ) * lanes + b];
+      }
+    }
+  m_Transform.Transform( zr, zi, lanes, false, transformWork );
+  for ( SizeValueType k = 0; k <= n; ++k )
+    {
+    const SizeValueType kk = ( k % n ) * lanes;
+    const SizeValueType mk = ( ( n - k ) % n ) * lanes;
+    const TReal wr = m_TwiddleRe[k];
+    const TReal wi = m_TwiddleIm[k];
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      const TReal er = TReal( 0.5 ) * ( zr[kk + b] + zr[mk + b] );
+      const TReal ei = TReal( 0.5 ) * ( zi[kk + b] - zi[mk + b] );
+      const TReal or_ = TReal( 0.5 ) * ( zi[kk + b] + zi[mk + b] );
+      const TReal oi = TReal( -0.5 ) * ( zr[kk + b] - zr[mk + b] );
+      re[k * lanes + b] = er + or_ * wr - oi * wi;
+      im[k * lanes + b] = ei + or_ * wi + oi * wr;
+      }
+    }
+}
+
+template< typename TReal >
+void
+NativeFFTCommon::RealTransform< TReal >
+::Backward( TReal * re, TReal * im, TReal * output, SizeValueType lanes, TReal * work ) const
+{
+  const SizeValueType n = m_Transform.GetSize();
+  TReal * zr = work;
+  TReal * zi = work + n * lanes;
+  TReal * transformWork = work + 2 * n * lanes;
+  if ( m_Size % 2 != 0 )
+    {
+    // Complete the spectrum with its hermitian symmetry.
+    const SizeValueType half = m_Size / 2;
+    std::copy( re, re + ( half + 1 ) * lanes, zr );
+    std::copy( im, im + ( half + 1 ) * lanes, zi );
+    for ( SizeValueType t = half + 1; t < n; ++t )
+      {
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        zr[t * lanes + b] = re[( n - t ) * lanes + b];
+        zi[t * lanes + b] = -im[( n - t ) * lanes + b];
+        }
+      }
+    m_Transform.Transform( zr, zi, lanes, true, transformWork );
+    std::copy( zr, zr + n * lanes, output );
+    return;
+    }
+
+  // Rebuild the transform of the even values plus i times the
+  // transform of the odd values, the inverse of Forward().
+  for ( SizeValueType b = 0; b < lanes; ++b )
+    {
+    im[b] = TReal( 0 );
+    im[n * lanes + b] = TReal( 0 );
+    }
+  for ( SizeValueType k = 0; k < n; ++k )
+    {
+    const SizeValueType mk = ( n - k ) * lanes;
+    const TReal c = m_TwiddleRe[k];
+    const TReal s = -m_TwiddleIm[k];
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      const TReal xkr = re[k * lanes + b];
+      const TReal xki = im[k * lanes + b];
+      const TReal xmr = re[mk + b];
+      const TReal xmi = im[mk + b];
+      const TReal sr = xkr + xmr;
+      const TReal si = xki - xmi;
+      const TReal dr = xkr - xmr;
+      const TReal di = xki + xmi;
+      const TReal tr = dr * c - di * s;
+      const TReal ti = dr * s + di * c;
+      zr[k * lanes + b] = sr - ti;
+      zi[k * lanes + b] = si + tr;
+      }
+    }
+  m_Transform.Transform( zr, zi, lanes, true, transformWork );
+  for ( SizeValueType k = 0; k < n; ++k )
+    {
+    for ( SizeValueType b = 0; b < lanes; ++b )
+      {
+      output[2 * k * lanes + b] = zr[k * lanes + b];
+      output[( 2 * k + 1 ) * lanes + b] = zi[k * lanes + b];
+      }
+    }
+}
+
+template< unsigned int VDimension >
+Offset< VDimension >
+NativeFFTCommon
+::ComputeStrides( const Size< VDimension > & size )
+{
+  Offset< VDimension > strides;
+  strides[0] = 1;
+  for ( unsigned int d = 1; d < VDimension; ++d )
+    {
+    strides[d] = strides[d - 1] * static_cast< OffsetValueType >( size[d - 1] );
+    }
+  return strides;
+}
+
+template< unsigned int VDimension, typename TFunction >
+void
+NativeFFTCommon
+::ForEachBatch( const ImageRegion< VDimension > & region, unsigned int direction,
+                unsigned int laneDirection, TFunction function )
+{
+  ImageRegion< VDimension > firsts = region;
+  firsts.SetSize( direction, 1 );
+  const bool batched = laneDirection != direction;
+  if ( batched )
+    {
+    firsts.SetSize( laneDirection, 1 );
+    }
+  const IndexValueType laneBegin = region.GetIndex( laneDirection );
+  const IndexValueType laneEnd = laneBegin + static_cast< IndexValueType >( region.GetSize( laneDirection ) );
+
+  Index< VDimension > index = firsts.GetIndex();
+  const SizeValueType numberOfFirsts = firsts.GetNumberOfPixels();
+  for ( SizeValueType i = 0; i < numberOfFirsts; ++i )
+    {
+    if ( batched )
+      {
+      for ( IndexValueType lane = laneBegin; lane < laneEnd; lane += MaximumNumberOfLanes )
+        {
+        index[laneDirection] = lane;
+        function( index, std::min( MaximumNumberOfLanes, static_cast< SizeValueType >( laneEnd - lane ) ) );
+        }
+      index[laneDirection] = laneBegin;
+      }
+    else
+      {
+      function( index, 1 );
+      }
+    // Next index of the region of the first indices
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      if ( ++index[d] < firsts.GetIndex( d ) + static_cast< IndexValueType >( firsts.GetSize( d ) ) )
+        {
+        break;
+        }
+      index[d] = firsts.GetIndex( d );
+      }
+    }
+}
+
+template< typename TReal, unsigned int VDimension >
+void
+NativeFFTCommon
+::TransformLines( std::complex< TReal > * data, const Size< VDimension > & size, unsigned int direction,
+                  bool inverse, MultiThreaderBase * threader )
+{
+  const SizeValueType n = size[direction];
+  if ( n < 2 )
+    {
+    return;
+    }
+  const ComplexTransform< TReal > transform( n );
+  const Offset< VDimension > strides = ComputeStrides( size );
+  const OffsetValueType lineStride = strides[direction];
+  // The lines of a batch are adjacent along the first dimension when
+  // possible, so that they are gathered from contiguous values.
+  const unsigned int laneDirection = ( direction == 0 && VDimension > 1 ) ? 1 : 0;
+  const OffsetValueType laneStride = strides[laneDirection];
+
+  ImageRegion< VDimension > region;
+  region.SetSize( size );
+  threader->template ParallelizeImageRegionRestrictDirection< VDimension >(
+    direction, region,
+    [&]( const ImageRegion< VDimension > & chunk )
+    {
+    const SizeValueType count = n * MaximumNumberOfLanes;
+    std::vector< TReal > buffer( 2 * count + transform.GetWorkSize( MaximumNumberOfLanes ) );
+    TReal * re = buffer.data();
+    TReal * im = re + count;
+    TReal * work = im + count;
+    ForEachBatch( chunk, direction, laneDirection,
+      [&]( const Index< VDimension > & first, SizeValueType lanes )
+      {
+      OffsetValueType offset = 0;
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        offset += first[d] * strides[d];
+        }
+      std::complex< TReal > * line = data + offset;
+      for ( SizeValueType t = 0; t < n; ++t )
+        {
+        const std::complex< TReal > * value = line + t * lineStride;
+        for ( SizeValueType b = 0; b < lanes; ++b )
+          {
+          re[t * lanes + b] = value[b * laneStride].real();
+          im[t * lanes + b] = value[b * laneStride].imag();
+          }
+        }
+      transform.Transform( re, im, lanes, inverse, work );
+      for ( SizeValueType t = 0; t < n; ++t )
+        {
+        std::complex< TReal > * value = line + t * lineStride;
+        for ( SizeValueType b = 0; b < lanes; ++b )
+          {
+          value[b * laneStride] = std::complex< TReal >( re[t * lanes + b], im[t * lanes + b] );
+          }
+        }
+      } );
+    },
+    nullptr );
+}
+
+template< typename TReal, unsigned int VDimension >
+void
+NativeFFTCommon
+::ComplexToComplex( std::complex< TReal > * data, const Size< VDimension > & size, bool inverse,
+                    MultiThreaderBase * threader )
+{
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    TransformLines( data, size, d, inverse, threader );
+    }
+}
+
+template< typename TReal, unsigned int VDimension >
+void
+NativeFFTCommon
+::RealToHalfHermitian( const TReal * input, std::complex< TReal > * output, const Size< VDimension > & size,
+                       MultiThreaderBase * threader )
+{
+  Size< VDimension > halfSize = size;
+  halfSize[0] = size[0] / 2 + 1;
+
+  // Real transform of the lines along the first dimension
+  const SizeValueType n = size[0];
+  const SizeValueType half = halfSize[0];
+  const RealTransform< TReal > transform( n );
+  const Offset< VDimension > inputStrides = ComputeStrides( size );
+  const Offset< VDimension > outputStrides = ComputeStrides( halfSize );
+  const unsigned int laneDirection = VDimension > 1 ? 1 : 0;
+
+  ImageRegion< VDimension > region;
+  region.SetSize( size );
+  threader->template ParallelizeImageRegionRestrictDirection< VDimension >(
+    0, region,
+    [&]( const ImageRegion< VDimension > & chunk )
+    {
+    std::vector< TReal > buffer( ( n + 2 * half ) * MaximumNumberOfLanes
+                                 + transform.GetWorkSize( MaximumNumberOfLanes ) );
+    TReal * in = buffer.data();
+    TReal * re = in + n * MaximumNumberOfLanes;
+    TReal * im = re + half * MaximumNumberOfLanes;
+    TReal * work = im + half * MaximumNumberOfLanes;
+    ForEachBatch( chunk, 0, laneDirection,
+      [&]( const Index< VDimension > & first, SizeValueType lanes )
+      {
+      OffsetValueType inputOffset = 0;
+      OffsetValueType outputOffset = 0;
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        inputOffset += first[d] * inputStrides[d];
+        outputOffset += first[d] * outputStrides[d];
+        }
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        const TReal * line = input + inputOffset + b * inputStrides[laneDirection];
+        for ( SizeValueType t = 0; t < n; ++t )
+          {
+          in[t * lanes + b] = line[t];
+          }
+        }
+      transform.Forward( in, re, im, lanes, work );
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        std::complex< TReal > * line = output + outputOffset + b * outputStrides[laneDirection];
+        for ( SizeValueType k = 0; k < half; ++k )
+          {
+          line[k] = std::complex< TReal >( re[k * lanes + b], im[k * lanes + b] );
+          }
+        }
+      } );
+    },
+    nullptr );
+
+  for ( unsigned int d = 1; d < VDimension; ++d )
+    {
+    TransformLines( output, halfSize, d, false, threader );
+    }
+}
+
+template< typename TReal, unsigned int VDimension >
+void
+NativeFFTCommon
+::HalfHermitianToReal( std::complex< TReal > * input, TReal * output, const Size< VDimension > & size,
+                       MultiThreaderBase * threader )
+{
+  Size< VDimension > halfSize = size;
+  halfSize[0] = size[0] / 2 + 1;
+
+  for ( unsigned int d = 1; d < VDimension; ++d )
+    {
+    TransformLines( input, halfSize, d, true, threader );
+    }
+
+  // Real backward transform of the lines along the first dimension
+  const SizeValueType n = size[0];
+  const SizeValueType half = halfSize[0];
+  const RealTransform< TReal > transform( n );
+  const Offset< VDimension > inputStrides = ComputeStrides( halfSize );
+  const Offset< VDimension > outputStrides = ComputeStrides( size );
+  const unsigned int laneDirection = VDimension > 1 ? 1 : 0;
+  const TReal scale = TReal( 1 ) / static_cast< TReal >( ImageRegion< VDimension >( size ).GetNumberOfPixels() );
+
+  ImageRegion< VDimension > region;
+  region.SetSize( size );
+  threader->template ParallelizeImageRegionRestrictDirection< VDimension >(
+    0, region,
+    [&]( const ImageRegion< VDimension > & chunk )
+    {
+    std::vector< TReal > buffer( ( n + 2 * half ) * MaximumNumberOfLanes
+                                 + transform.GetWorkSize( MaximumNumberOfLanes ) );
+    TReal * out = buffer.data();
+    TReal * re = out + n * MaximumNumberOfLanes;
+    TReal * im = re + half * MaximumNumberOfLanes;
+    TReal * work = im + half * MaximumNumberOfLanes;
+    ForEachBatch( chunk, 0, laneDirection,
+      [&]( const Index< VDimension > & first, SizeValueType lanes )
+      {
+      OffsetValueType inputOffset = 0;
+      OffsetValueType outputOffset = 0;
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        inputOffset += first[d] * inputStrides[d];
+        outputOffset += first[d] * outputStrides[d];
+        }
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        const std::complex< TReal > * line = input + inputOffset + b * inputStrides[laneDirection];
+        for ( SizeValueType k = 0; k < half; ++k )
+          {
+          re[k * lanes + b] = line[k].real();
+          im[k * lanes + b] = line[k].imag();
+          }
+        }
+      transform.Backward( re, im, out, lanes, work );
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        TReal * line = output + outputOffset + b * outputStrides[laneDirection];
+        for ( SizeValueType t = 0; t < n; ++t )
+          {
+          line[t] = out[t * lanes + b] * scale;
+          }
+        }
+      } );
+    },
+    nullptr );
+}
+
+} // end namespace itk
+
+#endif // itkNativeFFTCommon_hxx
@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeFFTImageFilterFactory_h
+#define itkNativeFFTImageFilterFactory_h
+
+#include "itkObjectFactoryBase.h"
+#include "itkVersion.h"
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeForwardFFTImageFilter.h"
+#include "itkNativeHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkNativeInverseFFTImageFilter.h"
+#include "itkNativeRealToHalfHermitianForwardFFTImageFilter.h"
+
+namespace itk
+{
+/** \class NativeFFTImageFilterFactory
+ *
+ * \brief Object factory selecting the native FFT filters.
+ *
+ * Once registered, this factory makes ForwardFFTImageFilter::New(),
+ * InverseFFTImageFilter::New(),
+ * RealToHalfHermitianForwardFFTImageFilter::New(),
+ * HalfHermitianToRealInverseFFTImageFilter::New() and
+ * ComplexToComplexFFTImageFilter::New() create the native
+ * implementations for float and double images of dimension 1 to 4,
+ * instead of the VNL or FFTW ones.
+ *
+ * \code
+ * itk::NativeFFTImageFilterFactory::RegisterOneFactory();
+ * \endcode
+ *
+ * \sa NativeForwardFFTImageFilter
+ * \ingroup FourierTransform
+ * \ingroup ITKFFT
+ */
+class NativeFFTImageFilterFactory : public ObjectFactoryBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(NativeFFTImageFilterFactory);
+
+  using Self = NativeFFTImageFilterFactory;
+  using Superclass = ObjectFactoryBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Class methods used to interface with the registered factories. */
+  const char* GetITKSourceVersion() const override
+    {
+    return ITK_SOURCE_VERSION;
+    }
+  const char* GetDescription() const override
+    {
+    return "A Factory for the native FFT image filters";
+    }
+
+  /** Method for class instantiation. */
+  itkFactorylessNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(NativeFFTImageFilterFactory, itk::ObjectFactoryBase);
+
+  /** Register one factory of this type  */
+  static void RegisterOneFactory()
+  {
+    NativeFFTImageFilterFactory::Pointer factory = NativeFFTImageFilterFactory::New();
+
+    ObjectFactoryBase::RegisterFactory(factory);
+  }
+
+private:
+  template< typename TReal, unsigned int VDimension >
+  void OverrideFFTFilterTypes()
+  {
+    using RealImageType = Image< TReal, VDimension >;
+    using ComplexImageType = Image< std::complex< TReal >, VDimension >;
+    this->OverrideFFTFilterType< ForwardFFTImageFilter< RealImageType, ComplexImageType >,
+                                 NativeForwardFFTImageFilter< RealImageType, ComplexImageType > >();
+    this->OverrideFFTFilterType< InverseFFTImageFilter< ComplexImageType, RealImageType >,
+                                 NativeInverseFFTImageFilter< ComplexImageType, RealImageType > >();
+    this->OverrideFFTFilterType< RealToHalfHermitianForwardFFTImageFilter< RealImageType, ComplexImageType >,
+                                 NativeRealToHalfHermitianForwardFFTImageFilter< RealImageType, ComplexImageType > >();
+    this->OverrideFFTFilterType< HalfHermitianToRealInverseFFTImageFilter< ComplexImageType, RealImageType >,
+                                 NativeHalfHermitianToRealInverseFFTImageFilter< ComplexImageType, RealImageType > >();
+    this->OverrideFFTFilterType< ComplexToComplexFFTImageFilter< ComplexImageType >,
+                                 NativeComplexToComplexFFTImageFilter< ComplexImageType > >();
+  }
+
+  template< typename TFilter, typename TNativeFilter >
+  void OverrideFFTFilterType()
+  {
+    this->RegisterOverride(
+      typeid(TFilter).name(),
+      typeid(TNativeFilter).name(),
+      "Native FFT Image Filter Override",
+      true,
+      CreateObjectFunction< TNativeFilter >::New() );
+  }
+
+  NativeFFTImageFilterFactory()
+  {
+    this->OverrideFFTFilterTypes< float, 1 >();
+    this->OverrideFFTFilterTypes< float, 2 >();
+    this->OverrideFFTFilterTypes< float, 3 >();
+    this->OverrideFFTFilterTypes< float, 4 >();
+
+    this->OverrideFFTFilterTypes< double, 1 >();
+    this->OverrideFFTFilterTypes< double, 2 >();
+    this->OverrideFFTFilterTypes< double, 3 >();
+    this->OverrideFFTFilterTypes< double, 4 >();
+  }
+};
+
+} // end namespace itk
+
+#endif
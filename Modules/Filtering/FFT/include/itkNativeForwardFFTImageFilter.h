@@ -0,0 +1,97 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeForwardFFTImageFilter_h
+#define itkNativeForwardFFTImageFilter_h
+
+#include "itkForwardFFTImageFilter.h"
+
+namespace itk
+{
+/** \class NativeForwardFFTImageFilter
+ *
+ * \brief Multithreaded forward Fast Fourier Transform implemented in ITK.
+ *
+ * The transform is computed in the precision of the input pixels, with
+ * the lines of each dimension processed in parallel. Images of any
+ * size are supported, but the transform is faster when the prime
+ * factors of the size along each dimension are 2, 3 and 5.
+ *
+ * This filter is used by ForwardFFTImageFilter::New() once a
+ * NativeFFTImageFilterFactory has been registered.
+ *
+ * \ingroup FourierTransform
+ *
+ * \sa ForwardFFTImageFilter
+ * \sa NativeFFTImageFilterFactory
+ * \ingroup ITKFFT
+ */
+template< typename TInputImage, typename TOutputImage=Image< std::complex<typename TInputImage::PixelType>, TInputImage::ImageDimension> >
+class ITK_TEMPLATE_EXPORT NativeForwardFFTImageFilter:
+  public ForwardFFTImageFilter< TInputImage, TOutputImage >
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(NativeForwardFFTImageFilter);
+
+  /** Standard class type aliases. */
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using InputSizeType = typename InputImageType::SizeType;
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+
+  using Self = NativeForwardFFTImageFilter;
+  using Superclass = ForwardFFTImageFilter<  TInputImage, TOutputImage>;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(NativeForwardFFTImageFilter,
+               ForwardFFTImageFilter);
+
+  /** Extract the dimensionality of the images. They are assumed to be
+   * the same. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static constexpr unsigned int InputImageDimension = TInputImage::ImageDimension;
+  static constexpr unsigned int OutputImageDimension = TOutputImage::ImageDimension;
+
+  SizeValueType GetSizeGreatestPrimeFactor() const override;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro( ImageDimensionsMatchCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  // End concept checking
+#endif
+
+protected:
+  NativeForwardFFTImageFilter() = default;
+  ~NativeForwardFFTImageFilter() override = default;
+
+  void GenerateData() override;
+};
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkNativeForwardFFTImageFilter.hxx"
+#endif
+
+#endif
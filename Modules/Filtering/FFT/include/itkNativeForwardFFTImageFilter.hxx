@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkNativeForwardFFTImageFilter_hxx
+#define itkNativeForwardFFTImageFilter_hxx
+
+#include "itkNativeForwardFFTImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNativeFFTCommon.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+
+template< typename TInputImage, typename TOutputImage >
+void
+NativeForwardFFTImageFilter< TInputImage, TOutputImage >
+::GenerateData()
+{
+  // Get pointers to the input and output.
+  typename InputImageType::ConstPointer inputPtr = this->GetInput();
+  typename OutputImageType::Pointer outputPtr = this->GetOutput();
+
+  if ( !inputPtr || !outputPtr )
+    {
+    return;
+    }
+
+  // We don't have a nice progress to report, but at least this simple line
+  // reports the beginning and the end of the process.
+  ProgressReporter progress( this, 0, 1 );
+
+  outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
+  outputPtr->Allocate();
+
+  const InputSizeType inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
+  InputSizeType halfSize = inputSize;
+  halfSize[0] = inputSize[0] / 2 + 1;
+
+  // Compute the first half of the transform along the first dimension.
+  using ComplexType = std::complex< InputPixelType >;
+  const OutputImageRegionType halfRegion( halfSize );
+  std::vector< ComplexType > half( halfRegion.GetNumberOfPixels() );
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  NativeFFTCommon::RealToHalfHermitian( inputPtr->GetBufferPointer(), half.data(), inputSize, multiThreader );
+
+  // Complete the output with the hermitian symmetry of the transform of
+  // a real image.
+  const OutputImageRegionType region = outputPtr->GetLargestPossibleRegion();
+  multiThreader->template ParallelizeImageRegion< ImageDimension >(
+    region,
+    [&]( const OutputImageRegionType & outputRegionForThread )
+    {
+    ImageRegionIteratorWithIndex< OutputImageType > oIt( outputPtr, outputRegionForThread );
+    for ( oIt.GoToBegin(); !oIt.IsAtEnd(); ++oIt )
+      {
+      const typename OutputImageType::IndexType index = oIt.GetIndex();
+      SizeValueType k[ImageDimension];
+      for ( unsigned int i = 0; i < ImageDimension; ++i )
+        {
+        k[i] = static_cast< SizeValueType >( index[i] - region.GetIndex( i ) );
+        }
+      const bool mirrored = k[0] >= halfSize[0];
+      SizeValueType offset = 0;
+      for ( unsigned int i = ImageDimension; i > 0; --i )
+        {
+        const unsigned int d = i - 1;
+        const SizeValueType kd = mirrored ? ( inputSize[d] - k[d] ) % inputSize[d] : k[d];
+        offset = offset * halfSize[d] + kd;
+        }
+      oIt.Set( mirrored ? std::conj( half[offset] ) : half[offset] );
+      }
+    },
+    nullptr );
+}
+
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+NativeForwardFFTImageFilter< TInputImage, TOutputImage >
+::GetSizeGreatestPrimeFactor() const
+{
+  return NativeFFTCommon::GREATEST_PRIME_FACTOR;
+}
+
+}
+
+#endif
@@ -2,7 +2,8 @@ set(DOCUMENTATION "This module provides interfaces to FFT
 implementations. In particular it provides the direct and inverse
 computations of Fast Fourier Transforms based on
 <a href=\"http://vxl.sourceforge.net/\">VXL</a> and
-<a href=\"http://www.fftw.org\">FFTW</a>. Note that when using the FFTW
+<a href=\"http://www.fftw.org\">FFTW</a>, and of a multithreaded native
+implementation supporting any image size. Note that when using the FFTW
 implementation you must comply with the GPL license.")
 
 if( ITK_USE_FFTWF OR ITK_USE_FFTWD )
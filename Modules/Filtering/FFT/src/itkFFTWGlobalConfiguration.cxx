@@ -412,7 +412,13 @@ FFTWGlobalConfiguration
   m_PlanRigor(0),
   m_WriteWisdomCache(false),
   m_ReadWisdomCache(true),
-  m_WisdomCacheBase("")
+  m_WisdomCacheBase(""),
+  m_PlanCaching(true),
+  m_PlanCacheMaximumSize(32),
+  m_PlanCacheUses(0),
+  m_PlanCacheHits(0),
+  m_PlanCacheMisses(0),
+  m_PlanningTime(0.0)
 {
     {//Configure default method for creating WISDOM_CACHE files
     std::string manualCacheFilename="";
@@ -514,6 +520,14 @@ FFTWGlobalConfiguration
       }
     }
 
+    {
+    std::string plan_cache_env;
+    if( itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE", plan_cache_env) && isDeclineString(plan_cache_env) )
+      {
+      this->m_PlanCaching=false;
+      }
+    }
+
   if( this->m_ReadWisdomCache )
     {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -532,6 +546,8 @@ FFTWGlobalConfiguration
 FFTWGlobalConfiguration
 ::~FFTWGlobalConfiguration()
 {
+  // The cached plans must be destroyed before the cleanup of FFTW
+  this->m_PlanCache.clear();
   if( this->m_WriteWisdomCache && this->m_NewWisdomAvailable )
     {
        std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -794,7 +810,13 @@ std::mutex &
 FFTWGlobalConfiguration
 ::GetLockMutex()
 {
-  return GetInstance()->m_Lock;
+  // Don't take a reference on the instance: the cached plans are
+  // destroyed under that lock in the destructor.
+  if( ! FFTWGlobalConfiguration::m_Instance )
+    {
+    GetInstance();
+    }
+  return FFTWGlobalConfiguration::m_Instance->m_Lock;
 }
 
 void
@@ -883,6 +905,168 @@ FFTWGlobalConfiguration
   return GetInstance()->m_WisdomCacheBase;
 }
 
+void
+FFTWGlobalConfiguration
+::SetPlanCaching( const bool & v )
+{
+  Pointer instance = GetInstance();
+  PlanCacheType released;
+    {
+    std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+    instance->m_PlanCaching = v;
+    if( !v )
+      {
+      released.swap( instance->m_PlanCache );
+      }
+    }
+}
+
+bool
+FFTWGlobalConfiguration
+::GetPlanCaching()
+{
+  return GetInstance()->m_PlanCaching;
+}
+
+void
+FFTWGlobalConfiguration
+::SetPlanCacheMaximumSize( const SizeValueType & v )
+{
+  Pointer instance = GetInstance();
+  std::vector< std::shared_ptr< void > > released;
+    {
+    std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+    instance->m_PlanCacheMaximumSize = v;
+    instance->TrimPlanCache( released );
+    }
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetPlanCacheMaximumSize()
+{
+  return GetInstance()->m_PlanCacheMaximumSize;
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetPlanCacheSize()
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  return instance->m_PlanCache.size();
+}
+
+void
+FFTWGlobalConfiguration
+::ClearPlanCache()
+{
+  Pointer instance = GetInstance();
+  PlanCacheType released;
+    {
+    std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+    released.swap( instance->m_PlanCache );
+    }
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetPlanCacheHits()
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  return instance->m_PlanCacheHits;
+}
+
+SizeValueType
+FFTWGlobalConfiguration
+::GetPlanCacheMisses()
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  return instance->m_PlanCacheMisses;
+}
+
+double
+FFTWGlobalConfiguration
+::GetPlanningTime()
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  return instance->m_PlanningTime;
+}
+
+void
+FFTWGlobalConfiguration
+::ResetPlanCacheStatistics()
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  instance->m_PlanCacheHits = 0;
+  instance->m_PlanCacheMisses = 0;
+  instance->m_PlanningTime = 0.0;
+}
+
+std::shared_ptr< void >
+FFTWGlobalConfiguration
+::GetCachedPlan( const std::string & key )
+{
+  Pointer instance = GetInstance();
+  std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+  auto it = instance->m_PlanCache.find( key );
+  if( it == instance->m_PlanCache.end() )
+    {
+    ++instance->m_PlanCacheMisses;
+    return nullptr;
+    }
+  ++instance->m_PlanCacheHits;
+  it->second.m_LastUse = ++instance->m_PlanCacheUses;
+  return it->second.m_Plan;
+}
+
+void
+FFTWGlobalConfiguration
+::AddCachedPlan( const std::string & key, const std::shared_ptr< void > & plan, double planningTime )
+{
+  Pointer instance = GetInstance();
+  std::vector< std::shared_ptr< void > > released;
+    {
+    std::lock_guard< std::mutex > lock( instance->m_PlanCacheLock );
+    instance->m_PlanningTime += planningTime;
+    if( instance->m_PlanCaching )
+      {
+      // Another thread may have cached the same plan in the mean time;
+      // keep the first one.
+      CachedPlan & cached = instance->m_PlanCache[key];
+      if( !cached.m_Plan )
+        {
+        cached.m_Plan = plan;
+        }
+      cached.m_LastUse = ++instance->m_PlanCacheUses;
+      instance->TrimPlanCache( released );
+      }
+    }
+}
+
+void
+FFTWGlobalConfiguration
+::TrimPlanCache( std::vector< std::shared_ptr< void > > & released )
+{
+  while( m_PlanCache.size() > m_PlanCacheMaximumSize )
+    {
+    auto oldest = m_PlanCache.begin();
+    for( auto it = m_PlanCache.begin(); it != m_PlanCache.end(); ++it )
+      {
+      if( it->second.m_LastUse < oldest->second.m_LastUse )
+        {
+        oldest = it;
+        }
+      }
+    released.push_back( oldest->second.m_Plan );
+    m_PlanCache.erase( oldest );
+    }
+}
+
 }//end namespace itk
 
 #endif
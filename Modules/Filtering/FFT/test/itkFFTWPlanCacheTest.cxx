@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTWCommon.h"
+#include "itkFFTWGlobalConfiguration.h"
+#include "itkTestingMacros.h"
+
+#include <complex>
+#include <vector>
+
+namespace
+{
+
+template< typename T >
+bool
+ArraysAreClose( const std::vector< T > & values, const std::vector< T > & expected )
+{
+  for( size_t i = 0; i < values.size(); ++i )
+    {
+    if( std::abs( values[i] - expected[i] ) > 1e-4 * ( 1.0 + std::abs( expected[i] ) ) )
+      {
+      std::cerr << "Value " << values[i] << " at " << i << " differs from " << expected[i] << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< typename TReal >
+int
+PlanCacheTest()
+{
+  using ProxyType = itk::fftw::Proxy< TReal >;
+  using PlanType = typename ProxyType::PlanType;
+  using PlanPointer = typename ProxyType::PlanPointer;
+  using FFTWComplexType = typename ProxyType::ComplexType;
+  using ComplexType = std::complex< TReal >;
+  using Configuration = itk::FFTWGlobalConfiguration;
+
+  // An odd size, so that the half hermitian arrays are not a plain
+  // half of the real arrays.
+  const int rank = 2;
+  const int n[2] = { 9, 15 };
+  const size_t realSize = 9 * 15;
+  const size_t halfSize = 9 * ( 15 / 2 + 1 );
+  // FFTW_ESTIMATE does not overwrite the arrays while planning.
+  const unsigned flags = FFTW_ESTIMATE;
+
+  std::vector< TReal > realInput( realSize );
+  std::vector< ComplexType > complexInput( realSize );
+  for( size_t i = 0; i < realSize; ++i )
+    {
+    realInput[i] = static_cast< TReal >( std::sin( 0.3 * i ) + 0.01 * i );
+    complexInput[i] = ComplexType( static_cast< TReal >( std::cos( 0.2 * i ) ),
+                                   static_cast< TReal >( std::sin( 0.7 * i ) ) );
+    }
+
+  // The buffers are never reallocated, so that all the plans see the
+  // same arrays.
+  std::vector< TReal > realBuffer( realSize );
+  std::vector< ComplexType > halfBuffer( halfSize );
+  std::vector< ComplexType > complexBuffer( realSize );
+  std::vector< ComplexType > complexOutput( realSize );
+  TReal * realData = realBuffer.data();
+  auto * halfData = reinterpret_cast< FFTWComplexType * >( halfBuffer.data() );
+  auto * complexData = reinterpret_cast< FFTWComplexType * >( complexBuffer.data() );
+  auto * complexOutputData = reinterpret_cast< FFTWComplexType * >( complexOutput.data() );
+
+  // Reference results, computed without the cache
+  std::copy( realInput.begin(), realInput.end(), realBuffer.begin() );
+  PlanType plan = ProxyType::Plan_dft_r2c( rank, n, realData, halfData, flags );
+  ProxyType::Execute( plan );
+  ProxyType::DestroyPlan( plan );
+  const std::vector< ComplexType > r2cExpected = halfBuffer;
+
+  // The complex to real transform destroys its input.
+  plan = ProxyType::Plan_dft_c2r( rank, n, halfData, realData, flags );
+  ProxyType::Execute( plan );
+  ProxyType::DestroyPlan( plan );
+  const std::vector< TReal > c2rExpected = realBuffer;
+
+  std::copy( complexInput.begin(), complexInput.end(), complexBuffer.begin() );
+  plan = ProxyType::Plan_dft( rank, n, complexData, complexOutputData, FFTW_FORWARD, flags );
+  ProxyType::Execute( plan );
+  ProxyType::DestroyPlan( plan );
+  const std::vector< ComplexType > c2cExpected = complexOutput;
+
+  // The round trip gives the input scaled by the number of values.
+  std::vector< TReal > scaledInput( realSize );
+  for( size_t i = 0; i < realSize; ++i )
+    {
+    scaledInput[i] = realInput[i] * static_cast< TReal >( realSize );
+    }
+  TEST_EXPECT_TRUE( ArraysAreClose( c2rExpected, scaledInput ) );
+
+  auto runR2C = [&]()
+    {
+    std::copy( realInput.begin(), realInput.end(), realBuffer.begin() );
+    PlanPointer cachedPlan = ProxyType::GetCachedPlan_dft_r2c( rank, n, realData, halfData, flags );
+    ProxyType::Execute_dft_r2c( cachedPlan.get(), realData, halfData );
+    return ArraysAreClose( halfBuffer, r2cExpected );
+    };
+  auto runC2R = [&]()
+    {
+    std::copy( r2cExpected.begin(), r2cExpected.end(), halfBuffer.begin() );
+    PlanPointer cachedPlan = ProxyType::GetCachedPlan_dft_c2r( rank, n, halfData, realData, flags );
+    ProxyType::Execute_dft_c2r( cachedPlan.get(), halfData, realData );
+    return ArraysAreClose( realBuffer, c2rExpected );
+    };
+  auto runC2C = [&]()
+    {
+    std::copy( complexInput.begin(), complexInput.end(), complexBuffer.begin() );
+    PlanPointer cachedPlan =
+      ProxyType::GetCachedPlan_dft( rank, n, complexData, complexOutputData, FFTW_FORWARD, flags );
+    ProxyType::Execute_dft( cachedPlan.get(), complexData, complexOutputData );
+    return ArraysAreClose( complexOutput, c2cExpected );
+    };
+
+  Configuration::SetPlanCaching( true );
+  Configuration::SetPlanCacheMaximumSize( 32 );
+  Configuration::ClearPlanCache();
+  Configuration::ResetPlanCacheStatistics();
+
+  // The first plan of each kind is created and cached, the second one
+  // is found in the cache.
+  TEST_EXPECT_TRUE( runR2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 1 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 0 );
+  TEST_EXPECT_TRUE( runR2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 1 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 1 );
+
+  TEST_EXPECT_TRUE( runC2R() );
+  TEST_EXPECT_TRUE( runC2R() );
+  TEST_EXPECT_TRUE( runC2C() );
+  TEST_EXPECT_TRUE( runC2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 3 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 3 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 3 );
+  TEST_EXPECT_TRUE( Configuration::GetPlanningTime() >= 0.0 );
+
+  // Lowering the maximum size releases the least recently used plan,
+  // the real to complex one.
+  Configuration::SetPlanCacheMaximumSize( 2 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 2 );
+  TEST_EXPECT_TRUE( runR2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 4 );
+  // Caching it again released the complex to real plan.
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 2 );
+  TEST_EXPECT_TRUE( runC2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 4 );
+  TEST_EXPECT_TRUE( runC2R() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 5 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 2 );
+
+  // Without caching, the cache is emptied and the plans are neither
+  // looked up nor stored.
+  Configuration::SetPlanCaching( false );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 0 );
+  TEST_EXPECT_TRUE( runR2C() );
+  TEST_EXPECT_TRUE( runC2R() );
+  TEST_EXPECT_TRUE( runC2C() );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 5 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 4 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheSize(), 0 );
+
+  Configuration::SetPlanCaching( true );
+  Configuration::SetPlanCacheMaximumSize( 32 );
+  Configuration::ResetPlanCacheStatistics();
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheMisses(), 0 );
+  TEST_EXPECT_EQUAL( Configuration::GetPlanCacheHits(), 0 );
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkFFTWPlanCacheTest( int, char *[] )
+{
+  int testStatus = EXIT_SUCCESS;
+
+#ifdef ITK_USE_FFTWF
+  if( PlanCacheTest< float >() == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed for float." << std::endl;
+    testStatus = EXIT_FAILURE;
+    }
+#endif
+
+#ifdef ITK_USE_FFTWD
+  if( PlanCacheTest< double >() == EXIT_FAILURE )
+    {
+    std::cerr << "Test failed for double." << std::endl;
+    testStatus = EXIT_FAILURE;
+    }
+#endif
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTTest.h"
+#include "itkNativeComplexToComplexFFTImageFilter.h"
+#include "itkNativeFFTImageFilterFactory.h"
+#include "itkTestingMacros.h"
+
+// Test the native FFT filters with the round trip of the forward and
+// inverse transforms, including sizes with prime factors greater than
+// 5, compare the forward transform with the VNL one, compare the
+// complex to complex transform of a size transformed with the
+// Bluestein algorithm with a direct computation of the DFT, and check
+// that the factory selects the native filters.
+
+namespace
+{
+
+template< typename TPixel, unsigned int VDimension >
+int
+NativeRoundTrip( unsigned int * sizeOfDimensions, const char * name )
+{
+  using RealImageType = itk::Image< TPixel, VDimension >;
+  using ComplexImageType = itk::Image< std::complex< TPixel >, VDimension >;
+  std::cerr << "Native " << name << "," << VDimension << std::endl;
+  if ( test_fft< TPixel, VDimension,
+                 itk::NativeForwardFFTImageFilter< RealImageType >,
+                 itk::NativeInverseFFTImageFilter< ComplexImageType > >( sizeOfDimensions ) != 0 )
+    {
+    std::cerr << "--------------------- Failed!" << std::endl;
+    return 1;
+    }
+  return 0;
+}
+
+template< typename TPixel, unsigned int VDimension >
+int
+NativeVersusVnl( unsigned int * sizeOfDimensions, const char * name )
+{
+  using RealImageType = itk::Image< TPixel, VDimension >;
+  std::cerr << "VnlNative " << name << "," << VDimension << std::endl;
+  if ( test_fft_rtc< TPixel, VDimension,
+                     itk::VnlForwardFFTImageFilter< RealImageType >,
+                     itk::NativeForwardFFTImageFilter< RealImageType > >( sizeOfDimensions ) != 0 )
+    {
+    std::cerr << "--------------------- Failed!" << std::endl;
+    return 1;
+    }
+  return 0;
+}
+
+template< typename TPixel >
+int
+NativeComplexToComplexDFT( unsigned int size, double tolerance )
+{
+  using ComplexType = std::complex< TPixel >;
+  using ImageType = itk::Image< ComplexType, 1 >;
+  typename ImageType::Pointer image = ImageType::New();
+  typename ImageType::SizeType imageSize;
+  imageSize[0] = size;
+  image->SetRegions( imageSize );
+  image->Allocate();
+  vnl_sample_reseed( 1234 );
+  for ( unsigned int t = 0; t < size; ++t )
+    {
+    image->GetBufferPointer()[t] = ComplexType( vnl_sample_uniform( -1.0, 1.0 ), vnl_sample_uniform( -1.0, 1.0 ) );
+    }
+
+  using FilterType = itk::NativeComplexToComplexFFTImageFilter< ImageType >;
+  typename FilterType::Pointer forward = FilterType::New();
+  forward->SetInput( image );
+  typename FilterType::Pointer inverse = FilterType::New();
+  inverse->SetInput( forward->GetOutput() );
+  inverse->SetTransformDirection( FilterType::INVERSE );
+  TRY_EXPECT_NO_EXCEPTION( inverse->Update() );
+
+  const ComplexType * in = image->GetBufferPointer();
+  const ComplexType * out = forward->GetOutput()->GetBufferPointer();
+  const ComplexType * back = inverse->GetOutput()->GetBufferPointer();
+  for ( unsigned int k = 0; k < size; ++k )
+    {
+    std::complex< double > expected( 0.0, 0.0 );
+    for ( unsigned int t = 0; t < size; ++t )
+      {
+      const double angle = -2.0 * itk::Math::pi * static_cast< double >( ( k * t ) % size ) / size;
+      expected += std::complex< double >( in[t] ) * std::complex< double >( std::cos( angle ), std::sin( angle ) );
+      }
+    if ( std::abs( std::complex< double >( out[k] ) - expected ) > tolerance * size
+         || std::abs( back[k] - in[k] ) > tolerance )
+      {
+      std::cerr << "Wrong value at " << k << " for size " << size << ": " << out[k] << " expected " << expected
+                << ", " << back[k] << " expected " << in[k] << std::endl;
+      return 1;
+      }
+    }
+  return 0;
+}
+
+}
+
+int itkNativeFFTTest(int, char *[])
+{
+  unsigned int SizeOfDimensions1[] = { 4,4,4,4 };
+  unsigned int SizeOfDimensions2[] = { 3,5,4 };
+  unsigned int SizeOfDimensions3[] = { 7,6,4 };
+  unsigned int SizeOfDimensions4[] = { 17,31,11 };
+  int rval = 0;
+
+  rval += NativeRoundTrip< float, 1 >( SizeOfDimensions1, "float" );
+  rval += NativeRoundTrip< float, 2 >( SizeOfDimensions1, "float" );
+  rval += NativeRoundTrip< float, 3 >( SizeOfDimensions1, "float" );
+  rval += NativeRoundTrip< float, 4 >( SizeOfDimensions1, "float" );
+  rval += NativeRoundTrip< double, 1 >( SizeOfDimensions1, "double" );
+  rval += NativeRoundTrip< double, 2 >( SizeOfDimensions1, "double" );
+  rval += NativeRoundTrip< double, 3 >( SizeOfDimensions1, "double" );
+
+  // Any size is supported
+  for ( unsigned int * sizeOfDimensions : { SizeOfDimensions2, SizeOfDimensions3, SizeOfDimensions4 } )
+    {
+    rval += NativeRoundTrip< float, 1 >( sizeOfDimensions, "float" );
+    rval += NativeRoundTrip< float, 2 >( sizeOfDimensions, "float" );
+    rval += NativeRoundTrip< float, 3 >( sizeOfDimensions, "float" );
+    rval += NativeRoundTrip< double, 1 >( sizeOfDimensions, "double" );
+    rval += NativeRoundTrip< double, 2 >( sizeOfDimensions, "double" );
+    rval += NativeRoundTrip< double, 3 >( sizeOfDimensions, "double" );
+    }
+
+  for ( unsigned int * sizeOfDimensions : { SizeOfDimensions1, SizeOfDimensions2 } )
+    {
+    rval += NativeVersusVnl< float, 1 >( sizeOfDimensions, "float" );
+    rval += NativeVersusVnl< float, 2 >( sizeOfDimensions, "float" );
+    rval += NativeVersusVnl< float, 3 >( sizeOfDimensions, "float" );
+    rval += NativeVersusVnl< double, 1 >( sizeOfDimensions, "double" );
+    rval += NativeVersusVnl< double, 2 >( sizeOfDimensions, "double" );
+    rval += NativeVersusVnl< double, 3 >( sizeOfDimensions, "double" );
+    }
+
+  // 17 and 101 are transformed with the Bluestein algorithm
+  for ( unsigned int size : { 1, 12, 17, 101 } )
+    {
+    rval += NativeComplexToComplexDFT< float >( size, 1e-5 );
+    rval += NativeComplexToComplexDFT< double >( size, 1e-12 );
+    }
+
+  // The factory selects the native filters
+  itk::NativeFFTImageFilterFactory::RegisterOneFactory();
+  using ImageType = itk::Image< float, 3 >;
+  using ComplexImageType = itk::Image< std::complex< float >, 3 >;
+  using ForwardFilterType = itk::ForwardFFTImageFilter< ImageType >;
+  ForwardFilterType::Pointer forward = ForwardFilterType::New();
+  TEST_EXPECT_EQUAL( std::string( forward->GetNameOfClass() ), std::string( "NativeForwardFFTImageFilter" ) );
+  TEST_EXPECT_EQUAL( forward->GetSizeGreatestPrimeFactor(), 5 );
+  using InverseFilterType = itk::InverseFFTImageFilter< ComplexImageType >;
+  InverseFilterType::Pointer inverse = InverseFilterType::New();
+  TEST_EXPECT_EQUAL( std::string( inverse->GetNameOfClass() ), std::string( "NativeInverseFFTImageFilter" ) );
+  using ComplexFilterType = itk::ComplexToComplexFFTImageFilter< ComplexImageType >;
+  ComplexFilterType::Pointer complexFilter = ComplexFilterType::New();
+  TEST_EXPECT_EQUAL( std::string( complexFilter->GetNameOfClass() ),
+                     std::string( "NativeComplexToComplexFFTImageFilter" ) );
+
+  return (rval == 0) ? 0 : -1;
+}
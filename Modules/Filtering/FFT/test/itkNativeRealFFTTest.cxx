@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRealFFTTest.h"
+#include "itkNativeHalfHermitianToRealInverseFFTImageFilter.h"
+#include "itkNativeRealToHalfHermitianForwardFFTImageFilter.h"
+
+// Test the native half Hermitian FFT filters with the round trip of
+// the forward and inverse transforms, for even and odd sizes including
+// prime factors greater than 5, and compare the forward transform with
+// the VNL one.
+
+namespace
+{
+
+template< typename TPixel, unsigned int VDimension >
+int
+NativeRealRoundTrip( unsigned int * sizeOfDimensions, const char * name )
+{
+  using RealImageType = itk::Image< TPixel, VDimension >;
+  using ComplexImageType = itk::Image< std::complex< TPixel >, VDimension >;
+  std::cerr << "Native " << name << "," << VDimension << std::endl;
+  if ( test_fft< TPixel, VDimension,
+                 itk::NativeRealToHalfHermitianForwardFFTImageFilter< RealImageType >,
+                 itk::NativeHalfHermitianToRealInverseFFTImageFilter< ComplexImageType > >( sizeOfDimensions ) != 0 )
+    {
+    std::cerr << "--------------------- Failed!" << std::endl;
+    return 1;
+    }
+  return 0;
+}
+
+template< typename TPixel, unsigned int VDimension >
+int
+NativeRealVersusVnl( unsigned int * sizeOfDimensions, const char * name )
+{
+  using RealImageType = itk::Image< TPixel, VDimension >;
+  std::cerr << "VnlNative " << name << "," << VDimension << std::endl;
+  if ( test_fft_rtc< TPixel, VDimension,
+                     itk::VnlRealToHalfHermitianForwardFFTImageFilter< RealImageType >,
+                     itk::NativeRealToHalfHermitianForwardFFTImageFilter< RealImageType > >( sizeOfDimensions ) != 0 )
+    {
+    std::cerr << "--------------------- Failed!" << std::endl;
+    return 1;
+    }
+  return 0;
+}
+
+}
+
+int itkNativeRealFFTTest(int, char *[])
+{
+  unsigned int SizeOfDimensions1[] = { 4,4,4,4 };
+  unsigned int SizeOfDimensions2[] = { 3,5,4 };
+  unsigned int SizeOfDimensions3[] = { 7,6,4 };
+  unsigned int SizeOfDimensions4[] = { 17,31,11 };
+  int rval = 0;
+
+  rval += NativeRealRoundTrip< float, 1 >( SizeOfDimensions1, "float" );
+  rval += NativeRealRoundTrip< float, 2 >( SizeOfDimensions1, "float" );
+  rval += NativeRealRoundTrip< float, 3 >( SizeOfDimensions1, "float" );
+  rval += NativeRealRoundTrip< float, 4 >( SizeOfDimensions1, "float" );
+  rval += NativeRealRoundTrip< double, 1 >( SizeOfDimensions1, "double" );
+  rval += NativeRealRoundTrip< double, 2 >( SizeOfDimensions1, "double" );
+  rval += NativeRealRoundTrip< double, 3 >( SizeOfDimensions1, "double" );
+
+  // Any size is supported
+  for ( unsigned int * sizeOfDimensions : { SizeOfDimensions2, SizeOfDimensions3, SizeOfDimensions4 } )
+    {
+    rval += NativeRealRoundTrip< float, 1 >( sizeOfDimensions, "float" );
+    rval += NativeRealRoundTrip< float, 2 >( sizeOfDimensions, "float" );
+    rval += NativeRealRoundTrip< float, 3 >( sizeOfDimensions, "float" );
+    rval += NativeRealRoundTrip< double, 1 >( sizeOfDimensions, "double" );
+    rval += NativeRealRoundTrip< double, 2 >( sizeOfDimensions, "double" );
+    rval += NativeRealRoundTrip< double, 3 >( sizeOfDimensions, "double" );
+    }
+
+  for ( unsigned int * sizeOfDimensions : { SizeOfDimensions1, SizeOfDimensions2 } )
+    {
+    rval += NativeRealVersusVnl< float, 1 >( sizeOfDimensions, "float" );
+    rval += NativeRealVersusVnl< float, 2 >( sizeOfDimensions, "float" );
+    rval += NativeRealVersusVnl< float, 3 >( sizeOfDimensions, "float" );
+    rval += NativeRealVersusVnl< double, 1 >( sizeOfDimensions, "double" );
+    rval += NativeRealVersusVnl< double, 2 >( sizeOfDimensions, "double" );
+    rval += NativeRealVersusVnl< double, 3 >( sizeOfDimensions, "double" );
+    }
+
+  return (rval == 0) ? 0 : -1;
+}
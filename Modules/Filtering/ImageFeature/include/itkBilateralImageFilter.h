@@ -23,6 +23,8 @@
 #include "itkNeighborhoodIterator.h"
 #include "itkNeighborhood.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -52,6 +54,32 @@ namespace itk
  * Manduchi (Bilateral Filtering for Gray and ColorImages. IEEE
  * ICCV. 1998.)
  *
+ * The exact implementation evaluates both Gaussians over the whole
+ * neighborhood of each pixel, so its cost grows as the power
+ * ImageDimension of the domain sigma. The bilateral grid implementation,
+ * selected with SetImplementationToBilateralGrid(), approximates the
+ * filter in a time nearly linear in the number of pixels, whatever the
+ * domain sigma (Paris and Durand, A Fast Approximation of the Bilateral
+ * Filter using a Signal Processing Approach. ECCV. 2006; Chen, Paris and
+ * Durand, Real-time Edge-Aware Image Processing with the Bilateral
+ * Grid. SIGGRAPH. 2007). The input pixels are splatted with multilinear
+ * weights in a grid of ImageDimension + 1 dimensions, whose cells are
+ * the domain and range sigmas divided by GridSamplingRate. The grid is
+ * smoothed with a separable Gaussian, so that with the interpolation the
+ * kernel has the variances of the domain and range Gaussians, and the
+ * output is interpolated in the grid at the position and value of each
+ * pixel. The pixels outside the image are ignored instead of being
+ * replaced by the nearest pixel of the image, and the Gaussians are
+ * truncated at three sigmas in the grid. With the default GridSamplingRate of 2, the mean absolute
+ * difference with the exact implementation on noisy smooth images with
+ * edges is below one percent of RangeSigma away from the boundaries of
+ * the image, and a few times as large with a rate of 1. It is larger
+ * within a few domain sigmas of the boundaries. The grid depends on the
+ * requested region, so streaming changes the output slightly. The grid
+ * has about GridSamplingRate / domain sigma nodes per pixel along each
+ * dimension of the image, and GridSamplingRate * dynamic range /
+ * RangeSigma nodes along the range, of 8 bytes each.
+ *
  * \sa GaussianOperator
  * \sa RecursiveGaussianImageFilter
  * \sa DiscreteGaussianImageFilter
@@ -127,6 +155,28 @@ public:
   /** Gaussian image type */
   using GaussianImageType = Image< double, Self::ImageDimension >;
 
+  /** Implementations of the filter: the exact evaluation of the Gaussians
+   * over the neighborhood of each pixel, or the approximation with a
+   * bilateral grid. */
+  enum class ImplementationEnum : uint8_t
+  {
+    EXACT = 0,
+    BILATERAL_GRID
+  };
+
+  /** Print the name of an implementation */
+  friend std::ostream & operator<<(std::ostream & os, const ImplementationEnum implementation)
+  {
+    switch ( implementation )
+      {
+      case ImplementationEnum::EXACT:
+        return os << "EXACT";
+      case ImplementationEnum::BILATERAL_GRID:
+        return os << "BILATERAL_GRID";
+      }
+    return os << static_cast< int >( implementation );
+  }
+
   /** Standard get/set macros for filter parameters.
    * DomainSigma is specified in the same units as the Image spacing.
    * RangeSigma is specified in the units of intensity. */
@@ -168,6 +218,21 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  /** Set/Get the implementation of the filter. Default is EXACT. */
+  itkSetEnumMacro(Implementation, ImplementationEnum);
+  itkGetEnumMacro(Implementation, ImplementationEnum);
+  void SetImplementationToExact()
+  { this->SetImplementation(ImplementationEnum::EXACT); }
+  void SetImplementationToBilateralGrid()
+  { this->SetImplementation(ImplementationEnum::BILATERAL_GRID); }
+
+  /** Set/Get the number of cells of the bilateral grid per domain and
+   * range sigma. Higher rates are more accurate, but slower and use more
+   * memory. Cells are never smaller than a pixel in the image domain.
+   * Default is 2. */
+  itkSetClampMacro(GridSamplingRate, double, 0.5, NumericTraits< double >::max());
+  itkGetConstMacro(GridSamplingRate, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputHasNumericTraitsCheck,
@@ -192,6 +257,9 @@ protected:
    * filter. */
   void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Release the bilateral grid */
+  void AfterThreadedGenerateData() override;
+
   /** BilateralImageFilter needs a larger input requested region than
    * the output requested region (larger by the size of the domain
    * Gaussian kernel).  As such, BilateralImageFilter needs to provide
@@ -201,6 +269,19 @@ protected:
   void GenerateInputRequestedRegion() override;
 
 private:
+  /** Type of the values of the bilateral grid */
+  using GridValueType = float;
+
+  /** Fill and smooth the bilateral grid of the input requested region */
+  void ComputeBilateralGrid();
+
+  /** Interpolate the output in the bilateral grid */
+  void SliceBilateralGrid(const OutputImageRegionType & outputRegionForThread);
+
+  /** Smooth the grid along one of its dimensions with a Gaussian of the
+   * given standard deviation, in cells */
+  void SmoothBilateralGrid(unsigned int direction, double sigma);
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma;
@@ -227,6 +308,23 @@ private:
   double                m_DynamicRange;
   double                m_DynamicRangeUsed;
   std::vector< double > m_RangeGaussianTable;
+
+  ImplementationEnum m_Implementation;
+  double             m_GridSamplingRate;
+
+  /** Bilateral grid of the input requested region. Each node holds the
+   * weighted sum of the pixel values, less the grid minimum, and the sum
+   * of the weights. Its first ImageDimension dimensions are the image
+   * domain, with cells of m_GridCellSize pixels, and the last one is the
+   * range, with cells of m_GridCellSize[ImageDimension] intensities.
+   * m_GridPadding nodes are added before and after the data. */
+  std::vector< GridValueType >                         m_Grid;
+  FixedArray< SizeValueType, Self::ImageDimension + 1 > m_GridSize;
+  FixedArray< SizeValueType, Self::ImageDimension + 1 > m_GridStrides;
+  FixedArray< SizeValueType, Self::ImageDimension + 1 > m_GridPadding;
+  FixedArray< double, Self::ImageDimension + 1 >        m_GridCellSize;
+  typename InputImageType::IndexType                   m_GridIndex;
+  double                                               m_GridMinimum;
 };
 } // end namespace itk
 
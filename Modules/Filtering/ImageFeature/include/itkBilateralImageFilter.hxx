@@ -20,12 +20,15 @@
 
 #include "itkBilateralImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkGaussianImageSource.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
 
+#include <algorithm>
+
 namespace itk
 {
 template< typename TInputImage, typename TOutputImage >
@@ -43,6 +46,14 @@ BilateralImageFilter< TInputImage, TOutputImage >
   this->m_DomainMu = 2.5;  // keep small to keep kernels small
   this->m_RangeMu = 4.0;   // can be bigger then DomainMu since we only
                            // index into a single table
+  this->m_Implementation = ImplementationEnum::EXACT;
+  this->m_GridSamplingRate = 2.0;
+  this->m_GridSize.Fill(0);
+  this->m_GridStrides.Fill(0);
+  this->m_GridPadding.Fill(0);
+  this->m_GridCellSize.Fill(1.0);
+  this->m_GridIndex.Fill(0);
+  this->m_GridMinimum = 0.0;
   this->DynamicMultiThreadingOn();
 }
 
@@ -129,6 +140,12 @@ void
 BilateralImageFilter< TInputImage, TOutputImage >
 ::BeforeThreadedGenerateData()
 {
+  if ( m_Implementation == ImplementationEnum::BILATERAL_GRID )
+    {
+    this->ComputeBilateralGrid();
+    return;
+    }
+
   // Build a small image of the N-dimensional Gaussian used for domain filter
   //
   // Gaussian image size will be (2*std::ceil(2.5*sigma)+1) x
@@ -248,6 +265,12 @@ void
 BilateralImageFilter< TInputImage, TOutputImage >
 ::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
+  if ( m_Implementation == ImplementationEnum::BILATERAL_GRID )
+    {
+    this->SliceBilateralGrid(outputRegionForThread);
+    return;
+    }
+
   typename TInputImage::ConstPointer input = this->GetInput();
   typename TOutputImage::Pointer output = this->GetOutput();
   typename TInputImage::IndexValueType i;
@@ -334,6 +357,317 @@ BilateralImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::AfterThreadedGenerateData()
+{
+  std::vector< GridValueType >().swap(m_Grid);
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::ComputeBilateralGrid()
+{
+  if ( m_RangeSigma <= 0.0 )
+    {
+    itkExceptionMacro( "RangeSigma must be positive, but is " << m_RangeSigma );
+    }
+
+  const InputImageType *                    input = this->GetInput();
+  const typename InputImageType::RegionType region = input->GetRequestedRegion();
+
+  // Dynamic range of the pixels of the grid
+  typename StatisticsImageFilter< TInputImage >::Pointer statistics =
+    StatisticsImageFilter< TInputImage >::New();
+  statistics->SetInput(input);
+  statistics->GetOutput()->SetRequestedRegion(region);
+  statistics->Update();
+  m_GridMinimum = static_cast< double >( statistics->GetMinimum() );
+  m_DynamicRange = static_cast< double >( statistics->GetMaximum() ) - m_GridMinimum;
+  m_DynamicRangeUsed = m_DynamicRange;
+
+  // The multilinear splatting and interpolation each add a variance of
+  // 1/6 squared cell to the Gaussians, except in the dimensions where the
+  // cells are the pixels, so the grid is smoothed with the remaining
+  // variance. The grid is padded so that the smoothing needs no boundary
+  // condition.
+  FixedArray< double, ImageDimension + 1 > sigmas;
+  for ( unsigned int d = 0; d <= ImageDimension; ++d )
+    {
+    double extent;
+    double sigma;
+    if ( d < ImageDimension )
+      {
+      sigma = m_DomainSigma[d] / input->GetSpacing()[d];
+      m_GridCellSize[d] = std::max(sigma / m_GridSamplingRate, 1.0);
+      extent = static_cast< double >( region.GetSize(d) - 1 );
+      }
+    else
+      {
+      sigma = m_RangeSigma;
+      m_GridCellSize[d] = sigma / m_GridSamplingRate;
+      extent = m_DynamicRange;
+      }
+    const double interpolationVariance = ( m_GridCellSize[d] > 1.0 || d == ImageDimension ) ? 1.0 / 3.0 : 0.0;
+    sigmas[d] = std::sqrt( std::max( Math::sqr( sigma / m_GridCellSize[d] ) - interpolationVariance, 0.0 ) );
+    m_GridPadding[d] = static_cast< SizeValueType >( std::ceil( 3.0 * sigmas[d] ) );
+    m_GridSize[d] = static_cast< SizeValueType >( std::floor( extent / m_GridCellSize[d] ) ) + 2 + 2 * m_GridPadding[d];
+    }
+
+  // Each node holds two values
+  SizeValueType numberOfValues = 2;
+  for ( unsigned int d = 0; d <= ImageDimension; ++d )
+    {
+    m_GridStrides[d] = numberOfValues;
+    numberOfValues *= m_GridSize[d];
+    }
+  m_Grid.assign(numberOfValues, NumericTraits< GridValueType >::ZeroValue());
+  m_GridIndex = region.GetIndex();
+
+  // Splat the pixels by slabs of cells along the last dimension. The
+  // pixels of a slab only change the nodes at both ends of its cells,
+  // so the slabs of even cells, then those of odd cells, are splatted in
+  // parallel.
+  constexpr unsigned int LastDimension = ImageDimension - 1;
+  const double           lastCellSize = m_GridCellSize[LastDimension];
+  const SizeValueType    numberOfSlabs = static_cast< SizeValueType >(
+    ( region.GetSize(LastDimension) - 1 ) / lastCellSize ) + 1;
+  // First pixel of a slab, with the rounding of the splatting
+  auto slabStart = [lastCellSize](SizeValueType slab)
+    {
+      auto first = static_cast< SizeValueType >( std::ceil( slab * lastCellSize ) );
+      while ( first > 0 && static_cast< SizeValueType >( ( first - 1 ) / lastCellSize ) >= slab )
+        {
+        --first;
+        }
+      while ( static_cast< SizeValueType >( first / lastCellSize ) < slab )
+        {
+        ++first;
+        }
+      return first;
+    };
+  for ( SizeValueType parity = 0; parity < 2; ++parity )
+    {
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      ( numberOfSlabs + 1 - parity ) / 2,
+      [&](SizeValueType item)
+      {
+        const SizeValueType slab = 2 * item + parity;
+        const SizeValueType first = slabStart(slab);
+        const SizeValueType end = std::min( slabStart(slab + 1), region.GetSize(LastDimension) );
+        if ( first >= end )
+          {
+          return;
+          }
+        typename InputImageType::RegionType slabRegion = region;
+        slabRegion.SetIndex( LastDimension, region.GetIndex(LastDimension) + static_cast< IndexValueType >( first ) );
+        slabRegion.SetSize( LastDimension, end - first );
+
+        ImageScanlineConstIterator< InputImageType > it(input, slabRegion);
+        while ( !it.IsAtEnd() )
+          {
+          // Nodes and weights of the other domain dimensions
+          SizeValueType lineOffsets[1 << ( ImageDimension - 1 )];
+          double        lineWeights[1 << ( ImageDimension - 1 )];
+          lineOffsets[0] = 0;
+          lineWeights[0] = 1.0;
+          unsigned int numberOfLineNodes = 1;
+          for ( unsigned int d = 1; d < ImageDimension; ++d )
+            {
+            const double        u = ( it.GetIndex()[d] - m_GridIndex[d] ) / m_GridCellSize[d];
+            const SizeValueType node = static_cast< SizeValueType >( u ) + m_GridPadding[d];
+            const double        fraction = u - std::floor( u );
+            for ( unsigned int k = 0; k < numberOfLineNodes; ++k )
+              {
+              lineOffsets[k + numberOfLineNodes] = lineOffsets[k] + ( node + 1 ) * m_GridStrides[d];
+              lineWeights[k + numberOfLineNodes] = lineWeights[k] * fraction;
+              lineOffsets[k] += node * m_GridStrides[d];
+              lineWeights[k] *= 1.0 - fraction;
+              }
+            numberOfLineNodes *= 2;
+            }
+
+          IndexValueType x = it.GetIndex()[0] - m_GridIndex[0];
+          while ( !it.IsAtEndOfLine() )
+            {
+            const double        value = static_cast< double >( it.Get() ) - m_GridMinimum;
+            const double        u = x / m_GridCellSize[0];
+            const SizeValueType node = static_cast< SizeValueType >( u ) + m_GridPadding[0];
+            const double        fraction = u - std::floor( u );
+            const double        r = value / m_GridCellSize[ImageDimension];
+            const SizeValueType rangeNode = static_cast< SizeValueType >( r ) + m_GridPadding[ImageDimension];
+            const double        rangeFraction = r - std::floor( r );
+            const SizeValueType offset = node * m_GridStrides[0] + rangeNode * m_GridStrides[ImageDimension];
+            const SizeValueType nodeOffsets[4] = { offset, offset + m_GridStrides[0],
+                                                   offset + m_GridStrides[ImageDimension],
+                                                   offset + m_GridStrides[0] + m_GridStrides[ImageDimension] };
+            const double nodeWeights[4] = { ( 1.0 - fraction ) * ( 1.0 - rangeFraction ),
+                                            fraction * ( 1.0 - rangeFraction ),
+                                            ( 1.0 - fraction ) * rangeFraction,
+                                            fraction * rangeFraction };
+            for ( unsigned int k = 0; k < numberOfLineNodes; ++k )
+              {
+              GridValueType * lineNode = m_Grid.data() + lineOffsets[k];
+              for ( unsigned int n = 0; n < 4; ++n )
+                {
+                const double weight = lineWeights[k] * nodeWeights[n];
+                lineNode[nodeOffsets[n]] += static_cast< GridValueType >( weight * value );
+                lineNode[nodeOffsets[n] + 1] += static_cast< GridValueType >( weight );
+                }
+              }
+            ++it;
+            ++x;
+            }
+          it.NextLine();
+          }
+      },
+      nullptr);
+    }
+
+  for ( unsigned int d = 0; d <= ImageDimension; ++d )
+    {
+    this->SmoothBilateralGrid(d, sigmas[d]);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::SmoothBilateralGrid(unsigned int direction, double sigma)
+{
+  const auto radius = static_cast< SizeValueType >( m_GridPadding[direction] );
+  if ( radius == 0 )
+    {
+    return;
+    }
+  std::vector< GridValueType > kernel(2 * radius + 1);
+  double                       sum = 0.0;
+  for ( SizeValueType k = 0; k < kernel.size(); ++k )
+    {
+    const double distance = static_cast< double >( k ) - static_cast< double >( radius );
+    kernel[k] = static_cast< GridValueType >( std::exp( -0.5 * distance * distance / ( sigma * sigma ) ) );
+    sum += kernel[k];
+    }
+  for ( auto & weight : kernel )
+    {
+    weight = static_cast< GridValueType >( weight / sum );
+    }
+
+  // The grid is a sequence of blocks of length planes of inner values.
+  // The planes are split in chunks of contiguous values, which are
+  // smoothed together.
+  constexpr SizeValueType MaximumChunkLength = 512;
+  const SizeValueType     inner = m_GridStrides[direction];
+  const SizeValueType     length = m_GridSize[direction];
+  const SizeValueType     outer = m_Grid.size() / ( inner * length );
+  const SizeValueType     chunkLength = std::min( inner, MaximumChunkLength );
+  const SizeValueType     chunksPerPlane = ( inner + chunkLength - 1 ) / chunkLength;
+  const SizeValueType     blocksPerItem = std::max( 4 * MaximumChunkLength / ( chunkLength * length ),
+                                                    SizeValueType( 1 ) );
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    chunksPerPlane * ( ( outer + blocksPerItem - 1 ) / blocksPerItem ),
+    [&](SizeValueType item)
+    {
+      const SizeValueType          chunkStart = ( item % chunksPerPlane ) * chunkLength;
+      const SizeValueType          chunkSize = std::min( chunkStart + chunkLength, inner ) - chunkStart;
+      const SizeValueType          firstBlock = ( item / chunksPerPlane ) * blocksPerItem;
+      const SizeValueType          lastBlock = std::min( firstBlock + blocksPerItem, outer );
+      std::vector< GridValueType > values(length * chunkSize);
+      for ( SizeValueType block = firstBlock; block < lastBlock; ++block )
+        {
+        GridValueType * blockValues = m_Grid.data() + block * inner * length + chunkStart;
+        for ( SizeValueType j = 0; j < length; ++j )
+          {
+          std::copy(blockValues + j * inner, blockValues + j * inner + chunkSize, values.data() + j * chunkSize);
+          }
+        for ( SizeValueType j = 0; j < length; ++j )
+          {
+          GridValueType * smoothed = blockValues + j * inner;
+          std::fill(smoothed, smoothed + chunkSize, NumericTraits< GridValueType >::ZeroValue());
+          const SizeValueType kernelStart = j < radius ? radius - j : 0;
+          const SizeValueType kernelEnd = std::min( 2 * radius + 1, length + radius - j );
+          for ( SizeValueType k = kernelStart; k < kernelEnd; ++k )
+            {
+            const GridValueType   weight = kernel[k];
+            const GridValueType * neighbor = values.data() + ( j + k - radius ) * chunkSize;
+            for ( SizeValueType i = 0; i < chunkSize; ++i )
+              {
+              smoothed[i] += weight * neighbor[i];
+              }
+            }
+          }
+        }
+    },
+    nullptr);
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+BilateralImageFilter< TInputImage, TOutputImage >
+::SliceBilateralGrid(const OutputImageRegionType & outputRegionForThread)
+{
+  constexpr unsigned int NumberOfNodes = 1 << ( ImageDimension + 1 );
+
+  ImageScanlineConstIterator< InputImageType > it(this->GetInput(), outputRegionForThread);
+  ImageScanlineIterator< OutputImageType >     outIt(this->GetOutput(), outputRegionForThread);
+  while ( !it.IsAtEnd() )
+    {
+    IndexValueType x = it.GetIndex()[0] - m_GridIndex[0];
+    while ( !it.IsAtEndOfLine() )
+      {
+      // Multilinear interpolation of the sums in the grid, at the
+      // position and value of the pixel
+      double position[ImageDimension + 1];
+      position[0] = x / m_GridCellSize[0];
+      for ( unsigned int d = 1; d < ImageDimension; ++d )
+        {
+        position[d] = ( it.GetIndex()[d] - m_GridIndex[d] ) / m_GridCellSize[d];
+        }
+      position[ImageDimension] = ( static_cast< double >( it.Get() ) - m_GridMinimum ) / m_GridCellSize[ImageDimension];
+      SizeValueType offset = 0;
+      double        fractions[ImageDimension + 1];
+      for ( unsigned int d = 0; d <= ImageDimension; ++d )
+        {
+        fractions[d] = position[d] - std::floor( position[d] );
+        offset += ( static_cast< SizeValueType >( position[d] ) + m_GridPadding[d] ) * m_GridStrides[d];
+        }
+      double sum = 0.0;
+      double weightSum = 0.0;
+      for ( unsigned int n = 0; n < NumberOfNodes; ++n )
+        {
+        double        weight = 1.0;
+        SizeValueType nodeOffset = offset;
+        for ( unsigned int d = 0; d <= ImageDimension; ++d )
+          {
+          if ( n & ( 1u << d ) )
+            {
+            weight *= fractions[d];
+            nodeOffset += m_GridStrides[d];
+            }
+          else
+            {
+            weight *= 1.0 - fractions[d];
+            }
+          }
+        sum += weight * m_Grid[nodeOffset];
+        weightSum += weight * m_Grid[nodeOffset + 1];
+        }
+      // The pixel itself is in the grid, so the weights are positive
+      outIt.Set( static_cast< OutputPixelType >( sum / weightSum + m_GridMinimum ) );
+      ++it;
+      ++outIt;
+      ++x;
+      }
+    it.NextLine();
+    outIt.NextLine();
+    }
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 BilateralImageFilter< TInputImage, TOutputImage >
@@ -349,6 +683,8 @@ BilateralImageFilter< TInputImage, TOutputImage >
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Implementation: " << m_Implementation << std::endl;
+  os << indent << "GridSamplingRate: " << m_GridSamplingRate << std::endl;
 }
 } // end namespace itk
 
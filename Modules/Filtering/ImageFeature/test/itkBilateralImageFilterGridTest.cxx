@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Compare the bilateral grid implementation with the exact one on a
+// noisy image with a smooth gradient and a sharp edge, with an
+// anisotropic spacing, for several grid sampling rates and through a
+// StreamingImageFilter.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using PixelType = short;
+using ImageType = itk::Image< PixelType, Dimension >;
+using RealImageType = itk::Image< float, Dimension >;
+using FilterType = itk::BilateralImageFilter< ImageType, RealImageType >;
+
+RealImageType::Pointer
+Filter( FilterType * filter, unsigned int numberOfStreamDivisions )
+{
+  using StreamingFilterType = itk::StreamingImageFilter< RealImageType, RealImageType >;
+  StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  RealImageType::Pointer output = streamer->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+double
+MeanAbsoluteDifference( const RealImageType * image1, const RealImageType * image2,
+                        const RealImageType::RegionType & region )
+{
+  double                                                  sum = 0.0;
+  itk::ImageRegionConstIteratorWithIndex< RealImageType > it( image1, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    sum += std::abs( it.Get() - image2->GetPixel( it.GetIndex() ) );
+    }
+  return sum / region.GetNumberOfPixels();
+}
+
+}
+
+int itkBilateralImageFilterGridTest( int, char *[] )
+{
+  ImageType::IndexType index;
+  index[0] = -5;
+  index[1] = 3;
+  index[2] = 0;
+  ImageType::SizeType size;
+  size[0] = 36;
+  size[1] = 30;
+  size[2] = 14;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 1.0;
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 2024 );
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( ImageType::RegionType( index, size ) );
+  image->SetSpacing( spacing );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const double edge = it.GetIndex()[0] + it.GetIndex()[2] > 8 ? 400.0 : 0.0;
+    it.Set( static_cast< PixelType >( 1000.0 + 3.0 * it.GetIndex()[1] + edge + generator->GetNormalVariate( 0.0, 60.0 ) ) );
+    }
+
+  const double rangeSigma = 60.0;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetDomainSigma( 1.5 );
+  filter->SetRangeSigma( rangeSigma );
+  TEST_SET_GET_VALUE( FilterType::ImplementationEnum::EXACT, filter->GetImplementation() );
+  TEST_SET_GET_VALUE( 2.0, filter->GetGridSamplingRate() );
+  RealImageType::Pointer exact = Filter( filter, 1 );
+
+  filter->SetImplementationToBilateralGrid();
+  TEST_SET_GET_VALUE( FilterType::ImplementationEnum::BILATERAL_GRID, filter->GetImplementation() );
+  RealImageType::Pointer grid = Filter( filter, 1 );
+  TEST_EXPECT_EQUAL( grid->GetBufferedRegion(), image->GetBufferedRegion() );
+  // Near the boundaries, the exact implementation replaces the pixels
+  // outside the image with the nearest pixel of the image, while the
+  // grid ignores them
+  const RealImageType::RegionType region = image->GetBufferedRegion();
+  RealImageType::RegionType       interior = region;
+  RealImageType::SizeType         radius;
+  radius[0] = 8;
+  radius[1] = 8;
+  radius[2] = 4;
+  interior.ShrinkByRadius( radius );
+  const double difference = MeanAbsoluteDifference( exact, grid, interior );
+  const double boundaryDifference = MeanAbsoluteDifference( exact, grid, region );
+  std::cout << "Mean absolute difference with rate 2: " << difference << ", with the boundaries: "
+            << boundaryDifference << std::endl;
+  TEST_EXPECT_TRUE( difference < 0.005 * rangeSigma );
+  TEST_EXPECT_TRUE( boundaryDifference < 0.02 * rangeSigma );
+
+  // The filter preserves the edge
+  ImageType::IndexType low = index;
+  low[0] = 2;
+  low[1] = 15;
+  low[2] = 5;
+  ImageType::IndexType high = low;
+  high[0] = 5;
+  TEST_EXPECT_TRUE( grid->GetPixel( high ) - grid->GetPixel( low ) > 200.0f );
+
+  filter->SetGridSamplingRate( 1.0 );
+  const double coarseDifference = MeanAbsoluteDifference( exact, Filter( filter, 1 ), interior );
+  std::cout << "Mean absolute difference with rate 1: " << coarseDifference << std::endl;
+  TEST_EXPECT_TRUE( coarseDifference < 0.02 * rangeSigma );
+
+  filter->SetGridSamplingRate( 0.1 );
+  TEST_SET_GET_VALUE( 0.5, filter->GetGridSamplingRate() );
+  filter->SetGridSamplingRate( 2.0 );
+  const double streamedDifference = MeanAbsoluteDifference( grid, Filter( filter, 4 ), region );
+  std::cout << "Mean absolute difference when streamed: " << streamedDifference << std::endl;
+  TEST_EXPECT_TRUE( streamedDifference < 0.01 * rangeSigma );
+
+  filter->SetRangeSigma( 0.0 );
+  TRY_EXPECT_EXCEPTION( filter->Update() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkVariableLengthVector.h"
+#include <type_traits>
 
 namespace itk
 {
@@ -44,6 +45,13 @@ namespace itk
  * G. Farneback & C.-F. Westin, "On Implementation of Recursive Gaussian
  * Filters", so far unpublished.
  *
+ * For images of scalar pixels, several adjacent lines are filtered
+ * together, their values being interleaved so that the recursions of
+ * the lines are computed in the lanes of the SIMD registers. The lines
+ * are read along the first dimension, or along the second dimension
+ * when filtering along the first one, so that their pixels are read in
+ * the order of the buffer.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -132,6 +140,15 @@ protected:
   void FilterDataArray(RealType *outs, const RealType *data, RealType *scratch,
                        SizeValueType ln);
 
+  /** Number of lines filtered together by FilterDataArrays(). */
+  static constexpr unsigned int NumberOfLanes = 64 / sizeof( ScalarRealType );
+
+  /** Apply the Recursive Filter to NumberOfLanes lines of scalar
+   * values. The value i of the line b is at i * NumberOfLanes + b in
+   * the arrays, which all hold ln * NumberOfLanes values. */
+  void FilterDataArrays(ScalarRealType *outs, const ScalarRealType *data, ScalarRealType *scratch,
+                        SizeValueType ln);
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -224,6 +241,11 @@ protected:
     }
 
 private:
+  /** Filter the lines of the region NumberOfLanes lines at a time, for
+   * scalar pixels, or one line at a time. */
+  void GenerateDataForLines(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void GenerateDataForLines(const OutputImageRegionType & outputRegionForThread, std::false_type);
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
@@ -21,7 +21,10 @@
 #include "itkRecursiveSeparableImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include <new>
+#include <vector>
 
 namespace itk
 {
@@ -168,6 +171,119 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     }
 }
 
+/**
+ * Apply Recursive Filter to interleaved lines
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::FilterDataArrays(ScalarRealType *outs, const ScalarRealType *data,
+                   ScalarRealType *scratch, SizeValueType ln)
+{
+  constexpr SizeValueType L = NumberOfLanes;
+
+  ScalarRealType * scratch1 = outs;
+  ScalarRealType * scratch2 = scratch;
+
+  /**
+   * Causal direction pass, initialize borders
+   */
+  for ( SizeValueType b = 0; b < L; ++b )
+    {
+    // this value is assumed to exist from the border to infinity.
+    const ScalarRealType outV1 = data[b];
+
+    scratch1[b]         = outV1       * m_N0 + outV1       * m_N1 + outV1     * m_N2 + outV1 * m_N3;
+    scratch1[L + b]     = data[L + b] * m_N0 + outV1       * m_N1 + outV1     * m_N2 + outV1 * m_N3;
+    scratch1[2 * L + b] = data[2 * L + b] * m_N0 + data[L + b] * m_N1 + outV1 * m_N2 + outV1 * m_N3;
+    scratch1[3 * L + b] = data[3 * L + b] * m_N0 + data[2 * L + b] * m_N1 + data[L + b] * m_N2 + outV1 * m_N3;
+
+    // note that the outV1 value is multiplied by the Boundary coefficients m_BNi
+    scratch1[b]         -= outV1 * m_BN1 + outV1 * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4;
+    scratch1[L + b]     -= scratch1[b] * m_D1 + outV1 * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4;
+    scratch1[2 * L + b] -= scratch1[L + b] * m_D1 + scratch1[b] * m_D2 + outV1 * m_BN3 + outV1 * m_BN4;
+    scratch1[3 * L + b] -= scratch1[2 * L + b] * m_D1 + scratch1[L + b] * m_D2 + scratch1[b] * m_D3
+                           + outV1 * m_BN4;
+    }
+
+  /**
+   * Recursively filter the rest
+   */
+  for ( SizeValueType i = 4; i < ln; i++ )
+    {
+    const ScalarRealType * x0 = data + i * L;
+    const ScalarRealType * x1 = x0 - L;
+    const ScalarRealType * x2 = x1 - L;
+    const ScalarRealType * x3 = x2 - L;
+    ScalarRealType *       y0 = scratch1 + i * L;
+    const ScalarRealType * y1 = y0 - L;
+    const ScalarRealType * y2 = y1 - L;
+    const ScalarRealType * y3 = y2 - L;
+    const ScalarRealType * y4 = y3 - L;
+    for ( SizeValueType b = 0; b < L; ++b )
+      {
+      y0[b] = x0[b] * m_N0 + x1[b] * m_N1 + x2[b] * m_N2 + x3[b] * m_N3;
+      y0[b] -= y1[b] * m_D1 + y2[b] * m_D2 + y3[b] * m_D3 + y4[b] * m_D4;
+      }
+    }
+
+  /**
+   * AntiCausal direction pass, initialize borders
+   */
+  const ScalarRealType * xn1 = data + ( ln - 1 ) * L;
+  const ScalarRealType * xn2 = data + ( ln - 2 ) * L;
+  const ScalarRealType * xn3 = data + ( ln - 3 ) * L;
+  ScalarRealType *       yn1 = scratch2 + ( ln - 1 ) * L;
+  ScalarRealType *       yn2 = scratch2 + ( ln - 2 ) * L;
+  ScalarRealType *       yn3 = scratch2 + ( ln - 3 ) * L;
+  ScalarRealType *       yn4 = scratch2 + ( ln - 4 ) * L;
+  for ( SizeValueType b = 0; b < L; ++b )
+    {
+    // this value is assumed to exist from the border to infinity.
+    const ScalarRealType outV2 = xn1[b];
+
+    yn1[b] = outV2 * m_M1 + outV2 * m_M2 + outV2 * m_M3 + outV2 * m_M4;
+    yn2[b] = xn1[b] * m_M1 + outV2 * m_M2 + outV2 * m_M3 + outV2 * m_M4;
+    yn3[b] = xn2[b] * m_M1 + xn1[b] * m_M2 + outV2 * m_M3 + outV2 * m_M4;
+    yn4[b] = xn3[b] * m_M1 + xn2[b] * m_M2 + xn1[b] * m_M3 + outV2 * m_M4;
+
+    // note that the outV2 value is multiplied by the Boundary coefficients m_BMi
+    yn1[b] -= outV2 * m_BM1 + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4;
+    yn2[b] -= yn1[b] * m_D1 + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4;
+    yn3[b] -= yn2[b] * m_D1 + yn1[b] * m_D2 + outV2 * m_BM3 + outV2 * m_BM4;
+    yn4[b] -= yn3[b] * m_D1 + yn2[b] * m_D2 + yn1[b] * m_D3 + outV2 * m_BM4;
+    }
+
+  /**
+   * Recursively filter the rest
+   */
+  for ( SizeValueType i = ln - 4; i > 0; i-- )
+    {
+    const ScalarRealType * x0 = data + i * L;
+    const ScalarRealType * x1 = x0 + L;
+    const ScalarRealType * x2 = x1 + L;
+    const ScalarRealType * x3 = x2 + L;
+    ScalarRealType *       y0 = scratch2 + ( i - 1 ) * L;
+    const ScalarRealType * y1 = y0 + L;
+    const ScalarRealType * y2 = y1 + L;
+    const ScalarRealType * y3 = y2 + L;
+    const ScalarRealType * y4 = y3 + L;
+    for ( SizeValueType b = 0; b < L; ++b )
+      {
+      y0[b] = x0[b] * m_M1 + x1[b] * m_M2 + x2[b] * m_M3 + x3[b] * m_M4;
+      y0[b] -= y1[b] * m_D1 + y2[b] * m_D2 + y3[b] * m_D3 + y4[b] * m_D4;
+      }
+    }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for ( SizeValueType i = 0; i < ln * L; i++ )
+    {
+    outs[i] += scratch2[i];
+    }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -262,6 +378,120 @@ template< typename TInputImage, typename TOutputImage >
 void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 ::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  this->GenerateDataForLines( outputRegionForThread,
+                              std::integral_constant< bool, std::is_same< RealType, ScalarRealType >::value
+                                                            && ( TOutputImage::ImageDimension > 1 ) >() );
+}
+
+/**
+ * Filter NumberOfLanes adjacent lines at a time
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::GenerateDataForLines(const OutputImageRegionType & outputRegionForThread, std::true_type)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+  using RegionType = ImageRegion< TInputImage::ImageDimension >;
+
+  typename TInputImage::ConstPointer inputImage( this->GetInputImage () );
+  typename TOutputImage::Pointer     outputImage( this->GetOutput() );
+
+  const unsigned int direction = this->m_Direction;
+  const SizeValueType ln = outputRegionForThread.GetSize(direction);
+
+  // The lines of a batch are adjacent along the lane direction. The
+  // region iterators then read and write the pixels of a batch in the
+  // order of the buffer.
+  const unsigned int laneDirection = ( direction == 0 ) ? 1 : 0;
+  const SizeValueType numberOfLines = outputRegionForThread.GetSize(laneDirection);
+
+  std::vector< ScalarRealType > inps( ln * NumberOfLanes, NumericTraits< ScalarRealType >::ZeroValue() );
+  std::vector< ScalarRealType > outs( ln * NumberOfLanes );
+  std::vector< ScalarRealType > scratch( ln * NumberOfLanes );
+
+  // The first pixels of the batches, one batch per line along the
+  // other directions.
+  RegionType firstsRegion = outputRegionForThread;
+  firstsRegion.SetSize(direction, 1);
+  firstsRegion.SetSize(laneDirection, 1);
+
+  ImageRegionConstIteratorWithIndex< TOutputImage > firstIterator(outputImage, firstsRegion);
+  for ( firstIterator.GoToBegin(); !firstIterator.IsAtEnd(); ++firstIterator )
+    {
+    for ( SizeValueType first = 0; first < numberOfLines; first += NumberOfLanes )
+      {
+      const SizeValueType lanes = ( numberOfLines - first < NumberOfLanes ) ? numberOfLines - first : NumberOfLanes;
+
+      typename RegionType::IndexType batchIndex = firstIterator.GetIndex();
+      batchIndex[laneDirection] += first;
+      typename RegionType::SizeType batchSize;
+      batchSize.Fill(1);
+      batchSize[direction] = ln;
+      batchSize[laneDirection] = lanes;
+      const RegionType batchRegion(batchIndex, batchSize);
+
+      ImageRegionConstIterator< TInputImage > inputIterator(inputImage, batchRegion);
+      if ( laneDirection < direction )
+        {
+        for ( SizeValueType i = 0; i < ln; ++i )
+          {
+          for ( SizeValueType b = 0; b < lanes; ++b )
+            {
+            inps[i * NumberOfLanes + b] = static_cast< ScalarRealType >( inputIterator.Get() );
+            ++inputIterator;
+            }
+          }
+        }
+      else
+        {
+        for ( SizeValueType b = 0; b < lanes; ++b )
+          {
+          for ( SizeValueType i = 0; i < ln; ++i )
+            {
+            inps[i * NumberOfLanes + b] = static_cast< ScalarRealType >( inputIterator.Get() );
+            ++inputIterator;
+            }
+          }
+        }
+
+      this->FilterDataArrays(outs.data(), inps.data(), scratch.data(), ln);
+
+      ImageRegionIterator< TOutputImage > outputIterator(outputImage, batchRegion);
+      if ( laneDirection < direction )
+        {
+        for ( SizeValueType i = 0; i < ln; ++i )
+          {
+          for ( SizeValueType b = 0; b < lanes; ++b )
+            {
+            outputIterator.Set( static_cast< OutputPixelType >( outs[i * NumberOfLanes + b] ) );
+            ++outputIterator;
+            }
+          }
+        }
+      else
+        {
+        for ( SizeValueType b = 0; b < lanes; ++b )
+          {
+          for ( SizeValueType i = 0; i < ln; ++i )
+            {
+            outputIterator.Set( static_cast< OutputPixelType >( outs[i * NumberOfLanes + b] ) );
+            ++outputIterator;
+            }
+          }
+        }
+      }
+    }
+}
+
+/**
+ * Filter one line at a time
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::GenerateDataForLines(const OutputImageRegionType & outputRegionForThread, std::false_type)
 {
   using OutputPixelType = typename TOutputImage::PixelType;
 
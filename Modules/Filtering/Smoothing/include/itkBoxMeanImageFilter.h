@@ -19,6 +19,9 @@
 #define itkBoxMeanImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
+
+#include <type_traits>
 
 namespace itk
 {
@@ -34,6 +37,11 @@ namespace itk
  * https://hdl.handle.net/1926/555
  * http://www.insight-journal.org/browse/publication/160
  *
+ * The sums over the boxes are read from a SummedAreaTable of the
+ * requested region of the input, which is computed in parallel before
+ * the threaded generation of the output, so the cost per pixel does not
+ * depend on the radius. The sums of integer pixels of at most 16 bits are
+ * exact.
  *
  * \author Richard Beare
  * \ingroup ITKSmoothing
@@ -87,9 +95,23 @@ protected:
   BoxMeanImageFilter();
   ~BoxMeanImageFilter() override = default;
 
+  /** Compute the summed area table of the input requested region. */
+  void BeforeThreadedGenerateData() override;
+
   /** Multi-thread version GenerateData. */
-  void  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+  void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Release the summed area table. */
+  void AfterThreadedGenerateData() override;
+
+private:
+  /** Type of the sums of the pixels: exact for the small integers */
+  using AccumulateType = typename std::conditional< std::is_integral< PixelType >::value && sizeof( PixelType ) <= 2,
+                                                    std::int64_t,
+                                                    typename NumericTraits< PixelType >::RealType >::type;
+  using SummedAreaTableType = SummedAreaTable< AccumulateType, InputImageDimension >;
 
+  SummedAreaTableType m_SummedAreaTable;
 };                                  // end of class
 } // end namespace itk
 
@@ -19,8 +19,7 @@
 #define itkBoxMeanImageFilter_hxx
 
 #include "itkBoxMeanImageFilter.h"
-#include "itkProgressAccumulator.h"
-#include "itkBoxUtilities.h"
+#include "itkImageRegionIterator.h"
 
 
 /*
@@ -42,53 +41,40 @@ BoxMeanImageFilter< TInputImage, TOutputImage >
   this->DynamicMultiThreadingOn();
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+BoxMeanImageFilter< TInputImage, TOutputImage >
+::BeforeThreadedGenerateData()
+{
+  const InputImageType * inputImage = this->GetInput();
+  m_SummedAreaTable.Compute( inputImage, inputImage->GetRequestedRegion(),
+                             [](const PixelType & p) { return static_cast< AccumulateType >( p ); },
+                             this->GetMultiThreader() );
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 BoxMeanImageFilter< TInputImage, TOutputImage >
 ::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
 {
-  // Accumulate type is too small
-  using AccPixType = typename NumericTraits< PixelType >::RealType;
-  using AccumImageType = Image< AccPixType, TInputImage::ImageDimension >;
+  using RealType = typename NumericTraits< PixelType >::RealType;
 
-  typename TInputImage::SizeType internalRadius;
-  for ( unsigned int i = 0; i < TInputImage::ImageDimension; i++ )
+  ImageRegionIterator< OutputImageType > it( this->GetOutput(), outputRegionForThread );
+  m_SummedAreaTable.ForEachBoxSum( outputRegionForThread, this->GetRadius(),
+                                   [&it](const AccumulateType & sum, SizeValueType numberOfPixels)
     {
-    internalRadius[i] = this->GetRadius()[i] + 1;
-    }
-
-  const InputImageType *inputImage = this->GetInput();
-  OutputImageType *     outputImage = this->GetOutput();
-  RegionType            accumRegion = outputRegionForThread;
-  accumRegion.PadByRadius(internalRadius);
-  accumRegion.Crop( inputImage->GetRequestedRegion() );
-
-  typename AccumImageType::Pointer accImage = AccumImageType::New();
-  accImage->SetRegions(accumRegion);
-  accImage->Allocate();
-
-#if defined(ITKV4_COMPATIBILITY)
-  // Dummy reporter for compatibility
-  ProgressReporter progress( this, 1, 2 * accumRegion.GetNumberOfPixels() );
-#endif
+      it.Set( static_cast< OutputPixelType >( static_cast< RealType >( sum )
+                                              / static_cast< RealType >( numberOfPixels ) ) );
+      ++it;
+    } );
+}
 
-  BoxAccumulateFunction< TInputImage, AccumImageType >(inputImage, accImage,
-                                                       accumRegion,
-                                                       accumRegion
-#if defined(ITKV4_COMPATIBILITY)
-                                                       , progress);
-#else
-                                                       );
-#endif
-  BoxMeanCalculatorFunction< AccumImageType, TOutputImage >(accImage.GetPointer(), outputImage,
-                                                            accumRegion,
-                                                            outputRegionForThread,
-                                                            this->GetRadius()
-#if defined(ITKV4_COMPATIBILITY)
-                                                            , progress);
-#else
-                                                            );
-#endif
+template< typename TInputImage, typename TOutputImage >
+void
+BoxMeanImageFilter< TInputImage, TOutputImage >
+::AfterThreadedGenerateData()
+{
+  m_SummedAreaTable.Release();
 }
 } // end namespace itk
 #endif
@@ -19,6 +19,10 @@
 #define itkBoxSigmaImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
+#include "itkVector.h"
+
+#include <type_traits>
 
 namespace itk
 {
@@ -33,6 +37,12 @@ namespace itk
  * https://hdl.handle.net/1926/555
  * http://www.insight-journal.org/browse/publication/160
  *
+ * The sums of the pixels and of their squares over the boxes are read
+ * from a SummedAreaTable of the requested region of the input, which is
+ * computed in parallel before the threaded generation of the output, so
+ * the cost per pixel does not depend on the radius. The sums of integer
+ * pixels of at most 16 bits are exact.
+ *
  * \author Gaetan Lehmann
  * \ingroup ITKSmoothing
  */
@@ -84,9 +94,26 @@ protected:
   BoxSigmaImageFilter();
   ~BoxSigmaImageFilter() override = default;
 
+  /** Compute the summed area table of the input requested region. */
+  void BeforeThreadedGenerateData() override;
+
   /** Multi-thread version GenerateData. */
   void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  /** Release the summed area table. */
+  void AfterThreadedGenerateData() override;
+
+private:
+  /** Type of the sums of the pixels and of their squares: exact for the
+   * small integers */
+  using AccumulateValueType = typename std::conditional< std::is_integral< PixelType >::value
+                                                         && sizeof( PixelType ) <= 2,
+                                                         std::int64_t,
+                                                         typename NumericTraits< PixelType >::RealType >::type;
+  using AccumulateType = Vector< AccumulateValueType, 2 >;
+  using SummedAreaTableType = SummedAreaTable< AccumulateType, InputImageDimension >;
+
+  SummedAreaTableType m_SummedAreaTable;
 }; // end of class
 } // end namespace itk
 
@@ -19,9 +19,11 @@
 #define itkBoxSigmaImageFilter_hxx
 
 #include "itkBoxSigmaImageFilter.h"
-#include "itkProgressAccumulator.h"
+#include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
-#include "itkBoxUtilities.h"
+
+#include <algorithm>
+#include <cmath>
 
 
 /*
@@ -46,51 +48,48 @@ BoxSigmaImageFilter< TInputImage, TOutputImage >
 template< typename TInputImage, typename TOutputImage >
 void
 BoxSigmaImageFilter< TInputImage, TOutputImage >
-::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+::BeforeThreadedGenerateData()
 {
-  // Accumulate type is too small
-  using AccValueType = typename itk::NumericTraits< PixelType >::RealType;
-  using AccPixType = typename itk::Vector< AccValueType, 2 >;
-  using AccumImageType = typename itk::Image< AccPixType, TInputImage::ImageDimension >;
-
-  typename TInputImage::SizeType internalRadius;
-  for ( unsigned int i = 0; i < TInputImage::ImageDimension; i++ )
+  const InputImageType * inputImage = this->GetInput();
+  m_SummedAreaTable.Compute( inputImage, inputImage->GetRequestedRegion(),
+                             [](const PixelType & p)
     {
-    internalRadius[i] = this->GetRadius()[i] + 1;
-    }
-
-  const InputImageType *inputImage = this->GetInput();
-  OutputImageType *     outputImage = this->GetOutput();
-  RegionType            accumRegion = outputRegionForThread;
-  accumRegion.PadByRadius(internalRadius);
-  accumRegion.Crop( inputImage->GetRequestedRegion() );
+      const auto     value = static_cast< AccumulateValueType >( p );
+      AccumulateType sums;
+      sums[0] = value;
+      sums[1] = value * value;
+      return sums;
+    },
+                             this->GetMultiThreader() );
+}
 
-  typename AccumImageType::Pointer accImage = AccumImageType::New();
-  accImage->SetRegions(accumRegion);
-  accImage->Allocate();
+template< typename TInputImage, typename TOutputImage >
+void
+BoxSigmaImageFilter< TInputImage, TOutputImage >
+::DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread)
+{
+  using RealType = typename NumericTraits< PixelType >::RealType;
 
-#if defined(ITKV4_COMPATIBILITY)
-  // Dummy reporter for compatibility
-  ProgressReporter progress( this, 1, 2 * accumRegion.GetNumberOfPixels() );
-#endif
+  ImageRegionIterator< OutputImageType > it( this->GetOutput(), outputRegionForThread );
+  m_SummedAreaTable.ForEachBoxSum( outputRegionForThread, this->GetRadius(),
+                                   [&it](const AccumulateType & sums, SizeValueType numberOfPixels)
+    {
+      const RealType sum = static_cast< RealType >( sums[0] );
+      const RealType squareSum = static_cast< RealType >( sums[1] );
+      const RealType count = static_cast< RealType >( numberOfPixels );
+      // The rounding errors must not make the variance negative
+      const RealType variance = std::max( ( squareSum - sum * sum / count ) / ( count - 1 ), RealType( 0 ) );
+      it.Set( static_cast< OutputPixelType >( std::sqrt( variance ) ) );
+      ++it;
+    } );
+}
 
-  BoxSquareAccumulateFunction< TInputImage, AccumImageType >(inputImage, accImage,
-                                                             accumRegion,
-                                                             accumRegion
-#if defined(ITKV4_COMPATIBILITY)
-                                                             , progress);
-#else
-                                                             );
-#endif
-  BoxSigmaCalculatorFunction< AccumImageType, TOutputImage >(accImage, outputImage,
-                                                             accumRegion,
-                                                             outputRegionForThread,
-                                                             this->GetRadius()
-#if defined(ITKV4_COMPATIBILITY)
-                                                            , progress);
-#else
-                                                            );
-#endif
+template< typename TInputImage, typename TOutputImage >
+void
+BoxSigmaImageFilter< TInputImage, TOutputImage >
+::AfterThreadedGenerateData()
+{
+  m_SummedAreaTable.Release();
 }
 } // end namespace itk
 #endif
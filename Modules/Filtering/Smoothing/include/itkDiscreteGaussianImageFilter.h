@@ -21,6 +21,9 @@
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 
+#include <type_traits>
+#include <vector>
+
 namespace itk
 {
 /**
@@ -40,14 +43,31 @@ namespace itk
  * SetUseImageSpacing is on (true, default). The variance can be set
  * independently in each dimension.
  *
- * When the Gaussian kernel is small, this filter tends to run faster than
- * itk::RecursiveGaussianImageFilter.
+ * The images of scalar pixels are smoothed in place in an internal
+ * image, one direction after the other, by batches of lines. In each
+ * direction the filter selects, from the variance, the size of the
+ * image and the accuracy required by MaximumError, the fastest of
+ * three implementations: the direct convolution with the discrete
+ * Gaussian kernel, the recursive approximation of the Gaussian of
+ * itk::RecursiveGaussianImageFilter and the multiplication of the
+ * Fourier transforms of the lines by the transfer function of the
+ * discrete Gaussian. The recursive implementation is only selected
+ * when its impulse response differs from the discrete Gaussian by no
+ * more than the direct kernel does. The selection can be forced with
+ * SetImplementation(). The images of vector pixels are always smoothed
+ * with the direct implementation, as are the images of integer output
+ * pixels when no implementation is forced: they are then cast to the
+ * output pixel type after each direction, like they always were.
+ *
+ * When the Gaussian kernel is small, the direct implementation tends to
+ * run faster than itk::RecursiveGaussianImageFilter.
  *
  * \sa GaussianOperator
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
  * \sa RecursiveGaussianImageFilter
+ * \sa SmoothingRecursiveGaussianImageFilter
  *
  * \ingroup ImageEnhancement
  * \ingroup ImageFeatureExtraction
@@ -99,6 +119,35 @@ public:
   /** Typedef of double containers */
   using ArrayType = FixedArray< double, Self::ImageDimension >;
 
+  /** Implementations of the smoothing of the images of scalar pixels */
+  enum class ImplementationEnum : uint8_t
+  {
+    AUTOMATIC = 0,
+    DIRECT,
+    RECURSIVE,
+    FFT
+  };
+
+  /** Print the name of an implementation */
+  friend std::ostream & operator<<(std::ostream & os, const ImplementationEnum implementation)
+  {
+    switch ( implementation )
+      {
+      case ImplementationEnum::AUTOMATIC:
+        return os << "AUTOMATIC";
+      case ImplementationEnum::DIRECT:
+        return os << "DIRECT";
+      case ImplementationEnum::RECURSIVE:
+        return os << "RECURSIVE";
+      case ImplementationEnum::FFT:
+        return os << "FFT";
+      }
+    return os << static_cast< int >( implementation );
+  }
+
+  /** Typedef of the implementations selected in each direction */
+  using ImplementationArrayType = FixedArray< ImplementationEnum, Self::ImageDimension >;
+
   /** The variance for the discrete Gaussian kernel.  Sets the variance
    * independently for each dimension, but
    * see also SetVariance(const double v). The default is 0.0 in each
@@ -201,6 +250,31 @@ public:
   itkSetMacro(UseImageSpacing, bool);
   itkGetConstMacro(UseImageSpacing, bool);
 
+  /** Set/Get the implementation of the smoothing of the images of scalar
+   * pixels. If set to AUTOMATIC, the fastest implementation which keeps
+   * the accuracy of the direct one is selected in each direction, but
+   * the images of integer output pixels are smoothed directly, with the
+   * intermediate results in the output pixel type. If set to DIRECT,
+   * RECURSIVE or FFT, that implementation is used in all the directions,
+   * with floating point intermediate results, but the recursive one is
+   * replaced by the direct one along the directions of less than 4
+   * pixels. Default is AUTOMATIC. */
+  itkSetEnumMacro(Implementation, ImplementationEnum);
+  itkGetEnumMacro(Implementation, ImplementationEnum);
+  void SetImplementationToAutomatic()
+  { this->SetImplementation(ImplementationEnum::AUTOMATIC); }
+  void SetImplementationToDirect()
+  { this->SetImplementation(ImplementationEnum::DIRECT); }
+  void SetImplementationToRecursive()
+  { this->SetImplementation(ImplementationEnum::RECURSIVE); }
+  void SetImplementationToFFT()
+  { this->SetImplementation(ImplementationEnum::FFT); }
+
+  /** Get the implementation used in each direction by the last
+   * execution of the filter. The directions which are not smoothed are
+   * set to DIRECT. */
+  itkGetConstReferenceMacro(SelectedImplementations, ImplementationArrayType);
+
   /** \brief Set/Get number of pieces to divide the input for the
    * internal composite pipeline. The upstream pipeline will not be
    * effected.
@@ -238,6 +312,8 @@ protected:
     m_MaximumKernelWidth = 32;
     m_UseImageSpacing = true;
     m_FilterDimensionality = ImageDimension;
+    m_Implementation = ImplementationEnum::AUTOMATIC;
+    m_SelectedImplementations.Fill(ImplementationEnum::DIRECT);
   }
 
   ~DiscreteGaussianImageFilter() override = default;
@@ -251,6 +327,54 @@ protected:
   void GenerateData() override;
 
 private:
+  /** Type of the values of the internal image: float for the float and
+   * the 8 and 16 bits integer output pixels, double otherwise. */
+  using RealValueType = typename std::conditional< std::is_same< OutputPixelValueType, float >::value
+                                                   || ( std::is_integral< OutputPixelValueType >::value
+                                                        && sizeof( OutputPixelValueType ) <= 2 ),
+                                                   float, double >::type;
+  using RealImageType = Image< RealValueType, ImageDimension >;
+
+  /** Number of lines filtered together by the direct and FFT
+   * implementations. */
+  static constexpr unsigned int NumberOfLanes = 64 / sizeof( RealValueType );
+
+  /** Smooth the images of scalar pixels in an internal image, or the
+   * images of vector pixels with a pipeline of
+   * NeighborhoodOperatorImageFilter. */
+  void GenerateDataForPixelType(const InputImageType *input, unsigned int filterDimensionality, std::true_type);
+  void GenerateDataForPixelType(const InputImageType *input, unsigned int filterDimensionality, std::false_type);
+
+  /** Select the implementation of the smoothing of lines of the given
+   * size with the given direct kernel. */
+  ImplementationEnum SelectImplementation(unsigned int direction, double variance, SizeValueType lineSize,
+                                          const std::vector< double > & kernel) const;
+
+  /** Smooth along a direction the region of the internal image, whose
+   * values are needed in the output region, with the direct kernel or
+   * with the transfer function of the discrete Gaussian. */
+  void DirectFilterDirection(RealImageType *image, const ImageRegion< ImageDimension > & region,
+                             const ImageRegion< ImageDimension > & outputRegion, unsigned int direction,
+                             const std::vector< double > & kernel) const;
+  void FFTFilterDirection(RealImageType *image, const ImageRegion< ImageDimension > & region,
+                          const ImageRegion< ImageDimension > & outputRegion, unsigned int direction,
+                          double variance, SizeValueType radius) const;
+
+  /** Call function, in parallel, with the first value, the stride
+   * between the lines and the number of lines of each batch of lines of
+   * a region along a direction, and with a work buffer. */
+  template< typename TFunction >
+  void ForEachBatch(RealImageType *image, const ImageRegion< ImageDimension > & region, unsigned int direction,
+                    TFunction function) const;
+
+  /** Radius beyond which the discrete Gaussian of the given variance is
+   * negligible. */
+  static SizeValueType ComputeNegligibleRadius(double variance);
+
+  /** Smallest size, not less than the given one, without prime factors
+   * greater than those handled by the native FFT. */
+  static SizeValueType ComputeFFTSize(SizeValueType size);
+
   /** The variance of the gaussian blurring kernel in each dimensional
     direction. */
   ArrayType m_Variance;
@@ -270,6 +394,10 @@ private:
   /** Flag to indicate whether to use image spacing */
   bool m_UseImageSpacing;
 
+  /** Implementation requested, and selected in each direction */
+  ImplementationEnum      m_Implementation;
+  ImplementationArrayType m_SelectedImplementations;
+
 };
 } // end namespace itk
 
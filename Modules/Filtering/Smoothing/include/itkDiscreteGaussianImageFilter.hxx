@@ -24,6 +24,11 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressAccumulator.h"
 #include "itkImageAlgorithm.h"
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkNativeFFTCommon.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -133,6 +138,7 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     {
     filterDimensionality = ImageDimension;
     }
+  m_SelectedImplementations.Fill(ImplementationEnum::DIRECT);
   if ( filterDimensionality == 0 )
     {
     // no smoothing, copy input to output
@@ -140,6 +146,27 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     return;
     }
 
+  // Unless an implementation is requested, the images of integer pixels
+  // are smoothed as they always were, with the result of each direction
+  // cast to the output pixel type.
+  if ( std::is_integral< OutputPixelValueType >::value && m_Implementation == ImplementationEnum::AUTOMATIC )
+    {
+    this->GenerateDataForPixelType( localInput, filterDimensionality, std::false_type() );
+    return;
+    }
+
+  this->GenerateDataForPixelType( localInput, filterDimensionality,
+                                  std::integral_constant< bool, std::is_arithmetic< InputPixelType >::value
+                                                                && std::is_arithmetic< OutputPixelType >::value >() );
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::GenerateDataForPixelType(const InputImageType *localInput, unsigned int filterDimensionality, std::false_type)
+{
+  TOutputImage * output = this->GetOutput();
+
   // Type of the pixel to use for intermediate results
   using RealOutputPixelType = typename NumericTraits< OutputPixelType >::RealType;
   using RealOutputImageType = Image< OutputPixelType, ImageDimension >;
@@ -303,6 +330,416 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::GenerateDataForPixelType(const InputImageType *localInput, unsigned int filterDimensionality, std::true_type)
+{
+  using RegionType = ImageRegion< ImageDimension >;
+
+  TOutputImage *   output = this->GetOutput();
+  const RegionType outputRegion = output->GetRequestedRegion();
+
+  // Set up the variance in pixels and the kernel of each direction
+  ArrayType                            variance = m_Variance;
+  std::vector< std::vector< double > > kernels( filterDimensionality );
+  typename RegionType::SizeType        radius;
+  radius.Fill( 0 );
+  for ( unsigned int i = 0; i < filterDimensionality; ++i )
+    {
+    if ( m_UseImageSpacing == true )
+      {
+      if ( localInput->GetSpacing()[i] == 0.0 )
+        {
+        itkExceptionMacro(<< "Pixel spacing cannot be zero");
+        }
+      // convert the variance from physical units to pixels
+      const double s = localInput->GetSpacing()[i];
+      variance[i] /= s * s;
+      }
+
+    GaussianOperator< double, ImageDimension > oper;
+    oper.SetDirection(i);
+    oper.SetVariance(variance[i]);
+    oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
+    oper.SetMaximumError(m_MaximumError[i]);
+    oper.CreateDirectional();
+
+    // The kernel is symmetric, keep its center and its second half
+    radius[i] = oper.GetRadius(i);
+    for ( SizeValueType k = 0; k <= radius[i]; ++k )
+      {
+      kernels[i].push_back( oper[radius[i] + k] );
+      }
+    }
+
+  // Copy the input region needed by the output region to an internal
+  // image, smoothed in place one direction after the other
+  RegionType region = outputRegion;
+  region.PadByRadius(radius);
+  region.Crop( localInput->GetBufferedRegion() );
+
+  typename RealImageType::Pointer image = RealImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  ImageAlgorithm::Copy( localInput, image.GetPointer(), region, region );
+
+  RegionType processRegion = region;
+  for ( unsigned int i = 0; i < filterDimensionality; ++i )
+    {
+    const SizeValueType lineSize = region.GetSize(i);
+    ImplementationEnum  implementation = m_Implementation;
+    if ( implementation == ImplementationEnum::AUTOMATIC )
+      {
+      implementation = this->SelectImplementation( i, variance[i], lineSize, kernels[i] );
+      }
+    else if ( implementation == ImplementationEnum::RECURSIVE && lineSize < 4 )
+      {
+      implementation = ImplementationEnum::DIRECT;
+      }
+    m_SelectedImplementations[i] = implementation;
+
+    if ( implementation == ImplementationEnum::RECURSIVE )
+      {
+      // The internal image has a unit spacing
+      using RecursiveFilterType = RecursiveGaussianImageFilter< RealImageType, RealImageType >;
+      typename RecursiveFilterType::Pointer recursiveFilter = RecursiveFilterType::New();
+      recursiveFilter->SetInput(image);
+      recursiveFilter->SetDirection(i);
+      recursiveFilter->SetSigma( std::sqrt( variance[i] ) );
+      recursiveFilter->SetZeroOrder();
+      recursiveFilter->SetNormalizeAcrossScale(false);
+      recursiveFilter->InPlaceOn();
+      recursiveFilter->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+      recursiveFilter->Update();
+      image = recursiveFilter->GetOutput();
+      image->DisconnectPipeline();
+      }
+    else if ( implementation == ImplementationEnum::FFT )
+      {
+      this->FFTFilterDirection( image, processRegion, outputRegion, i, variance[i],
+                                Self::ComputeNegligibleRadius( variance[i] ) );
+      }
+    else
+      {
+      this->DirectFilterDirection( image, processRegion, outputRegion, i, kernels[i] );
+      }
+
+    // The next directions only need the output region along this one
+    processRegion.SetIndex( i, outputRegion.GetIndex(i) );
+    processRegion.SetSize( i, outputRegion.GetSize(i) );
+    this->UpdateProgress( static_cast< float >( i + 1 ) / filterDimensionality );
+    }
+
+  ImageAlgorithm::Copy( image.GetPointer(), output, outputRegion, outputRegion );
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename DiscreteGaussianImageFilter< TInputImage, TOutputImage >::ImplementationEnum
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::SelectImplementation(unsigned int direction, double variance, SizeValueType lineSize,
+                       const std::vector< double > & kernel) const
+{
+  // Estimates of the time per pixel, in multiply-adds, of the
+  // convolution with the symmetric kernel, of the recursive filters and
+  // of the forward and backward transforms of the lines padded to a size
+  // without large prime factors.
+  constexpr double DirectCostOffset = 2.0;
+  constexpr double RecursiveCost = 15.0;
+  constexpr double FFTCostOffset = 2.0;
+  constexpr double FFTCostFactor = 2.5;
+  const SizeValueType negligibleRadius = Self::ComputeNegligibleRadius(variance);
+  const SizeValueType kernelRadius = kernel.size() - 1;
+  const SizeValueType fftSize = Self::ComputeFFTSize( lineSize + 2 * negligibleRadius );
+  const double directCost = DirectCostOffset + kernelRadius;
+  const double recursiveCost = RecursiveCost;
+  const double fftCost = static_cast< double >( fftSize ) / lineSize
+                         * ( FFTCostOffset + FFTCostFactor * std::log2( static_cast< double >( fftSize ) ) );
+
+  const ImplementationEnum fastest = directCost <= fftCost ? ImplementationEnum::DIRECT : ImplementationEnum::FFT;
+  if ( lineSize < 4 || recursiveCost >= std::min( directCost, fftCost ) )
+    {
+    return fastest;
+    }
+
+  // The recursive filters approximate the Gaussian: compare their
+  // impulse response and the direct kernel with the discrete Gaussian,
+  // computed from its transfer function.
+  const SizeValueType radius = std::max( kernelRadius, negligibleRadius );
+  const SizeValueType size = 2 * radius + 1;
+  std::vector< double > re( size / 2 + 1 );
+  std::vector< double > im( size / 2 + 1, 0.0 );
+  for ( SizeValueType k = 0; k < re.size(); ++k )
+    {
+    re[k] = std::exp( variance * ( std::cos( 2.0 * Math::pi * k / size ) - 1.0 ) ) / size;
+    }
+  const NativeFFTCommon::RealTransform< double > transform(size);
+  std::vector< double > work( transform.GetWorkSize(1) );
+  std::vector< double > gaussian(size);
+  transform.Backward( re.data(), im.data(), gaussian.data(), 1, work.data() );
+
+  using LineImageType = Image< double, 1 >;
+  LineImageType::Pointer impulse = LineImageType::New();
+  LineImageType::SizeType impulseSize;
+  impulseSize[0] = size;
+  impulse->SetRegions(impulseSize);
+  impulse->Allocate();
+  impulse->FillBuffer(0.0);
+  impulse->GetBufferPointer()[radius] = 1.0;
+
+  using LineFilterType = RecursiveGaussianImageFilter< LineImageType, LineImageType >;
+  LineFilterType::Pointer lineFilter = LineFilterType::New();
+  lineFilter->SetInput(impulse);
+  lineFilter->SetSigma( std::sqrt(variance) );
+  lineFilter->SetNormalizeAcrossScale(false);
+  lineFilter->SetNumberOfWorkUnits(1);
+  lineFilter->Update();
+  const double * response = lineFilter->GetOutput()->GetBufferPointer();
+
+  double directError = 0.0;
+  double recursiveError = 0.0;
+  for ( SizeValueType j = 0; j < size; ++j )
+    {
+    const SizeValueType distance = j < radius ? radius - j : j - radius;
+    const double        value = gaussian[distance];
+    directError += std::abs( ( distance <= kernelRadius ? kernel[distance] : 0.0 ) - value );
+    recursiveError += std::abs( response[j] - value );
+    }
+  if ( recursiveError <= std::max( m_MaximumError[direction], directError ) )
+    {
+    return ImplementationEnum::RECURSIVE;
+    }
+  return fastest;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::DirectFilterDirection(RealImageType *image, const ImageRegion< ImageDimension > & region,
+                        const ImageRegion< ImageDimension > & outputRegion, unsigned int direction,
+                        const std::vector< double > & kernel) const
+{
+  const SizeValueType   lineSize = region.GetSize(direction);
+  const SizeValueType   begin = outputRegion.GetIndex(direction) - region.GetIndex(direction);
+  const SizeValueType   count = outputRegion.GetSize(direction);
+  const SizeValueType   radius = kernel.size() - 1;
+  const SizeValueType   paddedSize = lineSize + 2 * radius;
+  const OffsetValueType stride = image->GetOffsetTable()[direction];
+  const std::vector< RealValueType > coefficients( kernel.begin(), kernel.end() );
+
+  this->ForEachBatch( image, region, direction,
+    [&]( RealValueType * values, OffsetValueType laneStride, SizeValueType lanes,
+         std::vector< RealValueType > & scratch )
+    {
+    scratch.resize( ( paddedSize + count ) * lanes );
+    RealValueType * padded = scratch.data();
+    RealValueType * smoothed = padded + paddedSize * lanes;
+
+    // Copy the lines, extended by their border values, with the value t
+    // of the line b at t * lanes + b
+    for ( SizeValueType t = 0; t < paddedSize; ++t )
+      {
+      const SizeValueType   s = t < radius ? 0 : std::min( t - radius, lineSize - 1 );
+      const RealValueType * x = values + static_cast< OffsetValueType >( s ) * stride;
+      RealValueType *       p = padded + t * lanes;
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        p[b] = x[static_cast< OffsetValueType >( b ) * laneStride];
+        }
+      }
+
+    for ( SizeValueType t = 0; t < count; ++t )
+      {
+      const RealValueType * center = padded + ( begin + t + radius ) * lanes;
+      RealValueType *       y = smoothed + t * lanes;
+      const RealValueType   c0 = coefficients[0];
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        y[b] = c0 * center[b];
+        }
+      for ( SizeValueType k = 1; k <= radius; ++k )
+        {
+        const RealValueType * before = center - k * lanes;
+        const RealValueType * after = center + k * lanes;
+        const RealValueType   ck = coefficients[k];
+        for ( SizeValueType b = 0; b < lanes; ++b )
+          {
+          y[b] += ck * ( before[b] + after[b] );
+          }
+        }
+      }
+
+    for ( SizeValueType t = 0; t < count; ++t )
+      {
+      RealValueType *       x = values + static_cast< OffsetValueType >( begin + t ) * stride;
+      const RealValueType * y = smoothed + t * lanes;
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        x[static_cast< OffsetValueType >( b ) * laneStride] = y[b];
+        }
+      }
+    } );
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::FFTFilterDirection(RealImageType *image, const ImageRegion< ImageDimension > & region,
+                     const ImageRegion< ImageDimension > & outputRegion, unsigned int direction,
+                     double variance, SizeValueType radius) const
+{
+  const SizeValueType   lineSize = region.GetSize(direction);
+  const SizeValueType   begin = outputRegion.GetIndex(direction) - region.GetIndex(direction);
+  const SizeValueType   count = outputRegion.GetSize(direction);
+  const SizeValueType   fftSize = Self::ComputeFFTSize( lineSize + 2 * radius );
+  const SizeValueType   halfSize = fftSize / 2 + 1;
+  const OffsetValueType stride = image->GetOffsetTable()[direction];
+
+  // Transfer function of the discrete Gaussian, divided by the size of
+  // the transform to normalize the backward transform
+  const NativeFFTCommon::RealTransform< RealValueType > transform(fftSize);
+  std::vector< RealValueType > transferFunction(halfSize);
+  for ( SizeValueType k = 0; k < halfSize; ++k )
+    {
+    transferFunction[k] = static_cast< RealValueType >(
+      std::exp( variance * ( std::cos( 2.0 * Math::pi * k / fftSize ) - 1.0 ) ) / fftSize );
+    }
+
+  this->ForEachBatch( image, region, direction,
+    [&]( RealValueType * values, OffsetValueType laneStride, SizeValueType lanes,
+         std::vector< RealValueType > & scratch )
+    {
+    scratch.resize( ( fftSize + 2 * halfSize ) * lanes + transform.GetWorkSize(lanes) );
+    RealValueType * padded = scratch.data();
+    RealValueType * re = padded + fftSize * lanes;
+    RealValueType * im = re + halfSize * lanes;
+    RealValueType * work = im + halfSize * lanes;
+
+    // Copy the lines, extended by their border values up to the size of
+    // the transform
+    for ( SizeValueType t = 0; t < fftSize; ++t )
+      {
+      const SizeValueType   s = t < radius ? 0 : std::min( t - radius, lineSize - 1 );
+      const RealValueType * x = values + static_cast< OffsetValueType >( s ) * stride;
+      RealValueType *       p = padded + t * lanes;
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        p[b] = x[static_cast< OffsetValueType >( b ) * laneStride];
+        }
+      }
+
+    transform.Forward( padded, re, im, lanes, work );
+    for ( SizeValueType k = 0; k < halfSize; ++k )
+      {
+      const RealValueType h = transferFunction[k];
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        re[k * lanes + b] *= h;
+        im[k * lanes + b] *= h;
+        }
+      }
+    transform.Backward( re, im, padded, lanes, work );
+
+    for ( SizeValueType t = 0; t < count; ++t )
+      {
+      RealValueType *       x = values + static_cast< OffsetValueType >( begin + t ) * stride;
+      const RealValueType * y = padded + ( begin + t + radius ) * lanes;
+      for ( SizeValueType b = 0; b < lanes; ++b )
+        {
+        x[static_cast< OffsetValueType >( b ) * laneStride] = y[b];
+        }
+      }
+    } );
+}
+
+template< typename TInputImage, typename TOutputImage >
+template< typename TFunction >
+void
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::ForEachBatch(RealImageType *image, const ImageRegion< ImageDimension > & region, unsigned int direction,
+               TFunction function) const
+{
+  using RegionType = ImageRegion< ImageDimension >;
+  using IndexType = typename RegionType::IndexType;
+
+  // The lines of a batch are consecutive along the lane direction
+  const unsigned int    laneDirection = ( direction == 0 && ImageDimension > 1 ) ? 1 : 0;
+  const OffsetValueType laneStride = image->GetOffsetTable()[laneDirection];
+  const SizeValueType   maximumNumberOfLanes = NumberOfLanes;
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  multiThreader->template ParallelizeImageRegionRestrictDirection< ImageDimension >(
+    direction, region,
+    [&]( const RegionType & lines )
+    {
+    RegionType firsts = lines;
+    firsts.SetSize( direction, 1 );
+    SizeValueType numberOfLines = 1;
+    if ( laneDirection != direction )
+      {
+      numberOfLines = lines.GetSize(laneDirection);
+      firsts.SetSize( laneDirection, 1 );
+      }
+
+    std::vector< RealValueType > scratch;
+    IndexType                    index = firsts.GetIndex();
+    for ( SizeValueType n = 0, numberOfFirsts = firsts.GetNumberOfPixels(); n < numberOfFirsts; ++n )
+      {
+      for ( SizeValueType first = 0; first < numberOfLines; first += maximumNumberOfLanes )
+        {
+        IndexType batchIndex = index;
+        if ( laneDirection != direction )
+          {
+          batchIndex[laneDirection] += first;
+          }
+        function( image->GetBufferPointer() + image->ComputeOffset(batchIndex), laneStride,
+                  std::min( maximumNumberOfLanes, numberOfLines - first ), scratch );
+        }
+
+      for ( unsigned int d = 0; d < ImageDimension; ++d )
+        {
+        if ( ++index[d] < firsts.GetIndex(d) + static_cast< OffsetValueType >( firsts.GetSize(d) ) )
+          {
+          break;
+          }
+        index[d] = firsts.GetIndex(d);
+        }
+      }
+    },
+    nullptr );
+}
+
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::ComputeNegligibleRadius(double variance)
+{
+  return static_cast< SizeValueType >( std::ceil( 6.0 * std::sqrt(variance) ) ) + 2;
+}
+
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::ComputeFFTSize(SizeValueType size)
+{
+  for ( SizeValueType fftSize = std::max( size, SizeValueType( 1 ) );; ++fftSize )
+    {
+    SizeValueType n = fftSize;
+    for ( SizeValueType p = 2; p <= NativeFFTCommon::GREATEST_PRIME_FACTOR; ++p )
+      {
+      while ( n % p == 0 )
+        {
+        n /= p;
+        }
+      }
+    if ( n == 1 )
+      {
+      return fftSize;
+      }
+    }
+}
+
 #if !defined( ITK_LEGACY_REMOVE )
 template< typename TInputImage, typename TOutputImage >
 unsigned int
@@ -335,6 +772,13 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
   os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
   os << indent << "FilterDimensionality: " << m_FilterDimensionality << std::endl;
   os << indent << "UseImageSpacing: " << m_UseImageSpacing << std::endl;
+  os << indent << "Implementation: " << m_Implementation << std::endl;
+  os << indent << "SelectedImplementations: [";
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    os << ( i == 0 ? "" : ", " ) << m_SelectedImplementations[i];
+    }
+  os << "]" << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMedianHistogram_h
+#define itkMedianHistogram_h
+
+#include "itkIntTypes.h"
+#include "itkNumericTraits.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+namespace Function
+{
+
+/** \class MedianHistogram
+ * \brief Histogram of the integer values of at most 16 bits which keeps
+ * track of their median.
+ *
+ * The bins are grouped in blocks, whose counts are kept as well. The
+ * median is searched from the block of the previous median, along the
+ * blocks and then along the bins of a single block, so that the cost of
+ * GetValue() is at most about the square root of the number of bins, and
+ * much less for the slowly varying medians of a moving neighborhood
+ * (T. Huang, G. Yang and G. Tang, "A fast two-dimensional median
+ * filtering algorithm", 1979, and S. Perreault and P. Hebert, "Median
+ * filtering in constant time", 2007).
+ *
+ * This class has the interface of the histograms of
+ * MovingHistogramImageFilter, where the pixels outside the image are
+ * ignored. It is used by MedianImageFilter.
+ *
+ * \sa MedianImageFilter
+ * \sa MovingHistogramImageFilter
+ * \ingroup ITKSmoothing
+ */
+template< typename TInputPixel >
+class MedianHistogram
+{
+public:
+  static_assert( std::is_integral< TInputPixel >::value && sizeof( TInputPixel ) <= 2,
+                 "MedianHistogram only supports integer pixels of at most 16 bits" );
+
+  MedianHistogram():
+    m_Counts( SizeValueType( 1 ) << ( 8 * sizeof( TInputPixel ) ), 0 ),
+    m_BlockCounts( m_Counts.size() >> BlockBits, 0 ),
+    m_Block( m_BlockCounts.size() / 2 ),
+    m_BelowBlock( 0 ),
+    m_Entries( 0 )
+  {}
+
+  void AddPixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = Self::GetBin(p);
+    ++m_Counts[bin];
+    ++m_BlockCounts[bin >> BlockBits];
+    if ( ( bin >> BlockBits ) < m_Block )
+      {
+      ++m_BelowBlock;
+      }
+    ++m_Entries;
+  }
+
+  void RemovePixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = Self::GetBin(p);
+    --m_Counts[bin];
+    --m_BlockCounts[bin >> BlockBits];
+    if ( ( bin >> BlockBits ) < m_Block )
+      {
+      --m_BelowBlock;
+      }
+    --m_Entries;
+  }
+
+  void AddBoundary(){}
+
+  void RemoveBoundary(){}
+
+  bool IsValid() const
+  {
+    return m_Entries > 0;
+  }
+
+  /** Get the median of the values, the greatest of the two middle values
+   * when there is an even number of values, as std::nth_element() at
+   * the position size / 2 does. */
+  TInputPixel GetValue(const TInputPixel & = TInputPixel())
+  {
+    if ( m_Entries == 0 )
+      {
+      return NumericTraits< TInputPixel >::ZeroValue();
+      }
+    // Number of values less than the median
+    const SizeValueType rank = m_Entries / 2;
+
+    // Move to the block of the median
+    while ( m_BelowBlock > rank )
+      {
+      --m_Block;
+      m_BelowBlock -= m_BlockCounts[m_Block];
+      }
+    while ( m_BelowBlock + m_BlockCounts[m_Block] <= rank )
+      {
+      m_BelowBlock += m_BlockCounts[m_Block];
+      ++m_Block;
+      }
+
+    // Then to its bin, from the nearest end of the block
+    SizeValueType bin;
+    if ( 2 * ( rank - m_BelowBlock ) < m_BlockCounts[m_Block] )
+      {
+      bin = m_Block << BlockBits;
+      SizeValueType count = m_BelowBlock + m_Counts[bin];
+      while ( count <= rank )
+        {
+        count += m_Counts[++bin];
+        }
+      }
+    else
+      {
+      bin = ( ( m_Block + 1 ) << BlockBits ) - 1;
+      SizeValueType count = m_BelowBlock + m_BlockCounts[m_Block] - m_Counts[bin];
+      while ( count > rank )
+        {
+        count -= m_Counts[--bin];
+        }
+      }
+    return static_cast< TInputPixel >( static_cast< OffsetValueType >( bin )
+                                       + static_cast< OffsetValueType >( NumericTraits< TInputPixel >::NonpositiveMin() ) );
+  }
+
+  static bool UseVectorBasedAlgorithm()
+  {
+    return true;
+  }
+
+private:
+  using Self = MedianHistogram;
+
+  /** Number of bits of the bin indices within a block */
+  static constexpr unsigned int BlockBits = 4 * sizeof( TInputPixel );
+
+  static SizeValueType GetBin(const TInputPixel & p)
+  {
+    return static_cast< SizeValueType >( static_cast< OffsetValueType >( p )
+                                         - static_cast< OffsetValueType >( NumericTraits< TInputPixel >::NonpositiveMin() ) );
+  }
+
+  std::vector< SizeValueType > m_Counts;
+  std::vector< SizeValueType > m_BlockCounts;
+  SizeValueType                m_Block;
+  SizeValueType                m_BelowBlock;
+  SizeValueType                m_Entries;
+};
+} // end namespace Function
+} // end namespace itk
+
+#endif
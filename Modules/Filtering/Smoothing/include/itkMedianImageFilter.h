@@ -21,6 +21,8 @@
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
 
+#include <type_traits>
+
 namespace itk
 {
 /** \class MedianImageFilter
@@ -35,10 +37,17 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * For images of integer pixels of at most 16 bits and large enough
+ * neighborhoods, the pixels whose neighborhood is inside the image are
+ * computed by moving a MedianHistogram along the lines, so that only the
+ * pixels entering and leaving the neighborhood are read for each pixel.
+ * The result is the same.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
  * \sa NeighborhoodIterator
+ * \sa Function::MedianHistogram
  *
  * \ingroup IntensityImageFilters
  * \ingroup ITKSmoothing
@@ -111,6 +120,19 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+private:
+  /** Whether the median can be computed with a MedianHistogram */
+  using HistogramSupportType = std::integral_constant< bool, std::is_integral< InputPixelType >::value
+                                                             && !std::is_same< InputPixelType, bool >::value
+                                                             && sizeof( InputPixelType ) <= 2
+                                                             && std::is_same< InputImageType,
+                                                                              Image< InputPixelType,
+                                                                                     InputImageDimension > >::value >;
+
+  /** Compute the median of the pixels of a region, whose neighborhoods
+   * are inside the input image, with a histogram moved along the lines. */
+  void HistogramGenerateData(const OutputImageRegionType & region, std::true_type);
+  void HistogramGenerateData(const OutputImageRegionType &, std::false_type) {}
 };
 } // end namespace itk
 
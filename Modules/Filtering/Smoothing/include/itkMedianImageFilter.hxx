@@ -22,6 +22,8 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkMedianHistogram.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
@@ -56,11 +58,28 @@ MedianImageFilter< TInputImage, TOutputImage >
   // always a median index (if there where an even number of pixels
   // in the neighborhood we have to average the middle two values).
 
+  // Moving a histogram reads 2 * ( 2 * r + 1 )^( N - 1 ) pixels for each
+  // pixel, instead of ( 2 * r + 1 )^N, but finding the median in a 16 bit
+  // histogram costs about as much as selecting it among a few dozens of
+  // pixels.
+  SizeValueType numberOfNeighbors = 1;
+  for ( unsigned int d = 0; d < InputImageDimension; ++d )
+    {
+    numberOfNeighbors *= 2 * this->GetRadius()[d] + 1;
+    }
+  const SizeValueType minimumHistogramNeighborhoodSize = sizeof( InputPixelType ) == 1 ? 9 : 25;
+  auto fit = faceList.begin();
+  if ( HistogramSupportType::value && numberOfNeighbors >= minimumHistogramNeighborhoodSize )
+    {
+    this->HistogramGenerateData( *fit, HistogramSupportType() );
+    ++fit;
+    }
+
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
   std::vector< InputPixelType >                      pixels;
   // Process each of the boundary faces.  These are N-d regions which border
   // the edge of the buffer.
-  for ( auto fit = faceList.begin(); fit != faceList.end(); ++fit )
+  for (; fit != faceList.end(); ++fit )
     {
     ImageRegionIterator< OutputImageType > it = ImageRegionIterator< OutputImageType >(output, *fit);
 
@@ -90,6 +109,88 @@ MedianImageFilter< TInputImage, TOutputImage >
       }
     }
 }
+
+template< typename TInputImage, typename TOutputImage >
+void
+MedianImageFilter< TInputImage, TOutputImage >
+::HistogramGenerateData(const OutputImageRegionType & region, std::true_type)
+{
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+  const InputSizeType    radius = this->GetRadius();
+
+  // Offsets of the pixels of the neighborhood which have the same first
+  // index as its center. A moving neighborhood gains and loses such a
+  // column of pixels at each step along the first direction.
+  std::vector< OffsetValueType > columnOffsets( 1, 0 );
+  for ( unsigned int d = 1; d < InputImageDimension; ++d )
+    {
+    const OffsetValueType        stride = input->GetOffsetTable()[d];
+    const OffsetValueType        r = static_cast< OffsetValueType >( radius[d] );
+    std::vector< OffsetValueType > offsets;
+    offsets.reserve( columnOffsets.size() * ( 2 * r + 1 ) );
+    for ( OffsetValueType i = -r; i <= r; ++i )
+      {
+      for ( const auto & offset : columnOffsets )
+        {
+        offsets.push_back( offset + i * stride );
+        }
+      }
+    columnOffsets.swap(offsets);
+    }
+  const OffsetValueType r0 = static_cast< OffsetValueType >( radius[0] );
+
+  using HistogramType = Function::MedianHistogram< InputPixelType >;
+  HistogramType histogram;
+
+  ImageScanlineIterator< OutputImageType > it( output, region );
+  while ( !it.IsAtEnd() )
+    {
+    const InputPixelType * center = input->GetBufferPointer() + input->ComputeOffset( it.GetIndex() );
+    const OffsetValueType  lineLength = static_cast< OffsetValueType >( region.GetSize(0) );
+
+    // Fill the histogram with the neighborhood of the first pixel
+    for ( OffsetValueType x = -r0; x <= r0; ++x )
+      {
+      for ( const auto & offset : columnOffsets )
+        {
+        histogram.AddPixel( center[x + offset] );
+        }
+      }
+
+    for ( OffsetValueType x = 0; x < lineLength; ++x )
+      {
+      it.Set( static_cast< OutputPixelType >( histogram.GetValue() ) );
+      ++it;
+      if ( x + 1 < lineLength )
+        {
+        const InputPixelType * added = center + x + r0 + 1;
+        const InputPixelType * removed = center + x - r0;
+        for ( const auto & offset : columnOffsets )
+          {
+          histogram.AddPixel( added[offset] );
+          histogram.RemovePixel( removed[offset] );
+          }
+        }
+      }
+
+    // Empty the histogram, keeping the position of its median for the
+    // next line
+    for ( OffsetValueType x = lineLength - 1 - r0; x <= lineLength - 1 + r0; ++x )
+      {
+      for ( const auto & offset : columnOffsets )
+        {
+        histogram.RemovePixel( center[x + offset] );
+        }
+      }
+    it.NextLine();
+    }
+}
 } // end namespace itk
 
 #endif
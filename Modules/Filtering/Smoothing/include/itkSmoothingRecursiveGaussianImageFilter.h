@@ -24,6 +24,7 @@
 #include "itkImage.h"
 #include "itkPixelTraits.h"
 #include "itkCommand.h"
+#include <vector>
 
 namespace itk
 {
@@ -35,6 +36,11 @@ namespace itk
  * filters. For multi-component images, the filter works on each
  * component independently.
  *
+ * The first recursive gaussian filter converts the input to the
+ * RealImageType, the following ones run in-place on its output and
+ * the last one writes the output image, so that at most one
+ * intermediate image is allocated whatever the image dimension.
+ *
  * For this filter to be able to run in-place the input and output
  * image types need to be the same and/or the same type as the
  * RealImageType.
@@ -92,8 +98,9 @@ public:
   /** Typedef for the internal Gaussian smoothing filter. */
   using InternalGaussianFilterType = RecursiveGaussianImageFilter< RealImageType, RealImageType >;
 
-  /** Typedef for the casting image filter. */
-  using CastingFilterType = CastImageFilter< RealImageType, OutputImageType >;
+  /** Typedef for the last Gaussian smoothing in the pipeline, which
+   * also casts to the output image type. */
+  using LastGaussianFilterType = RecursiveGaussianImageFilter< RealImageType, OutputImageType >;
 
   /** Pointer to the internal Gaussian filter. */
   using InternalGaussianFilterPointer = typename InternalGaussianFilterType::Pointer;
@@ -101,8 +108,15 @@ public:
   /** Pointer to the first Gaussian smoothing filter. */
   using FirstGaussianFilterPointer = typename FirstGaussianFilterType::Pointer;
 
-  /** Pointer to the casting image filter. */
+  /** Pointer to the last Gaussian smoothing filter. */
+  using LastGaussianFilterPointer = typename LastGaussianFilterType::Pointer;
+
+#if !defined( ITK_LEGACY_REMOVE )
+  /** \deprecated The output is cast by the last Gaussian smoothing
+   * filter, except for images of one dimension. */
+  using CastingFilterType = CastImageFilter< RealImageType, OutputImageType >;
   using CastingFilterPointer = typename CastingFilterType::Pointer;
+#endif
 
   /** Pointer to the Output Image */
   using OutputImagePointer = typename OutputImageType::Pointer;
@@ -163,9 +177,18 @@ protected:
   void EnlargeOutputRequestedRegion(DataObject *output) override;
 
 private:
-  InternalGaussianFilterPointer m_SmoothingFilters[ImageDimension - 1];
-  FirstGaussianFilterPointer    m_FirstSmoothingFilter;
-  CastingFilterPointer          m_CastingFilter;
+  /** In 1-D, the first filter smooths along the only dimension, and
+   * this filter casts its output to the output image type. */
+  using OutputCastingFilterType = CastImageFilter< RealImageType, OutputImageType >;
+
+  /** The filter producing the output of the mini-pipeline. */
+  using OutputFilterType = InPlaceImageFilter< RealImageType, OutputImageType >;
+  OutputFilterType * GetOutputFilter() const;
+
+  std::vector< InternalGaussianFilterPointer >       m_SmoothingFilters;
+  FirstGaussianFilterPointer                         m_FirstSmoothingFilter;
+  LastGaussianFilterPointer                          m_LastSmoothingFilter;
+  typename OutputCastingFilterType::Pointer          m_CastingFilter;
 
   bool m_NormalizeAcrossScale{ false };
 
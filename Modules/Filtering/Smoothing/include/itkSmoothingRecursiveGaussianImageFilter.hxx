@@ -43,26 +43,53 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
   m_FirstSmoothingFilter->ReleaseDataFlagOn();
   // InPlace will be set conditionally in the GenerateData method.
 
-  for ( unsigned int i = 0; i < ImageDimension - 1; i++ )
+  // The internal filters smooth along the dimensions 1 to
+  // ImageDimension - 2, in-place.
+  for ( unsigned int i = 1; i < ImageDimension - 1; i++ )
     {
-    m_SmoothingFilters[i] = InternalGaussianFilterType::New();
-    m_SmoothingFilters[i]->SetOrder(InternalGaussianFilterType::ZeroOrder);
-    m_SmoothingFilters[i]->SetNormalizeAcrossScale(m_NormalizeAcrossScale);
-    m_SmoothingFilters[i]->SetDirection(i);
-    m_SmoothingFilters[i]->ReleaseDataFlagOn();
-    m_SmoothingFilters[i]->InPlaceOn();
+    InternalGaussianFilterPointer filter = InternalGaussianFilterType::New();
+    filter->SetOrder(InternalGaussianFilterType::ZeroOrder);
+    filter->SetNormalizeAcrossScale(m_NormalizeAcrossScale);
+    filter->SetDirection(i);
+    filter->ReleaseDataFlagOn();
+    filter->InPlaceOn();
+    if ( m_SmoothingFilters.empty() )
+      {
+      filter->SetInput( m_FirstSmoothingFilter->GetOutput() );
+      }
+    else
+      {
+      filter->SetInput( m_SmoothingFilters.back()->GetOutput() );
+      }
+    m_SmoothingFilters.push_back(filter);
     }
 
-  m_SmoothingFilters[0]->SetInput( m_FirstSmoothingFilter->GetOutput() );
-  for ( unsigned int i = 1; i < ImageDimension - 1; i++ )
+  // The last filter smooths along the first dimension and casts to the
+  // output pixel type, in-place when the output is a RealImageType. In
+  // 1-D, the first filter already smoothed along the first dimension,
+  // so its output is only cast.
+  if ( ImageDimension > 1 )
     {
-    m_SmoothingFilters[i]->SetInput(
-      m_SmoothingFilters[i - 1]->GetOutput() );
+    m_LastSmoothingFilter = LastGaussianFilterType::New();
+    m_LastSmoothingFilter->SetOrder(LastGaussianFilterType::ZeroOrder);
+    m_LastSmoothingFilter->SetNormalizeAcrossScale(m_NormalizeAcrossScale);
+    m_LastSmoothingFilter->SetDirection(0);
+    m_LastSmoothingFilter->InPlaceOn();
+    if ( m_SmoothingFilters.empty() )
+      {
+      m_LastSmoothingFilter->SetInput( m_FirstSmoothingFilter->GetOutput() );
+      }
+    else
+      {
+      m_LastSmoothingFilter->SetInput( m_SmoothingFilters.back()->GetOutput() );
+      }
+    }
+  else
+    {
+    m_CastingFilter = OutputCastingFilterType::New();
+    m_CastingFilter->SetInput( m_FirstSmoothingFilter->GetOutput() );
+    m_CastingFilter->InPlaceOn();
     }
-
-  m_CastingFilter = CastingFilterType::New();
-  m_CastingFilter->SetInput( m_SmoothingFilters[ImageDimension - 2]->GetOutput() );
-  m_CastingFilter->InPlaceOn();
 
   this->InPlaceOff();
 
@@ -81,11 +108,25 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 ::SetNumberOfWorkUnits(ThreadIdType nb)
 {
   Superclass::SetNumberOfWorkUnits(nb);
-  for ( unsigned int i = 0; i < ImageDimension - 1; i++ )
+  for ( auto & filter : m_SmoothingFilters )
     {
-    m_SmoothingFilters[i]->SetNumberOfWorkUnits(nb);
+    filter->SetNumberOfWorkUnits(nb);
     }
   m_FirstSmoothingFilter->SetNumberOfWorkUnits(nb);
+  this->GetOutputFilter()->SetNumberOfWorkUnits(nb);
+}
+
+
+template< typename TInputImage, typename TOutputImage >
+typename SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >::OutputFilterType *
+SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
+::GetOutputFilter() const
+{
+  if ( m_LastSmoothingFilter )
+    {
+    return m_LastSmoothingFilter.GetPointer();
+    }
+  return m_CastingFilter.GetPointer();
 }
 
 
@@ -131,11 +172,15 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
   if ( this->m_Sigma != sigma )
     {
     this->m_Sigma = sigma;
-    for ( unsigned int i = 0; i < ImageDimension - 1; i++ )
+    for ( unsigned int i = 1; i < ImageDimension - 1; i++ )
       {
-      m_SmoothingFilters[i]->SetSigma(m_Sigma[i]);
+      m_SmoothingFilters[i - 1]->SetSigma(m_Sigma[i]);
       }
     m_FirstSmoothingFilter->SetSigma(m_Sigma[ImageDimension-1]);
+    if ( m_LastSmoothingFilter )
+      {
+      m_LastSmoothingFilter->SetSigma(m_Sigma[0]);
+      }
 
     this->Modified();
     }
@@ -167,11 +212,15 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 {
   m_NormalizeAcrossScale = normalize;
 
-  for ( unsigned int i = 0; i < ImageDimension - 1; i++ )
+  for ( auto & filter : m_SmoothingFilters )
     {
-    m_SmoothingFilters[i]->SetNormalizeAcrossScale(normalize);
+    filter->SetNormalizeAcrossScale(normalize);
     }
   m_FirstSmoothingFilter->SetNormalizeAcrossScale(normalize);
+  if ( m_LastSmoothingFilter )
+    {
+    m_LastSmoothingFilter->SetNormalizeAcrossScale(normalize);
+    }
 
   this->Modified();
 }
@@ -246,9 +295,11 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
     m_FirstSmoothingFilter->InPlaceOff();
     }
 
+  OutputFilterType * outputFilter = this->GetOutputFilter();
+
   // If the last filter is running in-place then this bulk data is not
   // needed, release it to save memory.
-  if ( m_CastingFilter->CanRunInPlace() )
+  if ( outputFilter->CanRunInPlace() )
     {
     this->GetOutput()->ReleaseData();
     }
@@ -259,20 +310,24 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 
   // Register the filter with the with progress accumulator using
   // equal weight proportion.
-  for ( unsigned int i = 0; i < ImageDimension - 1; i++ )
+  for ( auto & filter : m_SmoothingFilters )
     {
-    progress->RegisterInternalFilter( m_SmoothingFilters[i], 1.0 / ( ImageDimension ) );
+    progress->RegisterInternalFilter( filter, 1.0 / ( ImageDimension ) );
     }
 
   progress->RegisterInternalFilter( m_FirstSmoothingFilter, 1.0 / ( ImageDimension ) );
+  if ( m_LastSmoothingFilter )
+    {
+    progress->RegisterInternalFilter( m_LastSmoothingFilter, 1.0 / ( ImageDimension ) );
+    }
   m_FirstSmoothingFilter->SetInput(inputImage);
 
   // Graft our output to the internal filter to force the proper regions
   // to be generated, and the bulk data which be be from the input due
   // to the in-place option.
-  m_CastingFilter->GraftOutput( this->GetOutput() );
-  m_CastingFilter->Update();
-  this->GraftOutput( m_CastingFilter->GetOutput() );
+  outputFilter->GraftOutput( this->GetOutput() );
+  outputFilter->Update();
+  this->GraftOutput( outputFilter->GetOutput() );
 }
 
 
@@ -283,11 +338,12 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 {
   Superclass::PrintSelf(os, indent);
 
-  for( unsigned int i = 0; i < ImageDimension - 1; ++i )
+  for( unsigned int i = 0; i < m_SmoothingFilters.size(); ++i )
     {
     itkPrintSelfObjectMacro( SmoothingFilters[i] );
     }
   itkPrintSelfObjectMacro( FirstSmoothingFilter );
+  itkPrintSelfObjectMacro( LastSmoothingFilter );
   itkPrintSelfObjectMacro( CastingFilter );
 
   os << indent << "NormalizeAcrossScale: " << m_NormalizeAcrossScale << std::endl;
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSummedAreaTable_h
+#define itkSummedAreaTable_h
+
+#include "itkImageRegion.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class SummedAreaTable
+ * \brief Table of the sums of the values of the pixels of an image
+ * region over all the boxes which start at the region index, to compute
+ * the sum of the values over any box in constant time.
+ *
+ * Compute() fills the table with the values that a function returns
+ * for each pixel of a region, and accumulates them along each
+ * dimension in turn. The accumulations are run in parallel by a
+ * MultiThreaderBase when one is given, so that a whole requested region
+ * can be prepared before the threaded generation of a filter.
+ * The table only covers the region it is computed for, so a streamed
+ * filter computes it for the pixels its requested output region needs.
+ *
+ * The sum over a box is obtained from the values of the table at its
+ * 2^N corners. GetBoxSum() and ForEachBoxSum() crop the boxes to the
+ * region of the table, and give the number of pixels of the cropped
+ * boxes.
+ *
+ * TAccumulate is the type of the sums. It may be a floating point type
+ * or, for exact sums of integers, an integer type, and also a Vector of
+ * those to accumulate several values together. The sums of floating
+ * point values are compensated (Kahan summation) by default, which
+ * keeps the rounding error of each value of the table at the precision
+ * of TAccumulate instead of letting it grow with the size of the region.
+ *
+ * \sa BoxMeanImageFilter
+ * \sa BoxSigmaImageFilter
+ * \ingroup ITKSmoothing
+ */
+template< typename TAccumulate, unsigned int VDimension >
+class ITK_TEMPLATE_EXPORT SummedAreaTable
+{
+public:
+  using Self = SummedAreaTable;
+
+  static constexpr unsigned int ImageDimension = VDimension;
+
+  using AccumulateType = TAccumulate;
+  using RegionType = ImageRegion< VDimension >;
+  using IndexType = typename RegionType::IndexType;
+  using SizeType = typename RegionType::SizeType;
+  using OffsetType = typename RegionType::OffsetType;
+
+  SummedAreaTable();
+
+  /** Whether the sums of floating point values are compensated.
+   * Default is true. */
+  void SetCompensatedSummation(bool compensated)
+  {
+    m_CompensatedSummation = compensated;
+  }
+  bool GetCompensatedSummation() const
+  {
+    return m_CompensatedSummation;
+  }
+
+  /** Compute the table of the values function( pixel ) of the pixels of
+   * a region of an image, in parallel with threader if it is not
+   * nullptr. */
+  template< typename TImage, typename TFunction >
+  void Compute(const TImage * image, const RegionType & region, TFunction function,
+               MultiThreaderBase * threader = nullptr);
+
+  /** Region of the pixels of the table. */
+  const RegionType & GetRegion() const
+  {
+    return m_Region;
+  }
+
+  /** Free the memory of the table. */
+  void Release();
+
+  /** Sum of the values of the pixels of the box of a given radius around
+   * center, cropped to the region of the table, whose number of pixels
+   * is stored in numberOfPixels. */
+  AccumulateType GetBoxSum(const IndexType & center, const SizeType & radius, SizeValueType & numberOfPixels) const;
+
+  /** Call function( sum, numberOfPixels ) with the sums over the boxes of a
+   * given radius around the pixels of a region, and their number of
+   * pixels, in the order of an ImageRegionIterator. The boxes are cropped
+   * to the region of the table, which must contain the region. */
+  template< typename TFunction >
+  void ForEachBoxSum(const RegionType & region, const SizeType & radius, TFunction function) const;
+
+private:
+  /** Accumulate the table along a direction. */
+  void Accumulate(unsigned int direction, MultiThreaderBase * threader);
+
+  /** Bounds, in the table, of the box of a given radius around center,
+   * cropped to the region. */
+  void ComputeBoxBounds(const IndexType & center, const SizeType & radius, OffsetType & lower,
+                        OffsetType & upper) const;
+
+  RegionType                    m_Region;
+  OffsetType                    m_Strides;
+  std::vector< AccumulateType > m_Table;
+  bool                          m_CompensatedSummation;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkSummedAreaTable.hxx"
+#endif
+
+#endif
@@ -0,0 +1,322 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSummedAreaTable_hxx
+#define itkSummedAreaTable_hxx
+
+#include "itkSummedAreaTable.h"
+#include "itkImageScanlineIterator.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace itk
+{
+template< typename TAccumulate, unsigned int VDimension >
+SummedAreaTable< TAccumulate, VDimension >
+::SummedAreaTable():
+  m_CompensatedSummation( true )
+{
+  m_Strides.Fill( 0 );
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+template< typename TImage, typename TFunction >
+void
+SummedAreaTable< TAccumulate, VDimension >
+::Compute(const TImage * image, const RegionType & region, TFunction function, MultiThreaderBase * threader)
+{
+  // The table has a plane of zeros before the sums of the pixels along
+  // each dimension, so that the boxes at the start of the region need no
+  // special case
+  m_Region = region;
+  OffsetValueType numberOfValues = 1;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    m_Strides[d] = numberOfValues;
+    numberOfValues *= static_cast< OffsetValueType >( region.GetSize(d) ) + 1;
+    }
+  m_Table.assign( numberOfValues, NumericTraits< AccumulateType >::ZeroValue() );
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  auto fill = [&]( const RegionType & subregion )
+    {
+      ImageScanlineConstIterator< TImage > it( image, subregion );
+      while ( !it.IsAtEnd() )
+        {
+        OffsetValueType offset = 0;
+        for ( unsigned int d = 0; d < VDimension; ++d )
+          {
+          offset += ( it.GetIndex()[d] - m_Region.GetIndex(d) + 1 ) * m_Strides[d];
+          }
+        AccumulateType * value = m_Table.data() + offset;
+        while ( !it.IsAtEndOfLine() )
+          {
+          *value++ = static_cast< AccumulateType >( function( it.Get() ) );
+          ++it;
+          }
+        it.NextLine();
+        }
+    };
+  if ( threader )
+    {
+    threader->ParallelizeImageRegion< VDimension >( region, fill, nullptr );
+    }
+  else
+    {
+    fill( region );
+    }
+
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    this->Accumulate( d, threader );
+    }
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+void
+SummedAreaTable< TAccumulate, VDimension >
+::Accumulate(unsigned int direction, MultiThreaderBase * threader)
+{
+  // The table is a sequence of blocks of length planes of inner values,
+  // which are accumulated plane by plane. The planes are split in chunks
+  // of contiguous values, and the work items hold enough blocks to
+  // accumulate at least about MinimumItemSize values.
+  constexpr SizeValueType MaximumChunkLength = 1024;
+  constexpr SizeValueType MinimumItemSize = 16384;
+  const SizeValueType     inner = m_Strides[direction];
+  const SizeValueType     length = m_Region.GetSize(direction) + 1;
+  const SizeValueType     outer = m_Table.size() / ( inner * length );
+  const SizeValueType     chunkLength = std::min( inner, MaximumChunkLength );
+  const SizeValueType     chunksPerPlane = ( inner + chunkLength - 1 ) / chunkLength;
+  const SizeValueType     blocksPerItem = std::max( MinimumItemSize / ( chunkLength * length ), SizeValueType( 1 ) );
+  const SizeValueType     numberOfItems = chunksPerPlane * ( ( outer + blocksPerItem - 1 ) / blocksPerItem );
+  const bool              compensated = m_CompensatedSummation
+    && std::is_floating_point< typename NumericTraits< AccumulateType >::ValueType >::value;
+
+  auto accumulate = [&]( SizeValueType item )
+    {
+      const SizeValueType chunkStart = ( item % chunksPerPlane ) * chunkLength;
+      const SizeValueType chunkEnd = std::min( chunkStart + chunkLength, inner );
+      const SizeValueType firstBlock = ( item / chunksPerPlane ) * blocksPerItem;
+      const SizeValueType lastBlock = std::min( firstBlock + blocksPerItem, outer );
+      std::vector< AccumulateType > compensation;
+      for ( SizeValueType block = firstBlock; block < lastBlock; ++block )
+        {
+        AccumulateType * blockValues = m_Table.data() + block * inner * length;
+        if ( compensated )
+          {
+          compensation.assign( chunkEnd - chunkStart, NumericTraits< AccumulateType >::ZeroValue() );
+          }
+        // The first plane holds zeros, and the second one is its own sum
+        for ( SizeValueType j = 2; j < length; ++j )
+          {
+          AccumulateType *       current = blockValues + j * inner;
+          const AccumulateType * previous = current - inner;
+          if ( compensated )
+            {
+            for ( SizeValueType i = chunkStart; i < chunkEnd; ++i )
+              {
+              const AccumulateType y = current[i] - compensation[i - chunkStart];
+              const AccumulateType t = previous[i] + y;
+              compensation[i - chunkStart] = ( t - previous[i] ) - y;
+              current[i] = t;
+              }
+            }
+          else
+            {
+            for ( SizeValueType i = chunkStart; i < chunkEnd; ++i )
+              {
+              current[i] += previous[i];
+              }
+            }
+          }
+        }
+    };
+  if ( threader && numberOfItems > 1 )
+    {
+    threader->ParallelizeArray( 0, numberOfItems, accumulate, nullptr );
+    }
+  else
+    {
+    for ( SizeValueType item = 0; item < numberOfItems; ++item )
+      {
+      accumulate( item );
+      }
+    }
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+void
+SummedAreaTable< TAccumulate, VDimension >
+::Release()
+{
+  std::vector< AccumulateType >().swap( m_Table );
+  m_Region = RegionType();
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+void
+SummedAreaTable< TAccumulate, VDimension >
+::ComputeBoxBounds(const IndexType & center, const SizeType & radius, OffsetType & lower, OffsetType & upper) const
+{
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    const OffsetValueType position = center[d] - m_Region.GetIndex(d);
+    const OffsetValueType r = static_cast< OffsetValueType >( radius[d] );
+    lower[d] = std::max( position - r, OffsetValueType( 0 ) );
+    upper[d] = std::max( std::min( position + r + 1, static_cast< OffsetValueType >( m_Region.GetSize(d) ) ), lower[d] );
+    }
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+typename SummedAreaTable< TAccumulate, VDimension >::AccumulateType
+SummedAreaTable< TAccumulate, VDimension >
+::GetBoxSum(const IndexType & center, const SizeType & radius, SizeValueType & numberOfPixels) const
+{
+  OffsetType lower;
+  OffsetType upper;
+  this->ComputeBoxBounds( center, radius, lower, upper );
+
+  numberOfPixels = 1;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    numberOfPixels *= static_cast< SizeValueType >( upper[d] - lower[d] );
+    }
+  AccumulateType sum = NumericTraits< AccumulateType >::ZeroValue();
+  if ( numberOfPixels == 0 )
+    {
+    return sum;
+    }
+
+  // Inclusion-exclusion of the boxes which start at the region index and
+  // end at the corners of the box
+  for ( unsigned int corner = 0; corner < ( 1u << VDimension ); ++corner )
+    {
+    OffsetValueType offset = 0;
+    bool            negative = false;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      if ( corner & ( 1u << d ) )
+        {
+        offset += upper[d] * m_Strides[d];
+        }
+      else
+        {
+        offset += lower[d] * m_Strides[d];
+        negative = !negative;
+        }
+      }
+    if ( negative )
+      {
+      sum -= m_Table[offset];
+      }
+    else
+      {
+      sum += m_Table[offset];
+      }
+    }
+  return sum;
+}
+
+template< typename TAccumulate, unsigned int VDimension >
+template< typename TFunction >
+void
+SummedAreaTable< TAccumulate, VDimension >
+::ForEachBoxSum(const RegionType & region, const SizeType & radius, TFunction function) const
+{
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const AccumulateType * table = m_Table.data();
+  const OffsetValueType  radius0 = static_cast< OffsetValueType >( radius[0] );
+  const OffsetValueType  tableStart0 = m_Region.GetIndex(0);
+  const OffsetValueType  tableSize0 = static_cast< OffsetValueType >( m_Region.GetSize(0) );
+  const SizeValueType    lineLength = region.GetSize(0);
+  const SizeValueType    numberOfLines = region.GetNumberOfPixels() / lineLength;
+
+  // The corners of the boxes along the other dimensions are the same for
+  // a whole line, with a positive or negative sign
+  std::vector< OffsetValueType > positiveCorners;
+  std::vector< OffsetValueType > negativeCorners;
+  IndexType                      index = region.GetIndex();
+  for ( SizeValueType line = 0; line < numberOfLines; ++line )
+    {
+    OffsetType lower;
+    OffsetType upper;
+    this->ComputeBoxBounds( index, radius, lower, upper );
+    SizeValueType lineNumberOfPixels = 1;
+    for ( unsigned int d = 1; d < VDimension; ++d )
+      {
+      lineNumberOfPixels *= static_cast< SizeValueType >( upper[d] - lower[d] );
+      }
+    positiveCorners.clear();
+    negativeCorners.clear();
+    for ( unsigned int corner = 0; corner < ( 1u << ( VDimension - 1 ) ); ++corner )
+      {
+      OffsetValueType offset = 0;
+      bool            negative = false;
+      for ( unsigned int d = 1; d < VDimension; ++d )
+        {
+        if ( corner & ( 1u << ( d - 1 ) ) )
+          {
+          offset += upper[d] * m_Strides[d];
+          }
+        else
+          {
+          offset += lower[d] * m_Strides[d];
+          negative = !negative;
+          }
+        }
+      ( negative ? negativeCorners : positiveCorners ).push_back( offset );
+      }
+
+    for ( SizeValueType x = 0; x < lineLength; ++x )
+      {
+      const OffsetValueType position = index[0] + static_cast< OffsetValueType >( x ) - tableStart0;
+      const OffsetValueType lower0 = std::max( position - radius0, OffsetValueType( 0 ) );
+      const OffsetValueType upper0 = std::min( position + radius0 + 1, tableSize0 );
+      AccumulateType        sum = NumericTraits< AccumulateType >::ZeroValue();
+      for ( const auto & corner : positiveCorners )
+        {
+        sum += table[corner + upper0] - table[corner + lower0];
+        }
+      for ( const auto & corner : negativeCorners )
+        {
+        sum -= table[corner + upper0] - table[corner + lower0];
+        }
+      function( sum, lineNumberOfPixels * static_cast< SizeValueType >( upper0 - lower0 ) );
+      }
+
+    for ( unsigned int d = 1; d < VDimension; ++d )
+      {
+      if ( ++index[d] < region.GetIndex(d) + static_cast< OffsetValueType >( region.GetSize(d) ) )
+        {
+        break;
+        }
+      index[d] = region.GetIndex(d);
+      }
+    }
+}
+} // end namespace itk
+
+#endif
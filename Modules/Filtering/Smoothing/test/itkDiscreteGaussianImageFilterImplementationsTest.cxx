@@ -0,0 +1,278 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCastImageFilter.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Compare the direct smoothing of scalar images, in an internal image,
+// with the pipeline of NeighborhoodOperatorImageFilter which smooths the
+// images of one component vectors, in one to three dimensions and
+// through a StreamingImageFilter. Then compare the recursive and FFT
+// implementations with the direct one, and check the implementations
+// selected automatically.
+
+namespace
+{
+
+template< unsigned int VDimension >
+typename itk::Image< float, VDimension >::Pointer
+MakeImage( const itk::Size< VDimension > & size )
+{
+  using ImageType = itk::Image< float, VDimension >;
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 1234 );
+
+  typename ImageType::Pointer image = ImageType::New();
+  typename ImageType::IndexType index;
+  typename ImageType::SpacingType spacing;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    index[d] = 3 - 2 * static_cast< int >( d );
+    spacing[d] = 0.5 + 0.25 * d;
+    }
+  image->SetRegions( typename ImageType::RegionType( index, size ) );
+  image->SetSpacing( spacing );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( generator->GetUniformVariate( 0.0, 100.0 ) ) );
+    }
+  return image;
+}
+
+template< typename TFilter >
+typename TFilter::OutputImageType::Pointer
+Smooth( TFilter * filter, unsigned int numberOfStreamDivisions )
+{
+  using OutputImageType = typename TFilter::OutputImageType;
+  using StreamingFilterType = itk::StreamingImageFilter< OutputImageType, OutputImageType >;
+  typename StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+template< typename TImage, typename TExpectedImage >
+bool
+Compare( const TImage * image, const TExpectedImage * expected, double tolerance, const std::string & name )
+{
+  if ( image->GetBufferedRegion() != expected->GetBufferedRegion() )
+    {
+    std::cerr << name << ": wrong region " << image->GetBufferedRegion() << std::endl;
+    return false;
+    }
+  double maximumDifference = 0.0;
+  itk::ImageRegionConstIteratorWithIndex< TExpectedImage > it( expected, expected->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const double difference =
+      std::abs( static_cast< double >( image->GetPixel( it.GetIndex() ) ) - static_cast< double >( it.Get()[0] ) );
+    maximumDifference = std::max( maximumDifference, difference );
+    }
+  std::cout << name << ": maximum difference " << maximumDifference << std::endl;
+  if ( maximumDifference > tolerance )
+    {
+    std::cerr << name << ": maximum difference greater than " << tolerance << std::endl;
+    return false;
+    }
+  return true;
+}
+
+template< unsigned int VDimension >
+int
+CompareWithOperatorFilters( const itk::Size< VDimension > & size, unsigned int filterDimensionality )
+{
+  using ImageType = itk::Image< float, VDimension >;
+  using VectorImageType = itk::Image< itk::Vector< float, 1 >, VDimension >;
+  using FilterType = itk::DiscreteGaussianImageFilter< ImageType, ImageType >;
+  using VectorFilterType = itk::DiscreteGaussianImageFilter< VectorImageType, VectorImageType >;
+
+  typename ImageType::Pointer image = MakeImage< VDimension >( size );
+  using CastType = itk::CastImageFilter< ImageType, VectorImageType >;
+  typename CastType::Pointer cast = CastType::New();
+  cast->SetInput( image );
+  cast->Update();
+
+  typename FilterType::ArrayType variance;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    variance[d] = 0.5 + 0.75 * d;
+    }
+
+  typename VectorFilterType::Pointer vectorFilter = VectorFilterType::New();
+  vectorFilter->SetInput( cast->GetOutput() );
+  vectorFilter->SetVariance( variance );
+  vectorFilter->SetFilterDimensionality( filterDimensionality );
+  typename VectorImageType::Pointer expected = Smooth< VectorFilterType >( vectorFilter, 1 );
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetVariance( variance );
+  filter->SetFilterDimensionality( filterDimensionality );
+  filter->SetImplementationToDirect();
+  std::ostringstream name;
+  name << "Direct, dimension " << VDimension << ", filter dimensionality " << filterDimensionality;
+  if ( !Compare( Smooth< FilterType >( filter, 1 ).GetPointer(), expected.GetPointer(), 1e-4, name.str() )
+       || !Compare( Smooth< FilterType >( filter, 5 ).GetPointer(), expected.GetPointer(), 1e-4,
+                    name.str() + ", streamed" ) )
+    {
+    return EXIT_FAILURE;
+    }
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[d], FilterType::ImplementationEnum::DIRECT );
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkDiscreteGaussianImageFilterImplementationsTest( int, char *[] )
+{
+  itk::Size< 1 > size1 = { { 57 } };
+  itk::Size< 2 > size2 = { { 41, 26 } };
+  itk::Size< 3 > size3 = { { 37, 22, 17 } };
+  if ( CompareWithOperatorFilters< 1 >( size1, 1 ) != EXIT_SUCCESS
+       || CompareWithOperatorFilters< 2 >( size2, 2 ) != EXIT_SUCCESS
+       || CompareWithOperatorFilters< 3 >( size3, 3 ) != EXIT_SUCCESS
+       || CompareWithOperatorFilters< 3 >( size3, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image< float, Dimension >;
+  using VectorImageType = itk::Image< itk::Vector< float, 1 >, Dimension >;
+  using FilterType = itk::DiscreteGaussianImageFilter< ImageType, ImageType >;
+
+  ImageType::SizeType size;
+  size[0] = 256;
+  size[1] = 200;
+  size[2] = 3;
+  ImageType::Pointer image = MakeImage< Dimension >( size );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetUseImageSpacing( false );
+  TEST_SET_GET_VALUE( FilterType::ImplementationEnum::AUTOMATIC, filter->GetImplementation() );
+
+  // Small kernels are applied directly
+  filter->SetVariance( 1.0 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[d], FilterType::ImplementationEnum::DIRECT );
+    }
+
+  // With a large variance, the kernel is truncated to MaximumKernelWidth
+  // and the recursive filters are more accurate, but not along the third
+  // direction, too short for them.
+  filter->SetVariance( 100.0 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[0], FilterType::ImplementationEnum::RECURSIVE );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[1], FilterType::ImplementationEnum::RECURSIVE );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[2], FilterType::ImplementationEnum::DIRECT );
+
+  // Unless the kernel is wide enough and the required accuracy is out of
+  // their reach: the FFT is used
+  filter->SetVariance( 144.0 );
+  filter->SetMaximumKernelWidth( 1000 );
+  filter->SetMaximumError( 0.0001 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[0], FilterType::ImplementationEnum::FFT );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[1], FilterType::ImplementationEnum::FFT );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[2], FilterType::ImplementationEnum::DIRECT );
+
+  // The implementations give the same smoothing, up to the accuracy of
+  // the direct kernel or of the recursive filters
+  filter->SetMaximumError( 0.001 );
+  filter->SetVariance( 6.0 );
+  filter->SetImplementationToDirect();
+  ImageType::Pointer direct = Smooth< FilterType >( filter, 1 );
+  using CastType = itk::CastImageFilter< ImageType, VectorImageType >;
+  CastType::Pointer cast = CastType::New();
+  cast->SetInput( direct );
+  cast->Update();
+  const VectorImageType * expected = cast->GetOutput();
+
+  filter->SetImplementationToFFT();
+  if ( !Compare( Smooth< FilterType >( filter, 1 ).GetPointer(), expected, 0.2, "FFT" ) )
+    {
+    return EXIT_FAILURE;
+    }
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[0], FilterType::ImplementationEnum::FFT );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[2], FilterType::ImplementationEnum::FFT );
+
+  filter->SetImplementationToRecursive();
+  if ( !Compare( Smooth< FilterType >( filter, 1 ).GetPointer(), expected, 2.0, "Recursive" )
+       || !Compare( Smooth< FilterType >( filter, 4 ).GetPointer(), expected, 2.0, "Recursive, streamed" ) )
+    {
+    return EXIT_FAILURE;
+    }
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[0], FilterType::ImplementationEnum::RECURSIVE );
+  TEST_EXPECT_EQUAL( filter->GetSelectedImplementations()[2], FilterType::ImplementationEnum::DIRECT );
+
+  filter->SetImplementationToAutomatic();
+  if ( !Compare( Smooth< FilterType >( filter, 3 ).GetPointer(), expected, 2.0, "Automatic, streamed" ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The images of integer pixels are still cast to the output pixel type
+  // after each direction, like the images of vector pixels
+  using CharImageType = itk::Image< unsigned char, Dimension >;
+  using CharVectorImageType = itk::Image< itk::Vector< unsigned char, 1 >, Dimension >;
+  using CharFilterType = itk::DiscreteGaussianImageFilter< CharImageType, CharImageType >;
+  using CharVectorFilterType = itk::DiscreteGaussianImageFilter< CharVectorImageType, CharVectorImageType >;
+  using CharCastType = itk::CastImageFilter< ImageType, CharImageType >;
+  using CharVectorCastType = itk::CastImageFilter< ImageType, CharVectorImageType >;
+  CharCastType::Pointer charCast = CharCastType::New();
+  charCast->SetInput( image );
+  CharVectorCastType::Pointer charVectorCast = CharVectorCastType::New();
+  charVectorCast->SetInput( image );
+
+  CharVectorFilterType::Pointer charVectorFilter = CharVectorFilterType::New();
+  charVectorFilter->SetInput( charVectorCast->GetOutput() );
+  charVectorFilter->SetUseImageSpacing( false );
+  charVectorFilter->SetVariance( 100.0 );
+  CharVectorImageType::Pointer charExpected = Smooth< CharVectorFilterType >( charVectorFilter, 1 );
+
+  CharFilterType::Pointer charFilter = CharFilterType::New();
+  charFilter->SetInput( charCast->GetOutput() );
+  charFilter->SetUseImageSpacing( false );
+  charFilter->SetVariance( 100.0 );
+  if ( !Compare( Smooth< CharFilterType >( charFilter, 3 ).GetPointer(), charExpected.GetPointer(), 0.0,
+                 "Automatic, integer pixels" ) )
+    {
+    return EXIT_FAILURE;
+    }
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    TEST_EXPECT_EQUAL( charFilter->GetSelectedImplementations()[d], CharFilterType::ImplementationEnum::DIRECT );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
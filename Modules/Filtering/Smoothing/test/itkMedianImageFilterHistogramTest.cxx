@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMedianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+
+// Compare the medians of images of 8 and 16 bit pixels, which are
+// computed with a moving histogram inside the image, with those of the
+// same images of float pixels, for several radii, through a
+// StreamingImageFilter, then check a MedianHistogram directly.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using RealImageType = itk::Image< float, Dimension >;
+using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+
+template< typename TImage >
+typename TImage::Pointer
+Median( const TImage * image, const typename TImage::SizeType & radius, unsigned int numberOfStreamDivisions )
+{
+  using FilterType = itk::MedianImageFilter< TImage, TImage >;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetRadius( radius );
+
+  using StreamingFilterType = itk::StreamingImageFilter< TImage, TImage >;
+  typename StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+template< typename TPixel >
+int
+CompareMedians( double minimum, double maximum )
+{
+  using ImageType = itk::Image< TPixel, Dimension >;
+
+  RealImageType::IndexType index;
+  index[0] = -4;
+  index[1] = 7;
+  index[2] = 2;
+  RealImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 25;
+  size[2] = 11;
+  const RealImageType::RegionType region( index, size );
+
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 5678 + sizeof( TPixel ) );
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+  RealImageType::Pointer realImage = RealImageType::New();
+  realImage->SetRegions( region );
+  realImage->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    // Smooth variations and noise, over the whole range of the pixels
+    const double smooth = 0.5 + 0.5 * std::sin( 0.2 * it.GetIndex()[0] + 0.3 * it.GetIndex()[1] );
+    const double noise = generator->GetUniformVariate( -0.5, 0.5 );
+    const double value = minimum + ( maximum - minimum ) * std::min( std::max( smooth + noise, 0.0 ), 1.0 );
+    it.Set( static_cast< TPixel >( value ) );
+    realImage->SetPixel( it.GetIndex(), static_cast< float >( it.Get() ) );
+    }
+
+  const unsigned int radii[][Dimension] = { { 1, 1, 1 }, { 3, 2, 1 }, { 0, 4, 2 }, { 5, 0, 0 } };
+  for ( const auto & r : radii )
+    {
+    typename ImageType::SizeType radius;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      radius[d] = r[d];
+      }
+    std::cout << "Pixel size " << sizeof( TPixel ) << ", radius " << radius << std::endl;
+
+    RealImageType::Pointer expected = Median< RealImageType >( realImage, radius, 1 );
+    for ( unsigned int numberOfStreamDivisions : { 1u, 4u } )
+      {
+      typename ImageType::Pointer median = Median< ImageType >( image, radius, numberOfStreamDivisions );
+      TEST_EXPECT_EQUAL( median->GetBufferedRegion(), region );
+      itk::ImageRegionConstIteratorWithIndex< RealImageType > eit( expected, region );
+      for ( eit.GoToBegin(); !eit.IsAtEnd(); ++eit )
+        {
+        const TPixel value = median->GetPixel( eit.GetIndex() );
+        if ( static_cast< float >( value ) != eit.Get() )
+          {
+          std::cerr << "Wrong median at " << eit.GetIndex() << ": " << static_cast< double >( value )
+                    << " expected " << eit.Get() << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkMedianImageFilterHistogramTest( int, char *[] )
+{
+  if ( CompareMedians< unsigned char >( 0.0, 255.0 ) != EXIT_SUCCESS
+       || CompareMedians< short >( -32768.0, 32767.0 ) != EXIT_SUCCESS
+       || CompareMedians< unsigned short >( 100.0, 1200.0 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The histogram follows the values which are added and removed
+  using HistogramType = itk::Function::MedianHistogram< short >;
+  HistogramType histogram;
+  TEST_EXPECT_TRUE( !histogram.IsValid() );
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 91 );
+  std::vector< short > values;
+  for ( unsigned int i = 0; i < 2000; ++i )
+    {
+    if ( values.empty() || generator->GetVariateWithClosedRange() < 0.6 )
+      {
+      const short value = static_cast< short >( generator->GetIntegerVariate( 65535 ) - 32768 );
+      values.push_back( value );
+      histogram.AddPixel( value );
+      }
+    else
+      {
+      const std::vector< short >::size_type position = generator->GetIntegerVariate( values.size() - 1 );
+      histogram.RemovePixel( values[position] );
+      values.erase( values.begin() + position );
+      }
+    if ( !values.empty() )
+      {
+      std::vector< short > sorted( values );
+      std::nth_element( sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end() );
+      TEST_EXPECT_TRUE( histogram.IsValid() );
+      TEST_EXPECT_EQUAL( histogram.GetValue(), sorted[sorted.size() / 2] );
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
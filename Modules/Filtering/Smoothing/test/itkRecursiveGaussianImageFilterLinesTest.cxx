@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Compare the recursive gaussian filters of scalar images, which filter
+// several lines at a time, with the same filters of images of one
+// component vectors, which filter one line at a time, along each
+// direction and through a StreamingImageFilter. Then compare the fused
+// SmoothingRecursiveGaussianImageFilter with a pipeline of recursive
+// gaussian filters followed by a cast.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using ImageType = itk::Image< float, Dimension >;
+using VectorImageType = itk::Image< itk::Vector< float, 1 >, Dimension >;
+
+template< typename TImage >
+typename TImage::Pointer
+MakeImage( const ImageType * image )
+{
+  using CastType = itk::CastImageFilter< ImageType, TImage >;
+  typename CastType::Pointer cast = CastType::New();
+  cast->SetInput( image );
+  cast->Update();
+  return cast->GetOutput();
+}
+
+template< typename TImage >
+typename TImage::Pointer
+Filter( const TImage * image, unsigned int direction,
+        typename itk::RecursiveGaussianImageFilter< TImage >::OrderEnumType order,
+        unsigned int numberOfStreamDivisions )
+{
+  using FilterType = itk::RecursiveGaussianImageFilter< TImage >;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetDirection( direction );
+  filter->SetOrder( order );
+  filter->SetSigma( 1.7 );
+  using StreamingFilterType = itk::StreamingImageFilter< TImage, TImage >;
+  typename StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+template< typename TImage, typename TExpectedImage, typename TFunction >
+int
+Compare( const TImage * image, const TExpectedImage * expected, double tolerance, TFunction expectedValue )
+{
+  TEST_EXPECT_EQUAL( image->GetBufferedRegion(), expected->GetBufferedRegion() );
+  itk::ImageRegionConstIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const double value = it.Get();
+    const double expectedPixel = expectedValue( expected->GetPixel( it.GetIndex() ) );
+    if ( std::abs( value - expectedPixel ) > tolerance * ( 1.0 + std::abs( expectedPixel ) ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << value << " expected " << expectedPixel << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+template< unsigned int VDimension, typename TOutputPixel >
+int
+CompareSmoothing( double tolerance )
+{
+  using InputImageType = itk::Image< unsigned char, VDimension >;
+  using RealImageType = itk::Image< float, VDimension >;
+  using OutputImageType = itk::Image< TOutputPixel, VDimension >;
+
+  typename InputImageType::Pointer image = InputImageType::New();
+  typename InputImageType::SizeType size;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    size[d] = 9 + 4 * d;
+    }
+  image->SetRegions( size );
+  image->Allocate();
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 321 );
+  itk::ImageRegionIterator< InputImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< unsigned char >( generator->GetIntegerVariate( 255 ) ) );
+    }
+
+  typename itk::SmoothingRecursiveGaussianImageFilter< InputImageType, OutputImageType >::SigmaArrayType sigmas;
+  using FirstFilterType = itk::RecursiveGaussianImageFilter< InputImageType, RealImageType >;
+  typename FirstFilterType::Pointer first = FirstFilterType::New();
+  first->SetInput( image );
+  first->SetDirection( 0 );
+  sigmas[0] = 1.5;
+  first->SetSigma( sigmas[0] );
+  typename RealImageType::Pointer expected = first->GetOutput();
+  first->Update();
+  for ( unsigned int d = 1; d < VDimension; ++d )
+    {
+    using FilterType = itk::RecursiveGaussianImageFilter< RealImageType, RealImageType >;
+    typename FilterType::Pointer filter = FilterType::New();
+    filter->SetInput( expected );
+    filter->SetDirection( d );
+    sigmas[d] = 1.5 + 0.5 * d;
+    filter->SetSigma( sigmas[d] );
+    filter->Update();
+    expected = filter->GetOutput();
+    }
+
+  using SmoothingFilterType = itk::SmoothingRecursiveGaussianImageFilter< InputImageType, OutputImageType >;
+  typename SmoothingFilterType::Pointer smoothing = SmoothingFilterType::New();
+  smoothing->SetInput( image );
+  smoothing->SetSigmaArray( sigmas );
+  TRY_EXPECT_NO_EXCEPTION( smoothing->Update() );
+  return Compare( smoothing->GetOutput(), expected.GetPointer(), tolerance,
+                  []( float value ) { return static_cast< double >( static_cast< TOutputPixel >( value ) ); } );
+}
+
+}
+
+int itkRecursiveGaussianImageFilterLinesTest( int, char *[] )
+{
+  ImageType::IndexType index;
+  index[0] = -4;
+  index[1] = 3;
+  index[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 21;
+  size[2] = 13;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( ImageType::RegionType( index, size ) );
+  image->Allocate();
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 123 );
+  itk::ImageRegionIterator< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< float >( generator->GetUniformVariate( -10.0, 100.0 ) ) );
+    }
+  VectorImageType::Pointer vectorImage = MakeImage< VectorImageType >( image );
+
+  using FilterType = itk::RecursiveGaussianImageFilter< ImageType >;
+  for ( unsigned int direction = 0; direction < Dimension; ++direction )
+    {
+    for ( auto order : { FilterType::ZeroOrder, FilterType::FirstOrder, FilterType::SecondOrder } )
+      {
+      for ( unsigned int divisions : { 1, 5 } )
+        {
+        std::cout << "Direction " << direction << ", order " << order << ", " << divisions << " divisions"
+                  << std::endl;
+        ImageType::Pointer output = Filter< ImageType >( image, direction, order, divisions );
+        VectorImageType::Pointer expected = Filter< VectorImageType >(
+          vectorImage, direction,
+          static_cast< itk::RecursiveGaussianImageFilter< VectorImageType >::OrderEnumType >( order ), divisions );
+        if ( Compare( output.GetPointer(), expected.GetPointer(), 1e-5,
+                      []( const VectorImageType::PixelType & value ) { return static_cast< double >( value[0] ); } )
+             != EXIT_SUCCESS )
+          {
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  // The last smoothing filter casts to the output pixel type
+  std::cout << "SmoothingRecursiveGaussianImageFilter" << std::endl;
+  if ( CompareSmoothing< 2, float >( 1e-5 ) != EXIT_SUCCESS
+       || CompareSmoothing< 3, float >( 1e-5 ) != EXIT_SUCCESS
+       || CompareSmoothing< 4, float >( 1e-5 ) != EXIT_SUCCESS
+       || CompareSmoothing< 3, unsigned char >( 0.01 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
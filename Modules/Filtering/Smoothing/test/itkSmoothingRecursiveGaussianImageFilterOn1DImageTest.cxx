@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// In 1-D, the filter must smooth once along the only dimension, as a
+// single RecursiveGaussianImageFilter does.
+template< typename TInputImage, typename TOutputImage >
+int
+SmoothOnceTest( bool inPlace )
+{
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+
+  typename InputImageType::Pointer input = InputImageType::New();
+  typename InputImageType::SizeType size;
+  size[0] = 64;
+  input->SetRegions( size );
+  input->Allocate();
+  for ( itk::IndexValueType i = 0; i < 64; ++i )
+    {
+    typename InputImageType::IndexType index;
+    index[0] = i;
+    input->SetPixel( index, static_cast< typename InputImageType::PixelType >( ( i * 37 ) % 64 ) );
+    }
+
+  const double sigma = 2.5;
+
+  using ReferenceFilterType = itk::RecursiveGaussianImageFilter< InputImageType, OutputImageType >;
+  typename ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput( input );
+  reference->SetDirection( 0 );
+  reference->SetOrder( ReferenceFilterType::ZeroOrder );
+  reference->SetSigma( sigma );
+  TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+
+  using FilterType = itk::SmoothingRecursiveGaussianImageFilter< InputImageType, OutputImageType >;
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( input );
+  filter->SetSigma( sigma );
+  filter->SetInPlace( inPlace );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  itk::ImageRegionConstIterator< OutputImageType > it( filter->GetOutput(), filter->GetOutput()->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< OutputImageType > refIt( reference->GetOutput(),
+                                                          reference->GetOutput()->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++refIt )
+    {
+    if ( !itk::Math::FloatAlmostEqual( static_cast< double >( it.Get() ), static_cast< double >( refIt.Get() ),
+                                       4, 1e-5 ) )
+      {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "At index " << it.GetIndex() << ", expected " << refIt.Get() << ", but got " << it.Get()
+                << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkSmoothingRecursiveGaussianImageFilterOn1DImageTest( int, char *[] )
+{
+  using FloatImageType = itk::Image< float, 1 >;
+  using ShortImageType = itk::Image< short, 1 >;
+
+  int testStatus = EXIT_SUCCESS;
+  if ( SmoothOnceTest< FloatImageType, FloatImageType >( false ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+  if ( SmoothOnceTest< FloatImageType, FloatImageType >( true ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+  if ( SmoothOnceTest< ShortImageType, FloatImageType >( false ) == EXIT_FAILURE )
+    {
+    testStatus = EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBoxMeanImageFilter.h"
+#include "itkBoxSigmaImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkStreamingImageFilter.h"
+#include "itkSummedAreaTable.h"
+#include "itkTestingMacros.h"
+
+// Compare the box sums of summed area tables of several accumulation
+// types, computed serially and in parallel, and the outputs of the box
+// mean and sigma filters, through a StreamingImageFilter, with sums over
+// the cropped boxes computed pixel by pixel.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using PixelType = short;
+using ImageType = itk::Image< PixelType, Dimension >;
+using RealImageType = itk::Image< double, Dimension >;
+
+struct BoxStatistics
+{
+  double             m_Sum;
+  double             m_SquareSum;
+  itk::SizeValueType m_NumberOfPixels;
+};
+
+BoxStatistics
+ComputeBoxStatistics( const ImageType * image, const ImageType::RegionType & region, const ImageType::IndexType & center,
+                      const ImageType::SizeType & radius )
+{
+  ImageType::IndexType boxIndex;
+  ImageType::SizeType  boxSize;
+  for ( unsigned int d = 0; d < Dimension; ++d )
+    {
+    boxIndex[d] = center[d] - static_cast< itk::OffsetValueType >( radius[d] );
+    boxSize[d] = 2 * radius[d] + 1;
+    }
+  ImageType::RegionType box( boxIndex, boxSize );
+  box.Crop( region );
+  BoxStatistics statistics = { 0.0, 0.0, box.GetNumberOfPixels() };
+  itk::ImageRegionConstIterator< ImageType > it( image, box );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    statistics.m_Sum += it.Get();
+    statistics.m_SquareSum += static_cast< double >( it.Get() ) * it.Get();
+    }
+  return statistics;
+}
+
+template< typename TAccumulate >
+int
+CheckSummedAreaTable( const ImageType * image, const ImageType::RegionType & region, const ImageType::SizeType & radius,
+                      bool compensated, itk::MultiThreaderBase * threader, double tolerance )
+{
+  using TableType = itk::SummedAreaTable< TAccumulate, Dimension >;
+  TableType table;
+  TEST_SET_GET_VALUE( true, table.GetCompensatedSummation() );
+  table.SetCompensatedSummation( compensated );
+  table.Compute( image, region, [](PixelType p) { return static_cast< TAccumulate >( p ); }, threader );
+  TEST_EXPECT_EQUAL( table.GetRegion(), region );
+
+  // Check the boxes of a subregion which touches the end of the region
+  ImageType::RegionType subregion = region;
+  subregion.SetIndex( 1, region.GetIndex(1) + 3 );
+  subregion.SetSize( 1, region.GetSize(1) - 3 );
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( image, subregion );
+  it.GoToBegin();
+  bool ok = true;
+  table.ForEachBoxSum( subregion, radius, [&](const TAccumulate & sum, itk::SizeValueType numberOfPixels)
+    {
+      const BoxStatistics expected = ComputeBoxStatistics( image, region, it.GetIndex(), radius );
+      itk::SizeValueType  boxNumberOfPixels = 0;
+      const TAccumulate   boxSum = table.GetBoxSum( it.GetIndex(), radius, boxNumberOfPixels );
+      if ( ok && ( numberOfPixels != expected.m_NumberOfPixels || boxNumberOfPixels != expected.m_NumberOfPixels
+                   || std::abs( static_cast< double >( sum ) - expected.m_Sum ) > tolerance
+                   || std::abs( static_cast< double >( boxSum ) - expected.m_Sum ) > tolerance ) )
+        {
+        std::cerr << "Wrong sum at " << it.GetIndex() << ": " << static_cast< double >( sum ) << " and "
+                  << static_cast< double >( boxSum ) << " of " << numberOfPixels << " pixels, expected "
+                  << expected.m_Sum << " of " << expected.m_NumberOfPixels << std::endl;
+        ok = false;
+        }
+      ++it;
+    } );
+  TEST_EXPECT_TRUE( ok );
+  TEST_EXPECT_TRUE( it.IsAtEnd() );
+
+  table.Release();
+  TEST_EXPECT_EQUAL( table.GetRegion().GetNumberOfPixels(), 0 );
+  return EXIT_SUCCESS;
+}
+
+template< typename TFilter >
+typename TFilter::OutputImageType::Pointer
+Filter( const ImageType * image, const ImageType::SizeType & radius, unsigned int numberOfStreamDivisions )
+{
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput( image );
+  filter->SetRadius( radius );
+  using OutputImageType = typename TFilter::OutputImageType;
+  using StreamingFilterType = itk::StreamingImageFilter< OutputImageType, OutputImageType >;
+  typename StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+  return streamer->GetOutput();
+}
+
+}
+
+int itkSummedAreaTableTest( int, char *[] )
+{
+  ImageType::IndexType index;
+  index[0] = 3;
+  index[1] = -6;
+  index[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 41;
+  size[1] = 29;
+  size[2] = 13;
+  const ImageType::RegionType region( index, size );
+
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 4321 );
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+  itk::ImageRegionIterator< ImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< PixelType >( 20000 + generator->GetIntegerVariate( 2000 ) ) );
+    }
+
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  ImageType::SizeType             radius;
+  radius[0] = 2;
+  radius[1] = 4;
+  radius[2] = 1;
+  ImageType::RegionType tableRegion = region;
+  tableRegion.ShrinkByRadius( 1 );
+  if ( CheckSummedAreaTable< std::int64_t >( image, tableRegion, radius, true, threader, 0.0 ) != EXIT_SUCCESS
+       || CheckSummedAreaTable< std::int64_t >( image, region, radius, false, nullptr, 0.0 ) != EXIT_SUCCESS
+       || CheckSummedAreaTable< double >( image, region, radius, false, threader, 1e-6 ) != EXIT_SUCCESS
+       || CheckSummedAreaTable< float >( image, region, radius, true, threader, 256.0 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The compensated float sums are more accurate over a large region
+  ImageType::SizeType largeSize;
+  largeSize[0] = 500;
+  largeSize[1] = 400;
+  largeSize[2] = 2;
+  ImageType::Pointer largeImage = ImageType::New();
+  largeImage->SetRegions( largeSize );
+  largeImage->Allocate();
+  itk::ImageRegionIterator< ImageType > lit( largeImage, largeImage->GetBufferedRegion() );
+  for ( lit.GoToBegin(); !lit.IsAtEnd(); ++lit )
+    {
+    lit.Set( static_cast< PixelType >( 20000 + generator->GetIntegerVariate( 2000 ) ) );
+    }
+  const ImageType::RegionType largeRegion = largeImage->GetBufferedRegion();
+  const BoxStatistics         largeStatistics = ComputeBoxStatistics( largeImage, largeRegion, largeRegion.GetIndex(),
+                                                                      largeSize );
+  using FloatTableType = itk::SummedAreaTable< float, Dimension >;
+  double errors[2];
+  for ( bool compensated : { false, true } )
+    {
+    FloatTableType table;
+    table.SetCompensatedSummation( compensated );
+    table.Compute( largeImage.GetPointer(), largeRegion, [](PixelType p) { return static_cast< float >( p ); } );
+    itk::SizeValueType numberOfPixels;
+    const double       sum = table.GetBoxSum( largeRegion.GetIndex(), largeSize, numberOfPixels );
+    TEST_EXPECT_EQUAL( numberOfPixels, largeRegion.GetNumberOfPixels() );
+    errors[compensated] = std::abs( sum - largeStatistics.m_Sum );
+    }
+  std::cout << "Float sum errors: " << errors[0] << " " << errors[1] << std::endl;
+  TEST_EXPECT_TRUE( errors[1] < errors[0] );
+
+  // Box mean and sigma
+  for ( unsigned int numberOfStreamDivisions : { 1u, 5u } )
+    {
+    RealImageType::Pointer mean = Filter< itk::BoxMeanImageFilter< ImageType, RealImageType > >( image, radius,
+                                                                                                  numberOfStreamDivisions );
+    RealImageType::Pointer sigma = Filter< itk::BoxSigmaImageFilter< ImageType, RealImageType > >( image, radius,
+                                                                                                    numberOfStreamDivisions );
+    itk::ImageRegionConstIteratorWithIndex< RealImageType > mit( mean, region );
+    for ( mit.GoToBegin(); !mit.IsAtEnd(); ++mit )
+      {
+      const BoxStatistics expected = ComputeBoxStatistics( image, region, mit.GetIndex(), radius );
+      const double        n = expected.m_NumberOfPixels;
+      const double        expectedMean = expected.m_Sum / n;
+      const double        expectedSigma =
+        std::sqrt( ( expected.m_SquareSum - expected.m_Sum * expected.m_Sum / n ) / ( n - 1 ) );
+      if ( std::abs( mit.Get() - expectedMean ) > 1e-9 * expectedMean
+           || std::abs( sigma->GetPixel( mit.GetIndex() ) - expectedSigma ) > 1e-6 * ( 1.0 + expectedSigma ) )
+        {
+        std::cerr << "Wrong mean or sigma at " << mit.GetIndex() << ": " << mit.Get() << " "
+                  << sigma->GetPixel( mit.GetIndex() ) << " expected " << expectedMean << " " << expectedSigma
+                  << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@
 #include "itkImageIOBase.h"
 #include "ITKIOGDCMExport.h"
 #include <fstream>
+#include <mutex>
 #include <string>
 
 namespace itk
@@ -91,6 +92,11 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(GDCMImageIO, Superclass);
 
+  /** Clone() copies the UID prefix, KeepOriginalUID, LoadPrivateTags and
+   * compression type, and the Study/Series/Frame of Reference Instance
+   * UIDs, generating them first unless KeepOriginalUID is on. */
+  bool CanCloneSettings() const override;
+
   /*-------- This part of the interface deals with reading data. ------ */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -100,9 +106,32 @@ public:
   /** Set the spacing and dimesion information for the current filename. */
   void ReadImageInformation() override;
 
-  /** Reads the data from disk into the memory buffer provided. */
+  /** Read the information from the elements before the Pixel Data
+   * element only, so that the pixel data of the file is not parsed.
+   * Returns true when the Pixel Data is the last element of the file,
+   * or when the header does not describe the pixels and the whole file
+   * had to be read. Otherwise returns false, as the MetaDataDictionary
+   * lacks the elements that follow the Pixel Data. */
+  bool ReadImageInformationFromHeader() override;
+
+  /** Reads the data from disk into the memory buffer provided. The
+   * frames of a multi-frame object are decoded concurrently when its
+   * transfer syntax allows them to be decoded independently. */
   void Read(void *buffer) override;
 
+  /** Multi-frame objects whose frames can be decoded independently
+   * (uncompressed, RLE, JPEG, JPEG-LS and JPEG 2000 with one fragment
+   * per frame, no palette and no planar configuration) can be read
+   * frame range by frame range. Valid after ReadImageInformation(). */
+  bool CanStreamRead() override
+  {
+    return m_FrameRangesCanBeRead;
+  }
+
+  /** Expand the requested region to whole frames of the requested
+   * frame range when streaming, or to the whole image otherwise. */
+  ImageIORegion GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
   /** Set/Get the original component type of the image. This differs from
    * ComponentType which may change as a function of rescale slope and
    * intercept. */
@@ -265,15 +294,35 @@ protected:
   ~GDCMImageIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  void InternalReadImageInformation();
+  /** Also carry over the DICOM specific settings. */
+  LightObject::Pointer InternalClone() const override;
+
+  /** Read the image information, from the elements before the Pixel
+   * Data element only when headerOnly is true and they describe the
+   * pixels. Returns whether the information was read from them and
+   * elements follow the Pixel Data, so that it is incomplete. */
+  bool InternalReadImageInformation(bool headerOnly = false);
+
+  /** Decode the frames of the IORegion concurrently, each worker
+   * reading a contiguous frame range with its own gdcm reader. Returns
+   * false if GDCM can not decode the frames independently. */
+  bool ReadFrames(void *buffer);
+
+  /** Decode the whole image at once. */
+  void ReadWholeImage(void *buffer);
 
   double m_RescaleSlope;
   double m_RescaleIntercept;
 
-  std::string m_UIDPrefix;
-  std::string m_StudyInstanceUID;
-  std::string m_SeriesInstanceUID;
-  std::string m_FrameOfReferenceInstanceUID;
+  /** Generate the Study/Series/Frame of Reference Instance UIDs, unless
+   * they already were. */
+  void GenerateInstanceUIDs() const;
+
+  std::string         m_UIDPrefix;
+  mutable std::string m_StudyInstanceUID;
+  mutable std::string m_SeriesInstanceUID;
+  mutable std::string m_FrameOfReferenceInstanceUID;
+  mutable std::mutex  m_InstanceUIDMutex;
 
   bool m_KeepOriginalUID;
 
@@ -306,6 +355,10 @@ private:
 
   ImageIOBase::IOComponentType m_InternalComponentType;
   InternalHeader *             m_DICOMHeader;
+
+  /** Whether the frames of the current file can be decoded
+   * independently of each other. */
+  bool m_FrameRangesCanBeRead{false};
 };
 } // end namespace itk
 
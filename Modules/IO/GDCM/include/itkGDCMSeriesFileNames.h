@@ -21,6 +21,7 @@
 #include "itkProcessObject.h"
 #include "itkObjectFactory.h"
 #include "itkMacro.h"
+#include <map>
 #include <vector>
 #include "gdcmSerieHelper.h"
 #include "ITKIOGDCMExport.h"
@@ -45,6 +46,14 @@ namespace itk
  *    DICOM objects, you may want to try calling SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ *  Sorting a directory requires parsing the header of every file in
+ *    it. When the same directories are scanned repeatedly, a persistent
+ *    header index can be enabled with SetHeaderIndexFileName() prior to
+ *    calling SetDirectory(). The tags needed for sorting are then read
+ *    concurrently, only up to the Pixel Data element, and stored in the
+ *    index file keyed by file name, size and modification time. Later
+ *    scans only parse the files that are new or have changed.
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -153,6 +162,7 @@ public:
   void AddSeriesRestriction(const std::string & tag)
   {
     m_SerieHelper->AddRestriction(tag);
+    m_SeriesRestrictions.push_back(tag);
   }
 
   /** Parse any sequences in the DICOM file. Defaults to false
@@ -171,12 +181,52 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Set/Get the file used as a persistent index of the parsed
+   * headers. When set, the headers are parsed concurrently and only
+   * for the files whose size or modification time differ from the
+   * index, which is then updated. Several directories may share the
+   * same index file. Empty by default, which disables the index.
+   * Must be set before the call to SetInputDirectory(). */
+  itkSetStringMacro(HeaderIndexFileName);
+  itkGetStringMacro(HeaderIndexFileName);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Sorting information parsed from the header of one file */
+  struct HeaderIndexEntry
+  {
+    unsigned long                        m_FileSize{ 0 };
+    long                                 m_ModifiedTime{ 0 };
+    bool                                 m_IsImage{ false };
+    std::map< std::string, std::string > m_Tags;
+    double                               m_Origin[3]{ 0.0, 0.0, 0.0 };
+    double                               m_DirectionCosines[6]{ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  };
+  using HeaderIndexType = std::map< std::string, HeaderIndexEntry >;
+
+  /** Scan the input directory using the header index */
+  void ScanDirectoryWithHeaderIndex();
+
+  /** Parse the tags needed for sorting from a header */
+  void ReadHeaderIndexEntry(const std::string & filename, HeaderIndexEntry & entry) const;
+
+  bool ReadHeaderIndex();
+  void WriteHeaderIndex();
+
+  /** Tags read into the header index entries */
+  std::vector< std::string > GetHeaderIndexTags() const;
+
+  /** Series identifier of an entry, as built by gdcm::SerieHelper */
+  std::string CreateUniqueSeriesIdentifier(const HeaderIndexEntry & entry) const;
+
+  /** Order the files of a series as gdcm::SerieHelper does */
+  void OrderIndexedFileNames(FileNamesContainerType & filenames) const;
+
+
   /** Contains the input directory where the DICOM serie is found */
   std::string m_InputDirectory;
 
@@ -197,6 +247,18 @@ private:
   bool m_Recursive;
   bool m_LoadSequences;
   bool m_LoadPrivateTags;
+
+  /** Tags added to the series identifier when UseSeriesDetails is on */
+  std::vector< std::string > m_SeriesRestrictions;
+
+  std::string m_HeaderIndexFileName;
+
+  /** Index loaded from m_HeaderIndexFileName */
+  HeaderIndexType m_HeaderIndex;
+
+  /** Image files of the last scan done with the header index, in
+   * directory order. Empty when the index is not used. */
+  FileNamesContainerType m_IndexedFileNames;
 };
 } //namespace ITK
 
@@ -47,14 +47,22 @@
 #include "gdcmImageChangePlanarConfiguration.h"
 #include "gdcmRescaler.h"
 #include "gdcmImageReader.h"
+#include "gdcmImageRegionReader.h"
+#include "gdcmBoxRegion.h"
 #include "gdcmImageWriter.h"
 #include "gdcmUIDGenerator.h"
 #include "gdcmAttribute.h"
 #include "gdcmGlobal.h"
 #include "gdcmMediaStorage.h"
 
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <sstream>
+#include <typeinfo>
 
 namespace itk {
 
@@ -120,6 +128,60 @@ GDCMImageIO::~GDCMImageIO()
   delete this->m_DICOMHeader;
 }
 
+LightObject::Pointer
+GDCMImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_UIDPrefix = m_UIDPrefix;
+  rval->m_KeepOriginalUID = m_KeepOriginalUID;
+  rval->m_LoadPrivateTags = m_LoadPrivateTags;
+  rval->m_CompressionType = m_CompressionType;
+
+  // All the clones write to the same Study/Series/Frame of Reference
+  if ( !m_KeepOriginalUID )
+    {
+    this->GenerateInstanceUIDs();
+    }
+  rval->m_StudyInstanceUID = m_StudyInstanceUID;
+  rval->m_SeriesInstanceUID = m_SeriesInstanceUID;
+  rval->m_FrameOfReferenceInstanceUID = m_FrameOfReferenceInstanceUID;
+
+  return loPtr;
+}
+
+bool
+GDCMImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
+void
+GDCMImageIO::GenerateInstanceUIDs() const
+{
+  // Clones may be requested concurrently, e.g. by ImageSeriesWriter
+  std::lock_guard< std::mutex > lock( m_InstanceUIDMutex );
+  // We only create *ONE* Study/Series/Frame of Reference Instance UID.
+  // As long as user maintain there gdcmIO they will keep the same
+  // Study/Series instance UID.
+  if ( m_StudyInstanceUID.empty() )
+    {
+    // global static:
+    gdcm::UIDGenerator::SetRoot( m_UIDPrefix.c_str() );
+    gdcm::UIDGenerator uid;
+    m_StudyInstanceUID = uid.Generate();
+    m_SeriesInstanceUID = uid.Generate();
+    m_FrameOfReferenceInstanceUID = uid.Generate();
+    }
+}
+
 /**
  * Helper function to test for some dicom like formatting.
  * @param file A stream to test if the file is dicom like
@@ -274,6 +336,128 @@ void GDCMImageIO::Read(void *pointer)
   this->OpenFileForReading( inputFileStream, m_FileName );
   inputFileStream.close();
 
+  const unsigned int  frameDimension = 2;
+  const SizeValueType numberOfFramesInFile = m_Dimensions[frameDimension];
+  SizeValueType       firstFrame = 0;
+  SizeValueType       numberOfFrames = numberOfFramesInFile;
+  if ( m_IORegion.GetImageDimension() > frameDimension )
+    {
+    firstFrame = m_IORegion.GetIndex(frameDimension);
+    numberOfFrames = m_IORegion.GetSize(frameDimension);
+    }
+
+  if ( m_FrameRangesCanBeRead && this->ReadFrames(pointer) )
+    {
+    return;
+    }
+
+  if ( firstFrame == 0 && numberOfFrames == numberOfFramesInFile )
+    {
+    this->ReadWholeImage(pointer);
+    return;
+    }
+
+  // GDCM could not decode the requested frames on their own: decode
+  // all of them and keep the requested ones.
+  const SizeValueType frameSizeInBytes =
+    static_cast< SizeValueType >( this->GetImageSizeInBytes() ) / numberOfFramesInFile;
+  std::vector< char > wholeImage( static_cast< size_t >( this->GetImageSizeInBytes() ) );
+  this->ReadWholeImage( &wholeImage[0] );
+  memcpy( pointer, &wholeImage[firstFrame * frameSizeInBytes], numberOfFrames * frameSizeInBytes );
+}
+
+bool GDCMImageIO::ReadFrames(void *pointer)
+{
+  const unsigned int  frameDimension = 2;
+  const SizeValueType numberOfFramesInFile = m_Dimensions[frameDimension];
+  SizeValueType       firstFrame = 0;
+  SizeValueType       numberOfFrames = numberOfFramesInFile;
+  if ( m_IORegion.GetImageDimension() > frameDimension )
+    {
+    firstFrame = m_IORegion.GetIndex(frameDimension);
+    numberOfFrames = m_IORegion.GetSize(frameDimension);
+    }
+  if ( numberOfFrames == 0 )
+    {
+    return true;
+    }
+
+  const SizeValueType frameSizeInBytes =
+    static_cast< SizeValueType >( this->GetImageSizeInBytes() ) / numberOfFramesInFile;
+  const bool rescale = ( m_RescaleSlope != 1.0 || m_RescaleIntercept != 0.0 );
+
+  // Each worker decodes a contiguous range of frames with its own
+  // gdcm::ImageRegionReader, straight into its part of the buffer.
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  const SizeValueType numberOfRanges =
+    std::min< SizeValueType >( numberOfFrames, threader->GetNumberOfWorkUnits() );
+
+  std::atomic< bool > succeeded( true );
+  auto readRange = [&]( SizeValueType range )
+    {
+    const SizeValueType rangeStart = firstFrame + range * numberOfFrames / numberOfRanges;
+    const SizeValueType rangeEnd = firstFrame + ( range + 1 ) * numberOfFrames / numberOfRanges;
+    if ( !succeeded || rangeStart == rangeEnd )
+      {
+      return;
+      }
+
+    try
+      {
+      gdcm::ImageRegionReader reader;
+      reader.SetFileName( m_FileName.c_str() );
+      if ( !reader.ReadInformation() )
+        {
+        succeeded = false;
+        return;
+        }
+
+      gdcm::BoxRegion box;
+      box.SetDomain( 0, static_cast< unsigned int >( m_Dimensions[0] - 1 ),
+                     0, static_cast< unsigned int >( m_Dimensions[1] - 1 ),
+                     static_cast< unsigned int >( rangeStart ),
+                     static_cast< unsigned int >( rangeEnd - 1 ) );
+      reader.SetRegion( box );
+
+      const size_t storedLength = reader.ComputeBufferLength();
+      char *       rangeBuffer = static_cast< char * >( pointer ) + ( rangeStart - firstFrame ) * frameSizeInBytes;
+
+      if ( !rescale )
+        {
+        if ( storedLength != ( rangeEnd - rangeStart ) * frameSizeInBytes
+             || !reader.ReadIntoBuffer( rangeBuffer, storedLength ) )
+          {
+          succeeded = false;
+          }
+        return;
+        }
+
+      // The rescaled pixels may be larger than the stored ones, so
+      // decode to a temporary buffer first.
+      std::vector< char > stored( storedLength );
+      if ( storedLength == 0 || !reader.ReadIntoBuffer( &stored[0], storedLength ) )
+        {
+        succeeded = false;
+        return;
+        }
+      gdcm::Rescaler r;
+      r.SetIntercept(m_RescaleIntercept);
+      r.SetSlope(m_RescaleSlope);
+      r.SetPixelFormat( reader.GetImage().GetPixelFormat() );
+      r.Rescale( rangeBuffer, &stored[0], storedLength );
+      }
+    catch ( ... )
+      {
+      succeeded = false;
+      }
+    };
+  threader->ParallelizeArray( 0, numberOfRanges, readRange, nullptr );
+
+  return succeeded;
+}
+
+void GDCMImageIO::ReadWholeImage(void *pointer)
+{
   itkAssertInDebugAndIgnoreInReleaseMacro( gdcm::ImageHelper::GetForceRescaleInterceptSlope() );
   gdcm::ImageReader reader;
   reader.SetFileName( m_FileName.c_str() );
@@ -350,7 +534,88 @@ void GDCMImageIO::Read(void *pointer)
 }
 
 
-void GDCMImageIO::InternalReadImageInformation()
+/**
+ * Helper function to test whether the Pixel Data element is the last
+ * element of a file, so that the elements read before it by reader
+ * are the whole data set.
+ * @param reader A reader which stopped at the value of the Pixel Data
+ * @param fileName The name of the file read by reader
+ * @return true if the value of the Pixel Data ends the file
+ */
+static bool
+pixelDataEndsFile( const gdcm::Reader & reader, const std::string & fileName )
+{
+  const gdcm::TransferSyntax & ts = reader.GetFile().GetHeader().GetDataSetTransferSyntax();
+  if ( ts.IsEncoded() )
+    {
+    // The positions in a deflated data set are not those in the file
+    return false;
+    }
+  const bool           bigEndian = ts.GetSwapCode() == gdcm::SwapCode::BigEndian;
+  const std::streamoff valueOffset = static_cast< std::streamoff >( reader.GetStreamCurrentPosition() );
+  // The tag and value length, and in explicit VR the VR and two
+  // reserved bytes, precede the value.
+  const std::streamoff headerLength = ts.IsExplicit() ? 12 : 8;
+  if ( valueOffset < headerLength )
+    {
+    return false;
+    }
+
+  std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+  const auto readValue = [&file, bigEndian]( unsigned int numberOfBytes, uint32_t & value ) -> bool
+    {
+    unsigned char bytes[4];
+    if ( !file.read( reinterpret_cast< char * >( bytes ), numberOfBytes ) )
+      {
+      return false;
+      }
+    value = 0;
+    for ( unsigned int i = 0; i < numberOfBytes; ++i )
+      {
+      value = ( value << 8 ) | bytes[bigEndian ? i : numberOfBytes - 1 - i];
+      }
+    return true;
+    };
+
+  uint32_t group;
+  uint32_t element;
+  uint32_t length;
+  file.seekg( valueOffset - headerLength );
+  if ( !readValue( 2, group ) || !readValue( 2, element ) || group != 0x7fe0 || element != 0x0010 )
+    {
+    return false;
+    }
+  file.seekg( headerLength - 8, std::ios::cur );
+  if ( !readValue( 4, length ) )
+    {
+    return false;
+    }
+
+  std::streamoff end = valueOffset + length;
+  if ( length == 0xffffffff )
+    {
+    // The encapsulated fragments end with a sequence delimitation item
+    while ( true )
+      {
+      if ( !readValue( 2, group ) || !readValue( 2, element ) || !readValue( 4, length ) || group != 0xfffe )
+        {
+        return false;
+        }
+      if ( element == 0xe0dd )
+        {
+        break;
+        }
+      if ( element != 0xe000 || !file.seekg( length, std::ios::cur ) )
+        {
+        return false;
+        }
+      }
+    end = file.tellg();
+    }
+  return end == static_cast< std::streamoff >( itksys::SystemTools::FileLength( fileName ) );
+}
+
+bool GDCMImageIO::InternalReadImageInformation(bool headerOnly)
 {
   // ensure file can be opened for reading, before doing any more work
   std::ifstream inputFileStream;
@@ -361,14 +626,37 @@ void GDCMImageIO::InternalReadImageInformation()
   // In general this should be relatively safe to assume
   gdcm::ImageHelper::SetForceRescaleInterceptSlope(true);
 
-  gdcm::ImageReader reader;
-  reader.SetFileName( m_FileName.c_str() );
-  if ( !reader.Read() )
+  std::unique_ptr< gdcm::ImageReader > reader;
+  if ( headerOnly )
     {
-    itkExceptionMacro(<< "Cannot read requested file");
+    // Files whose header does not give the size of their pixels, such
+    // as JPEG ones without Rows or Columns, are read whole.
+    std::unique_ptr< gdcm::ImageRegionReader > headerReader( new gdcm::ImageRegionReader );
+    headerReader->SetFileName( m_FileName.c_str() );
+    if ( headerReader->ReadInformation()
+         && headerReader->GetImage().GetDimension(0) > 0
+         && headerReader->GetImage().GetDimension(1) > 0 )
+      {
+      // Nothing is left to read when the Pixel Data ends the file
+      if ( pixelDataEndsFile( *headerReader, m_FileName ) )
+        {
+        headerOnly = false;
+        }
+      reader = std::move( headerReader );
+      }
+    }
+  if ( !reader )
+    {
+    headerOnly = false;
+    reader.reset( new gdcm::ImageReader );
+    reader->SetFileName( m_FileName.c_str() );
+    if ( !reader->Read() )
+      {
+      itkExceptionMacro(<< "Cannot read requested file");
+      }
     }
-  const gdcm::Image &   image = reader.GetImage();
-  const gdcm::File &    f = reader.GetFile();
+  const gdcm::Image &   image = reader->GetImage();
+  const gdcm::File &    f = reader->GetFile();
   const gdcm::DataSet & ds = f.GetDataSet();
   const unsigned int *  dims = image.GetDimensions();
 
@@ -606,6 +894,37 @@ void GDCMImageIO::InternalReadImageInformation()
     m_Dimensions[2] = 1;
     }
 
+  // Find out whether the frames can be decoded independently of each
+  // other, so that they can be read concurrently or by frame range.
+  m_FrameRangesCanBeRead = false;
+  if ( m_Dimensions[2] > 1
+       && image.GetPlanarConfiguration() == 0
+       && image.GetPhotometricInterpretation() != gdcm::PhotometricInterpretation::PALETTE_COLOR
+       && pixeltype.GetBitsAllocated() % 8 == 0
+       && pixeltype.GetBitsAllocated() != 24 )
+    {
+    switch ( f.GetHeader().GetDataSetTransferSyntax() )
+      {
+      case gdcm::TransferSyntax::ImplicitVRLittleEndian:
+      case gdcm::TransferSyntax::ImplicitVRBigEndianPrivateGE:
+      case gdcm::TransferSyntax::ExplicitVRLittleEndian:
+      case gdcm::TransferSyntax::ExplicitVRBigEndian:
+      case gdcm::TransferSyntax::JPEGBaselineProcess1:
+      case gdcm::TransferSyntax::JPEGExtendedProcess2_4:
+      case gdcm::TransferSyntax::JPEGLosslessProcess14:
+      case gdcm::TransferSyntax::JPEGLosslessProcess14_1:
+      case gdcm::TransferSyntax::JPEGLSLossless:
+      case gdcm::TransferSyntax::JPEGLSNearLossless:
+      case gdcm::TransferSyntax::JPEG2000Lossless:
+      case gdcm::TransferSyntax::JPEG2000:
+      case gdcm::TransferSyntax::RLELossless:
+        m_FrameRangesCanBeRead = true;
+        break;
+      default:
+        break;
+      }
+    }
+
   const double *       dircos = image.GetDirectionCosines();
   vnl_vector< double > rowDirection(3), columnDirection(3);
   rowDirection[0] = dircos[0];
@@ -709,6 +1028,38 @@ void GDCMImageIO::InternalReadImageInformation()
   this->GetModel(name);
   this->GetScanOptions(name);
 #endif
+
+  return headerOnly;
+}
+
+ImageIORegion
+GDCMImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if ( !m_UseStreamedReading || !m_FrameRangesCanBeRead )
+    {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+    }
+
+  // Frames are decoded whole, so only the frame range is streamed.
+  const unsigned int frameDimension = 2;
+  const unsigned int dimension = std::max( this->GetNumberOfDimensions(), requested.GetImageDimension() );
+  ImageIORegion      streamableRegion(dimension);
+  for ( unsigned int i = 0; i < dimension; ++i )
+    {
+    streamableRegion.SetIndex(i, 0);
+    streamableRegion.SetSize(i, 1);
+    }
+  for ( unsigned int i = 0; i < frameDimension; ++i )
+    {
+    streamableRegion.SetSize(i, m_Dimensions[i]);
+    }
+  if ( requested.GetImageDimension() > frameDimension )
+    {
+    streamableRegion.SetIndex( frameDimension, requested.GetIndex(frameDimension) );
+    streamableRegion.SetSize( frameDimension, requested.GetSize(frameDimension) );
+    }
+
+  return streamableRegion;
 }
 
 void GDCMImageIO::ReadImageInformation()
@@ -716,6 +1067,11 @@ void GDCMImageIO::ReadImageInformation()
   this->InternalReadImageInformation();
 }
 
+bool GDCMImageIO::ReadImageInformationFromHeader()
+{
+  return !this->InternalReadImageInformation(true);
+}
+
 bool GDCMImageIO::CanWriteFile(const char *name)
 {
   std::string filename = name;
@@ -1234,16 +1590,7 @@ void GDCMImageIO::Write(const void *buffer)
   if ( !m_KeepOriginalUID )
     {
     // UID generation part:
-    // We only create *ONE* Study/Series.Frame of Reference Instance UID
-    if ( m_StudyInstanceUID.empty() )
-      {
-      // As long as user maintain there gdcmIO they will keep the same
-      // Study/Series instance UID.
-      gdcm::UIDGenerator uid;
-      m_StudyInstanceUID = uid.Generate();
-      m_SeriesInstanceUID = uid.Generate();
-      m_FrameOfReferenceInstanceUID = uid.Generate();
-      }
+    this->GenerateInstanceUIDs();
     //std::string uid = uid.Generate();
     const char *studyuid = m_StudyInstanceUID.c_str();
       {
@@ -21,9 +21,79 @@
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
+#include "itkMultiThreaderBase.h"
+#include "gdcmDirectory.h"
+#include "gdcmImageHelper.h"
+#include "gdcmReader.h"
+#include "gdcmStringFilter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <set>
+#include <sstream>
 
 namespace itk
 {
+namespace
+{
+const char * const HeaderIndexSignature = "ITKGDCMSeriesFileNamesHeaderIndex 1";
+
+// Names and values are stored one per line
+std::string EscapeHeaderIndexString(const std::string & in)
+{
+  std::string out;
+  out.reserve( in.size() );
+  for ( char c : in )
+    {
+    if ( c == '\\' )
+      {
+      out += "\\\\";
+      }
+    else if ( c == '\n' )
+      {
+      out += "\\n";
+      }
+    else if ( c == '\r' )
+      {
+      out += "\\r";
+      }
+    else
+      {
+      out += c;
+      }
+    }
+  return out;
+}
+
+std::string UnescapeHeaderIndexString(const std::string & in)
+{
+  std::string out;
+  out.reserve( in.size() );
+  for ( std::string::size_type i = 0; i < in.size(); ++i )
+    {
+    if ( in[i] == '\\' && i + 1 < in.size() )
+      {
+      ++i;
+      out += ( in[i] == 'n' ? '\n' : ( in[i] == 'r' ? '\r' : in[i] ) );
+      }
+    else
+      {
+      out += in[i];
+      }
+    }
+  return out;
+}
+
+std::string NormalizeTag(const std::string & tag)
+{
+  gdcm::Tag t;
+  t.ReadFromPipeSeparatedString( tag.c_str() );
+  return t.PrintAsPipeSeparatedString();
+}
+}
+
 GDCMSeriesFileNames::GDCMSeriesFileNames()
 {
   m_SerieHelper = new gdcm::SerieHelper();
@@ -72,7 +142,15 @@ void GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode( ( m_LoadSequences ? 0 : gdcm::LD_NOSEQ )
                               | ( m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW ) );
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  m_IndexedFileNames.clear();
+  if ( m_HeaderIndexFileName.empty() )
+    {
+    m_SerieHelper->SetDirectory(name, m_Recursive);
+    }
+  else
+    {
+    this->ScanDirectoryWithHeaderIndex();
+    }
   //as a side effect it also execute
   this->Modified();
 }
@@ -80,6 +158,16 @@ void GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
 const GDCMSeriesFileNames::SeriesUIDContainerType & GDCMSeriesFileNames::GetSeriesUIDs()
 {
   m_SeriesUIDs.clear();
+  if ( !m_IndexedFileNames.empty() )
+    {
+    std::set< std::string > ids;
+    for ( const auto & filename : m_IndexedFileNames )
+      {
+      ids.insert( this->CreateUniqueSeriesIdentifier( m_HeaderIndex[filename] ) );
+      }
+    m_SeriesUIDs.assign( ids.begin(), ids.end() );
+    return m_SeriesUIDs;
+    }
   // Accessing the first serie found (assume there is at least one)
   gdcm::FileList *flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
   while ( flist )
@@ -106,6 +194,29 @@ const GDCMSeriesFileNames::SeriesUIDContainerType & GDCMSeriesFileNames::GetSeri
 const GDCMSeriesFileNames::FileNamesContainerType & GDCMSeriesFileNames::GetFileNames(const std::string serie)
 {
   m_InputFileNames.clear();
+  if ( !m_IndexedFileNames.empty() )
+    {
+    // Without a sub selection, the first series in identifier order is used
+    std::string id = serie;
+    if ( id == "" )
+      {
+      id = this->GetSeriesUIDs().front();
+      }
+    for ( const auto & filename : m_IndexedFileNames )
+      {
+      if ( this->CreateUniqueSeriesIdentifier( m_HeaderIndex[filename] ) == id )
+        {
+        m_InputFileNames.push_back(filename);
+        }
+      }
+    if ( m_InputFileNames.empty() )
+      {
+      itkWarningMacro(<< "No Series were found");
+      return m_InputFileNames;
+      }
+    this->OrderIndexedFileNames(m_InputFileNames);
+    return m_InputFileNames;
+    }
   // Accessing the first serie found (assume there is at least one)
   gdcm::FileList *flist = m_SerieHelper->GetFirstSingleSerieUIDFileSet();
   if ( !flist )
@@ -278,6 +389,7 @@ void GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "InputDirectory: " << m_InputDirectory << std::endl;
   os << indent << "LoadSequences:" << m_LoadSequences << std::endl;
   os << indent << "LoadPrivateTags:" << m_LoadPrivateTags << std::endl;
+  os << indent << "HeaderIndexFileName: " << m_HeaderIndexFileName << std::endl;
   if ( m_Recursive )
     {
     os << indent << "Recursive: True" << std::endl;
@@ -304,6 +416,360 @@ void GDCMSeriesFileNames::SetUseSeriesDetails(bool useSeriesDetails)
   m_UseSeriesDetails = useSeriesDetails;
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->CreateDefaultUniqueSeriesIdentifier();
+  // Same tags as gdcm::SerieHelper::CreateDefaultUniqueSeriesIdentifier()
+  m_SeriesRestrictions.push_back("0020|0011");
+  m_SeriesRestrictions.push_back("0018|0024");
+  m_SeriesRestrictions.push_back("0018|0050");
+  m_SeriesRestrictions.push_back("0028|0010");
+  m_SeriesRestrictions.push_back("0028|0011");
+}
+
+std::vector< std::string > GDCMSeriesFileNames::GetHeaderIndexTags() const
+{
+  std::vector< std::string > tags;
+  // Series Instance UID
+  tags.emplace_back("0020|000e");
+  for ( const auto & tag : m_SeriesRestrictions )
+    {
+    tags.push_back( NormalizeTag(tag) );
+    }
+  return tags;
+}
+
+void GDCMSeriesFileNames::ReadHeaderIndexEntry(const std::string & filename, HeaderIndexEntry & entry) const
+{
+  entry.m_IsImage = false;
+  entry.m_Tags.clear();
+
+  // Only the header is parsed, the Pixel Data element is skipped
+  const gdcm::Tag pixelDataTag(0x7fe0, 0x0010);
+  std::set< gdcm::Tag > skipTags;
+  skipTags.insert(pixelDataTag);
+
+  gdcm::Reader reader;
+  reader.SetFileName( filename.c_str() );
+  if ( !reader.ReadUpToTag(pixelDataTag, skipTags) )
+    {
+    return;
+    }
+
+  // Only accept DICOM files containing an image, i.e. with image
+  // dimensions and with the Pixel Data element before the end of the file
+  const gdcm::File &    file = reader.GetFile();
+  const gdcm::DataSet & ds = file.GetDataSet();
+  if ( !ds.FindDataElement( gdcm::Tag(0x0028, 0x0010) )
+       || !ds.FindDataElement( gdcm::Tag(0x0028, 0x0011) )
+       || reader.GetStreamCurrentPosition() > entry.m_FileSize )
+    {
+    return;
+    }
+
+  gdcm::StringFilter sf;
+  sf.SetFile(file);
+  for ( const auto & tagName : this->GetHeaderIndexTags() )
+    {
+    gdcm::Tag tag;
+    tag.ReadFromPipeSeparatedString( tagName.c_str() );
+    entry.m_Tags[tagName] = sf.ToString(tag);
+    }
+
+  const std::vector< double > origin = gdcm::ImageHelper::GetOriginValue(file);
+  const std::vector< double > cosines = gdcm::ImageHelper::GetDirectionCosinesValue(file);
+  std::copy( origin.begin(), origin.begin() + 3, entry.m_Origin );
+  std::copy( cosines.begin(), cosines.begin() + 6, entry.m_DirectionCosines );
+  entry.m_IsImage = true;
+}
+
+void GDCMSeriesFileNames::ScanDirectoryWithHeaderIndex()
+{
+  if ( !this->ReadHeaderIndex() )
+    {
+    m_HeaderIndex.clear();
+    }
+
+  gdcm::Directory directory;
+  directory.Load(m_InputDirectory, m_Recursive);
+  const gdcm::Directory::FilenamesType & filenames = directory.GetFilenames();
+
+  // Find the files that are not in the index, or whose header lacks
+  // one of the tags currently used to identify the series
+  const std::vector< std::string > tags = this->GetHeaderIndexTags();
+  std::vector< std::string >       toParse;
+  std::vector< HeaderIndexEntry >  parsed;
+  for ( const auto & filename : filenames )
+    {
+    HeaderIndexEntry entry;
+    entry.m_FileSize = itksys::SystemTools::FileLength(filename);
+    entry.m_ModifiedTime = itksys::SystemTools::ModifiedTime(filename);
+
+    auto found = m_HeaderIndex.find(filename);
+    bool upToDate = found != m_HeaderIndex.end()
+                    && found->second.m_FileSize == entry.m_FileSize
+                    && found->second.m_ModifiedTime == entry.m_ModifiedTime;
+    if ( upToDate && found->second.m_IsImage )
+      {
+      for ( const auto & tag : tags )
+        {
+        upToDate = upToDate && found->second.m_Tags.count(tag) != 0;
+        }
+      }
+    if ( !upToDate )
+      {
+      toParse.push_back(filename);
+      parsed.push_back(entry);
+      }
+    }
+
+  itkDebugMacro(<< "Parsing " << toParse.size() << " of " << filenames.size() << " headers");
+  if ( !toParse.empty() )
+    {
+    this->GetMultiThreader()->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      toParse.size(),
+      [this, &toParse, &parsed](SizeValueType i)
+        {
+        this->ReadHeaderIndexEntry( toParse[i], parsed[i] );
+        },
+      this);
+
+    for ( std::vector< std::string >::size_type i = 0; i < toParse.size(); ++i )
+      {
+      m_HeaderIndex[toParse[i]] = parsed[i];
+      }
+    }
+
+  // Forget the files of this directory that have been removed
+  std::set< std::string > scanned( filenames.begin(), filenames.end() );
+  std::string             prefix = m_InputDirectory;
+  itksys::SystemTools::ConvertToUnixSlashes(prefix);
+  bool pruned = false;
+  for ( auto it = m_HeaderIndex.begin(); it != m_HeaderIndex.end(); )
+    {
+    if ( it->first.compare(0, prefix.size(), prefix) == 0
+         && scanned.count(it->first) == 0
+         && !itksys::SystemTools::FileExists(it->first) )
+      {
+      it = m_HeaderIndex.erase(it);
+      pruned = true;
+      }
+    else
+      {
+      ++it;
+      }
+    }
+
+  if ( !toParse.empty() || pruned )
+    {
+    this->WriteHeaderIndex();
+    }
+
+  for ( const auto & filename : filenames )
+    {
+    if ( m_HeaderIndex[filename].m_IsImage )
+      {
+      m_IndexedFileNames.push_back(filename);
+      }
+    }
+  if ( m_IndexedFileNames.empty() )
+    {
+    itkWarningMacro(<< "No DICOM image was found in " << m_InputDirectory);
+    }
+}
+
+bool GDCMSeriesFileNames::ReadHeaderIndex()
+{
+  m_HeaderIndex.clear();
+
+  std::ifstream in( m_HeaderIndexFileName.c_str() );
+  if ( !in )
+    {
+    // The index is created on the first scan
+    return false;
+    }
+  in.imbue( std::locale::classic() );
+
+  std::string line;
+  if ( !std::getline(in, line) || line != HeaderIndexSignature )
+    {
+    itkWarningMacro(<< m_HeaderIndexFileName << " is not a header index, it will be rebuilt");
+    return false;
+    }
+
+  HeaderIndexEntry * entry = nullptr;
+  while ( std::getline(in, line) )
+    {
+    if ( line.size() < 2 || line[1] != ' ' )
+      {
+      itkWarningMacro(<< "Corrupted header index " << m_HeaderIndexFileName << ", it will be rebuilt");
+      return false;
+      }
+    const std::string value = line.substr(2);
+    if ( line[0] == 'F' )
+      {
+      entry = &m_HeaderIndex[UnescapeHeaderIndexString(value)];
+      continue;
+      }
+    if ( entry == nullptr )
+      {
+      itkWarningMacro(<< "Corrupted header index " << m_HeaderIndexFileName << ", it will be rebuilt");
+      return false;
+      }
+    std::istringstream fields(value);
+    fields.imbue( std::locale::classic() );
+    switch ( line[0] )
+      {
+      case 'S':
+        fields >> entry->m_FileSize >> entry->m_ModifiedTime >> entry->m_IsImage;
+        break;
+      case 'G':
+        for ( double & o : entry->m_Origin )
+          {
+          fields >> o;
+          }
+        for ( double & c : entry->m_DirectionCosines )
+          {
+          fields >> c;
+          }
+        break;
+      case 'T':
+        entry->m_Tags[value.substr(0, 9)] = value.size() > 10 ? UnescapeHeaderIndexString( value.substr(10) ) : "";
+        break;
+      default:
+        fields.setstate(std::ios::failbit);
+      }
+    if ( fields.fail() )
+      {
+      itkWarningMacro(<< "Corrupted header index " << m_HeaderIndexFileName << ", it will be rebuilt");
+      return false;
+      }
+    }
+  return true;
+}
+
+void GDCMSeriesFileNames::WriteHeaderIndex()
+{
+  // Write to a temporary file first so that an interrupted scan, or
+  // another process, never sees a partial index
+  const std::string temporaryFileName = m_HeaderIndexFileName + ".tmp";
+  {
+  std::ofstream out( temporaryFileName.c_str() );
+  if ( !out )
+    {
+    itkWarningMacro(<< "Could not write the header index " << temporaryFileName);
+    return;
+    }
+  out.imbue( std::locale::classic() );
+  out.precision(17);
+
+  out << HeaderIndexSignature << '\n';
+  for ( const auto & indexed : m_HeaderIndex )
+    {
+    const HeaderIndexEntry & entry = indexed.second;
+    out << "F " << EscapeHeaderIndexString(indexed.first) << '\n';
+    out << "S " << entry.m_FileSize << ' ' << entry.m_ModifiedTime << ' ' << entry.m_IsImage << '\n';
+    if ( !entry.m_IsImage )
+      {
+      continue;
+      }
+    out << "G";
+    for ( double o : entry.m_Origin )
+      {
+      out << ' ' << o;
+      }
+    for ( double c : entry.m_DirectionCosines )
+      {
+      out << ' ' << c;
+      }
+    out << '\n';
+    for ( const auto & tag : entry.m_Tags )
+      {
+      out << "T " << tag.first << ' ' << EscapeHeaderIndexString(tag.second) << '\n';
+      }
+    }
+  if ( !out )
+    {
+    itkWarningMacro(<< "Could not write the header index " << temporaryFileName);
+    return;
+    }
+  }
+  itksys::SystemTools::RemoveFile(m_HeaderIndexFileName);
+  if ( std::rename( temporaryFileName.c_str(), m_HeaderIndexFileName.c_str() ) != 0 )
+    {
+    itkWarningMacro(<< "Could not write the header index " << m_HeaderIndexFileName);
+    }
+}
+
+std::string GDCMSeriesFileNames::CreateUniqueSeriesIdentifier(const HeaderIndexEntry & entry) const
+{
+  auto value = [&entry](const std::string & tag) -> std::string
+    {
+    auto found = entry.m_Tags.find(tag);
+    return found != entry.m_Tags.end() ? found->second : std::string();
+    };
+
+  const std::string uid = value("0020|000e").c_str();
+  std::string       id = uid;
+  if ( m_UseSeriesDetails )
+    {
+    for ( const auto & tag : m_SeriesRestrictions )
+      {
+      const std::string s = value( NormalizeTag(tag) );
+      if ( id == uid && !s.empty() )
+        {
+        id += ".";
+        }
+      id += s;
+      }
+    }
+  // Keep only the characters kept by gdcm::SerieHelper
+  std::string cleaned;
+  for ( char c : id )
+    {
+    if ( c == '.' || ( c >= 'a' && c <= 'z' ) || ( c >= '0' && c <= '9' ) || ( c >= 'A' && c <= 'Z' ) )
+      {
+      cleaned += c;
+      }
+    }
+  return cleaned;
+}
+
+void GDCMSeriesFileNames::OrderIndexedFileNames(FileNamesContainerType & filenames) const
+{
+  // Sort along the normal of the first slice, falling back to the
+  // file names when the positions are missing or not unique
+  const HeaderIndexEntry & first = m_HeaderIndex.find( filenames.front() )->second;
+  const double *           cosines = first.m_DirectionCosines;
+  const double             normal[3] = { cosines[1] * cosines[5] - cosines[2] * cosines[4],
+                                         cosines[2] * cosines[3] - cosines[0] * cosines[5],
+                                         cosines[0] * cosines[4] - cosines[1] * cosines[3] };
+
+  std::multimap< double, std::string > distances;
+  for ( const auto & filename : filenames )
+    {
+    const double * origin = m_HeaderIndex.find(filename)->second.m_Origin;
+    const double   dist = normal[0] * origin[0] + normal[1] * origin[1] + normal[2] * origin[2];
+    distances.insert( std::make_pair(dist, filename) );
+    }
+
+  bool unique = distances.begin()->first != distances.rbegin()->first;
+  for ( auto it = distances.begin(); unique && it != distances.end(); ++it )
+    {
+    unique = distances.count(it->first) == 1;
+    }
+
+  if ( unique )
+    {
+    filenames.clear();
+    for ( const auto & d : distances )
+      {
+      filenames.push_back(d.second);
+      }
+    }
+  else
+    {
+    std::sort( filenames.begin(), filenames.end() );
+    }
 }
 } //namespace ITK
 
@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Write a multi-frame object uncompressed and with each of the
+// compressions GDCMImageIO writes, then read it back whole and by
+// frame range.
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image< PixelType, 3 >;
+
+PixelType
+ExpectedValue( const ImageType::IndexType & index )
+{
+  return static_cast< PixelType >( ( index[0] * 7 + index[1] * 13 + index[2] * 101 ) % 2000 );
+}
+
+int
+CheckRegion( const ImageType * image, const ImageType::RegionType & region )
+{
+  if ( !image->GetBufferedRegion().IsInside( region ) )
+    {
+    std::cerr << "Buffered region " << image->GetBufferedRegion()
+              << " does not contain " << region << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != ExpectedValue( it.GetIndex() ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << it.Get()
+                << " expected " << ExpectedValue( it.GetIndex() ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int
+WriteAndRead( const ImageType * image, const std::string & fileName,
+              bool compress, itk::GDCMImageIO::TCompressionType compressionType )
+{
+  std::cout << fileName << std::endl;
+
+  itk::GDCMImageIO::Pointer writerIO = itk::GDCMImageIO::New();
+  writerIO->SetCompressionType( compressionType );
+
+  using WriterType = itk::ImageFileWriter< ImageType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetImageIO( writerIO );
+  writer->SetFileName( fileName );
+  writer->SetUseCompression( compress );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  using ReaderType = itk::ImageFileReader< ImageType >;
+
+  // Whole image
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetImageIO( itk::GDCMImageIO::New() );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  TEST_EXPECT_TRUE( reader->GetImageIO()->CanStreamRead() );
+  if ( CheckRegion( reader->GetOutput(), image->GetLargestPossibleRegion() ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A frame range: only those frames must be read
+  ImageType::RegionType frameRange = image->GetLargestPossibleRegion();
+  frameRange.SetIndex( 2, 5 );
+  frameRange.SetSize( 2, 7 );
+
+  reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetImageIO( itk::GDCMImageIO::New() );
+  reader->GetOutput()->SetRequestedRegion( frameRange );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  TEST_EXPECT_EQUAL( reader->GetOutput()->GetBufferedRegion(), frameRange );
+  if ( CheckRegion( reader->GetOutput(), frameRange ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A sub-region of a single frame is read as that whole frame
+  ImageType::RegionType subRegion = frameRange;
+  subRegion.SetIndex( 0, 3 );
+  subRegion.SetSize( 0, 10 );
+  subRegion.SetIndex( 2, 13 );
+  subRegion.SetSize( 2, 1 );
+
+  reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetImageIO( itk::GDCMImageIO::New() );
+  reader->GetOutput()->SetRequestedRegion( subRegion );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  TEST_EXPECT_EQUAL( reader->GetOutput()->GetBufferedRegion().GetSize( 2 ), 1 );
+  if ( CheckRegion( reader->GetOutput(), subRegion ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkGDCMImageIOMultiFrameStreamingTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string outputDirectory = argv[1];
+
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+  size[2] = 23;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( ExpectedValue( it.GetIndex() ) );
+    }
+
+  int status = EXIT_SUCCESS;
+  status |= WriteAndRead( image, outputDirectory + "/itkGDCMImageIOMultiFrameStreamingTestRaw.dcm",
+                          false, itk::GDCMImageIO::JPEG2000 );
+  status |= WriteAndRead( image, outputDirectory + "/itkGDCMImageIOMultiFrameStreamingTestJPEG.dcm",
+                          true, itk::GDCMImageIO::JPEG );
+  status |= WriteAndRead( image, outputDirectory + "/itkGDCMImageIOMultiFrameStreamingTestJPEG2000.dcm",
+                          true, itk::GDCMImageIO::JPEG2000 );
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkImageFileWriter.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+#include <sstream>
+
+// Write two interleaved series whose file names do not follow the
+// slice positions, then check that scanning the directory with a
+// header index gives the same series and ordering as without it, on
+// the first scan, on a rescan, after the directory changed and after
+// the index was corrupted.
+
+namespace
+{
+
+using ImageType = itk::Image< unsigned short, 3 >;
+using NamesType = itk::GDCMSeriesFileNames;
+
+void
+WriteSlice( const std::string & fileName, const std::string & seriesUID, double z )
+{
+  ImageType::SizeType size;
+  size[0] = 8;
+  size[1] = 6;
+  size[2] = 1;
+  ImageType::PointType origin;
+  origin[0] = -3.0;
+  origin[1] = 4.0;
+  origin[2] = z;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->SetOrigin( origin );
+  image->Allocate();
+  image->FillBuffer( static_cast< unsigned short >( z * 10 ) );
+
+  itk::MetaDataDictionary & dictionary = image->GetMetaDataDictionary();
+  itk::EncapsulateMetaData< std::string >( dictionary, "0020|000e", seriesUID );
+  itk::EncapsulateMetaData< std::string >( dictionary, "0008|0060", "CT" );
+
+  itk::GDCMImageIO::Pointer imageIO = itk::GDCMImageIO::New();
+  imageIO->KeepOriginalUIDOn();
+
+  using WriterType = itk::ImageFileWriter< ImageType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetImageIO( imageIO );
+  writer->SetFileName( fileName );
+  writer->Update();
+}
+
+std::string
+Describe( NamesType * names )
+{
+  std::ostringstream description;
+  for ( const auto & uid : names->GetSeriesUIDs() )
+    {
+    description << uid << ":";
+    for ( const auto & fileName : names->GetFileNames( uid ) )
+      {
+      description << " " << itksys::SystemTools::GetFilenameName( fileName );
+      }
+    description << "\n";
+    }
+  return description.str();
+}
+
+std::string
+Scan( const std::string & directory, const std::string & indexFileName, bool useSeriesDetails )
+{
+  NamesType::Pointer names = NamesType::New();
+  names->SetHeaderIndexFileName( indexFileName );
+  if ( useSeriesDetails )
+    {
+    names->SetUseSeriesDetails( true );
+    }
+  names->SetDirectory( directory );
+  return Describe( names );
+}
+
+int
+CompareScans( const std::string & directory, const std::string & indexFileName, const char * step )
+{
+  for ( int useSeriesDetails = 0; useSeriesDetails < 2; ++useSeriesDetails )
+    {
+    const std::string expected = Scan( directory, "", useSeriesDetails != 0 );
+    const std::string indexed = Scan( directory, indexFileName, useSeriesDetails != 0 );
+    std::cout << step << " UseSeriesDetails " << useSeriesDetails << "\n" << indexed;
+    if ( indexed != expected )
+      {
+      std::cerr << "Scan with header index differs, expected\n" << expected << std::endl;
+      return EXIT_FAILURE;
+      }
+    if ( !itksys::SystemTools::FileExists( indexFileName ) )
+      {
+      std::cerr << "Header index " << indexFileName << " was not written" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkGDCMSeriesFileNamesHeaderIndexTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const std::string directory = std::string( argv[1] ) + "/itkGDCMSeriesFileNamesHeaderIndexTest";
+  const std::string indexFileName = std::string( argv[1] ) + "/itkGDCMSeriesFileNamesHeaderIndexTest.index";
+  itksys::SystemTools::RemoveADirectory( directory );
+  itksys::SystemTools::MakeDirectory( directory );
+  itksys::SystemTools::RemoveFile( indexFileName );
+
+  NamesType::Pointer names = NamesType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( names, GDCMSeriesFileNames, ProcessObject );
+  TEST_SET_GET_VALUE( "", std::string( names->GetHeaderIndexFileName() ) );
+  names->SetHeaderIndexFileName( indexFileName );
+  TEST_SET_GET_VALUE( indexFileName, std::string( names->GetHeaderIndexFileName() ) );
+
+  // File names in reverse order of the positions for the first series
+  const char * seriesA = "1.2.826.0.1.3680043.2.1125.1.1";
+  const char * seriesB = "1.2.826.0.1.3680043.2.1125.1.2";
+  for ( int i = 0; i < 6; ++i )
+    {
+    std::ostringstream fileName;
+    fileName << directory << "/slice" << i << ".dcm";
+    TRY_EXPECT_NO_EXCEPTION( WriteSlice( fileName.str(), i % 2 ? seriesB : seriesA, 20.0 - 2.5 * i ) );
+    }
+  std::ofstream( ( directory + "/notes.txt" ).c_str() ) << "Not a DICOM file" << std::endl;
+
+  if ( CompareScans( directory, indexFileName, "First scan" ) != EXIT_SUCCESS
+       || CompareScans( directory, indexFileName, "Rescan" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // New, replaced and removed files
+  TRY_EXPECT_NO_EXCEPTION( WriteSlice( directory + "/slice6.dcm", seriesA, 40.0 ) );
+  TRY_EXPECT_NO_EXCEPTION( WriteSlice( directory + "/slice1.dcm", "1.2.826.0.1.3680043.2.1125.1.33", 1.0 ) );
+  itksys::SystemTools::RemoveFile( directory + "/slice2.dcm" );
+  if ( CompareScans( directory, indexFileName, "Modified directory" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A damaged index is rebuilt
+  std::ofstream( indexFileName.c_str() ) << "garbage" << std::endl;
+  if ( CompareScans( directory, indexFileName, "Damaged index" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
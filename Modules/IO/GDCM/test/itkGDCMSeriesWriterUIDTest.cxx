@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkImageSeriesWriter.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+#include <vector>
+
+// Write a volume as a DICOM series with one and with several work
+// units, and check that all the files of the series share one Study,
+// Series and Frame of Reference Instance UID.
+
+namespace
+{
+
+using ImageType = itk::Image< unsigned short, 3 >;
+using SliceType = itk::Image< unsigned short, 2 >;
+
+const char * const InstanceUIDTags[] = { "0020|000d", "0020|000e", "0020|0052" };
+
+std::string
+ReadTag( const std::string & fileName, const char * tag )
+{
+  itk::GDCMImageIO::Pointer imageIO = itk::GDCMImageIO::New();
+  imageIO->SetFileName( fileName );
+  imageIO->ReadImageInformation();
+  std::string value;
+  itk::ExposeMetaData< std::string >( imageIO->GetMetaDataDictionary(), tag, value );
+  return value;
+}
+
+}
+
+int itkGDCMSeriesWriterUIDTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ImageType::SizeType size;
+  size[0] = 8;
+  size[1] = 6;
+  size[2] = 7;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  image->FillBuffer( 100 );
+
+  std::vector< std::string > fileNames;
+  for ( itk::SizeValueType i = 0; i < size[2]; ++i )
+    {
+    std::ostringstream fileName;
+    fileName << argv[1] << "/itkGDCMSeriesWriterUIDTest" << i << ".dcm";
+    fileNames.push_back( fileName.str() );
+    }
+
+  itk::GDCMImageIO::Pointer imageIO = itk::GDCMImageIO::New();
+
+  using WriterType = itk::ImageSeriesWriter< ImageType, SliceType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetImageIO( imageIO );
+  writer->SetFileNames( fileNames );
+
+  std::string firstUIDs[3];
+  for ( itk::ThreadIdType workUnits : { 1, 4 } )
+    {
+    std::cout << "Work units: " << workUnits << std::endl;
+    writer->SetNumberOfWorkUnits( workUnits );
+    TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+    writer->Modified();
+
+    for ( unsigned int t = 0; t < 3; ++t )
+      {
+      const std::string uid = ReadTag( fileNames[0], InstanceUIDTags[t] );
+      TEST_EXPECT_TRUE( !uid.empty() );
+      for ( const auto & fileName : fileNames )
+        {
+        TEST_EXPECT_EQUAL( ReadTag( fileName, InstanceUIDTags[t] ), uid );
+        }
+      // The same ImageIO keeps writing to the same study and series
+      if ( firstUIDs[t].empty() )
+        {
+        firstUIDs[t] = uid;
+        }
+      TEST_EXPECT_EQUAL( uid, firstUIDs[t] );
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -36,6 +36,9 @@ namespace itk
  * OutputConvertTraits() is the traits class.  The default one used is
  * DefaultConvertPixelTraits.
  *
+ * The conversions are counted loops over independent pixels, which
+ * compilers vectorize for the scalar, gray, RGB and RGBA cases.
+ *
  * \ingroup ITKIOImageBase
  */
 template<
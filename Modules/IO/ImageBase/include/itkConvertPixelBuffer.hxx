@@ -182,14 +182,11 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToGray(InputPixelType *inputData,
                     OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData++,
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
+                                          ( inputData[i] ) );
     }
 }
 
@@ -207,16 +204,14 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
   // NOTE: The scale factors are converted to whole numbers for precision
 
-  InputPixelType *endInput = inputData + size * 3;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
+    const InputPixelType *rgb = inputData + 3 * i;
     auto val = static_cast< OutputComponentType >(
-      ( 2125.0 * static_cast< OutputComponentType >( *inputData )
-        + 7154.0 * static_cast< OutputComponentType >( *( inputData + 1 ) )
-        + 0721.0 * static_cast< OutputComponentType >( *( inputData + 2 ) ) ) / 10000.0 );
-    inputData += 3;
-    OutputConvertTraits::SetNthComponent(0, *outputData++, val);
+      ( 2125.0 * static_cast< OutputComponentType >( rgb[0] )
+        + 7154.0 * static_cast< OutputComponentType >( rgb[1] )
+        + 0721.0 * static_cast< OutputComponentType >( rgb[2] ) ) / 10000.0 );
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
     }
 }
 
@@ -234,7 +229,6 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
   // NOTE: The scale factors are converted to whole numbers for
   // precision
-  InputPixelType *endInput = inputData + size * 4;
   double maxAlpha(DefaultAlphaValue<InputPixelType>());
   //
   // To be backwards campatible, if the output pixel type
@@ -243,20 +237,20 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
     {
     maxAlpha = 1.0;
     }
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
+    const InputPixelType *rgba = inputData + 4 * i;
     // this is an ugly implementation of the simple equation
     // greval = (.2125 * red + .7154 * green + .0721 * blue) / alpha
     //
     double tempval =
-      ((2125.0 * static_cast< double >( * inputData)
-        + 7154.0 * static_cast< double >( *( inputData + 1 ))
-        + 0721.0 * static_cast< double >( *( inputData + 2 ))) / 10000.0)
-      * static_cast< double >(*( inputData + 3))
+      ((2125.0 * static_cast< double >( rgba[0] )
+        + 7154.0 * static_cast< double >( rgba[1] )
+        + 0721.0 * static_cast< double >( rgba[2] )) / 10000.0)
+      * static_cast< double >( rgba[3] )
       / maxAlpha;
-    inputData += 4;
     auto val = static_cast< OutputComponentType >( tempval );
-    OutputConvertTraits::SetNthComponent(0, *outputData++, val);
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
     }
 }
 
@@ -327,21 +321,12 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToRGB(InputPixelType *inputData,
                    OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
-    outputData++;
+    const auto val = static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent( 0, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i], val );
     }
 }
 
@@ -354,21 +339,15 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBToRGB(InputPixelType *inputData,
                   OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 3;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    inputData += 3;
-    outputData++;
+    const InputPixelType *rgb = inputData + 3 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[2] ) );
     }
 }
 
@@ -381,22 +360,16 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBAToRGB(InputPixelType *inputData,
                    OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 4;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    inputData += 3;
-    inputData++; // skip alpha
-    outputData++;
+    // skip alpha
+    const InputPixelType *rgba = inputData + 4 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[2] ) );
     }
 }
 
@@ -460,23 +433,15 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
                     OutputPixelType *outputData, size_t size)
 
 {
-  InputPixelType *endInput = inputData + size;
+  const auto alpha = static_cast< OutputComponentType >( DefaultAlphaValue<InputPixelType>() );
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-      static_cast< OutputComponentType >(DefaultAlphaValue<InputPixelType>()));
-    inputData++;
-    outputData++;
+    const auto val = static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent( 0, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 3, outputData[i], alpha );
     }
 }
 
@@ -491,24 +456,18 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 {
   using InputConvertTraits = itk::DefaultConvertPixelTraits< InputPixelType >;
   using InputComponentType = typename InputConvertTraits::ComponentType;
-  InputPixelType *endInput = inputData + size * 3;
+  const auto alpha = static_cast< OutputComponentType >( DefaultAlphaValue<InputComponentType>() );
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-  static_cast< OutputComponentType >(DefaultAlphaValue<InputComponentType>()));
-
-    inputData += 3;
-    outputData++;
+    const InputPixelType *rgb = inputData + 3 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
+                                          static_cast< OutputComponentType >( rgb[2] ) );
+    OutputConvertTraits::SetNthComponent( 3, outputData[i], alpha );
     }
 }
 
@@ -521,24 +480,17 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBAToRGBA(InputPixelType *inputData,
                     OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 4;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *( inputData + 3 ) ) );
-    inputData += 4;
-    outputData++;
+    const InputPixelType *rgba = inputData + 4 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[2] ) );
+    OutputConvertTraits::SetNthComponent( 3, outputData[i],
+                                          static_cast< OutputComponentType >( rgba[3] ) );
     }
 }
 
@@ -566,6 +518,7 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
       OutputConvertTraits::SetNthComponent(1, *outputData, val);
       OutputConvertTraits::SetNthComponent(2, *outputData, val);
       OutputConvertTraits::SetNthComponent(3, *outputData, alpha);
+      outputData++;
       }
     }
   else
@@ -631,18 +584,11 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToComplex(InputPixelType *inputData,
                        OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
-    outputData++;
+    const auto val = static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent( 0, outputData[i], val );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i], val );
     }
 }
 
@@ -655,20 +601,12 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertComplexToComplex(InputPixelType *inputData,
                           OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 2;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent(
-      0, *outputData,
-      static_cast< OutputComponentType >
-      ( *inputData ) );
-    OutputConvertTraits::SetNthComponent(
-      1, *outputData,
-      static_cast< OutputComponentType >
-      ( *( inputData + 1 ) ) );
-    inputData += 2;
-    outputData++;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast< OutputComponentType >( inputData[2 * i] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast< OutputComponentType >( inputData[2 * i + 1] ) );
     }
 }
 
@@ -736,14 +674,12 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
                      int inputNumberOfComponents,
                      OutputPixelType *outputData, size_t size)
 {
-  size_t length = size * (size_t)inputNumberOfComponents;
+  const size_t length = size * (size_t)inputNumberOfComponents;
 
   for ( size_t i = 0; i < length; i++ )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast<  OutputComponentType >( *inputData ) );
-    ++outputData;
-    ++inputData;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast<  OutputComponentType >( inputData[i] ) );
     }
 }
 } // end namespace itk
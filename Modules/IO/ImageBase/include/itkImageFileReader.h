@@ -46,6 +46,21 @@ namespace itk
  * then specified by TOutputImage, than this filter converts data
  * between the file type and the external expected type.  The
  * ConvertTraits template argument is used to do the conversion.
+ * When the file pixels are no larger than the output pixels, they are
+ * read straight into the output buffer and converted there. Otherwise,
+ * an ImageIO that can stream read is read slab by slab into a small
+ * buffer. Only other ImageIOs need a temporary copy of the whole
+ * region read.
+ *
+ * UpdateOutputInformation() reads the image information with
+ * ImageIOBase::ReadImageInformationFromHeader(), so that a metadata
+ * query does not read or decode the pixel data. When that is not all
+ * of the information, ImageIOBase::ReadImageInformation() is called
+ * before the pixels are read. With
+ * ImageIOBase::SetGlobalImageInformationCaching(), the information of
+ * files read through an ImageIO created by the object factory is kept
+ * in a process wide cache, and neither the factory nor the ImageIO
+ * read an unchanged file again.
  *
  * A Pluggable factory pattern is used this allows different kinds of readers
  * to be registered (even at run time) without having to modify the
@@ -126,6 +141,10 @@ protected:
   /** Convert a block of pixels from one type to another. */
   void DoConvertBuffer(void *buffer, size_t numberOfPixels);
 
+  /** Convert a block of pixels from one type to another, into the
+   * output buffer starting at pixel firstPixel. */
+  void DoConvertBuffer(void *buffer, size_t firstPixel, size_t numberOfPixels);
+
   /** Test whether the given filename exist and it is readable, this
     * is intended to be called before attempting to use  ImageIO
     * classes for actually reading the file. If the file doesn't exist
@@ -155,11 +174,28 @@ protected:
   bool m_UseStreaming;
 
 private:
+  /** Read pixels wider than the output's straight into the output
+   * buffer, and convert them in place, chunk by chunk from the end. */
+  void ReadAndConvertInPlace(size_t numberOfPixels, size_t ioPixelSize);
+
+  /** Read m_ActualIORegion slab by slab into a small buffer, converting
+   * each slab into the output buffer. Returns false, having read
+   * nothing, if the ImageIO would not read the slabs as they are. */
+  bool ReadAndConvertBySlab(size_t numberOfPixels, size_t ioPixelSize);
+
   std::string m_ExceptionMessage;
 
   // The region that the ImageIO class will return when we ask to
   // produce the requested region.
   ImageIORegion m_ActualIORegion;
+
+  // Whether m_ImageIO read all of the image information, and not just
+  // the header or the copy of the cached one.
+  bool m_ImageInformationIsComplete;
+
+  // The image information cache entry m_ImageIO was read into or
+  // copied from, zero if none.
+  ModifiedTimeType m_ImageInformationStamp;
 };
 } //namespace ITK
 
@@ -26,7 +26,10 @@
 #include "itkVectorImage.h"
 
 #include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <memory>
 
 namespace itk
 {
@@ -38,6 +41,8 @@ ImageFileReader< TOutputImage, ConvertPixelTraits >
   this->SetFileName("");
   m_UserSpecifiedImageIO = false;
   m_UseStreaming = true;
+  m_ImageInformationIsComplete = false;
+  m_ImageInformationStamp = 0;
 }
 
 template< typename TOutputImage, typename ConvertPixelTraits >
@@ -54,6 +59,8 @@ void ImageFileReader< TOutputImage, ConvertPixelTraits >
 
   os << indent << "UserSpecifiedImageIO flag: " << m_UserSpecifiedImageIO << "\n";
   os << indent << "m_UseStreaming: " << m_UseStreaming << "\n";
+  os << indent << "ImageInformationIsComplete: " << m_ImageInformationIsComplete << "\n";
+  os << indent << "ImageInformationStamp: " << m_ImageInformationStamp << "\n";
 }
 
 template< typename TOutputImage, typename ConvertPixelTraits >
@@ -101,51 +108,79 @@ ImageFileReader< TOutputImage, ConvertPixelTraits >
     m_ExceptionMessage = err.GetDescription();
     }
 
-  if ( m_UserSpecifiedImageIO == false ) //try creating via factory
+  // An unchanged file in the image information cache is not read
+  // again: the ImageIO of this reader is kept when it holds the cached
+  // information, or replaced by a copy of the cached one.
+  ImageIOBase::Pointer cachedImageIO;
+  ModifiedTimeType     cachedStamp = 0;
+  if ( m_UserSpecifiedImageIO == false && m_ExceptionMessage.empty()
+       && ImageIOBase::GetGlobalImageInformationCaching() )
     {
-    m_ImageIO = ImageIOFactory::CreateImageIO(this->GetFileName().c_str(), ImageIOFactory::ReadMode);
+    cachedImageIO = ImageIOBase::GetCachedImageInformation( this->GetFileName(), cachedStamp );
     }
 
-  if ( m_ImageIO.IsNull() )
+  if ( cachedImageIO.IsNotNull() )
     {
-    std::ostringstream msg;
-    msg << " Could not create IO object for reading file "
-        << this->GetFileName().c_str() << std::endl;
-    if ( m_ExceptionMessage.size() )
+    if ( m_ImageIO.IsNull() || cachedStamp != m_ImageInformationStamp )
       {
-      msg << m_ExceptionMessage;
+      m_ImageIO = cachedImageIO;
+      m_ImageInformationIsComplete = false;
+      m_ImageInformationStamp = cachedStamp;
       }
-    else
+    }
+  else
+    {
+    if ( m_UserSpecifiedImageIO == false ) //try creating via factory
       {
-      std::list< LightObject::Pointer > allobjects =
-        ObjectFactoryBase::CreateAllInstance("itkImageIOBase");
-      if (allobjects.size() > 0)
+      m_ImageIO = ImageIOFactory::CreateImageIO(this->GetFileName().c_str(), ImageIOFactory::ReadMode);
+      }
+
+    if ( m_ImageIO.IsNull() )
+      {
+      std::ostringstream msg;
+      msg << " Could not create IO object for reading file "
+          << this->GetFileName().c_str() << std::endl;
+      if ( m_ExceptionMessage.size() )
         {
-        msg << "  Tried to create one of the following:" << std::endl;
-        for (auto & allobject : allobjects)
-          {
-          auto * io = dynamic_cast< ImageIOBase * >( allobject.GetPointer() );
-          msg << "    " << io->GetNameOfClass() << std::endl;
-          }
-        msg << "  You probably failed to set a file suffix, or" << std::endl;
-        msg << "    set the suffix to an unsupported type." << std::endl;
+        msg << m_ExceptionMessage;
         }
       else
         {
-        msg << "  There are no registered IO factories." << std::endl;
-        msg << "  Please visit https://www.itk.org/Wiki/ITK/FAQ#NoFactoryException to diagnose the problem." << std::endl;
+        std::list< LightObject::Pointer > allobjects =
+          ObjectFactoryBase::CreateAllInstance("itkImageIOBase");
+        if (allobjects.size() > 0)
+          {
+          msg << "  Tried to create one of the following:" << std::endl;
+          for (auto & allobject : allobjects)
+            {
+            auto * io = dynamic_cast< ImageIOBase * >( allobject.GetPointer() );
+            msg << "    " << io->GetNameOfClass() << std::endl;
+            }
+          msg << "  You probably failed to set a file suffix, or" << std::endl;
+          msg << "    set the suffix to an unsupported type." << std::endl;
+          }
+        else
+          {
+          msg << "  There are no registered IO factories." << std::endl;
+          msg << "  Please visit https://www.itk.org/Wiki/ITK/FAQ#NoFactoryException to diagnose the problem." << std::endl;
+          }
         }
+      ImageFileReaderException e(__FILE__, __LINE__, msg.str().c_str(), ITK_LOCATION);
+      throw e;
+      return;
       }
-    ImageFileReaderException e(__FILE__, __LINE__, msg.str().c_str(), ITK_LOCATION);
-    throw e;
-    return;
-    }
 
-  // Got to allocate space for the image. Determine the characteristics of
-  // the image.
-  //
-  m_ImageIO->SetFileName( this->GetFileName().c_str() );
-  m_ImageIO->ReadImageInformation();
+    // Got to allocate space for the image. Determine the characteristics of
+    // the image, from the header of the file only.
+    //
+    m_ImageIO->SetFileName( this->GetFileName().c_str() );
+    m_ImageInformationStamp = 0;
+    m_ImageInformationIsComplete = m_ImageIO->ReadImageInformationFromHeader();
+    if ( m_UserSpecifiedImageIO == false && ImageIOBase::GetGlobalImageInformationCaching() )
+      {
+      m_ImageInformationStamp = ImageIOBase::CacheImageInformation( m_ImageIO );
+      }
+    }
 
   SizeType dimSize;
   double   spacing[TOutputImage::ImageDimension];
@@ -274,6 +309,12 @@ ImageFileReader< TOutputImage, ConvertPixelTraits >
     return;
     }
 
+  // Images stored as a directory are checked by their ImageIO.
+  if ( itksys::SystemTools::FileIsDirectory( this->GetFileName() ) )
+    {
+    return;
+    }
+
   // Test if the file can be open for reading access.
   std::ifstream readTester;
   readTester.open( this->GetFileName().c_str() );
@@ -301,6 +342,16 @@ ImageFileReader< TOutputImage, ConvertPixelTraits >
   typename TOutputImage::RegionType largestRegion = out->GetLargestPossibleRegion();
   ImageRegionType streamableRegion;
 
+  // Only the header, or a copy of the cached information, may have been
+  // read so far: read all of the information before reading pixels.
+  if ( !m_ImageInformationIsComplete )
+    {
+    m_ImageIO->ReadImageInformation();
+    m_ImageInformationIsComplete = true;
+    out->SetMetaDataDictionary( m_ImageIO->GetMetaDataDictionary() );
+    this->SetMetaDataDictionary( m_ImageIO->GetMetaDataDictionary() );
+    }
+
   // The following code converts the ImageRegion (templated over dimension)
   // into an ImageIORegion (not templated over dimension).
   ImageRegionType imageRequestedRegion = out->GetRequestedRegion();
@@ -419,13 +470,31 @@ void ImageFileReader< TOutputImage, ConvertPixelTraits >
                      << " m_ImageIO->NumComponents "
                      << m_ImageIO->GetNumberOfComponents() );
 
-      loadBuffer = new char[sizeOfActualIORegion];
-      m_ImageIO->Read( static_cast< void * >( loadBuffer ) );
+      const size_t numberOfPixels = output->GetBufferedRegion().GetNumberOfPixels();
+      const size_t ioPixelSize = m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+      const size_t sizeOfOutputBuffer =
+        output->GetPixelContainer()->Size() * sizeof( OutputImagePixelType );
+
+      if ( numberOfPixels > 0 && numberOfPixels == m_ActualIORegion.GetNumberOfPixels()
+           && sizeOfOutputBuffer >= numberOfPixels * ioPixelSize )
+        {
+        this->ReadAndConvertInPlace( numberOfPixels, ioPixelSize );
+        }
+      else if ( numberOfPixels > 0 && numberOfPixels == m_ActualIORegion.GetNumberOfPixels()
+                && m_ImageIO->CanStreamRead()
+                && this->ReadAndConvertBySlab( numberOfPixels, ioPixelSize ) )
+        {
+        itkDebugMacro(<< "Converted slab by slab");
+        }
+      else
+        {
+        loadBuffer = new char[sizeOfActualIORegion];
+        m_ImageIO->Read( static_cast< void * >( loadBuffer ) );
 
-      // See note below as to why the buffered region is needed and
-      // not actualIOregion
-      this->DoConvertBuffer( static_cast< void * >( loadBuffer ),
-                             output->GetBufferedRegion().GetNumberOfPixels() );
+        // See note below as to why the buffered region is needed and
+        // not actualIOregion
+        this->DoConvertBuffer( static_cast< void * >( loadBuffer ), numberOfPixels );
+        }
       }
     else if ( m_ActualIORegion.GetNumberOfPixels() !=
               output->GetBufferedRegion().GetNumberOfPixels() )
@@ -475,15 +544,118 @@ void ImageFileReader< TOutputImage, ConvertPixelTraits >
   loadBuffer = nullptr;
 }
 
+template< typename TOutputImage, typename ConvertPixelTraits >
+void
+ImageFileReader< TOutputImage, ConvertPixelTraits >
+::ReadAndConvertInPlace(size_t numberOfPixels, size_t ioPixelSize)
+{
+  // Chunks small enough to stay in cache between the copy and the
+  // conversion
+  const size_t chunkSize = std::max< size_t >( ( 64 * 1024 ) / ioPixelSize, 1 );
+
+  OutputImagePixelType *outputBuffer = this->GetOutput()->GetPixelContainer()->GetBufferPointer();
+  m_ImageIO->Read( outputBuffer );
+
+  // Going backward, the output pixels of a chunk only overwrite file
+  // pixels already converted, since an output pixel is at least as
+  // large as a file pixel. The chunk itself is copied out first.
+  auto *fileBuffer = reinterpret_cast< char * >( outputBuffer );
+  std::unique_ptr< char[] > chunk( new char[chunkSize * ioPixelSize] );
+  size_t end = numberOfPixels;
+  while ( end > 0 )
+    {
+    const size_t begin = end > chunkSize ? end - chunkSize : 0;
+    std::memcpy( chunk.get(), fileBuffer + begin * ioPixelSize, ( end - begin ) * ioPixelSize );
+    this->DoConvertBuffer( static_cast< void * >( chunk.get() ), begin, end - begin );
+    end = begin;
+    }
+}
+
+template< typename TOutputImage, typename ConvertPixelTraits >
+bool
+ImageFileReader< TOutputImage, ConvertPixelTraits >
+::ReadAndConvertBySlab(size_t numberOfPixels, size_t ioPixelSize)
+{
+  // Slabs large enough to keep the ImageIO's per read overhead small
+  const size_t slabSize = 16 * 1024 * 1024;
+
+  // Split along the outermost dimension with more than one line
+  unsigned int splitDimension = m_ActualIORegion.GetImageDimension() - 1;
+  while ( splitDimension > 0 && m_ActualIORegion.GetSize( splitDimension ) == 1 )
+    {
+    --splitDimension;
+    }
+  const SizeValueType numberOfLines = m_ActualIORegion.GetSize( splitDimension );
+  const size_t        pixelsPerLine = numberOfPixels / numberOfLines;
+  const SizeValueType linesPerSlab =
+    std::max< SizeValueType >( slabSize / ( pixelsPerLine * ioPixelSize ), 1 );
+
+  const auto slabAt = [this, splitDimension, numberOfLines, linesPerSlab](SizeValueType line)
+    {
+    ImageIORegion slab = m_ActualIORegion;
+    slab.SetIndex( splitDimension, m_ActualIORegion.GetIndex( splitDimension ) + line );
+    slab.SetSize( splitDimension, std::min( linesPerSlab, numberOfLines - line ) );
+    return slab;
+    };
+
+  // The ImageIO must read each slab as is, not a larger region
+  for ( SizeValueType line = 0; line < numberOfLines; line += linesPerSlab )
+    {
+    const ImageIORegion slab = slabAt( line );
+    if ( m_ImageIO->GenerateStreamableReadRegionFromRequestedRegion( slab ) != slab )
+      {
+      return false;
+      }
+    }
+
+  std::unique_ptr< char[] > slabBuffer(
+    new char[std::min( linesPerSlab, numberOfLines ) * pixelsPerLine * ioPixelSize] );
+  try
+    {
+    for ( SizeValueType line = 0; line < numberOfLines; line += linesPerSlab )
+      {
+      const ImageIORegion slab = slabAt( line );
+      const SizeValueType slabLines = slab.GetSize( splitDimension );
+      m_ImageIO->SetIORegion( slab );
+      m_ImageIO->Read( static_cast< void * >( slabBuffer.get() ) );
+      this->DoConvertBuffer( static_cast< void * >( slabBuffer.get() ),
+                             line * pixelsPerLine, slabLines * pixelsPerLine );
+      this->UpdateProgress( static_cast< float >( line + slabLines ) / numberOfLines );
+      }
+    }
+  catch ( ... )
+    {
+    m_ImageIO->SetIORegion( m_ActualIORegion );
+    throw;
+    }
+  m_ImageIO->SetIORegion( m_ActualIORegion );
+  return true;
+}
+
 template< typename TOutputImage, typename ConvertPixelTraits >
 void
 ImageFileReader< TOutputImage, ConvertPixelTraits >
 ::DoConvertBuffer(void *inputData,
                   size_t numberOfPixels)
 {
-  // get the pointer to the destination buffer
-  OutputImagePixelType *outputData =
-    this->GetOutput()->GetPixelContainer()->GetBufferPointer();
+  this->DoConvertBuffer( inputData, 0, numberOfPixels );
+}
+
+template< typename TOutputImage, typename ConvertPixelTraits >
+void
+ImageFileReader< TOutputImage, ConvertPixelTraits >
+::DoConvertBuffer(void *inputData,
+                  size_t firstPixel,
+                  size_t numberOfPixels)
+{
+  // get the pointer to the destination buffer, at the first pixel
+  TOutputImage *output = this->GetOutput();
+  OutputImagePixelType *outputData = output->GetPixelContainer()->GetBufferPointer();
+  const size_t bufferedPixels = output->GetBufferedRegion().GetNumberOfPixels();
+  if ( firstPixel > 0 && bufferedPixels > 0 )
+    {
+    outputData += firstPixel * ( output->GetPixelContainer()->Size() / bufferedPixels );
+    }
   bool isVectorImage(strcmp(this->GetOutput()->GetNameOfClass(),
                             "VectorImage") == 0);
   // TODO:
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageFileWriteQueue_h
+#define itkImageFileWriteQueue_h
+#include "ITKIOImageBaseExport.h"
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+/** \class ImageFileWriteQueue
+ * \brief Background I/O thread shared by the asynchronous writers.
+ *
+ * ImageFileWriteQueue runs the jobs submitted by ImageFileWriter in
+ * asynchronous mode on a single background thread, in submission
+ * order, so that two writes of the same file land in the order they
+ * were requested.
+ *
+ * Every queued job holds a copy of the pixels it writes. The sum of
+ * these is bounded by the MemoryBudget: ReserveMemory blocks while
+ * the budget would be exceeded, until earlier jobs are done. A single
+ * write larger than the budget is let through when nothing else is
+ * outstanding.
+ *
+ * At exit, the queue waits for the pending writes, unless
+ * ThreadPool::GetDoNotWaitForThreads() is true or ITK is unloaded as a
+ * Windows DLL, in which case they are abandoned. Call
+ * ImageFileWriter::Flush() to make sure that the files are written.
+ *
+ * \sa ImageFileWriter
+ * \ingroup ITKIOImageBase
+ */
+class ITKIOImageBase_EXPORT ImageFileWriteQueue:public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(ImageFileWriteQueue);
+
+  /** Standard class type aliases. */
+  using Self = ImageFileWriteQueue;
+  using Superclass = Object;
+  using Pointer = SmartPointer< Self >;
+  using ConstPointer = SmartPointer< const Self >;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageFileWriteQueue, Object);
+
+  /** Returns the global instance */
+  static Pointer New();
+
+  /** Returns the global singleton instance of the ImageFileWriteQueue */
+  static Pointer GetInstance();
+
+  using JobType = std::function< void() >;
+
+  /** Set/Get the number of bytes that the outstanding jobs may hold.
+   * Defaults to 1 GiB. */
+  void SetMemoryBudget(SizeValueType budget);
+  SizeValueType GetMemoryBudget() const;
+
+  /** The number of bytes held by the outstanding jobs. */
+  SizeValueType GetOutstandingMemory() const;
+
+  /** Block until numberOfBytes more fit in the memory budget, then
+   * count them as outstanding. */
+  void ReserveMemory(SizeValueType numberOfBytes);
+
+  /** Give back memory reserved with ReserveMemory that will not be
+   * handed to a job. */
+  void ReleaseMemory(SizeValueType numberOfBytes);
+
+  /** Queue a job for the I/O thread. The numberOfBytes, reserved
+   * beforehand with ReserveMemory, are released when the job is done.
+   * The returned future rethrows the exception raised by the job, if
+   * any. */
+  std::future< void > Submit(const JobType & job, SizeValueType numberOfBytes);
+
+  /** Block until all the jobs submitted so far are done. */
+  void WaitForAll();
+
+protected:
+  ImageFileWriteQueue();
+  ~ImageFileWriteQueue() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The continuously running I/O thread function */
+  void ThreadExecute();
+
+  mutable std::mutex      m_Mutex;
+  std::condition_variable m_JobCondition;
+  std::condition_variable m_DoneCondition;
+
+  struct QueuedJob
+  {
+    JobType                                m_Job;
+    SizeValueType                          m_NumberOfBytes{ 0 };
+    std::shared_ptr< std::promise< void > > m_Promise;
+  };
+
+  std::deque< QueuedJob > m_Jobs;
+  std::thread             m_Thread;
+
+  SizeValueType m_MemoryBudget;
+  SizeValueType m_OutstandingMemory{ 0 };
+  SizeValueType m_NumberOfPendingJobs{ 0 };
+  bool          m_Stopping{ false };
+};
+} // end namespace itk
+
+#endif // itkImageFileWriteQueue_h
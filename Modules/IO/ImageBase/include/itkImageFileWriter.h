@@ -23,6 +23,9 @@
 #include "itkImageIOBase.h"
 #include "itkMacro.h"
 
+#include <future>
+#include <vector>
+
 namespace itk
 {
 /** \brief Base exception class for IO problems during writing.
@@ -70,6 +73,19 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * In Asynchronous mode, Write() returns as soon as the pixels to write
+ * are held by the writer, and the ImageIO encodes and writes them on
+ * the background thread of the ImageFileWriteQueue. The pixels are
+ * copied, except when the input releases its data after the write, in
+ * which case its buffer is handed over to the write instead. Flush()
+ * waits for the pending writes; their errors are thrown by Flush() or
+ * by the next Write(). Writes streamed in several pieces are always
+ * done synchronously. The memory held by all the pending writes is
+ * bounded by the MemoryBudget of the ImageFileWriteQueue. The
+ * StartEvent, ProgressEvent and EndEvent are invoked by Write() as the
+ * pixels are handed over to the ImageFileWriteQueue, so the file is not
+ * written yet when the EndEvent is observed; Flush() waits for it.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -194,6 +210,18 @@ public:
   itkGetConstReferenceMacro(UseInputMetaDataDictionary, bool);
   itkBooleanMacro(UseInputMetaDataDictionary);
 
+  /** Set/Get whether Write() returns before the file is written. Off
+   * by default. While a write is pending, its ImageIO must not be
+   * modified; a new ImageIO is created for the next write unless the
+   * ImageIO was set by the user. */
+  itkSetMacro(Asynchronous, bool);
+  itkGetConstMacro(Asynchronous, bool);
+  itkBooleanMacro(Asynchronous);
+
+  /** Wait for the pending asynchronous writes, and throw the error of
+   * the first one that failed. */
+  void Flush();
+
 protected:
   ImageFileWriter();
   ~ImageFileWriter() override;
@@ -202,6 +230,12 @@ protected:
   /** Does the real work. */
   void GenerateData() override;
 
+  /** Hand the ioRegion of the image to the write queue. Its buffer is
+   * taken as is when canTakeBuffer is true, i.e. when nothing will write
+   * to it anymore: a cache image, or an input that ReleaseInputs gives a
+   * new buffer. Otherwise it is copied. */
+  void WriteAsynchronously(InputImageType * image, const InputImageRegionType & ioRegion, bool canTakeBuffer);
+
 private:
   std::string m_FileName;
 
@@ -219,6 +253,18 @@ private:
   bool m_UseInputMetaDataDictionary;        // whether to use the
                                             // MetaDataDictionary from the
                                             // input or not.
+
+  /** Throw the error of the first finished asynchronous write that
+   * failed, and forget about the finished ones. */
+  void CheckFinishedWrites();
+
+  bool m_Asynchronous;
+  bool m_WritingAsynchronously;             // whether the current write
+                                            // is asynchronous
+
+  std::vector< std::future< void > > m_PendingWrites;
+  const ImageIOBase *                m_PendingImageIO; // used by the last
+                                                       // pending write
 };
 } // end namespace itk
 
@@ -32,6 +32,8 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include "itkImageFileWriteQueue.h"
+#include <chrono>
 #include <complex>
 
 namespace itk
@@ -48,12 +50,93 @@ ImageFileWriter< TInputImage >
   m_UserSpecifiedIORegion = false;
   m_UserSpecifiedImageIO = false;
   m_NumberOfStreamDivisions = 1;
+  m_Asynchronous = false;
+  m_WritingAsynchronously = false;
+  m_PendingImageIO = nullptr;
 }
 
 //---------------------------------------------------------
 template< typename TInputImage >
 ImageFileWriter< TInputImage >
-::~ImageFileWriter() = default;
+::~ImageFileWriter()
+{
+  // A destructor must not throw: the errors that nobody asked for are
+  // only reported
+  try
+    {
+    this->Flush();
+    }
+  catch ( std::exception & e )
+    {
+    itkWarningMacro(<< "Asynchronous write of " << m_FileName << " failed: " << e.what());
+    }
+  catch ( ... )
+    {
+    itkWarningMacro(<< "Asynchronous write of " << m_FileName << " failed");
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::Flush()
+{
+  std::exception_ptr firstException;
+  for ( auto & pendingWrite : m_PendingWrites )
+    {
+    try
+      {
+      pendingWrite.get();
+      }
+    catch ( ... )
+      {
+      if ( !firstException )
+        {
+        firstException = std::current_exception();
+        }
+      }
+    }
+  m_PendingWrites.clear();
+  m_PendingImageIO = nullptr;
+
+  if ( firstException )
+    {
+    std::rethrow_exception( firstException );
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::CheckFinishedWrites()
+{
+  // The writes of the queue are done in order, so the finished ones
+  // come first
+  auto firstPending = m_PendingWrites.begin();
+  while ( firstPending != m_PendingWrites.end()
+          && firstPending->wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+    {
+    ++firstPending;
+    }
+
+  std::vector< std::future< void > > finishedWrites;
+  finishedWrites.insert( finishedWrites.end(),
+                         std::make_move_iterator( m_PendingWrites.begin() ),
+                         std::make_move_iterator( firstPending ) );
+  m_PendingWrites.erase( m_PendingWrites.begin(), firstPending );
+  if ( m_PendingWrites.empty() )
+    {
+    m_PendingImageIO = nullptr;
+    }
+
+  for ( auto & finishedWrite : finishedWrites )
+    {
+    // Throws the error of the first failed write
+    finishedWrite.get();
+    }
+}
 
 //---------------------------------------------------------
 template< typename TInputImage >
@@ -109,6 +192,26 @@ ImageFileWriter< TInputImage >
 
   itkDebugMacro(<< "Writing an image file");
 
+  // Report the errors of the earlier asynchronous writes
+  this->CheckFinishedWrites();
+  if ( !m_Asynchronous )
+    {
+    // Do not overtake a pending write of the same file
+    this->Flush();
+    }
+  else if ( !m_PendingWrites.empty() && m_ImageIO.GetPointer() == m_PendingImageIO )
+    {
+    // The ImageIO is still in use by the last pending write
+    if ( m_FactorySpecifiedImageIO )
+      {
+      m_ImageIO = nullptr;
+      }
+    else
+      {
+      this->Flush();
+      }
+    }
+
   // Make sure input is available
   if ( input == nullptr )
     {
@@ -295,6 +398,9 @@ ImageFileWriter< TInputImage >
                                                               pasteIORegion,
                                                               largestIORegion);
 
+  // Only a write done in one piece may be handed to the write queue
+  m_WritingAsynchronously = m_Asynchronous && numDivisions == 1;
+
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
    * piece, and copy the results into the output image.
@@ -361,7 +467,10 @@ ImageFileWriter< TInputImage >
     this->UpdateProgress( static_cast<float>( piece + 1 ) / static_cast<float>( numDivisions ) );
     }
 
-  // Notify end event observers
+  m_WritingAsynchronously = false;
+
+  // Notify end event observers, while an asynchronous write may still
+  // be pending
   this->InvokeEvent( EndEvent() );
 
   // Release upstream data if requested
@@ -422,9 +531,62 @@ ImageFileWriter< TInputImage >
       }
     }
 
+  if ( m_WritingAsynchronously )
+    {
+    if ( cacheImage.IsNotNull() )
+      {
+      this->WriteAsynchronously( cacheImage, ioRegion, true );
+      }
+    else
+      {
+      this->WriteAsynchronously( const_cast< InputImageType * >( input ), ioRegion, input->ShouldIReleaseData() );
+      }
+    return;
+    }
+
   m_ImageIO->Write(dataPtr);
 }
 
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::WriteAsynchronously(InputImageType * image, const InputImageRegionType & ioRegion, bool canTakeBuffer)
+{
+  ImageFileWriteQueue::Pointer queue = ImageFileWriteQueue::GetInstance();
+  const SizeValueType numberOfBytes = ioRegion.GetNumberOfPixels()
+    * m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents();
+  queue->ReserveMemory( numberOfBytes );
+
+  InputImagePointer snapshot = InputImageType::New();
+  try
+    {
+    snapshot->CopyInformation(image);
+    snapshot->SetBufferedRegion(ioRegion);
+    if ( canTakeBuffer && image->GetBufferedRegion() == ioRegion )
+      {
+      snapshot->SetPixelContainer( image->GetPixelContainer() );
+      }
+    else
+      {
+      snapshot->Allocate();
+      ImageAlgorithm::Copy( image, snapshot.GetPointer(), ioRegion, ioRegion );
+      }
+    }
+  catch ( ... )
+    {
+    queue->ReleaseMemory( numberOfBytes );
+    throw;
+    }
+
+  ImageIOBase::Pointer imageIO = m_ImageIO;
+  m_PendingWrites.push_back( queue->Submit( [imageIO, snapshot]()
+    {
+    imageIO->Write( snapshot->GetBufferPointer() );
+    }, numberOfBytes ) );
+  m_PendingImageIO = imageIO.GetPointer();
+}
+
 //---------------------------------------------------------
 template< typename TInputImage >
 void
@@ -475,6 +637,9 @@ ImageFileWriter< TInputImage >
     {
     os << indent << "FactorySpecifiedmageIO: Off\n";
     }
+
+  os << indent << "Asynchronous: " << ( m_Asynchronous ? "On" : "Off" ) << "\n";
+  os << indent << "Number of Pending Writes: " << m_PendingWrites.size() << "\n";
 }
 } // end namespace itk
 
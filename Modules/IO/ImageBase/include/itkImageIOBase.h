@@ -84,6 +84,22 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(ImageIOBase, Superclass);
 
+  /** Create a copy of this ImageIO of the same type, see
+   * InternalClone(). */
+  itkCloneMacro(Self);
+
+  /** Return whether Clone() carries over all the settings of this
+   * ImageIO. Only then do the ImageSeriesReader and ImageSeriesWriter
+   * process their files concurrently, each with its own copy, instead
+   * of one at a time with this ImageIO. False by default, as the
+   * settings specific to a format are only copied by the classes which
+   * override InternalClone(), and those return false for subclasses
+   * which do not. */
+  virtual bool CanCloneSettings() const
+  {
+    return false;
+  }
+
   /** Set/Get the name of the file to be read. */
   itkSetStringMacro(FileName);
   itkGetStringMacro(FileName);
@@ -346,6 +362,55 @@ public:
    * Assumes SetFileName has been called with a valid file name. */
   virtual void ReadImageInformation() = 0;
 
+  /** Read the spacing and dimensions of the image from the header of
+   * the file only, without reading or decoding any of its pixel data.
+   * Returns true when this is all that ReadImageInformation() would
+   * have read, false when ReadImageInformation() must still be called
+   * before Read(), for example because the MetaDataDictionary lacks
+   * the entries stored after the pixel data. The default calls
+   * ReadImageInformation(), for formats whose header is read without
+   * the pixel data anyway. */
+  virtual bool ReadImageInformationFromHeader();
+
+  /** Set/Get whether the information read from a file by the
+   * ImageFileReader is kept in a process wide cache, keyed by the
+   * file name, and reused until the modification time or the length
+   * of the file changes. Then repeated metadata queries on the same
+   * file, through any reader, do not read it again. Off by default.
+   * The modification time has a resolution of a second, so a file
+   * rewritten with the same length within the same second is not
+   * noticed. */
+  static void SetGlobalImageInformationCaching(bool flag);
+  static bool GetGlobalImageInformationCaching();
+  static void GlobalImageInformationCachingOn()
+  { SetGlobalImageInformationCaching(true); }
+  static void GlobalImageInformationCachingOff()
+  { SetGlobalImageInformationCaching(false); }
+
+  /** Set/Get the maximum number of files in the image information
+   * cache. When it is full, the entry of the least recently read file
+   * is removed. 256 by default. */
+  static void SetGlobalImageInformationCacheMaximumSize(SizeValueType size);
+  static SizeValueType GetGlobalImageInformationCacheMaximumSize();
+
+  /** Return the number of files in the image information cache. */
+  static SizeValueType GetGlobalImageInformationCacheSize();
+
+  /** Remove all the entries of the image information cache. */
+  static void ClearGlobalImageInformationCache();
+
+  /** Add the information read by imageIO from its file to the image
+   * information cache, and return the stamp identifying the entry. */
+  static ModifiedTimeType CacheImageInformation(const ImageIOBase *imageIO);
+
+  /** Return a copy of the ImageIO cached for fileName, holding its
+   * image information and MetaDataDictionary, and set stamp to the
+   * stamp of its entry. Returns nullptr when fileName is not cached,
+   * or changed since. The copy is made with Clone(), so the state
+   * specific to a format is not set until it reads the information
+   * itself. */
+  static Pointer GetCachedImageInformation(const std::string & fileName, ModifiedTimeType & stamp);
+
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void *buffer) = 0;
 
@@ -550,6 +615,14 @@ protected:
   ~ImageIOBase() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Create a new ImageIO of the same type carrying over the
+   * user-configurable state of this one (file type, byte order,
+   * compression and streaming flags, and the image geometry for
+   * formats without a header). The file name and IORegion are not
+   * copied. Used to get an independent ImageIO per thread when
+   * reading or writing several files concurrently. */
+  LightObject::Pointer InternalClone() const override;
+
   virtual const ImageRegionSplitterBase* GetImageRegionSplitter() const;
 
   /** Check fileName as an extensions contained in the supported
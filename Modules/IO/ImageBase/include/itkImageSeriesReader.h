@@ -35,6 +35,13 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * The files are read concurrently by the filter's MultiThreader, each
+ * slice being decoded directly into its section of the output
+ * buffer. When an ImageIO is set, each slice is read with a Clone()
+ * of it if ImageIOBase::CanCloneSettings() is true, and otherwise the
+ * files are read one at a time with it. Use SetNumberOfWorkUnits(1) to
+ * read the files one at a time, with the ImageIO itself if one is set.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
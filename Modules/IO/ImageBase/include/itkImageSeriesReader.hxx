@@ -24,9 +24,13 @@
 #include "itkArray.h"
 #include "itkVector.h"
 #include "itkMath.h"
-#include "itkProgressReporter.h"
+#include "itkMultiThreaderBase.h"
 #include "itkMetaDataObject.h"
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+
 namespace itk
 {
 // Destructor
@@ -281,11 +285,6 @@ void ImageSeriesReader< TOutputImage >
   output->SetBufferedRegion(requestedRegion);
   output->Allocate();
 
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0,
-                            requestedRegion.GetSize(TOutputImage::ImageDimension-1),
-                            100);
-
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
   // information is updated so should the meta array.
@@ -296,140 +295,192 @@ void ImageSeriesReader< TOutputImage >
     && m_MetaDataDictionaryArrayUpdate;
 
   typename  TOutputImage::InternalPixelType *outputBuffer = output->GetBufferPointer();
-  IndexType                           sliceStartIndex = requestedRegion.GetIndex();
   const auto numberOfFiles = static_cast< int >( m_FileNames.size() );
 
-  for ( int i = 0; i != numberOfFiles; ++i )
-    {
-    if ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage )
-      {
-      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
-      }
-
-    const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = ( m_ReverseOrder ? numberOfFiles - i - 1 : i );
+  // The slices are independent of each other: each one is read by
+  // its own ImageFileReader, with its own ImageIO, directly into its
+  // section of the output buffer. The dictionaries are collected per
+  // slice and appended in file order once all the slices are read.
+  std::vector< DictionaryRawPointer > sliceDictionaries( numberOfFiles, nullptr );
 
-    // check if we need this slice
-    if ( !insideRequestedRegion && !needToUpdateMetaDataDictionaryArray )
-      {
-      continue;
-      }
-
-    // configure reader
-    typename ReaderType::Pointer reader = ReaderType::New();
-    reader->SetFileName( m_FileNames[iFileName].c_str() );
+  // ImageIO objects hold the state of the file being read, so when
+  // several work units run each slice gets its own copy of the user
+  // provided one, unless it cannot be copied with its settings.
+  // Otherwise the slices are read one at a time with it.
+  const bool cloneImageIO = m_ImageIO && this->GetNumberOfWorkUnits() > 1
+                            && m_ImageIO->CanCloneSettings();
 
-    TOutputImage * readerOutput = reader->GetOutput();
-
-    if ( m_ImageIO )
-      {
-      reader->SetImageIO(m_ImageIO);
-      }
-    reader->SetUseStreaming(m_UseStreaming);
-    readerOutput->SetRequestedRegion(sliceRegionToRequest);
+  std::mutex         exceptionMutex;
+  std::exception_ptr firstException;
+  std::atomic< bool > failed( false );
 
-    // update the data or info
-    if ( !insideRequestedRegion )
+  auto readSlice = [&]( SizeValueType sliceIndex )
+    {
+    if ( failed )
       {
-      reader->UpdateOutputInformation();
+      return;
       }
-    else
+    try
       {
-      // read the meta data information
-      readerOutput->UpdateOutputInformation();
-
-      // propagate the requested region to determin what the region
-      // will actually be read
-      readerOutput->PropagateRequestedRegion();
+      const auto i = static_cast< int >( sliceIndex );
 
-      // check that the size of each slice is the same
-      if ( readerOutput->GetLargestPossibleRegion().GetSize() != validSize )
+      IndexType sliceStartIndex = requestedRegion.GetIndex();
+      if ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage )
         {
-        itkExceptionMacro( << "Size mismatch! The size of  "
-                           << m_FileNames[iFileName].c_str()
-                           << " is "
-                           << readerOutput->GetLargestPossibleRegion().GetSize()
-                           << " and does not match the required size "
-                           << validSize
-                           << " from file "
-                           << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str() );
+        sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
         }
 
-      // get the size of the region to be read
-      SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
+      const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
+      const int  iFileName = ( m_ReverseOrder ? numberOfFiles - i - 1 : i );
 
-      if( readSize == sliceRegionToRequest.GetSize() )
+      // check if we need this slice
+      if ( !insideRequestedRegion && !needToUpdateMetaDataDictionaryArray )
         {
-        // if the buffer of the ImageReader is going to match that of
-        // ourselves, then set the ImageReader's buffer to a section
-        // of ours
+        return;
+        }
 
-        const size_t  numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+      // configure reader
+      typename ReaderType::Pointer reader = ReaderType::New();
+      reader->SetFileName( m_FileNames[iFileName].c_str() );
 
-        using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t      numberOfInternalComponentsPerPixel =  AccessorFunctorType::GetVectorLength( output );
+      TOutputImage * readerOutput = reader->GetOutput();
 
+      if ( cloneImageIO )
+        {
+        reader->SetImageIO( m_ImageIO->Clone() );
+        }
+      else if ( m_ImageIO )
+        {
+        reader->SetImageIO( m_ImageIO );
+        }
+      reader->SetUseStreaming(m_UseStreaming);
+      readerOutput->SetRequestedRegion(sliceRegionToRequest);
+
+      // update the data or info
+      if ( !insideRequestedRegion )
+        {
+        reader->UpdateOutputInformation();
+        }
+      else
+        {
+        // read the meta data information
+        readerOutput->UpdateOutputInformation();
 
-        const ptrdiff_t   sliceOffset = ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage ) ?
-          ( i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage)) : 0;
+        // propagate the requested region to determin what the region
+        // will actually be read
+        readerOutput->PropagateRequestedRegion();
 
-        const ptrdiff_t  numberOfPixelComponentsUpToSlice =  numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
-        const bool       bufferDelete = false;
+        // check that the size of each slice is the same
+        if ( readerOutput->GetLargestPossibleRegion().GetSize() != validSize )
+          {
+          itkExceptionMacro( << "Size mismatch! The size of  "
+                             << m_FileNames[iFileName].c_str()
+                             << " is "
+                             << readerOutput->GetLargestPossibleRegion().GetSize()
+                             << " and does not match the required size "
+                             << validSize
+                             << " from file "
+                             << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str() );
+          }
 
-        typename  TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+        // get the size of the region to be read
+        SizeType readSize = readerOutput->GetRequestedRegion().GetSize();
 
-        if ( strcmp(output->GetNameOfClass(), "VectorImage") == 0 )
+        if( readSize == sliceRegionToRequest.GetSize() )
           {
-          // if the input image type is a vector image then the number
-          // of components needs to be set for the size
-          readerOutput->GetPixelContainer()->SetImportPointer( outputSliceBuffer,
-                                                               static_cast<unsigned long>( numberOfPixelsInSlice*numberOfInternalComponentsPerPixel ),
-                                                               bufferDelete );
+          // if the buffer of the ImageReader is going to match that of
+          // ourselves, then set the ImageReader's buffer to a section
+          // of ours
+
+          const size_t  numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
+
+          using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+          const size_t      numberOfInternalComponentsPerPixel =  AccessorFunctorType::GetVectorLength( output );
+
+
+          const ptrdiff_t   sliceOffset = ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage ) ?
+            ( i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage)) : 0;
+
+          const ptrdiff_t  numberOfPixelComponentsUpToSlice =  numberOfPixelsInSlice * numberOfInternalComponentsPerPixel * sliceOffset;
+          const bool       bufferDelete = false;
+
+          typename  TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
+
+          if ( strcmp(output->GetNameOfClass(), "VectorImage") == 0 )
+            {
+            // if the input image type is a vector image then the number
+            // of components needs to be set for the size
+            readerOutput->GetPixelContainer()->SetImportPointer( outputSliceBuffer,
+                                                                 static_cast<unsigned long>( numberOfPixelsInSlice*numberOfInternalComponentsPerPixel ),
+                                                                 bufferDelete );
+            }
+          else
+            {
+            // otherwise the actual number of pixels needs to be passed
+            readerOutput->GetPixelContainer()->SetImportPointer( outputSliceBuffer,
+                                                                 static_cast<unsigned long>( numberOfPixelsInSlice ),
+                                                                 bufferDelete );
+            }
+          readerOutput->UpdateOutputData();
           }
         else
           {
-          // otherwise the actual number of pixels needs to be passed
-          readerOutput->GetPixelContainer()->SetImportPointer( outputSliceBuffer,
-                                                               static_cast<unsigned long>( numberOfPixelsInSlice ),
-                                                               bufferDelete );
-          }
-        readerOutput->UpdateOutputData();
-        }
-      else
-        {
-        // the read region isn't going to match exactly what we need
-        // to update to buffer created by the reader, then copy
+          // the read region isn't going to match exactly what we need
+          // to update to buffer created by the reader, then copy
 
-        reader->Update();
+          reader->Update();
 
-        // output of buffer copy
-        ImageRegionType outRegion = requestedRegion;
-        outRegion.SetIndex( sliceStartIndex );
+          // output of buffer copy
+          ImageRegionType outRegion = requestedRegion;
+          outRegion.SetIndex( sliceStartIndex );
 
-        // set the moving dimension to a size of 1
-        if ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage )
-          {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
-          }
+          // set the moving dimension to a size of 1
+          if ( TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage )
+            {
+            outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+            }
 
-        ImageAlgorithm::Copy( readerOutput, output, sliceRegionToRequest, outRegion );
+          ImageAlgorithm::Copy( readerOutput, output, sliceRegionToRequest, outRegion );
 
-        }
+          }
+        } // end !insidedRequestedRegion
 
-      // report progress for read slices
-      progress.CompletedPixel();
+      // Deep copy the MetaDataDictionary
+      if ( reader->GetImageIO() &&  needToUpdateMetaDataDictionaryArray )
+        {
+        auto newDictionary = new DictionaryType;
+        *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
+        sliceDictionaries[i] = newDictionary;
+        }
+      }
+    catch ( ... )
+      {
+      std::lock_guard< std::mutex > lock( exceptionMutex );
+      if ( !failed )
+        {
+        firstException = std::current_exception();
+        failed = true;
+        }
+      }
+    };
 
-     } // end !insidedRequestedRegion
+  // progress reported on a per slice basis by the multi-threader
+  this->GetMultiThreader()->SetNumberOfWorkUnits( m_ImageIO && !cloneImageIO ? 1 : this->GetNumberOfWorkUnits() );
+  this->GetMultiThreader()->ParallelizeArray( 0, numberOfFiles, readSlice, this );
 
-    // Deep copy the MetaDataDictionary into the array
-    if ( reader->GetImageIO() &&  needToUpdateMetaDataDictionaryArray )
+  // Move the dictionaries into the array, in slice order
+  for ( auto & dictionary : sliceDictionaries )
+    {
+    if ( dictionary != nullptr )
       {
-      auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      m_MetaDataDictionaryArray.push_back(newDictionary);
+      m_MetaDataDictionaryArray.push_back(dictionary);
       }
+    }
 
-    } // end per slice loop
+  if ( failed )
+    {
+    std::rethrow_exception( firstException );
+    }
 
   // update the time if we modified the meta array
   if ( needToUpdateMetaDataDictionaryArray )
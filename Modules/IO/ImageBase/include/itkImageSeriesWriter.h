@@ -23,6 +23,7 @@
 #include "itkImageFileWriter.h"
 #include <vector>
 #include <string>
+#include <type_traits>
 
 namespace itk
 {
@@ -71,6 +72,17 @@ public:
  * the type of file is determined by either the file extension or an
  * ImageIO class if specified.
  *
+ * The files are written one at a time by default. Use
+ * SetNumberOfWorkUnits() with more than one work unit to encode and
+ * write them concurrently by the filter's MultiThreader, each one by
+ * its own ImageFileWriter. When an ImageIO is set, each file is then
+ * written with a Clone() of it if ImageIOBase::CanCloneSettings() is
+ * true, and otherwise the files are still written one at a time with
+ * it. When the input and output images have the same pixel container
+ * type and the slices span the buffered region of the input, the files
+ * are written directly from the input buffer instead of from a copy of
+ * each slice.
+ *
  * \sa ImageFileWriter
  * \sa ImageIOBase
  * \sa ImageSeriesReader
@@ -240,6 +252,13 @@ private:
   void GenerateNumericFileNames();
 
   void WriteFiles();
+
+  /** Make outputImage refer to size values of the input buffer,
+   * starting at offset, without copying them. */
+  static void ReferenceSlice(const InputImageType *inputImage, SizeValueType offset, SizeValueType size,
+                             OutputImageType *outputImage, std::true_type);
+  static void ReferenceSlice(const InputImageType *, SizeValueType, SizeValueType,
+                             OutputImageType *, std::false_type);
 };
 } // end namespace itk
 
@@ -27,7 +27,10 @@
 #include "itkMetaDataObject.h"
 #include "itkArray.h"
 #include "vnl/algo/vnl_determinant.h"
+#include <atomic>
 #include <cstdio>
+#include <exception>
+#include <mutex>
 
 #if defined(_MSC_VER)
 #define snprintf _snprintf
@@ -43,6 +46,9 @@ ImageSeriesWriter< TInputImage, TOutputImage >
   m_SeriesFormat("%d")
 {
   m_UseCompression = false;
+
+  // Writing the files concurrently is opt-in
+  this->SetNumberOfWorkUnits(1);
 }
 
 //---------------------------------------------------------
@@ -205,21 +211,14 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     outRegion.SetSize(i, inputImage->GetRequestedRegion().GetSize()[i]);
     }
 
-  // Allocate an image for output and create an iterator for it
-  typename OutputImageType::Pointer outputImage = OutputImageType::New();
-  outputImage->SetRegions(outRegion);
-  outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
-  outputImage->Allocate();
-
   // Set the origin and spacing of the output
-  double spacing[TOutputImage::ImageDimension];
-  double origin[TOutputImage::ImageDimension];
+  typename TOutputImage::PointType origin;
+  typename TOutputImage::SpacingType spacing;
   typename TOutputImage::DirectionType direction;
   for ( unsigned int i = 0; i < TOutputImage::ImageDimension; i++ )
     {
     origin[i] = inputImage->GetOrigin()[i];
     spacing[i] = inputImage->GetSpacing()[i];
-    outRegion.SetSize(i, inputImage->GetRequestedRegion().GetSize()[i]);
     for ( unsigned int j = 0; j < TOutputImage::ImageDimension; j++ )
       {
       direction[j][i] = inputImage->GetDirection()[j][i];
@@ -238,14 +237,9 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     direction.SetIdentity();
     }
 
-  outputImage->SetOrigin(origin);
-  outputImage->SetSpacing(spacing);
-  outputImage->SetDirection(direction);
-
-  Index< TInputImage::ImageDimension > inIndex;
-  Size< TInputImage::ImageDimension >  inSize;
+  Size< TInputImage::ImageDimension > inSize;
 
-  SizeValueType pixelsPerFile = outputImage->GetRequestedRegion().GetNumberOfPixels();
+  const SizeValueType pixelsPerFile = outRegion.GetNumberOfPixels();
 
   inSize.Fill(1);
   for ( unsigned int ns = 0; ns < TOutputImage::ImageDimension; ns++ )
@@ -267,107 +261,197 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     return;
     }
 
-  itkDebugMacro( << "Number of files to write = " << m_FileNames.size() );
-
-  ProgressReporter progress(this, 0,
-                            expectedNumberOfFiles,
-                            expectedNumberOfFiles);
-
-  // For each "slice" in the input, copy the region to the output,
-  // build a filename and write the file.
-
-  typename InputImageType::OffsetValueType offset = 0;
-  for ( unsigned int slice = 0; slice < m_FileNames.size(); slice++ )
+  if ( m_MetaDataDictionaryArray )
     {
-    // Select a "slice" of the image.
-    inIndex = inputImage->ComputeIndex(offset);
-    inRegion.SetIndex(inIndex);
-    inRegion.SetSize(inSize);
-
-    // Copy the selected "slice" into the output image.
-    ImageAlgorithm::Copy(inputImage, outputImage.GetPointer(), inRegion, outRegion);
-
-    typename WriterType::Pointer writer = WriterType::New();
+    if ( !m_ImageIO )
+      {
+      itkExceptionMacro(<< "Attempted to use a MetaDataDictionaryArray without specifying an ImageIO!");
+      }
+    if ( m_MetaDataDictionaryArray->size() < expectedNumberOfFiles )
+      {
+      itkExceptionMacro (
+        "The slice number: " << m_MetaDataDictionaryArray->size() + 1 << " exceeds the size of the MetaDataDictionaryArray "
+                             << m_MetaDataDictionaryArray->size() << ".");
+      }
+    }
 
-    writer->UseInputMetaDataDictionaryOff(); // use the dictionary from the
-                                             // ImageIO class
-    writer->SetInput(outputImage);
+  itkDebugMacro( << "Number of files to write = " << m_FileNames.size() );
 
-    if ( m_ImageIO )
+  // When each slice covers the whole buffered extent of the input in
+  // the dimensions of the files, the slices are contiguous sections of
+  // the input buffer, and the files are written straight from it.
+  const ImageRegion< TInputImage::ImageDimension > bufferedRegion = inputImage->GetBufferedRegion();
+  bool writeFromInputBuffer = std::is_same< typename TInputImage::PixelContainer,
+                                            typename TOutputImage::PixelContainer >::value
+    && bufferedRegion.GetNumberOfPixels() > 0;
+  for ( unsigned int i = 0; i < TOutputImage::ImageDimension; i++ )
+    {
+    writeFromInputBuffer = writeFromInputBuffer && bufferedRegion.GetSize(i) == outRegion.GetSize(i);
+    }
+  const SizeValueType valuesPerPixel = writeFromInputBuffer ?
+    inputImage->GetPixelContainer()->Size() / bufferedRegion.GetNumberOfPixels() : 0;
+
+  // The slices are encoded and written concurrently, each by its own
+  // ImageFileWriter with its own ImageIO. ImageIO objects hold the state
+  // of the file being written, so when several work units run each
+  // slice gets its own copy of the user provided one, unless it cannot
+  // be copied with its settings. Otherwise the slices are written one
+  // at a time with it.
+  std::vector< DictionaryType > sliceDictionaries( m_ImageIO ? m_FileNames.size() : 0 );
+  const bool                    cloneImageIO = m_ImageIO && this->GetNumberOfWorkUnits() > 1
+                                               && m_ImageIO->CanCloneSettings();
+
+  std::mutex         exceptionMutex;
+  std::exception_ptr firstException;
+  std::atomic< bool > failed( false );
+
+  auto writeSlice = [&]( SizeValueType slice )
+    {
+    if ( failed )
       {
-      writer->SetImageIO(m_ImageIO);
+      return;
       }
-
-    if ( m_MetaDataDictionaryArray )
+    try
       {
-      if ( m_ImageIO )
+      // Select a "slice" of the image.
+      const auto offset = static_cast< typename InputImageType::OffsetValueType >( slice * pixelsPerFile );
+      const Index< TInputImage::ImageDimension > inIndex = inputImage->ComputeIndex(offset);
+      ImageRegion< TInputImage::ImageDimension > sliceRegion( inIndex, inSize );
+
+      typename OutputImageType::Pointer outputImage = OutputImageType::New();
+      outputImage->SetRegions(outRegion);
+      outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
+      outputImage->SetOrigin(origin);
+      outputImage->SetSpacing(spacing);
+      outputImage->SetDirection(direction);
+
+      if ( writeFromInputBuffer )
         {
-        if ( slice > m_MetaDataDictionaryArray->size() - 1 )
-          {
-          itkExceptionMacro (
-            "The slice number: " << slice + 1 << " exceeds the size of the MetaDataDictionaryArray "
-                                 << m_MetaDataDictionaryArray->size() << ".");
-          }
-        DictionaryRawPointer dictionary = ( *m_MetaDataDictionaryArray )[slice];
-        m_ImageIO->SetMetaDataDictionary( ( *dictionary ) );
+        Self::ReferenceSlice( inputImage, offset * valuesPerPixel, pixelsPerFile * valuesPerPixel, outputImage,
+                              std::is_same< typename TInputImage::PixelContainer,
+                                            typename TOutputImage::PixelContainer >() );
         }
       else
         {
-        itkExceptionMacro(<< "Attempted to use a MetaDataDictionaryArray without specifying an ImageIO!");
+        // Copy the selected "slice" into the output image.
+        outputImage->Allocate();
+        ImageAlgorithm::Copy(inputImage, outputImage.GetPointer(), sliceRegion, outRegion);
         }
-      }
-    else
-      {
+
+      typename WriterType::Pointer writer = WriterType::New();
+
+      writer->UseInputMetaDataDictionaryOff(); // use the dictionary from the
+                                               // ImageIO class
+      writer->SetInput(outputImage);
+
       if ( m_ImageIO )
         {
-        DictionaryType & dictionary = m_ImageIO->GetMetaDataDictionary();
+        ImageIOBase::Pointer imageIO = cloneImageIO ? m_ImageIO->Clone() : m_ImageIO;
+        DictionaryType & dictionary = sliceDictionaries[slice];
+
+        if ( m_MetaDataDictionaryArray )
+          {
+          dictionary = *( *m_MetaDataDictionaryArray )[slice];
+          }
+        else
+          {
+          dictionary = m_ImageIO->GetMetaDataDictionary();
 
-        typename InputImageType::SpacingType spacing2 = inputImage->GetSpacing();
+          typename InputImageType::SpacingType spacing2 = inputImage->GetSpacing();
 
-        // origin of the output slice in the
-        // N-Dimensional space of the input image.
-        typename InputImageType::PointType origin2;
+          // origin of the output slice in the
+          // N-Dimensional space of the input image.
+          typename InputImageType::PointType origin2;
 
-        inputImage->TransformIndexToPhysicalPoint(inIndex, origin2);
+          inputImage->TransformIndexToPhysicalPoint(inIndex, origin2);
 
-        const unsigned int inputImageDimension = TInputImage::ImageDimension;
+          const unsigned int inputImageDimension = TInputImage::ImageDimension;
 
-        using DoubleArrayType = Array< double >;
+          using DoubleArrayType = Array< double >;
 
-        DoubleArrayType originArray(inputImageDimension);
-        DoubleArrayType spacingArray(inputImageDimension);
+          DoubleArrayType originArray(inputImageDimension);
+          DoubleArrayType spacingArray(inputImageDimension);
 
-        for ( unsigned int d = 0; d < inputImageDimension; d++ )
-          {
-          originArray[d]  = origin2[d];
-          spacingArray[d] = spacing2[d];
-          }
+          for ( unsigned int d = 0; d < inputImageDimension; d++ )
+            {
+            originArray[d]  = origin2[d];
+            spacingArray[d] = spacing2[d];
+            }
 
-        EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Origin, originArray);
-        EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Spacing, spacingArray);
-        EncapsulateMetaData<  unsigned int   >(dictionary, ITK_NumberOfDimensions, inputImageDimension);
+          EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Origin, originArray);
+          EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Spacing, spacingArray);
+          EncapsulateMetaData<  unsigned int   >(dictionary, ITK_NumberOfDimensions, inputImageDimension);
 
-        typename InputImageType::DirectionType direction2 = inputImage->GetDirection();
-        using DoubleMatrixType = Matrix< double, inputImageDimension, inputImageDimension>;
-        DoubleMatrixType directionMatrix;
-        for( unsigned int i = 0; i < inputImageDimension; i++ )
-          {
-          for( unsigned int j = 0; j < inputImageDimension; j++ )
+          typename InputImageType::DirectionType direction2 = inputImage->GetDirection();
+          using DoubleMatrixType = Matrix< double, inputImageDimension, inputImageDimension>;
+          DoubleMatrixType directionMatrix;
+          for( unsigned int i = 0; i < inputImageDimension; i++ )
             {
-            directionMatrix[j][i]  = direction2[i][j];
+            for( unsigned int j = 0; j < inputImageDimension; j++ )
+              {
+              directionMatrix[j][i]  = direction2[i][j];
+              }
             }
+          EncapsulateMetaData< DoubleMatrixType >( dictionary, ITK_ZDirection, directionMatrix );
           }
-        EncapsulateMetaData< DoubleMatrixType >( dictionary, ITK_ZDirection, directionMatrix );
+
+        imageIO->SetMetaDataDictionary( dictionary );
+        writer->SetImageIO(imageIO);
+        }
+
+      writer->SetFileName( m_FileNames[slice].c_str() );
+      writer->SetUseCompression(m_UseCompression);
+      writer->Update();
+      }
+    catch ( ... )
+      {
+      std::lock_guard< std::mutex > lock( exceptionMutex );
+      if ( !failed )
+        {
+        firstException = std::current_exception();
+        failed = true;
         }
       }
+    };
 
-    writer->SetFileName( m_FileNames[slice].c_str() );
-    writer->SetUseCompression(m_UseCompression);
-    writer->Update();
+  // progress reported on a per slice basis by the multi-threader
+  this->GetMultiThreader()->SetNumberOfWorkUnits( m_ImageIO && !cloneImageIO ? 1 : this->GetNumberOfWorkUnits() );
+  this->GetMultiThreader()->ParallelizeArray( 0, m_FileNames.size(), writeSlice, this );
 
-    progress.CompletedPixel();
-    offset += pixelsPerFile;
+  if ( failed )
+    {
+    std::rethrow_exception( firstException );
     }
+
+  // As when the slices were written one after the other, the ImageIO
+  // is left with the dictionary of the last slice
+  if ( !sliceDictionaries.empty() )
+    {
+    m_ImageIO->SetMetaDataDictionary( sliceDictionaries.back() );
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+void
+ImageSeriesWriter< TInputImage, TOutputImage >
+::ReferenceSlice(const InputImageType *inputImage, SizeValueType offset, SizeValueType size,
+                 OutputImageType *outputImage, std::true_type)
+{
+  // The writer does not modify the pixels, and the output image does
+  // not own them.
+  auto * buffer = const_cast< typename InputImageType::InternalPixelType * >( inputImage->GetBufferPointer() );
+  outputImage->GetPixelContainer()->SetImportPointer( buffer + offset, size, false );
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+void
+ImageSeriesWriter< TInputImage, TOutputImage >
+::ReferenceSlice(const InputImageType *, SizeValueType, SizeValueType,
+                 OutputImageType *, std::false_type)
+{
+  itkGenericExceptionMacro(<< "The input and output images do not share their pixel container type");
 }
 
 //---------------------------------------------------------
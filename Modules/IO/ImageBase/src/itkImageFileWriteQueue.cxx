@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageFileWriteQueue.h"
+#include "itkThreadPool.h"
+
+#include <algorithm>
+
+namespace
+{
+std::mutex                       instanceMutex;
+itk::ImageFileWriteQueue::Pointer instance;
+}
+
+namespace itk
+{
+
+ImageFileWriteQueue::Pointer
+ImageFileWriteQueue
+::New()
+{
+  return Self::GetInstance();
+}
+
+ImageFileWriteQueue::Pointer
+ImageFileWriteQueue
+::GetInstance()
+{
+  std::unique_lock< std::mutex > mutexHolder( instanceMutex );
+  if ( instance.IsNull() )
+    {
+    instance = ObjectFactory< Self >::Create();
+    if ( instance.IsNull() )
+      {
+      instance = new Self;
+      instance->UnRegister();
+      }
+    }
+  return instance;
+}
+
+ImageFileWriteQueue
+::ImageFileWriteQueue() :
+  m_MemoryBudget( SizeValueType( 1 ) << 30 )
+{
+  m_Thread = std::thread( &Self::ThreadExecute, this );
+}
+
+ImageFileWriteQueue
+::~ImageFileWriteQueue()
+{
+  bool waitForThread = true;
+#if defined(_WIN32) && defined(ITKIOImageBase_EXPORTS)
+  // This destructor is called during DllMain's DLL_PROCESS_DETACH, once
+  // the other threads of the process have been terminated, as for the
+  // ThreadPool. Joining the background thread there would deadlock.
+  waitForThread = false;
+#else
+  if ( ThreadPool::GetDoNotWaitForThreads() )
+    {
+    waitForThread = false;
+    }
+#endif
+
+  {
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  m_Stopping = true;
+  }
+
+  if ( !m_Thread.joinable() )
+    {
+    return;
+    }
+  if ( waitForThread )
+    {
+    // The thread returns once the queued writes are done
+    m_JobCondition.notify_all();
+    m_Thread.join();
+    }
+  else
+    {
+    // The queued writes are abandoned
+    m_Thread.detach();
+    }
+}
+
+void
+ImageFileWriteQueue
+::SetMemoryBudget(SizeValueType budget)
+{
+  {
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  if ( m_MemoryBudget == budget )
+    {
+    return;
+    }
+  m_MemoryBudget = budget;
+  }
+  // A larger budget may let blocked writers through
+  m_DoneCondition.notify_all();
+  this->Modified();
+}
+
+SizeValueType
+ImageFileWriteQueue
+::GetMemoryBudget() const
+{
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  return m_MemoryBudget;
+}
+
+SizeValueType
+ImageFileWriteQueue
+::GetOutstandingMemory() const
+{
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  return m_OutstandingMemory;
+}
+
+void
+ImageFileWriteQueue
+::ReserveMemory(SizeValueType numberOfBytes)
+{
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+
+  // A job writing asynchronously would wait for itself
+  if ( std::this_thread::get_id() != m_Thread.get_id() )
+    {
+    m_DoneCondition.wait( mutexHolder, [this, numberOfBytes]
+      {
+      return m_OutstandingMemory == 0 || m_OutstandingMemory + numberOfBytes <= m_MemoryBudget;
+      } );
+    }
+  m_OutstandingMemory += numberOfBytes;
+}
+
+void
+ImageFileWriteQueue
+::ReleaseMemory(SizeValueType numberOfBytes)
+{
+  {
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  m_OutstandingMemory -= std::min( numberOfBytes, m_OutstandingMemory );
+  }
+  m_DoneCondition.notify_all();
+}
+
+std::future< void >
+ImageFileWriteQueue
+::Submit(const JobType & job, SizeValueType numberOfBytes)
+{
+  QueuedJob queuedJob;
+  queuedJob.m_Job = job;
+  queuedJob.m_NumberOfBytes = numberOfBytes;
+  queuedJob.m_Promise = std::make_shared< std::promise< void > >();
+  std::future< void > result = queuedJob.m_Promise->get_future();
+  {
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  ++m_NumberOfPendingJobs;
+  m_Jobs.push_back( std::move( queuedJob ) );
+  }
+  m_JobCondition.notify_one();
+  return result;
+}
+
+void
+ImageFileWriteQueue
+::WaitForAll()
+{
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  if ( std::this_thread::get_id() == m_Thread.get_id() )
+    {
+    return;
+    }
+  m_DoneCondition.wait( mutexHolder, [this] { return m_NumberOfPendingJobs == 0; } );
+}
+
+void
+ImageFileWriteQueue
+::ThreadExecute()
+{
+  while ( true )
+    {
+    QueuedJob queuedJob;
+    {
+    std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+    m_JobCondition.wait( mutexHolder, [this] { return m_Stopping || !m_Jobs.empty(); } );
+    if ( m_Jobs.empty() )
+      {
+      return; // m_Stopping, and all the queued writes are done
+      }
+    queuedJob = std::move( m_Jobs.front() );
+    m_Jobs.pop_front();
+    }
+
+    std::exception_ptr exception;
+    try
+      {
+      queuedJob.m_Job();
+      }
+    catch ( ... )
+      {
+      exception = std::current_exception();
+      }
+
+    // Free the pixels held by the job before its memory is given back,
+    // and fulfill its promise before WaitForAll may return
+    queuedJob.m_Job = nullptr;
+    this->ReleaseMemory( queuedJob.m_NumberOfBytes );
+    if ( exception )
+      {
+      queuedJob.m_Promise->set_exception( exception );
+      }
+    else
+      {
+      queuedJob.m_Promise->set_value();
+      }
+
+    {
+    std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+    --m_NumberOfPendingJobs;
+    }
+    m_DoneCondition.notify_all();
+    }
+}
+
+void
+ImageFileWriteQueue
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  std::unique_lock< std::mutex > mutexHolder( m_Mutex );
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "OutstandingMemory: " << m_OutstandingMemory << std::endl;
+  os << indent << "NumberOfPendingJobs: " << m_NumberOfPendingJobs << std::endl;
+}
+
+} // end namespace itk
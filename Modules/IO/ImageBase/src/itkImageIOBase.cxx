@@ -21,7 +21,9 @@
 #include <mutex>
 #include "itksys/SystemTools.hxx"
 
+#include <atomic>
 #include <iterator>
+#include <map>
 
 namespace itk
 {
@@ -929,6 +931,140 @@ ImageIOBase::GetImageRegionSplitter() const
   return ioDefaultSplitter;
 }
 
+bool
+ImageIOBase::ReadImageInformationFromHeader()
+{
+  this->ReadImageInformation();
+  return true;
+}
+
+namespace
+{
+struct ImageInformationCacheEntry
+{
+  ImageIOBase::Pointer m_ImageIO;
+  MetaDataDictionary   m_MetaDataDictionary;
+  unsigned long        m_FileModifiedTime;
+  unsigned long        m_FileLength;
+  ModifiedTimeType     m_Stamp;
+  SizeValueType        m_LastUse;
+};
+
+std::mutex                                          imageInformationCacheLock;
+std::map< std::string, ImageInformationCacheEntry > imageInformationCache;
+std::atomic< bool >                                 imageInformationCaching( false );
+SizeValueType                                       imageInformationCacheMaximumSize = 256;
+SizeValueType                                       imageInformationCacheUse = 0;
+
+// Remove the least recently used entries until the cache fits in its
+// maximum size. The lock must be held by the caller.
+void
+TrimImageInformationCache()
+{
+  while ( imageInformationCache.size() > imageInformationCacheMaximumSize )
+    {
+    auto oldest = imageInformationCache.begin();
+    for ( auto it = imageInformationCache.begin(); it != imageInformationCache.end(); ++it )
+      {
+      if ( it->second.m_LastUse < oldest->second.m_LastUse )
+        {
+        oldest = it;
+        }
+      }
+    imageInformationCache.erase( oldest );
+    }
+}
+}
+
+void
+ImageIOBase::SetGlobalImageInformationCaching(bool flag)
+{
+  imageInformationCaching = flag;
+  if ( !flag )
+    {
+    ImageIOBase::ClearGlobalImageInformationCache();
+    }
+}
+
+bool
+ImageIOBase::GetGlobalImageInformationCaching()
+{
+  return imageInformationCaching;
+}
+
+void
+ImageIOBase::SetGlobalImageInformationCacheMaximumSize(SizeValueType size)
+{
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  imageInformationCacheMaximumSize = size;
+  TrimImageInformationCache();
+}
+
+SizeValueType
+ImageIOBase::GetGlobalImageInformationCacheMaximumSize()
+{
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  return imageInformationCacheMaximumSize;
+}
+
+SizeValueType
+ImageIOBase::GetGlobalImageInformationCacheSize()
+{
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  return static_cast< SizeValueType >( imageInformationCache.size() );
+}
+
+void
+ImageIOBase::ClearGlobalImageInformationCache()
+{
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  imageInformationCache.clear();
+}
+
+ModifiedTimeType
+ImageIOBase::CacheImageInformation(const ImageIOBase *imageIO)
+{
+  ImageInformationCacheEntry entry;
+  entry.m_ImageIO = imageIO->Clone();
+  entry.m_MetaDataDictionary = imageIO->GetMetaDataDictionary();
+  entry.m_FileModifiedTime = static_cast< unsigned long >( itksys::SystemTools::ModifiedTime( imageIO->GetFileName() ) );
+  entry.m_FileLength = itksys::SystemTools::FileLength( imageIO->GetFileName() );
+  TimeStamp stamp;
+  stamp.Modified();
+  entry.m_Stamp = stamp.GetMTime();
+
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  entry.m_LastUse = ++imageInformationCacheUse;
+  imageInformationCache[imageIO->GetFileName()] = std::move( entry );
+  TrimImageInformationCache();
+  return stamp.GetMTime();
+}
+
+ImageIOBase::Pointer
+ImageIOBase::GetCachedImageInformation(const std::string & fileName, ModifiedTimeType & stamp)
+{
+  const auto modifiedTime = static_cast< unsigned long >( itksys::SystemTools::ModifiedTime( fileName ) );
+  const unsigned long fileLength = itksys::SystemTools::FileLength( fileName );
+
+  std::lock_guard< std::mutex > lock( imageInformationCacheLock );
+  auto it = imageInformationCache.find( fileName );
+  if ( it == imageInformationCache.end() )
+    {
+    return nullptr;
+    }
+  if ( it->second.m_FileModifiedTime != modifiedTime || it->second.m_FileLength != fileLength )
+    {
+    imageInformationCache.erase( it );
+    return nullptr;
+    }
+  it->second.m_LastUse = ++imageInformationCacheUse;
+  Pointer imageIO = it->second.m_ImageIO->Clone();
+  imageIO->SetFileName( fileName );
+  imageIO->SetMetaDataDictionary( it->second.m_MetaDataDictionary );
+  stamp = it->second.m_Stamp;
+  return imageIO;
+}
+
 
 bool
 ImageIOBase::HasSupportedReadExtension( const char *fileName, bool ignoreCase )
@@ -1147,6 +1283,38 @@ std::ostream & operator<<( std::ostream & os, const std::vector<T>& v)
 }
 }
 
+LightObject::Pointer
+ImageIOBase::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+
+  rval->m_PixelType = m_PixelType;
+  rval->m_ComponentType = m_ComponentType;
+  rval->m_ByteOrder = m_ByteOrder;
+  rval->m_FileType = m_FileType;
+  rval->m_NumberOfComponents = m_NumberOfComponents;
+  rval->m_NumberOfDimensions = m_NumberOfDimensions;
+  rval->m_UseCompression = m_UseCompression;
+  rval->m_UseStreamedReading = m_UseStreamedReading;
+  rval->m_UseStreamedWriting = m_UseStreamedWriting;
+  rval->m_ExpandRGBPalette = m_ExpandRGBPalette;
+  rval->m_Dimensions = m_Dimensions;
+  rval->m_Spacing = m_Spacing;
+  rval->m_Origin = m_Origin;
+  rval->m_Direction = m_Direction;
+  rval->m_Strides = m_Strides;
+
+  return loPtr;
+}
+
 void ImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
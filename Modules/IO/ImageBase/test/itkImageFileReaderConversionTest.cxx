@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBAPixel.h"
+#include "itkRGBPixel.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+#include <functional>
+
+// Read files whose pixel type differs from the output's: wider output
+// pixels (converted in place in the output buffer), narrower output
+// pixels from a file that can be streamed (converted slab by slab) and
+// from a compressed file (converted from a whole copy), and check every
+// pixel against a conversion done one pixel at a time.
+
+namespace
+{
+
+template< typename TImage >
+typename TImage::Pointer
+CreateImage( const typename TImage::SizeType & size,
+             const std::function< typename TImage::PixelType( const typename TImage::IndexType & ) > & value )
+{
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( value( it.GetIndex() ) );
+    }
+  return image;
+}
+
+template< typename TImage >
+void
+WriteImage( const TImage * image, const std::string & fileName, bool compress )
+{
+  using WriterType = itk::ImageFileWriter< TImage >;
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetFileName( fileName );
+  writer->SetUseCompression( compress );
+  writer->Update();
+}
+
+template< typename TOutputImage, typename TFileImage, typename TConvert >
+int
+ReadAndCheck( const TFileImage * fileImage, const std::string & fileName, bool useStreaming,
+              TConvert convert )
+{
+  std::cout << fileName << ( useStreaming ? "" : " without streaming" ) << std::endl;
+
+  using ReaderType = itk::ImageFileReader< TOutputImage >;
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetUseStreaming( useStreaming );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  const TOutputImage * output = reader->GetOutput();
+
+  TEST_EXPECT_EQUAL( output->GetBufferedRegion().GetNumberOfPixels(),
+                     fileImage->GetBufferedRegion().GetNumberOfPixels() );
+  itk::ImageRegionConstIteratorWithIndex< TFileImage > it( fileImage, fileImage->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( !convert( it.Get(), output->GetPixel( it.GetIndex() ) ) )
+      {
+      std::cerr << fileName << ": wrong value at " << it.GetIndex() << ": " << output->GetPixel( it.GetIndex() )
+                << " from " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkImageFileReaderConversionTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkImageFileReaderConversionTest";
+
+  int status = EXIT_SUCCESS;
+
+  // Narrower output pixels. The volume spans more than one slab.
+  {
+  using FloatImageType = itk::Image< float, 3 >;
+  using UCharImageType = itk::Image< unsigned char, 3 >;
+  FloatImageType::SizeType size;
+  size[0] = 128;
+  size[1] = 128;
+  size[2] = 300;
+  FloatImageType::Pointer image = CreateImage< FloatImageType >( size,
+    []( const FloatImageType::IndexType & index )
+    {
+    return static_cast< float >( ( index[0] + 3 * index[1] + 7 * index[2] ) % 251 ) + 0.25f;
+    } );
+  const auto toUChar = []( float in, unsigned char out ) { return out == static_cast< unsigned char >( in ); };
+
+  WriteImage( image.GetPointer(), directory + "Float.mha", false );
+  status |= ReadAndCheck< UCharImageType >( image.GetPointer(), directory + "Float.mha", true, toUChar );
+  status |= ReadAndCheck< UCharImageType >( image.GetPointer(), directory + "Float.mha", false, toUChar );
+  WriteImage( image.GetPointer(), directory + "FloatCompressed.mha", true );
+  status |= ReadAndCheck< UCharImageType >( image.GetPointer(), directory + "FloatCompressed.mha", true, toUChar );
+  }
+
+  // Wider output pixels, over several conversion chunks
+  {
+  using UCharImageType = itk::Image< unsigned char, 3 >;
+  using DoubleImageType = itk::Image< double, 3 >;
+  using RGBAImageType = itk::Image< itk::RGBAPixel< unsigned short >, 3 >;
+  UCharImageType::SizeType size;
+  size[0] = 70;
+  size[1] = 60;
+  size[2] = 50;
+  UCharImageType::Pointer image = CreateImage< UCharImageType >( size,
+    []( const UCharImageType::IndexType & index )
+    {
+    return static_cast< unsigned char >( index[0] + 5 * index[1] + 11 * index[2] );
+    } );
+  WriteImage( image.GetPointer(), directory + "UChar.mha", false );
+
+  status |= ReadAndCheck< DoubleImageType >( image.GetPointer(), directory + "UChar.mha", true,
+    []( unsigned char in, double out ) { return out == static_cast< double >( in ); } );
+  status |= ReadAndCheck< RGBAImageType >( image.GetPointer(), directory + "UChar.mha", true,
+    []( unsigned char in, const itk::RGBAPixel< unsigned short > & out )
+    {
+    return out.GetRed() == in && out.GetGreen() == in && out.GetBlue() == in && out.GetAlpha() == 255;
+    } );
+  }
+
+  // Color to gray and to a vector image
+  {
+  using RGBImageType = itk::Image< itk::RGBPixel< unsigned char >, 2 >;
+  using FloatImageType = itk::Image< float, 2 >;
+  using VectorImageType = itk::VectorImage< float, 2 >;
+  RGBImageType::SizeType size;
+  size[0] = 300;
+  size[1] = 250;
+  RGBImageType::Pointer image = CreateImage< RGBImageType >( size,
+    []( const RGBImageType::IndexType & index )
+    {
+    itk::RGBPixel< unsigned char > pixel;
+    pixel.SetRed( static_cast< unsigned char >( index[0] ) );
+    pixel.SetGreen( static_cast< unsigned char >( index[1] ) );
+    pixel.SetBlue( static_cast< unsigned char >( index[0] + index[1] ) );
+    return pixel;
+    } );
+  WriteImage( image.GetPointer(), directory + "RGB.mha", false );
+
+  status |= ReadAndCheck< FloatImageType >( image.GetPointer(), directory + "RGB.mha", true,
+    []( const itk::RGBPixel< unsigned char > & in, float out )
+    {
+    return out == static_cast< float >( ( 2125.0 * static_cast< float >( in.GetRed() )
+                                          + 7154.0 * static_cast< float >( in.GetGreen() )
+                                          + 0721.0 * static_cast< float >( in.GetBlue() ) ) / 10000.0 );
+    } );
+  status |= ReadAndCheck< VectorImageType >( image.GetPointer(), directory + "RGB.mha", true,
+    []( const itk::RGBPixel< unsigned char > & in, const itk::VariableLengthVector< float > & out )
+    {
+    return out.GetSize() == 3 && out[0] == in.GetRed() && out[1] == in.GetGreen() && out[2] == in.GetBlue();
+    } );
+  }
+
+  if ( status == EXIT_SUCCESS )
+    {
+    std::cout << "Test finished." << std::endl;
+    }
+  return status;
+}
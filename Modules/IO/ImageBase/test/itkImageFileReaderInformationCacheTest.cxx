@@ -0,0 +1,314 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGDCMImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkTestingMacros.h"
+
+#include <fstream>
+
+// Read the information of a DICOM file from its header only and compare
+// it with the whole information, then query and read an image through
+// the image information cache, rewriting the file in between.
+
+namespace
+{
+
+using PixelType = short;
+using ImageType = itk::Image< PixelType, 2 >;
+using ReaderType = itk::ImageFileReader< ImageType >;
+
+PixelType
+ExpectedValue( const ImageType::IndexType & index, unsigned int version )
+{
+  return static_cast< PixelType >( 100 * version + 20 * index[1] + index[0] );
+}
+
+int
+WriteImage( const std::string & fileName, unsigned int columns, unsigned int rows, unsigned int version )
+{
+  ImageType::Pointer image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = columns;
+  size[1] = rows;
+  image->SetRegions( size );
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.75 * version;
+  image->SetSpacing( spacing );
+  ImageType::PointType origin;
+  origin[0] = -10.0;
+  origin[1] = 2.5 * version;
+  image->SetOrigin( origin );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( ExpectedValue( it.GetIndex(), version ) );
+    }
+
+  using WriterType = itk::ImageFileWriter< ImageType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+  return EXIT_SUCCESS;
+}
+
+int
+CheckImage( const ImageType * image, unsigned int columns, unsigned int rows, unsigned int version )
+{
+  TEST_EXPECT_EQUAL( image->GetLargestPossibleRegion().GetSize()[0], columns );
+  TEST_EXPECT_EQUAL( image->GetLargestPossibleRegion().GetSize()[1], rows );
+  TEST_EXPECT_EQUAL( image->GetSpacing()[1], 0.75 * version );
+  TEST_EXPECT_EQUAL( image->GetOrigin()[1], 2.5 * version );
+  if ( image->GetBufferedRegion().GetNumberOfPixels() == 0 )
+    {
+    return EXIT_SUCCESS;
+    }
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != ExpectedValue( it.GetIndex(), version ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkImageFileReaderInformationCacheTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkImageFileReaderInformationCacheTest";
+
+  // The header of a DICOM file holds all of its information but the
+  // elements following the Pixel Data, which is the last element of
+  // the files written by ITK
+  const std::string dicomFileName = directory + ".dcm";
+  if ( WriteImage( dicomFileName, 24, 18, 1 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  itk::GDCMImageIO::Pointer headerIO = itk::GDCMImageIO::New();
+  headerIO->SetFileName( dicomFileName );
+  TEST_EXPECT_TRUE( headerIO->ReadImageInformationFromHeader() );
+  itk::GDCMImageIO::Pointer wholeIO = itk::GDCMImageIO::New();
+  wholeIO->SetFileName( dicomFileName );
+  TRY_EXPECT_NO_EXCEPTION( wholeIO->ReadImageInformation() );
+
+  TEST_EXPECT_EQUAL( headerIO->GetNumberOfDimensions(), wholeIO->GetNumberOfDimensions() );
+  for ( unsigned int i = 0; i < wholeIO->GetNumberOfDimensions(); ++i )
+    {
+    TEST_EXPECT_EQUAL( headerIO->GetDimensions( i ), wholeIO->GetDimensions( i ) );
+    TEST_EXPECT_EQUAL( headerIO->GetSpacing( i ), wholeIO->GetSpacing( i ) );
+    TEST_EXPECT_EQUAL( headerIO->GetOrigin( i ), wholeIO->GetOrigin( i ) );
+    TEST_EXPECT_TRUE( headerIO->GetDirection( i ) == wholeIO->GetDirection( i ) );
+    }
+  TEST_EXPECT_EQUAL( headerIO->GetComponentType(), wholeIO->GetComponentType() );
+  TEST_EXPECT_EQUAL( headerIO->GetInternalComponentType(), wholeIO->GetInternalComponentType() );
+  TEST_EXPECT_EQUAL( headerIO->GetNumberOfComponents(), wholeIO->GetNumberOfComponents() );
+  TEST_EXPECT_EQUAL( headerIO->GetRescaleSlope(), wholeIO->GetRescaleSlope() );
+  TEST_EXPECT_EQUAL( headerIO->GetRescaleIntercept(), wholeIO->GetRescaleIntercept() );
+  const itk::MetaDataDictionary & headerDictionary = headerIO->GetMetaDataDictionary();
+  const itk::MetaDataDictionary & wholeDictionary = wholeIO->GetMetaDataDictionary();
+  TEST_EXPECT_EQUAL( headerDictionary.GetKeys().size(), wholeDictionary.GetKeys().size() );
+  for ( const auto & key : wholeDictionary.GetKeys() )
+    {
+    std::string headerValue;
+    std::string wholeValue;
+    TEST_EXPECT_TRUE( itk::ExposeMetaData< std::string >( headerDictionary, key, headerValue ) );
+    itk::ExposeMetaData< std::string >( wholeDictionary, key, wholeValue );
+    TEST_EXPECT_EQUAL( headerValue, wholeValue );
+    }
+
+  // The reader reads the information from the header only
+  ReaderType::Pointer dicomReader = ReaderType::New();
+  dicomReader->SetFileName( dicomFileName );
+  TRY_EXPECT_NO_EXCEPTION( dicomReader->UpdateOutputInformation() );
+  TRY_EXPECT_NO_EXCEPTION( dicomReader->Update() );
+  TEST_EXPECT_EQUAL( dicomReader->GetOutput()->GetLargestPossibleRegion().GetSize()[0], 24 );
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( dicomReader->GetOutput(),
+                                                          dicomReader->GetOutput()->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    TEST_EXPECT_EQUAL( it.Get(), ExpectedValue( it.GetIndex(), 1 ) );
+    }
+
+  // An empty Data Set Trailing Padding element, in implicit VR little
+  // endian, follows the Pixel Data of a copy
+  const std::string paddedFileName = directory + "Padded.dcm";
+  {
+  std::ifstream input( dicomFileName.c_str(), std::ios::binary );
+  std::ofstream output( paddedFileName.c_str(), std::ios::binary );
+  output << input.rdbuf();
+  const char padding[8] = { '\xfc', '\xff', '\xfc', '\xff', 0, 0, 0, 0 };
+  output.write( padding, sizeof( padding ) );
+  }
+  itk::GDCMImageIO::Pointer paddedIO = itk::GDCMImageIO::New();
+  paddedIO->SetFileName( paddedFileName );
+  TEST_EXPECT_TRUE( !paddedIO->ReadImageInformationFromHeader() );
+  TEST_EXPECT_EQUAL( paddedIO->GetDimensions( 0 ), 24 );
+  ReaderType::Pointer paddedReader = ReaderType::New();
+  paddedReader->SetFileName( paddedFileName );
+  TRY_EXPECT_NO_EXCEPTION( paddedReader->Update() );
+  const ImageType * paddedImage = paddedReader->GetOutput();
+  TEST_EXPECT_TRUE( paddedImage->GetLargestPossibleRegion() == dicomReader->GetOutput()->GetLargestPossibleRegion() );
+  TEST_EXPECT_TRUE( paddedImage->GetSpacing() == dicomReader->GetOutput()->GetSpacing() );
+  TEST_EXPECT_TRUE( paddedImage->GetOrigin() == dicomReader->GetOutput()->GetOrigin() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    TEST_EXPECT_EQUAL( paddedImage->GetPixel( it.GetIndex() ), it.Get() );
+    }
+
+  // Through the image information cache
+  TEST_SET_GET_VALUE( false, itk::ImageIOBase::GetGlobalImageInformationCaching() );
+  itk::ImageIOBase::GlobalImageInformationCachingOn();
+  TEST_SET_GET_VALUE( true, itk::ImageIOBase::GetGlobalImageInformationCaching() );
+
+  const std::string fileName = directory + ".mha";
+  if ( WriteImage( fileName, 16, 12, 1 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  itk::ModifiedTimeType stamp = 0;
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNull() );
+
+  ReaderType::Pointer firstReader = ReaderType::New();
+  firstReader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( firstReader->UpdateOutputInformation() );
+  if ( CheckImage( firstReader->GetOutput(), 16, 12, 1 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNotNull() );
+
+  // Another reader gets a copy of the cached ImageIO
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->UpdateOutputInformation() );
+  itk::ImageIOBase::Pointer imageIO = reader->GetImageIO();
+  TEST_EXPECT_TRUE( imageIO != firstReader->GetImageIO() );
+  TEST_EXPECT_EQUAL( std::string( imageIO->GetNameOfClass() ),
+                     std::string( firstReader->GetImageIO()->GetNameOfClass() ) );
+  TEST_EXPECT_EQUAL( imageIO->GetFileName(), fileName );
+  if ( CheckImage( reader->GetOutput(), 16, 12, 1 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Executing the pipeline again keeps that ImageIO, which reads the
+  // whole information before the pixels
+  reader->Modified();
+  TRY_EXPECT_NO_EXCEPTION( reader->UpdateOutputInformation() );
+  TEST_EXPECT_TRUE( reader->GetImageIO() == imageIO );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  TEST_EXPECT_TRUE( reader->GetImageIO() == imageIO );
+  if ( CheckImage( reader->GetOutput(), 16, 12, 1 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Rewriting the file with another length invalidates its entry
+  if ( WriteImage( fileName, 20, 10, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  reader->Modified();
+  TRY_EXPECT_NO_EXCEPTION( reader->UpdateLargestPossibleRegion() );
+  TEST_EXPECT_TRUE( reader->GetImageIO() != imageIO );
+  if ( CheckImage( reader->GetOutput(), 20, 10, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A user specified ImageIO does not go through the cache
+  ReaderType::Pointer userReader = ReaderType::New();
+  itk::ImageIOBase::Pointer userIO = firstReader->GetImageIO()->Clone();
+  userReader->SetImageIO( userIO );
+  userReader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( userReader->Update() );
+  TEST_EXPECT_TRUE( userReader->GetImageIO() == userIO );
+  if ( CheckImage( userReader->GetOutput(), 20, 10, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The least recently read file leaves a full cache
+  TEST_SET_GET_VALUE( 256, itk::ImageIOBase::GetGlobalImageInformationCacheMaximumSize() );
+  itk::ImageIOBase::SetGlobalImageInformationCacheMaximumSize( 2 );
+  TEST_SET_GET_VALUE( 2, itk::ImageIOBase::GetGlobalImageInformationCacheMaximumSize() );
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 1 );
+  const std::string secondFileName = directory + "Second.mha";
+  const std::string thirdFileName = directory + "Third.mha";
+  if ( WriteImage( secondFileName, 8, 6, 3 ) != EXIT_SUCCESS
+       || WriteImage( thirdFileName, 10, 4, 4 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  ReaderType::Pointer secondReader = ReaderType::New();
+  secondReader->SetFileName( secondFileName );
+  TRY_EXPECT_NO_EXCEPTION( secondReader->UpdateOutputInformation() );
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 2 );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNotNull() );
+  ReaderType::Pointer thirdReader = ReaderType::New();
+  thirdReader->SetFileName( thirdFileName );
+  TRY_EXPECT_NO_EXCEPTION( thirdReader->UpdateOutputInformation() );
+  if ( CheckImage( thirdReader->GetOutput(), 10, 4, 4 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 2 );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( secondFileName, stamp ).IsNull() );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNotNull() );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( thirdFileName, stamp ).IsNotNull() );
+
+  // Reducing the maximum size keeps the most recently read files
+  itk::ImageIOBase::SetGlobalImageInformationCacheMaximumSize( 1 );
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 1 );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( thirdFileName, stamp ).IsNotNull() );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNull() );
+
+  itk::ImageIOBase::ClearGlobalImageInformationCache();
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 0 );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( thirdFileName, stamp ).IsNull() );
+  itk::ImageIOBase::SetGlobalImageInformationCacheMaximumSize( 256 );
+
+  TRY_EXPECT_NO_EXCEPTION( thirdReader->Update() );
+  if ( CheckImage( thirdReader->GetOutput(), 10, 4, 4 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageIOBase::GlobalImageInformationCachingOff();
+  TEST_EXPECT_EQUAL( itk::ImageIOBase::GetGlobalImageInformationCacheSize(), 0 );
+  TEST_EXPECT_TRUE( itk::ImageIOBase::GetCachedImageInformation( fileName, stamp ).IsNull() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
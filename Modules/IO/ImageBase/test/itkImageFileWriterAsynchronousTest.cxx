@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriteQueue.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+
+// Write a sequence of images asynchronously, modifying the input as
+// soon as Write() returns, then read them back and check that each
+// file holds the pixels of the input at the time of its Write().
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image< PixelType, 3 >;
+using WriterType = itk::ImageFileWriter< ImageType >;
+
+PixelType
+ExpectedValue( const ImageType::IndexType & index, unsigned int version )
+{
+  return static_cast< PixelType >( version * 1000 + index[2] * 100 + index[1] * 10 + index[0] );
+}
+
+void
+Fill( ImageType * image, unsigned int version )
+{
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( ExpectedValue( it.GetIndex(), version ) );
+    }
+}
+
+ImageType::Pointer
+CreateImage( unsigned int version )
+{
+  ImageType::SizeType size;
+  size[0] = 31;
+  size[1] = 17;
+  size[2] = 9;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  Fill( image, version );
+  return image;
+}
+
+int
+CheckFile( const std::string & fileName, unsigned int version )
+{
+  using ReaderType = itk::ImageFileReader< ImageType >;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->Update();
+
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( reader->GetOutput(),
+                                                          reader->GetOutput()->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != ExpectedValue( it.GetIndex(), version ) )
+      {
+      std::cerr << fileName << ": wrong value at " << it.GetIndex() << ": " << it.Get()
+                << " expected " << ExpectedValue( it.GetIndex(), version ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+std::string
+FileName( const std::string & directory, unsigned int version )
+{
+  std::ostringstream fileName;
+  fileName << directory << "/itkImageFileWriterAsynchronousTest_" << version << ".mha";
+  return fileName.str();
+}
+
+}
+
+int itkImageFileWriterAsynchronousTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = argv[1];
+  const unsigned int numberOfVersions = 6;
+
+  itk::ImageFileWriteQueue::Pointer queue = itk::ImageFileWriteQueue::GetInstance();
+  TEST_EXPECT_TRUE( queue == itk::ImageFileWriteQueue::New() );
+  const itk::SizeValueType defaultBudget = queue->GetMemoryBudget();
+  std::cout << queue;
+
+  WriterType::Pointer writer = WriterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( writer, ImageFileWriter, ProcessObject );
+  TEST_SET_GET_BOOLEAN( writer, Asynchronous, true );
+
+  // The input is overwritten as soon as Write() returns
+  ImageType::Pointer image = CreateImage( 0 );
+  writer->SetInput( image );
+  for ( unsigned int version = 0; version < numberOfVersions; ++version )
+    {
+    Fill( image, version );
+    writer->SetFileName( FileName( directory, version ) );
+    TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+    }
+  Fill( image, numberOfVersions );
+  TRY_EXPECT_NO_EXCEPTION( writer->Flush() );
+  for ( unsigned int version = 0; version < numberOfVersions; ++version )
+    {
+    if ( CheckFile( FileName( directory, version ), version ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // An input that releases its data hands its buffer over
+  ImageType::Pointer released = CreateImage( 7 );
+  released->ReleaseDataFlagOn();
+  writer->SetInput( released );
+  writer->SetFileName( FileName( directory, 7 ) );
+  TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+  TEST_EXPECT_EQUAL( released->GetBufferedRegion().GetNumberOfPixels(), 0 );
+  TRY_EXPECT_NO_EXCEPTION( writer->Flush() );
+  if ( CheckFile( FileName( directory, 7 ), 7 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // With a budget smaller than an image, the writes are done one at a
+  // time
+  queue->SetMemoryBudget( 1 );
+  TEST_SET_GET_VALUE( 1, queue->GetMemoryBudget() );
+  const itk::SizeValueType imageSize = image->GetBufferedRegion().GetNumberOfPixels() * sizeof( PixelType );
+  writer->SetInput( image );
+  for ( unsigned int version = 0; version < numberOfVersions; ++version )
+    {
+    Fill( image, version );
+    writer->SetFileName( FileName( directory, version ) );
+    TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+    TEST_EXPECT_TRUE( queue->GetOutstandingMemory() <= imageSize );
+    }
+  TRY_EXPECT_NO_EXCEPTION( writer->Flush() );
+  TEST_EXPECT_EQUAL( queue->GetOutstandingMemory(), 0 );
+  queue->SetMemoryBudget( defaultBudget );
+  for ( unsigned int version = 0; version < numberOfVersions; ++version )
+    {
+    if ( CheckFile( FileName( directory, version ), version ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A failed write is reported by Flush()
+  const std::string badFileName = directory + "/NonExistingDirectory/itkImageFileWriterAsynchronousTest.mha";
+  writer->SetFileName( badFileName );
+  TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+  TRY_EXPECT_EXCEPTION( writer->Flush() );
+  TRY_EXPECT_NO_EXCEPTION( writer->Flush() );
+
+  // or by the next Write()
+  TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+  queue->WaitForAll();
+  writer->SetFileName( FileName( directory, 0 ) );
+  TRY_EXPECT_EXCEPTION( writer->Write() );
+
+  // Going back to synchronous writes waits for the pending ones
+  Fill( image, 8 );
+  writer->SetFileName( FileName( directory, 8 ) );
+  TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+  Fill( image, 9 );
+  writer->AsynchronousOff();
+  TRY_EXPECT_NO_EXCEPTION( writer->Write() );
+  if ( CheckFile( FileName( directory, 8 ), 9 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaDataObject.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+
+// Write a series of 2D slices, each filled with a value derived from
+// its slice number and its pixel index, then read them back with
+// different numbers of work units and check that the slices land in
+// the right place and that the dictionaries are in slice order.
+
+namespace
+{
+
+using PixelType = unsigned short;
+using SliceType = itk::Image< PixelType, 2 >;
+using VolumeType = itk::Image< PixelType, 3 >;
+using ReaderType = itk::ImageSeriesReader< VolumeType >;
+
+PixelType
+ExpectedValue( const VolumeType::IndexType & index )
+{
+  return static_cast< PixelType >( index[2] * 1000 + index[1] * 10 + index[0] );
+}
+
+int
+CheckSeries( ReaderType * reader, unsigned int numberOfSlices, bool reverseOrder )
+{
+  const VolumeType * output = reader->GetOutput();
+
+  if ( output->GetLargestPossibleRegion().GetSize()[2] != numberOfSlices )
+    {
+    std::cerr << "Wrong number of slices: "
+              << output->GetLargestPossibleRegion().GetSize() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageRegionConstIteratorWithIndex< VolumeType > it( output, output->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    VolumeType::IndexType fileIndex = it.GetIndex();
+    if ( reverseOrder )
+      {
+      fileIndex[2] = numberOfSlices - 1 - fileIndex[2];
+      }
+    if ( it.Get() != ExpectedValue( fileIndex ) )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << ": " << it.Get()
+                << " expected " << ExpectedValue( fileIndex ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  const ReaderType::DictionaryArrayType * dictionaries = reader->GetMetaDataDictionaryArray();
+  if ( dictionaries->size() != numberOfSlices )
+    {
+    std::cerr << "Wrong number of dictionaries: " << dictionaries->size() << std::endl;
+    return EXIT_FAILURE;
+    }
+  for ( unsigned int i = 0; i < numberOfSlices; ++i )
+    {
+    const unsigned int fileNumber = reverseOrder ? numberOfSlices - 1 - i : i;
+    std::ostringstream expected;
+    expected << "slice" << fileNumber;
+    std::string label;
+    if ( !itk::ExposeMetaData< std::string >( *( *dictionaries )[i], "SliceLabel", label )
+         || label != expected.str() )
+      {
+      std::cerr << "Wrong dictionary for slice " << i << ": \"" << label
+                << "\" expected \"" << expected.str() << "\"" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkImageSeriesReaderParallelTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int numberOfSlices = 23;
+
+  ReaderType::FileNamesContainer fileNames;
+  for ( unsigned int z = 0; z < numberOfSlices; ++z )
+    {
+    SliceType::SizeType size;
+    size[0] = 17;
+    size[1] = 9;
+    SliceType::Pointer slice = SliceType::New();
+    slice->SetRegions( size );
+    slice->Allocate();
+
+    itk::ImageRegionIteratorWithIndex< SliceType > it( slice, slice->GetBufferedRegion() );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      VolumeType::IndexType index;
+      index[0] = it.GetIndex()[0];
+      index[1] = it.GetIndex()[1];
+      index[2] = z;
+      it.Set( ExpectedValue( index ) );
+      }
+
+    std::ostringstream label;
+    label << "slice" << z;
+    itk::EncapsulateMetaData< std::string >( slice->GetMetaDataDictionary(), "SliceLabel", label.str() );
+
+    std::ostringstream fileName;
+    fileName << argv[1] << "/itkImageSeriesReaderParallelTest_" << z << ".mha";
+    fileNames.push_back( fileName.str() );
+
+    using WriterType = itk::ImageFileWriter< SliceType >;
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetInput( slice );
+    writer->SetFileName( fileName.str() );
+    TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+    }
+
+  const itk::ThreadIdType workUnits[] = { 1, 4, 64 };
+  for ( auto numberOfWorkUnits : workUnits )
+    {
+    for ( int explicitImageIO = 0; explicitImageIO < 2; ++explicitImageIO )
+      {
+      for ( int reverseOrder = 0; reverseOrder < 2; ++reverseOrder )
+        {
+        std::cout << "Work units: " << numberOfWorkUnits
+                  << " ImageIO: " << explicitImageIO
+                  << " ReverseOrder: " << reverseOrder << std::endl;
+
+        ReaderType::Pointer reader = ReaderType::New();
+        reader->SetFileNames( fileNames );
+        reader->SetNumberOfWorkUnits( numberOfWorkUnits );
+        reader->SetReverseOrder( reverseOrder != 0 );
+        if ( explicitImageIO )
+          {
+          // Clone() does not carry over the settings of MetaImageIO, so
+          // the slices are read one at a time with it
+          itk::MetaImageIO::Pointer imageIO = itk::MetaImageIO::New();
+          TEST_EXPECT_TRUE( !imageIO->CanCloneSettings() );
+          reader->SetImageIO( imageIO );
+          }
+        TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+
+        if ( CheckSeries( reader, numberOfSlices, reverseOrder != 0 ) != EXIT_SUCCESS )
+          {
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  // A missing file must be reported as an exception after all the
+  // workers are done.
+  ReaderType::FileNamesContainer missingFileNames = fileNames;
+  missingFileNames[numberOfSlices / 2] = std::string( argv[1] ) + "/itkImageSeriesReaderParallelTest_missing.mha";
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileNames( missingFileNames );
+  TRY_EXPECT_EXCEPTION( reader->Update() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
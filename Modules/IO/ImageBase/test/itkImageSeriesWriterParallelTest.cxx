@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesWriter.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkIOCommon.h"
+#include "itkMetaDataObject.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+#include <sstream>
+
+// Write a volume as a series of 2D files with different numbers of
+// work units, both straight from the input buffer (same pixel type)
+// and through a copy of each slice (different pixel type), then read
+// the files back and check their pixels and origins.
+
+namespace
+{
+
+using VolumeType = itk::Image< unsigned short, 3 >;
+
+template< typename TSlice >
+int
+CheckSlices( const VolumeType * volume, const std::vector< std::string > & fileNames )
+{
+  using ReaderType = itk::ImageFileReader< TSlice >;
+
+  for ( unsigned int z = 0; z < fileNames.size(); ++z )
+    {
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName( fileNames[z] );
+    reader->Update();
+    const TSlice * slice = reader->GetOutput();
+
+    if ( slice->GetLargestPossibleRegion().GetSize()[0] != volume->GetLargestPossibleRegion().GetSize()[0]
+         || slice->GetLargestPossibleRegion().GetSize()[1] != volume->GetLargestPossibleRegion().GetSize()[1] )
+      {
+      std::cerr << fileNames[z] << ": wrong size " << slice->GetLargestPossibleRegion().GetSize() << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    itk::ImageRegionConstIteratorWithIndex< TSlice > it( slice, slice->GetBufferedRegion() );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      VolumeType::IndexType index;
+      index[0] = it.GetIndex()[0];
+      index[1] = it.GetIndex()[1];
+      index[2] = z;
+      if ( it.Get() != static_cast< typename TSlice::PixelType >( volume->GetPixel( index ) ) )
+        {
+        std::cerr << fileNames[z] << ": wrong value at " << it.GetIndex() << ": " << it.Get()
+                  << " expected " << volume->GetPixel( index ) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+template< typename TSlice >
+int
+WriteAndCheck( const VolumeType * volume, const std::string & directory, const char * name )
+{
+  using WriterType = itk::ImageSeriesWriter< VolumeType, TSlice >;
+
+  std::vector< std::string > fileNames;
+  for ( unsigned int z = 0; z < volume->GetLargestPossibleRegion().GetSize()[2]; ++z )
+    {
+    std::ostringstream fileName;
+    fileName << directory << "/itkImageSeriesWriterParallelTest_" << name << "_" << z << ".mha";
+    fileNames.push_back( fileName.str() );
+    }
+
+  const itk::ThreadIdType workUnits[] = { 1, 4, 64 };
+  for ( auto numberOfWorkUnits : workUnits )
+    {
+    for ( int explicitImageIO = 0; explicitImageIO < 2; ++explicitImageIO )
+      {
+      std::cout << name << " Work units: " << numberOfWorkUnits
+                << " ImageIO: " << explicitImageIO << std::endl;
+
+      typename WriterType::Pointer writer = WriterType::New();
+      writer->SetInput( volume );
+      writer->SetFileNames( fileNames );
+      writer->SetNumberOfWorkUnits( numberOfWorkUnits );
+      itk::MetaImageIO::Pointer imageIO = itk::MetaImageIO::New();
+      if ( explicitImageIO )
+        {
+        writer->SetImageIO( imageIO );
+        }
+      TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+      if ( CheckSlices< TSlice >( volume, fileNames ) != EXIT_SUCCESS )
+        {
+        return EXIT_FAILURE;
+        }
+
+      // The ImageIO is left with the dictionary of the last slice
+      if ( explicitImageIO )
+        {
+        itk::Array< double > origin;
+        TEST_EXPECT_TRUE( itk::ExposeMetaData< itk::Array< double > >( imageIO->GetMetaDataDictionary(),
+                                                                      itk::ITK_Origin, origin ) );
+        TEST_EXPECT_EQUAL( origin[2], volume->GetOrigin()[2]
+                           + volume->GetSpacing()[2] * ( fileNames.size() - 1 ) );
+        }
+      }
+    }
+
+  // A missing directory must be reported as an exception after all
+  // the workers are done.
+  std::vector< std::string > badFileNames = fileNames;
+  badFileNames[fileNames.size() / 2] = directory + "/NonExistingDirectory/itkImageSeriesWriterParallelTest.mha";
+  typename WriterType::Pointer writer = WriterType::New();
+  TEST_EXPECT_EQUAL( writer->GetNumberOfWorkUnits(), 1 );
+  writer->SetInput( volume );
+  writer->SetFileNames( badFileNames );
+  writer->SetNumberOfWorkUnits( 4 );
+  TRY_EXPECT_EXCEPTION( writer->Update() );
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkImageSeriesWriterParallelTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  VolumeType::SizeType size;
+  size[0] = 17;
+  size[1] = 9;
+  size[2] = 23;
+  VolumeType::PointType origin;
+  origin[0] = 1.5;
+  origin[1] = -2.0;
+  origin[2] = 10.0;
+  VolumeType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 2.5;
+
+  VolumeType::Pointer volume = VolumeType::New();
+  volume->SetRegions( size );
+  volume->SetOrigin( origin );
+  volume->SetSpacing( spacing );
+  volume->Allocate();
+  itk::ImageRegionIteratorWithIndex< VolumeType > it( volume, volume->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const VolumeType::IndexType index = it.GetIndex();
+    it.Set( static_cast< unsigned short >( index[2] * 1000 + index[1] * 10 + index[0] ) );
+    }
+
+  using ShortSliceType = itk::Image< unsigned short, 2 >;
+  using FloatSliceType = itk::Image< float, 2 >;
+  if ( WriteAndCheck< ShortSliceType >( volume, argv[1], "short" ) != EXIT_SUCCESS
+       || WriteAndCheck< FloatSliceType >( volume, argv[1], "float" ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
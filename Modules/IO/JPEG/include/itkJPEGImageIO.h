@@ -48,6 +48,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(JPEGImageIO, ImageIOBase);
 
+  /** Clone() copies the quality and progressive settings. */
+  bool CanCloneSettings() const override;
+
   /** Set/Get the level of quality for the output images. */
   itkSetMacro(Quality, int);
   itkGetConstMacro(Quality, int);
@@ -90,6 +93,9 @@ protected:
   ~JPEGImageIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also carry over the quality and progressive setting. */
+  LightObject::Pointer InternalClone() const override;
+
   void WriteSlice(std::string & fileName, const void *buffer);
 
   /** Determines the quality of compression for written files.
@@ -21,6 +21,7 @@
 
 #include "itk_jpeg.h"
 #include <csetjmp>
+#include <typeinfo>
 
 // create an error handler for jpeg that
 // can longjmp out of the jpeg library
@@ -278,6 +279,30 @@ void JPEGImageIO::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Progressive : " << m_Progressive << "\n";
 }
 
+LightObject::Pointer
+JPEGImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_Quality = m_Quality;
+  rval->m_Progressive = m_Progressive;
+
+  return loPtr;
+}
+
+bool
+JPEGImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
 void JPEGImageIO::ReadImageInformation()
 {
   m_Spacing[0] = 1.0;  // We'll look for JPEG pixel size information later,
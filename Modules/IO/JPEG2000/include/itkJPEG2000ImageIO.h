@@ -37,6 +37,12 @@ class JPEG2000ImageIOInternal;
  *  JPEG2000 offers a large collection of interesting features including:
  *  compression (lossless and lossy), streaming, multi-channel images.
  *
+ *  When streaming, only the tiles intersecting the requested region are
+ *  decoded, so images written with SetTileSize() can be read piecewise.
+ *  The wavelet resolution levels of the codestream can be used as a
+ *  pyramid: SetResolutionFactor(n) reads the image at 1/2^n of its size
+ *  by discarding the n highest resolution levels, which are then not
+ *  decoded at all.
  *
  * This code was contributed in the Insight Journal paper:
  * "Support for Streaming the JPEG2000 File Format"
@@ -64,6 +70,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(JPEG2000ImageIO, StreamingImageIOBase);
 
+  /** Clone() copies the tile size and resolution factor. */
+  bool CanCloneSettings() const override;
+
   /*-------- This part of the interfaces deals with reading data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -102,6 +111,20 @@ public:
   /** Define the tile size to use when writing out an image. */
   void SetTileSize(int x, int y);
 
+  /** Set/Get the number of highest resolution levels to discard when
+   * reading. The image is read with dimensions divided by
+   * 2^ResolutionFactor (rounded up) and a spacing multiplied by the
+   * same amount. It must be less than GetNumberOfResolutionLevels().
+   * Defaults to 0, which reads the full resolution image.
+   * Must be set before ReadImageInformation(). */
+  itkSetMacro(ResolutionFactor, unsigned int);
+  itkGetConstMacro(ResolutionFactor, unsigned int);
+
+  /** Get the number of resolution levels of the codestream, i.e. the
+   * number of wavelet decomposition levels plus one. Available after
+   * ReadImageInformation(), 0 when it could not be determined. */
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
   /** Currently JPEG2000 does not support streamed writing
    *
    * These methods are re-overridden to not support streaming for
@@ -115,9 +138,15 @@ protected:
 
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also carry over the tile size and the resolution factor. */
+  LightObject::Pointer InternalClone() const override;
+
 private:
   std::unique_ptr< JPEG2000ImageIOInternal >  m_Internal;
 
+  unsigned int m_ResolutionFactor{0};
+  unsigned int m_NumberOfResolutionLevels{0};
+
   using SizeValueType = ImageIORegion::SizeValueType;
   using IndexValueType = ImageIORegion::IndexValueType;
 
@@ -19,6 +19,11 @@
 #include "itkJPEG2000ImageIO.h"
 #include "itksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <fstream>
+#include <vector>
+#include <typeinfo>
+
 // for memset
 // for malloc
 
@@ -64,9 +69,67 @@ public:
   OPJ_UINT32 m_NumberOfTilesInX;
   OPJ_UINT32 m_NumberOfTilesInY;
 
+  OPJ_UINT32 m_FullResolutionSizeX;
+  OPJ_UINT32 m_FullResolutionSizeY;
+
   opj_dparameters_t m_DecompressionParameters;  /* decompression parameters */
 };
 
+namespace
+{
+// Coordinate of a full resolution sample at a resolution reduced by
+// 2^factor, as defined by the standard: ceil( x / 2^factor )
+inline OPJ_INT32 ReducedCoordinate(OPJ_INT32 x, unsigned int factor)
+{
+  return ( x + ( 1 << factor ) - 1 ) >> factor;
+}
+
+// Read the number of decomposition levels from the COD marker segment
+// of the main header. Returns the number of resolution levels, or 0
+// when the codestream could not be found.
+unsigned int ReadNumberOfResolutionLevels(const std::string & fileName)
+{
+  std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+  if ( !file )
+    {
+    return 0;
+    }
+
+  // A JP2 file wraps the codestream in boxes: look for the SOC and
+  // SIZ markers in the first part of the file.
+  std::vector< unsigned char > header(1 << 20);
+  file.read( reinterpret_cast< char * >( header.data() ), header.size() );
+  header.resize( static_cast< size_t >( file.gcount() ) );
+
+  const unsigned char signature[] = { 0xff, 0x4f, 0xff, 0x51 };
+  auto pos = std::search( header.begin(), header.end(), signature, signature + 4 );
+  if ( pos == header.end() )
+    {
+    return 0;
+    }
+  size_t offset = ( pos - header.begin() ) + 2;
+
+  while ( offset + 4 <= header.size() )
+    {
+    const unsigned int marker = ( header[offset] << 8 ) | header[offset + 1];
+    const size_t       length = ( header[offset + 2] << 8 ) | header[offset + 3];
+    if ( marker == 0xff52 ) // COD
+      {
+      // Lcod, Scod, progression order, number of layers, MCT, then the
+      // number of decomposition levels
+      const size_t levels = offset + 9;
+      return levels < header.size() ? header[levels] + 1u : 0u;
+      }
+    if ( marker == 0xff90 || ( marker & 0xff00 ) != 0xff00 ) // SOT or garbage
+      {
+      return 0;
+      }
+    offset += 2 + length;
+    }
+  return 0;
+}
+}
+
 
 JPEG2000ImageIO::JPEG2000ImageIO()
   : m_Internal( new JPEG2000ImageIOInternal )
@@ -88,6 +151,9 @@ JPEG2000ImageIO::JPEG2000ImageIO()
   this->m_Internal->m_NumberOfTilesInX = 0;
   this->m_Internal->m_NumberOfTilesInY = 0;
 
+  this->m_Internal->m_FullResolutionSizeX = 0;
+  this->m_Internal->m_FullResolutionSizeY = 0;
+
   const char *extensions[] =
     {
       ".j2k", ".jp2", ".jpt"
@@ -108,6 +174,33 @@ JPEG2000ImageIO::~JPEG2000ImageIO()
 void JPEG2000ImageIO::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "ResolutionFactor: " << m_ResolutionFactor << std::endl;
+  os << indent << "NumberOfResolutionLevels: " << m_NumberOfResolutionLevels << std::endl;
+}
+
+LightObject::Pointer
+JPEG2000ImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_Internal->m_TileWidth = this->m_Internal->m_TileWidth;
+  rval->m_Internal->m_TileHeight = this->m_Internal->m_TileHeight;
+  rval->m_ResolutionFactor = m_ResolutionFactor;
+
+  return loPtr;
+}
+
+bool
+JPEG2000ImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
 }
 
 bool JPEG2000ImageIO::CanReadFile(const char *filename)
@@ -157,6 +250,21 @@ void JPEG2000ImageIO::ReadImageInformation()
   /* set decoding parameters to default values */
   opj_set_default_decoder_parameters(& (this->m_Internal->m_DecompressionParameters) );
 
+  this->m_NumberOfResolutionLevels = ReadNumberOfResolutionLevels(this->m_FileName);
+  if ( this->m_NumberOfResolutionLevels > 0
+       && this->m_ResolutionFactor >= this->m_NumberOfResolutionLevels )
+    {
+    fclose(l_file);
+    itkExceptionMacro(
+      "JPEG2000ImageIO failed to read file: "
+      << this->GetFileName()
+      << std::endl
+      << "Reason: ResolutionFactor " << this->m_ResolutionFactor
+      << " must be less than the number of resolution levels "
+      << this->m_NumberOfResolutionLevels );
+    }
+  this->m_Internal->m_DecompressionParameters.cp_reduce = this->m_ResolutionFactor;
+
   opj_stream_t *cio = opj_stream_create_default_file_stream(l_file, true);
 
   this->m_Internal->m_Dinfo = nullptr;  /* handle to a decompressor */
@@ -364,11 +472,23 @@ void JPEG2000ImageIO::ReadImageInformation()
   itkDebugMacro(<< "image->x1 = " <<  l_image->x1);
   itkDebugMacro(<< "image->y1 = " <<  l_image->y1);
 
-  this->SetDimensions(0,  l_image->x1);
-  this->SetDimensions(1,  l_image->y1);
+  this->m_Internal->m_FullResolutionSizeX = l_image->x1;
+  this->m_Internal->m_FullResolutionSizeY = l_image->y1;
+
+  // Each reduced resolution pixel covers 2^ResolutionFactor full
+  // resolution pixels along each axis
+  const double reduction = static_cast< double >( 1 << this->m_ResolutionFactor );
 
-  this->SetSpacing(0, 1.0);    // FIXME : Get the real pixel resolution.
-  this->SetSpacing(1, 1.0);    // FIXME : Get the real pixel resolution.
+  this->SetDimensions(0,  ReducedCoordinate(l_image->x1, this->m_ResolutionFactor));
+  this->SetDimensions(1,  ReducedCoordinate(l_image->y1, this->m_ResolutionFactor));
+
+  // The full resolution pixels have a unit spacing, so the spacing is
+  // the reduction factor relative to them.
+  this->SetSpacing(0, reduction);
+  this->SetSpacing(1, reduction);
+
+  this->SetOrigin(0, 0.5 * ( reduction - 1.0 ));
+  this->SetOrigin(1, 0.5 * ( reduction - 1.0 ));
 
   /* close the byte stream */
   opj_stream_destroy(cio);
@@ -518,36 +638,39 @@ void JPEG2000ImageIO::Read(void *buffer)
       << "Reason: opj_read_header returns false");
     }
 
- ImageIORegion regionToRead = this->GetIORegion();
+  ImageIORegion regionToRead = this->GetIORegion();
 
   ImageIORegion::SizeType  size  = regionToRead.GetSize();
   ImageIORegion::IndexType start = regionToRead.GetIndex();
 
-  const unsigned int sizex = size[0];
-  const unsigned int sizey = size[1];
-  // const unsigned int sizez = size[2];
+  // The region is given at the reduced resolution, the decode area and
+  // the tile coordinates are at full resolution
+  const unsigned int factor = this->m_ResolutionFactor;
 
-  const unsigned int startx = start[0];
-  const unsigned int starty = start[1];
-  // const unsigned int startz = start[2];
+  const auto p_start_x = static_cast< OPJ_INT32 >( start[0] );
+  const auto p_start_y = static_cast< OPJ_INT32 >( start[1] );
+  const auto p_end_x   = static_cast< OPJ_INT32 >( start[0] + size[0] );
+  const auto p_end_y   = static_cast< OPJ_INT32 >( start[1] + size[1] );
 
-  auto p_start_x = static_cast< OPJ_INT32 >( startx );
-  auto p_start_y = static_cast< OPJ_INT32 >( starty );
-  auto p_end_x   = static_cast< OPJ_INT32 >( startx + sizex );
-  auto p_end_y   = static_cast< OPJ_INT32 >( starty + sizey );
+  const auto area_start_x = static_cast< OPJ_INT32 >( p_start_x << factor );
+  const auto area_start_y = static_cast< OPJ_INT32 >( p_start_y << factor );
+  const auto area_end_x = std::min( static_cast< OPJ_INT32 >( ( ( p_end_x - 1 ) << factor ) + 1 ),
+                                    static_cast< OPJ_INT32 >( this->m_Internal->m_FullResolutionSizeX ) );
+  const auto area_end_y = std::min( static_cast< OPJ_INT32 >( ( ( p_end_y - 1 ) << factor ) + 1 ),
+                                    static_cast< OPJ_INT32 >( this->m_Internal->m_FullResolutionSizeY ) );
 
   itkDebugMacro(<< "opj_set_decode_area() before");
-  itkDebugMacro(<< "p_start_x = " << p_start_x);
-  itkDebugMacro(<< "p_start_y = " << p_start_y);
-  itkDebugMacro(<< "p_end_x = " << p_end_x);
-  itkDebugMacro(<< "p_end_y = " << p_end_y);
+  itkDebugMacro(<< "area_start_x = " << area_start_x);
+  itkDebugMacro(<< "area_start_y = " << area_start_y);
+  itkDebugMacro(<< "area_end_x = " << area_end_x);
+  itkDebugMacro(<< "area_end_y = " << area_end_y);
 
   bResult = opj_set_decode_area(
     this->m_Internal->m_Dinfo,
-    p_start_x,
-    p_start_y,
-    p_end_x,
-    p_end_y
+    area_start_x,
+    area_start_y,
+    area_end_x,
+    area_end_y
     );
 
   itkDebugMacro(<< "opj_set_decode_area() after");
@@ -663,51 +786,51 @@ void JPEG2000ImageIO::Read(void *buffer)
           << "Reason: opj_decode_tile_data returns false");
         }
 
-      OPJ_BYTE *l_data_ptr = l_data;
+      // The decoded tile holds one plane per component, at the reduced
+      // resolution
+      const OPJ_INT32 tx0 = ReducedCoordinate(l_current_tile_x0, factor);
+      const OPJ_INT32 ty0 = ReducedCoordinate(l_current_tile_y0, factor);
+      const OPJ_INT32 tx1 = ReducedCoordinate(l_current_tile_x1, factor);
+      const OPJ_INT32 ty1 = ReducedCoordinate(l_current_tile_y1, factor);
 
-      const SizeValueType tsizex = l_current_tile_x1 - l_current_tile_x0;
-      const SizeValueType tsizey = l_current_tile_y1 - l_current_tile_y0;
+      const SizeValueType tsizex = tx1 - tx0;
+      const SizeValueType tsizey = ty1 - ty0;
+      if ( tsizex == 0 || tsizey == 0 )
+        {
+        continue;
+        }
       const SizeValueType numberOfPixels = tsizex * tsizey;
       const SizeValueType numberOfComponents = this->GetNumberOfComponents();
       const SizeValueType sizePerComponentInBytes = l_data_size / ( numberOfPixels * numberOfComponents );
-      const SizeValueType sizePerChannelInBytes = l_data_size / ( numberOfComponents );
 
       itkDebugMacro(<< "sizePerComponentInBytes: " << sizePerComponentInBytes);
-      itkDebugMacro(<< "sizePerChannelInBytes:   " << sizePerChannelInBytes);
-
-      const SizeValueType sizePerStrideXInBytes = sizePerChannelInBytes / tsizey;
-      const SizeValueType initialStrideInBytes =
-        ( l_current_tile_y0 - p_start_y ) * sizex * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType priorStrideInBytes =
-        ( l_current_tile_x0 - p_start_x ) * sizePerComponentInBytes * numberOfComponents;
-      const SizeValueType postStrideInBytes =
-        ( p_end_x - l_current_tile_x1 ) * sizePerComponentInBytes * numberOfComponents;
-
-      itkDebugMacro(<< "sizePerStrideYInBytes:   " << sizePerChannelInBytes / tsizex );
-      itkDebugMacro(<< "sizePerStrideXInBytes:   " << sizePerStrideXInBytes);
-      itkDebugMacro(<< "initialStrideInBytes:    " << initialStrideInBytes);
-      itkDebugMacro(<< "priorStrideInBytes:      " << priorStrideInBytes);
-      itkDebugMacro(<< "postStrideInBytes:       " << postStrideInBytes);
 
+      // Only copy the part of the tile inside the requested region
+      const OPJ_INT32 x0 = std::max(tx0, p_start_x);
+      const OPJ_INT32 y0 = std::max(ty0, p_start_y);
+      const OPJ_INT32 x1 = std::min(tx1, p_end_x);
+      const OPJ_INT32 y1 = std::min(ty1, p_end_y);
+      if ( x0 >= x1 || y0 >= y1 )
+        {
+        continue;
+        }
 
-      //TODO: Read the void buffer within the tile ROI. How do we specify the
-      // tile ROI iteration
+      const SizeValueType pixelSizeInBytes = sizePerComponentInBytes * numberOfComponents;
       for ( unsigned int k = 0; k < numberOfComponents; k++ )
         {
-        auto * charBuffer = (unsigned char *)buffer;
-        charBuffer += k * sizePerComponentInBytes;
-
-        charBuffer += initialStrideInBytes;
-
-        for ( SizeValueType m = 0; m < tsizey; m++ )
+        const OPJ_BYTE * plane = l_data + k * numberOfPixels * sizePerComponentInBytes;
+        for ( OPJ_INT32 y = y0; y < y1; y++ )
           {
-          charBuffer += priorStrideInBytes;
-          for ( SizeValueType j = 0; j < sizePerStrideXInBytes; j++ )
+          const OPJ_BYTE * in = plane + ( ( y - ty0 ) * tsizex + ( x0 - tx0 ) ) * sizePerComponentInBytes;
+          auto * out = static_cast< unsigned char * >( buffer )
+                       + ( ( y - p_start_y ) * size[0] + ( x0 - p_start_x ) ) * pixelSizeInBytes
+                       + k * sizePerComponentInBytes;
+          for ( OPJ_INT32 x = x0; x < x1; x++ )
             {
-            *charBuffer = (unsigned char)( *l_data_ptr++ );
-            charBuffer += numberOfComponents;
+            std::copy( in, in + sizePerComponentInBytes, out );
+            in += sizePerComponentInBytes;
+            out += pixelSizeInBytes;
             }
-          charBuffer += postStrideInBytes;
           }
         }
       }
@@ -1206,30 +1329,35 @@ JPEG2000ImageIO
 ::ComputeRegionInTileBoundaries(unsigned int dimension,
                                 SizeValueType tileSize, ImageIORegion & streamableRegion) const
 {
-  SizeValueType  requestedSize = streamableRegion.GetSize(dimension);
-  IndexValueType requestedIndex = streamableRegion.GetIndex(dimension);
-
-  IndexValueType startQuantizedInTileSize = requestedIndex - ( requestedIndex % tileSize );
-  IndexValueType requestedEnd = requestedIndex + requestedSize;
-  SizeValueType  extendedSize = requestedEnd - startQuantizedInTileSize;
-  SizeValueType  tileRemanent = extendedSize % tileSize;
+  const unsigned int factor = this->m_ResolutionFactor;
 
-  SizeValueType sizeQuantizedInTileSize = extendedSize;
+  const IndexValueType tileStart = dimension == 0 ? this->m_Internal->m_TileStartX : this->m_Internal->m_TileStartY;
+  const IndexValueType fullSize = dimension == 0 ? this->m_Internal->m_FullResolutionSizeX
+                                                 : this->m_Internal->m_FullResolutionSizeY;
+  const auto tile = static_cast< IndexValueType >( tileSize );
 
-  if ( tileRemanent )
+  if ( tile <= 0 || fullSize <= 0 )
     {
-    sizeQuantizedInTileSize += tileSize - tileRemanent;
+    return;
     }
 
-  IndexValueType endQuantizedInTileSize = startQuantizedInTileSize + sizeQuantizedInTileSize - 1;
+  // Full resolution extent of the requested region
+  const IndexValueType requestedIndex = streamableRegion.GetIndex(dimension);
+  const IndexValueType requestedEnd = requestedIndex + streamableRegion.GetSize(dimension);
+  const IndexValueType fullStart = requestedIndex << factor;
+  const IndexValueType fullEnd = std::min( ( ( requestedEnd - 1 ) << factor ) + 1, fullSize );
 
-  if ( endQuantizedInTileSize > static_cast<int>(this->GetDimensions(dimension)) )
-    {
-    sizeQuantizedInTileSize = this->GetDimensions(dimension) - startQuantizedInTileSize;
-    }
+  // Extent of the tiles intersecting it
+  const IndexValueType firstTile = ( fullStart - tileStart ) / tile;
+  const IndexValueType lastTile = ( fullEnd - 1 - tileStart ) / tile;
+  const IndexValueType tilesStart = std::max( tileStart + firstTile * tile, IndexValueType(0) );
+  const IndexValueType tilesEnd = std::min( tileStart + ( lastTile + 1 ) * tile, fullSize );
+
+  const IndexValueType streamableIndex = ReducedCoordinate(static_cast< OPJ_INT32 >( tilesStart ), factor);
+  const IndexValueType streamableEnd = ReducedCoordinate(static_cast< OPJ_INT32 >( tilesEnd ), factor);
 
-  streamableRegion.SetSize(dimension, sizeQuantizedInTileSize);
-  streamableRegion.SetIndex(dimension, startQuantizedInTileSize);
+  streamableRegion.SetIndex(dimension, streamableIndex);
+  streamableRegion.SetSize(dimension, streamableEnd - streamableIndex);
 }
 
 bool
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkJPEG2000ImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// Write a tiled, lossless codestream and read it back at full and
+// reduced resolutions, whole and by region of interest.
+
+namespace
+{
+
+using PixelType = unsigned short;
+using ImageType = itk::Image< PixelType, 2 >;
+using ReaderType = itk::ImageFileReader< ImageType >;
+
+PixelType
+ExpectedValue( itk::IndexValueType x, itk::IndexValueType y )
+{
+  return static_cast< PixelType >( 3 * x + 5 * y + 100 );
+}
+
+ReaderType::Pointer
+CreateReader( const std::string & fileName, unsigned int resolutionFactor )
+{
+  itk::JPEG2000ImageIO::Pointer imageIO = itk::JPEG2000ImageIO::New();
+  imageIO->SetResolutionFactor( resolutionFactor );
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetImageIO( imageIO );
+  return reader;
+}
+
+// Values of a reduced resolution read are the low-pass wavelet
+// coefficients, which match the full resolution samples for a linear
+// ramp away from the tile borders.
+int
+CheckImage( const ImageType * image, const ImageType::RegionType & region,
+            unsigned int resolutionFactor, int tolerance )
+{
+  if ( !image->GetBufferedRegion().IsInside( region ) )
+    {
+    std::cerr << "Buffered region " << image->GetBufferedRegion()
+              << " does not contain " << region << std::endl;
+    return EXIT_FAILURE;
+    }
+  int maximumDifference = 0;
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    const int expected = ExpectedValue( index[0] << resolutionFactor, index[1] << resolutionFactor );
+    maximumDifference = std::max( maximumDifference, std::abs( static_cast< int >( it.Get() ) - expected ) );
+    }
+  std::cout << "  Maximum difference: " << maximumDifference << std::endl;
+  if ( maximumDifference > tolerance )
+    {
+    std::cerr << "Maximum difference " << maximumDifference << " above " << tolerance << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkJPEG2000ImageIOResolutionTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string fileName = std::string( argv[1] ) + "/itkJPEG2000ImageIOResolutionTest.j2k";
+
+  itk::JPEG2000ImageIO::Pointer imageIO = itk::JPEG2000ImageIO::New();
+  EXERCISE_BASIC_OBJECT_METHODS( imageIO, JPEG2000ImageIO, StreamingImageIOBase );
+  TEST_SET_GET_VALUE( 0u, imageIO->GetResolutionFactor() );
+
+  ImageType::SizeType size;
+  size[0] = 150;
+  size[1] = 110;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( ExpectedValue( it.GetIndex()[0], it.GetIndex()[1] ) );
+    }
+
+  imageIO->SetTileSize( 64, 64 );
+  using WriterType = itk::ImageFileWriter< ImageType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetImageIO( imageIO );
+  writer->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  // Full resolution, lossless
+  ReaderType::Pointer reader = CreateReader( fileName, 0 );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  auto * readerIO = dynamic_cast< itk::JPEG2000ImageIO * >( reader->GetImageIO() );
+  const unsigned int numberOfResolutionLevels = readerIO->GetNumberOfResolutionLevels();
+  std::cout << "Number of resolution levels: " << numberOfResolutionLevels << std::endl;
+  TEST_EXPECT_TRUE( numberOfResolutionLevels > 2 );
+  if ( CheckImage( reader->GetOutput(), image->GetLargestPossibleRegion(), 0, 0 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  ImageType::RegionType regionOfInterest;
+  regionOfInterest.SetIndex( 0, 40 );
+  regionOfInterest.SetIndex( 1, 30 );
+  regionOfInterest.SetSize( 0, 50 );
+  regionOfInterest.SetSize( 1, 25 );
+
+  for ( unsigned int factor = 0; factor < 3; ++factor )
+    {
+    std::cout << "Resolution factor " << factor << std::endl;
+    const int tolerance = factor == 0 ? 0 : 8 << factor;
+
+    reader = CreateReader( fileName, factor );
+    TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+    ImageType::Pointer whole = reader->GetOutput();
+    whole->DisconnectPipeline();
+
+    const ImageType::SizeType reducedSize = whole->GetLargestPossibleRegion().GetSize();
+    TEST_EXPECT_EQUAL( reducedSize[0], ( size[0] + ( 1u << factor ) - 1 ) >> factor );
+    TEST_EXPECT_EQUAL( reducedSize[1], ( size[1] + ( 1u << factor ) - 1 ) >> factor );
+    TEST_EXPECT_EQUAL( whole->GetSpacing()[0], static_cast< double >( 1 << factor ) );
+    if ( CheckImage( whole, whole->GetLargestPossibleRegion(), factor, tolerance ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+
+    // Only the tiles covering the region of interest are decoded, and
+    // they decode to the same values as in the whole image
+    ImageType::RegionType reducedRegion = regionOfInterest;
+    for ( unsigned int d = 0; d < 2; ++d )
+      {
+      reducedRegion.SetIndex( d, regionOfInterest.GetIndex( d ) >> factor );
+      reducedRegion.SetSize( d, regionOfInterest.GetSize( d ) >> factor );
+      }
+
+    reader = CreateReader( fileName, factor );
+    reader->GetOutput()->SetRequestedRegion( reducedRegion );
+    TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+    const ImageType::RegionType buffered = reader->GetOutput()->GetBufferedRegion();
+    std::cout << "  Buffered region " << buffered.GetIndex() << " " << buffered.GetSize() << std::endl;
+    TEST_EXPECT_TRUE( buffered.IsInside( reducedRegion ) );
+    TEST_EXPECT_TRUE( buffered.GetNumberOfPixels() < whole->GetLargestPossibleRegion().GetNumberOfPixels() );
+
+    itk::ImageRegionConstIteratorWithIndex< ImageType > roi( reader->GetOutput(), buffered );
+    for ( roi.GoToBegin(); !roi.IsAtEnd(); ++roi )
+      {
+      if ( roi.Get() != whole->GetPixel( roi.GetIndex() ) )
+        {
+        std::cerr << "Region of interest differs at " << roi.GetIndex() << ": " << roi.Get()
+                  << " instead of " << whole->GetPixel( roi.GetIndex() ) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Discarding all the resolution levels is an error
+  reader = CreateReader( fileName, numberOfResolutionLevels );
+  TRY_EXPECT_EXCEPTION( reader->Update() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -55,6 +55,14 @@ struct ITKIOMINC_HIDDEN MINCImageIOPImpl;
  * reads the regularly sampled dimensions as I am not sure how to deal
  * with "iregularly sampled" dimensions yet!
  *
+ * Reading and writing can be streamed: each IORegion is transferred as
+ * a MINC hyperslab, with the vector or time dimension read or written
+ * whole. A streamed write creates the file with its first piece and
+ * closes it with the piece that completes the image. Floating point
+ * images stored as integers (see the "storage_data_type" meta data)
+ * need the range of the whole image before the first voxel is
+ * written, so they are written in one piece.
+ *
  * This code was contributed in the Insight Journal paper:
  * "MINC2.0 IO Support for ITK"
  * by Baghdadi L.
@@ -103,6 +111,17 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void *buffer) override;
 
+  /** Any region can be read as a hyperslab. */
+  bool CanStreamRead() override
+  {
+    return true;
+  }
+
+  /** Return the requested region when streaming is enabled, and the
+   * whole image otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -117,6 +136,14 @@ public:
    * that the IORegion has been set properly. */
   void Write(const void *buffer) override;
 
+  /** True unless floating point pixels are stored as integers. */
+  bool CanStreamWrite() override;
+
+  /** Pasting into an existing file is not supported. */
+  unsigned int GetActualNumberOfSplitsForWriting(unsigned int numberOfRequestedSplits,
+                                                 const ImageIORegion & pasteRegion,
+                                                 const ImageIORegion & largestPossibleRegion) override;
+
 protected:
   MINCImageIO();
   ~MINCImageIO() override;
@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkMINCImageIO.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cctype>
 #include "vnl/vnl_vector.h"
@@ -49,8 +50,35 @@ struct ITKIOMINC_HIDDEN MINCImageIOPImpl
 
   // MINC2 volume handle , currently opened
   mihandle_t     m_Volume;
+
+  // progress of a write streamed over several calls to Write(),
+  // and the range of the values written so far
+  SizeValueType  m_NumberOfPixelsWritten;
+  double         m_WrittenMin;
+  double         m_WrittenMax;
 };
 
+namespace
+{
+// Floating point pixels stored with fixed point arithmetics are
+// rescaled with the range of the whole image
+bool StoresFloatAsInteger(ImageIOBase::IOComponentType componentType, const MetaDataDictionary & dictionary)
+{
+  std::string storage_data_type;
+  if( ( componentType != ImageIOBase::FLOAT && componentType != ImageIOBase::DOUBLE ) ||
+      !ExposeMetaData< std::string >(dictionary,"storage_data_type",storage_data_type) )
+    {
+    return false;
+    }
+  return storage_data_type==typeid(char).name() ||
+         storage_data_type==typeid(unsigned char).name() ||
+         storage_data_type==typeid(short).name() ||
+         storage_data_type==typeid(unsigned short).name() ||
+         storage_data_type==typeid(int).name() ||
+         storage_data_type==typeid(unsigned int).name();
+}
+}
+
 
 bool MINCImageIO::CanReadFile(const char *name)
 {
@@ -64,6 +92,33 @@ bool MINCImageIO::CanReadFile(const char *name)
 
 }
 
+ImageIORegion
+MINCImageIO
+::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if ( !m_UseStreamedReading )
+    {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+    }
+
+  const unsigned int nDims = std::max( this->GetNumberOfDimensions(), requestedRegion.GetImageDimension() );
+  ImageIORegion streamableRegion(nDims);
+  for ( unsigned int i = 0; i < nDims; i++ )
+    {
+    if ( i < requestedRegion.GetImageDimension() )
+      {
+      streamableRegion.SetIndex(i, requestedRegion.GetIndex(i));
+      streamableRegion.SetSize(i, requestedRegion.GetSize(i));
+      }
+    else
+      {
+      streamableRegion.SetIndex(i, 0);
+      streamableRegion.SetSize(i, i < this->GetNumberOfDimensions() ? this->GetDimensions(i) : 1);
+      }
+    }
+  return streamableRegion;
+}
+
 void MINCImageIO::Read(void *buffer)
 {
   const unsigned int nDims = this->GetNumberOfDimensions();
@@ -205,6 +260,7 @@ void MINCImageIO::CloseVolume()
     miclose_volume( this->m_MINCPImpl->m_Volume );
     }
   this->m_MINCPImpl->m_Volume = nullptr;
+  this->m_MINCPImpl->m_NumberOfPixelsWritten = 0;
 }
 
 MINCImageIO::MINCImageIO()
@@ -218,6 +274,9 @@ MINCImageIO::MINCImageIO()
   this->m_MINCPImpl->m_MincFileDims   = nullptr;
   this->m_MINCPImpl->m_MincApparentDims = nullptr;
   this->m_MINCPImpl->m_Volume = nullptr;
+  this->m_MINCPImpl->m_NumberOfPixelsWritten = 0;
+  this->m_MINCPImpl->m_WrittenMin = 0.0;
+  this->m_MINCPImpl->m_WrittenMax = 0.0;
 
   for (auto & dimensionIndex : this->m_MINCPImpl->m_DimensionIndices)
     {
@@ -851,6 +910,27 @@ bool MINCImageIO::CanWriteFile(const char *name)
   return this->HasSupportedWriteExtension(name, true);
 }
 
+bool MINCImageIO::CanStreamWrite()
+{
+  return !StoresFloatAsInteger( this->GetComponentType(), this->GetMetaDataDictionary() );
+}
+
+unsigned int
+MINCImageIO
+::GetActualNumberOfSplitsForWriting(unsigned int numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion)
+{
+  // a new write starts, drop the file of one that did not complete
+  this->CloseVolume();
+
+  if ( pasteRegion != largestPossibleRegion )
+    {
+    itkExceptionMacro( "Pasting is not supported! Can't write:" << this->GetFileName() );
+    }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
 /*
  * fill out the appropriate header information
 */
@@ -1350,9 +1430,22 @@ void MINCImageIO::Write(const void *buffer)
       delete[] count;
       itkExceptionMacro(<<"Could not read datatype " << this->GetComponentType() );
     }
-  this->WriteImageInformation();
 
-  //by default valid range will be equal to range, to avoid scaling
+  // the first piece of a streamed write creates the file
+  if( this->m_MINCPImpl->m_NumberOfPixelsWritten == 0 )
+    {
+    this->WriteImageInformation();
+    }
+  else
+    {
+    buffer_min = std::min( buffer_min, this->m_MINCPImpl->m_WrittenMin );
+    buffer_max = std::max( buffer_max, this->m_MINCPImpl->m_WrittenMax );
+    }
+  this->m_MINCPImpl->m_WrittenMin = buffer_min;
+  this->m_MINCPImpl->m_WrittenMax = buffer_max;
+
+  //by default valid range will be equal to range, to avoid scaling.
+  //Widening both with each piece keeps the pieces already written valid.
   if( volume_data_type == this->m_MINCPImpl->m_Volume_type )
     {
     miset_volume_valid_range(this->m_MINCPImpl->m_Volume,buffer_max,buffer_min);
@@ -1383,8 +1476,13 @@ void MINCImageIO::Write(const void *buffer)
     delete[] count;
     itkExceptionMacro( << " Can not set real value hyperslab!!\n");
     }
-  //TODO: determine what to do if we are streming
-  this->CloseVolume();
+
+  // the piece that completes the image closes the file
+  this->m_MINCPImpl->m_NumberOfPixelsWritten += buffer_length / nComp;
+  if( this->m_MINCPImpl->m_NumberOfPixelsWritten >= static_cast< SizeValueType >( this->GetImageSizeInPixels() ) )
+    {
+    this->CloseVolume();
+    }
 
   delete[] start;
   delete[] count;
@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMINCImageIO.h"
+#include "itkMINCImageIOFactory.h"
+#include "itkMetaDataObject.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkTestingMacros.h"
+
+#include <functional>
+
+// Copy a MINC file through a streaming reader into a streaming writer,
+// so that both only ever hold a slab of the image, then read the copy
+// back whole and compare it with the original pixels. The values change
+// from slab to slab so that the range of the written file must grow
+// with each piece.
+
+namespace
+{
+
+const unsigned int NumberOfDivisions = 4;
+
+template< typename TImage >
+void
+FillImage( TImage * image, const std::function< double( const typename TImage::IndexType &, unsigned int ) > & value )
+{
+  using PixelType = typename TImage::PixelType;
+  const unsigned int numberOfComponents = image->GetNumberOfComponentsPerPixel();
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    PixelType pixel = it.Get();
+    for ( unsigned int c = 0; c < numberOfComponents; ++c )
+      {
+      itk::DefaultConvertPixelTraits< PixelType >::SetNthComponent( c, pixel,
+        static_cast< typename TImage::InternalPixelType >( value( it.GetIndex(), c ) ) );
+      }
+    it.Set( pixel );
+    }
+}
+
+template< typename TImage >
+int
+StreamAndCheck( TImage * image, const std::string & fileName, bool expectStreaming, double tolerance )
+{
+  std::cout << fileName << std::endl;
+
+  using ReaderType = itk::ImageFileReader< TImage >;
+  using WriterType = itk::ImageFileWriter< TImage >;
+  using MonitorType = itk::PipelineMonitorImageFilter< TImage >;
+  using PixelType = typename TImage::PixelType;
+
+  const std::string originalFileName = fileName + "Original.mnc";
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetFileName( originalFileName );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( originalFileName );
+  reader->SetUseStreaming( true );
+  typename MonitorType::Pointer monitor = MonitorType::New();
+  monitor->SetInput( reader->GetOutput() );
+
+  // The monitor does not pass the meta data on before it executes, so
+  // a file whose storage type matters is written from the reader
+  const std::string streamedFileName = fileName + "Streamed.mnc";
+  writer = WriterType::New();
+  if ( expectStreaming )
+    {
+    writer->SetInput( monitor->GetOutput() );
+    }
+  else
+    {
+    writer->SetInput( reader->GetOutput() );
+    }
+  writer->SetFileName( streamedFileName );
+  writer->SetNumberOfStreamDivisions( NumberOfDivisions );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  if ( expectStreaming )
+    {
+    TEST_EXPECT_TRUE( monitor->VerifyAllInputCanStream( NumberOfDivisions ) );
+    }
+
+  reader = ReaderType::New();
+  reader->SetFileName( streamedFileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  const TImage * streamed = reader->GetOutput();
+
+  TEST_EXPECT_EQUAL( streamed->GetLargestPossibleRegion(), image->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( streamed->GetNumberOfComponentsPerPixel(), image->GetNumberOfComponentsPerPixel() );
+  const unsigned int numberOfComponents = image->GetNumberOfComponentsPerPixel();
+  itk::ImageRegionConstIteratorWithIndex< TImage > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const PixelType expected = it.Get();
+    const PixelType value = streamed->GetPixel( it.GetIndex() );
+    for ( unsigned int c = 0; c < numberOfComponents; ++c )
+      {
+      const double difference =
+        static_cast< double >( itk::DefaultConvertPixelTraits< PixelType >::GetNthComponent( c, value ) )
+        - static_cast< double >( itk::DefaultConvertPixelTraits< PixelType >::GetNthComponent( c, expected ) );
+      if ( std::abs( difference ) > tolerance )
+        {
+        std::cerr << streamedFileName << ": wrong value at " << it.GetIndex() << " component " << c
+                  << ": " << value << " expected " << expected << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkMINCImageIOStreamingTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkMINCImageIOStreamingTest";
+
+  itk::MINCImageIOFactory::RegisterOneFactory();
+
+  itk::MINCImageIO::Pointer mincIO = itk::MINCImageIO::New();
+  EXERCISE_BASIC_OBJECT_METHODS( mincIO, MINCImageIO, ImageIOBase );
+  TEST_EXPECT_TRUE( mincIO->CanStreamRead() );
+
+  int status = EXIT_SUCCESS;
+
+  // A series of frames, stored along the time dimension
+  {
+  using ImageType = itk::VectorImage< float, 3 >;
+  ImageType::SizeType size;
+  size[0] = 19;
+  size[1] = 13;
+  size[2] = 16;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->SetNumberOfComponentsPerPixel( 5 );
+  image->Allocate();
+  FillImage< ImageType >( image, []( const ImageType::IndexType & index, unsigned int frame )
+    {
+    return 0.25 * ( index[0] + 20 * index[1] ) + 1000.0 * frame * index[2] - 7.0;
+    } );
+  status |= StreamAndCheck< ImageType >( image, directory + "Frames", true, 0.0 );
+  }
+
+  // Integer voxels, whose valid range must cover every slab
+  {
+  using ImageType = itk::Image< short, 3 >;
+  ImageType::SizeType size;
+  size[0] = 21;
+  size[1] = 11;
+  size[2] = 12;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  FillImage< ImageType >( image, []( const ImageType::IndexType & index, unsigned int )
+    {
+    return ( index[2] - 6 ) * 2000 + index[1] * 21 + index[0];
+    } );
+  status |= StreamAndCheck< ImageType >( image, directory + "Short", true, 0.0 );
+  }
+
+  // Floating point pixels stored as integers are written in one piece
+  {
+  using ImageType = itk::Image< float, 3 >;
+  ImageType::SizeType size;
+  size[0] = 15;
+  size[1] = 10;
+  size[2] = 8;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  FillImage< ImageType >( image, []( const ImageType::IndexType & index, unsigned int )
+    {
+    return index[2] * 10.0 + index[1] + 0.5 * index[0];
+    } );
+  itk::EncapsulateMetaData< std::string >( image->GetMetaDataDictionary(), "storage_data_type",
+                                           typeid( unsigned short ).name() );
+  mincIO->SetComponentType( itk::ImageIOBase::FLOAT );
+  mincIO->SetMetaDataDictionary( image->GetMetaDataDictionary() );
+  TEST_EXPECT_TRUE( !mincIO->CanStreamWrite() );
+  status |= StreamAndCheck< ImageType >( image, directory + "FixedPoint", false, 1e-2 );
+  }
+
+  if ( status == EXIT_SUCCESS )
+    {
+    std::cout << "Test finished." << std::endl;
+    }
+  return status;
+}
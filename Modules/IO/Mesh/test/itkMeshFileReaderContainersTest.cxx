@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultDynamicMeshTraits.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkVTKPolyDataMeshIO.h"
+#include "itkTestingMacros.h"
+
+// Write a surface with point and cell data and read it back into meshes
+// whose containers are filled in place (VectorContainer with the
+// coordinate type of the file), after a conversion (VectorContainer with
+// another coordinate type) and element by element (MapContainer), then
+// read a polyline split into edges.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using MeshType = itk::Mesh< float, Dimension >;
+using DoubleMeshType = itk::Mesh< double, Dimension, itk::DefaultStaticMeshTraits< double, Dimension, Dimension, double,
+                                                                                   double, double > >;
+using DynamicMeshType = itk::Mesh< float, Dimension, itk::DefaultDynamicMeshTraits< float, Dimension, Dimension, float,
+                                                                                    float, float > >;
+
+MeshType::Pointer
+MakeSurface(unsigned int columns, unsigned int rows)
+{
+  MeshType::Pointer mesh = MeshType::New();
+  for ( unsigned int row = 0; row < rows; ++row )
+    {
+    for ( unsigned int column = 0; column < columns; ++column )
+      {
+      const MeshType::PointIdentifier id = row * columns + column;
+      MeshType::PointType             point;
+      point[0] = 0.5f * column;
+      point[1] = 0.25f * row;
+      point[2] = 0.125f * ( ( column * row ) % 11 );
+      mesh->SetPoint(id, point);
+      mesh->SetPointData(id, 0.5f * id);
+      }
+    }
+
+  using TriangleType = itk::TriangleCell< MeshType::CellType >;
+  MeshType::CellIdentifier cellId = 0;
+  for ( unsigned int row = 0; row + 1 < rows; ++row )
+    {
+    for ( unsigned int column = 0; column + 1 < columns; ++column )
+      {
+      const MeshType::PointIdentifier corner = row * columns + column;
+      const MeshType::PointIdentifier triangles[2][3] = { { corner, corner + 1, corner + columns },
+                                                          { corner + 1, corner + columns + 1, corner + columns } };
+      for ( const auto & triangle : triangles )
+        {
+        MeshType::CellAutoPointer cell;
+        cell.TakeOwnership(new TriangleType);
+        for ( unsigned int ii = 0; ii < 3; ++ii )
+          {
+          cell->SetPointId(ii, triangle[ii]);
+          }
+        mesh->SetCellData(cellId, -0.25f * cellId);
+        mesh->SetCell(cellId++, cell);
+        }
+      }
+    }
+  return mesh;
+}
+
+template< typename TMesh >
+int
+CompareSurface(const MeshType * mesh, const std::string & fileName)
+{
+  using ReaderType = itk::MeshFileReader< TMesh >;
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  const TMesh * readMesh = reader->GetOutput();
+
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfPoints(), mesh->GetNumberOfPoints() );
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfCells(), mesh->GetNumberOfCells() );
+  TEST_EXPECT_EQUAL( readMesh->GetPointData()->Size(), mesh->GetPointData()->Size() );
+  TEST_EXPECT_EQUAL( readMesh->GetCellData()->Size(), mesh->GetCellData()->Size() );
+  for ( MeshType::PointIdentifier id = 0; id < mesh->GetNumberOfPoints(); ++id )
+    {
+    const typename TMesh::PointType point = readMesh->GetPoint(id);
+    for ( unsigned int dd = 0; dd < Dimension; ++dd )
+      {
+      TEST_EXPECT_EQUAL( point[dd], mesh->GetPoint(id)[dd] );
+      }
+    typename TMesh::PixelType pointData;
+    TEST_EXPECT_TRUE( readMesh->GetPointData(id, &pointData) );
+    TEST_EXPECT_EQUAL( pointData, mesh->GetPointData()->ElementAt(id) );
+    }
+  for ( MeshType::CellIdentifier id = 0; id < mesh->GetNumberOfCells(); ++id )
+    {
+    typename TMesh::CellAutoPointer readCell;
+    TEST_EXPECT_TRUE( readMesh->GetCell(id, readCell) );
+    MeshType::CellAutoPointer cell;
+    mesh->GetCell(id, cell);
+    // The cell types of the two meshes are distinct enumerations
+    TEST_EXPECT_EQUAL( static_cast< int >( readCell->GetType() ), static_cast< int >( cell->GetType() ) );
+    for ( unsigned int ii = 0; ii < cell->GetNumberOfPoints(); ++ii )
+      {
+      TEST_EXPECT_EQUAL( readCell->GetPointIds()[ii], cell->GetPointIds()[ii] );
+      }
+    typename TMesh::CellPixelType cellData;
+    TEST_EXPECT_TRUE( readMesh->GetCellData(id, &cellData) );
+    TEST_EXPECT_EQUAL( cellData, mesh->GetCellData()->ElementAt(id) );
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkMeshFileReaderContainersTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkMeshFileReaderContainersTest";
+
+  MeshType::Pointer mesh = MakeSurface(40, 30);
+
+  const std::string fileName = directory + ".vtk";
+  using WriterType = itk::MeshFileWriter< MeshType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(mesh);
+  writer->SetFileName(fileName);
+  writer->SetFileTypeAsBINARY();
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  if ( CompareSurface< MeshType >(mesh, fileName) != EXIT_SUCCESS
+       || CompareSurface< DoubleMeshType >(mesh, fileName) != EXIT_SUCCESS
+       || CompareSurface< DynamicMeshType >(mesh, fileName) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A polyline of four points and a triangle give four cells
+  const std::string polylineFileName = directory + "Polyline.vtk";
+  {
+  std::ofstream file( polylineFileName.c_str() );
+  file << "# vtk DataFile Version 2.0\n"
+       << "Polyline\n"
+       << "ASCII\n"
+       << "DATASET POLYDATA\n"
+       << "POINTS 4 float\n"
+       << "0 0 0 1 0 0 1 1 0 0 1 0\n"
+       << "LINES 1 5\n"
+       << "4 0 1 2 3\n"
+       << "POLYGONS 1 4\n"
+       << "3 0 1 3\n";
+  }
+  using ReaderType = itk::MeshFileReader< MeshType >;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(polylineFileName);
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  MeshType * readMesh = reader->GetOutput();
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfPoints(), 4 );
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfCells(), 4 );
+  TEST_EXPECT_EQUAL( readMesh->GetCells()->CastToSTLConstContainer().capacity(), 4 );
+  for ( MeshType::CellIdentifier id = 0; id < 3; ++id )
+    {
+    MeshType::CellAutoPointer cell;
+    TEST_EXPECT_TRUE( readMesh->GetCell(id, cell) );
+    TEST_EXPECT_EQUAL( cell->GetType(), MeshType::CellType::LINE_CELL );
+    TEST_EXPECT_EQUAL( cell->GetPointIds()[0], id );
+    TEST_EXPECT_EQUAL( cell->GetPointIds()[1], id + 1 );
+    }
+  MeshType::CellAutoPointer triangle;
+  TEST_EXPECT_TRUE( readMesh->GetCell(3, triangle) );
+  TEST_EXPECT_EQUAL( triangle->GetType(), MeshType::CellType::TRIANGLE_CELL );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -100,6 +100,10 @@ public:
   using OutputCellIdentifier = typename OutputMeshType::CellIdentifier;
   using OutputCellAutoPointer = typename OutputMeshType::CellAutoPointer;
   using OutputCellType = typename OutputMeshType::CellType;
+  using OutputPointsContainer = typename OutputMeshType::PointsContainer;
+  using OutputCellsContainer = typename OutputMeshType::CellsContainer;
+  using OutputPointDataContainer = typename OutputMeshType::PointDataContainer;
+  using OutputCellDataContainer = typename OutputMeshType::CellDataContainer;
   using SizeValueType = typename MeshIOBase::SizeValueType;
 
   using OutputVertexCellType = VertexCell< OutputCellType >;
@@ -170,6 +174,52 @@ protected:
   std::string m_FileName;                    // The file to be read
 
 private:
+  /** Whether the coordinates of consecutive points are contiguous, which
+   * is not the case for points holding more than their coordinates. */
+  static constexpr bool PointCoordinatesAreContiguous =
+    sizeof( OutputPointType ) == OutputPointDimension * sizeof( typename OutputPointType::ValueType );
+
+  /** Read the points straight into the storage of the points
+   * container, when it is a VectorContainer and the points are stored
+   * with the coordinate type of the mesh. Returns false, having read
+   * nothing, otherwise. */
+  bool ReadPointsInPlace();
+
+  /** Resize a VectorContainer to size elements and return its storage,
+   * to be filled in place. Other containers return nullptr and are
+   * filled element by element. */
+  template< typename TElementIdentifier, typename TElement >
+  static TElement * ResizeContainerStorage(VectorContainer< TElementIdentifier, TElement > *container,
+                                           SizeValueType size)
+  {
+    container->CastToSTLContainer().resize(size);
+    return size > 0 ? container->CastToSTLContainer().data() : nullptr;
+  }
+
+  template< typename TContainer >
+  static typename TContainer::Element * ResizeContainerStorage(TContainer *, SizeValueType)
+  {
+    return nullptr;
+  }
+
+  template< typename TElementIdentifier >
+  static bool * ResizeContainerStorage(VectorContainer< TElementIdentifier, bool > *, SizeValueType)
+  {
+    return nullptr;
+  }
+
+  /** Reserve the storage of a VectorContainer for size elements. */
+  template< typename TElementIdentifier, typename TElement >
+  static void ReserveContainerStorage(VectorContainer< TElementIdentifier, TElement > *container,
+                                      SizeValueType size)
+  {
+    container->CastToSTLContainer().reserve(size);
+  }
+
+  template< typename TContainer >
+  static void ReserveContainerStorage(TContainer *, SizeValueType)
+  {}
+
   std::string m_ExceptionMessage;
 };
 } // end namespace itk
@@ -29,6 +29,7 @@
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <memory>
 
 namespace itk
 {
@@ -120,7 +121,24 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 ::ReadPoints(T *buffer)
 {
   typename TOutputMesh::Pointer output = this->GetOutput();
-  output->GetPoints()->Reserve( m_MeshIO->GetNumberOfPoints() );
+  const SizeValueType numberOfPoints = m_MeshIO->GetNumberOfPoints();
+
+  // Convert the coordinates of all the points in a single flat loop,
+  // straight into the storage of a VectorContainer
+  OutputPointType *points =
+    PointCoordinatesAreContiguous ? ResizeContainerStorage( output->GetPoints(), numberOfPoints ) : nullptr;
+  if ( points != nullptr )
+    {
+    typename OutputPointType::ValueType *coordinates = points->GetDataPointer();
+    const SizeValueType numberOfCoordinates = numberOfPoints * OutputPointDimension;
+    for ( SizeValueType ii = 0; ii < numberOfCoordinates; ++ii )
+      {
+      coordinates[ii] = static_cast< typename OutputPointType::ValueType >( buffer[ii] );
+      }
+    return;
+    }
+
+  output->GetPoints()->Reserve( numberOfPoints );
   OutputPointType point;
 
   for ( OutputPointIdentifier id = 0; id < output->GetNumberOfPoints(); id++ )
@@ -134,6 +152,30 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
     }
 }
 
+template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
+bool
+MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadPointsInPlace()
+{
+  if ( m_MeshIO->GetPointComponentType() !=
+       MeshIOBase::MapComponentType< typename OutputPointType::ValueType >::CType
+       || m_MeshIO->GetPointDimension() != OutputPointDimension
+       || !PointCoordinatesAreContiguous )
+    {
+    return false;
+    }
+
+  OutputPointType *points = ResizeContainerStorage( this->GetOutput()->GetPoints(), m_MeshIO->GetNumberOfPoints() );
+  if ( points == nullptr )
+    {
+    return false;
+    }
+
+  itkDebugMacro(<< "Reading the points in place.");
+  m_MeshIO->ReadPoints( static_cast< void * >( points->GetDataPointer() ) );
+  return true;
+}
+
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
 template< typename T >
 void
@@ -142,6 +184,23 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 {
   typename TOutputMesh::Pointer output = this->GetOutput();
 
+  // Count the cells, polylines being split into edges, to allocate the
+  // cells container once. The cells themselves are still allocated one
+  // by one, since the mesh releases them one by one.
+  if ( output->GetCells() == nullptr )
+    {
+    output->SetCells( OutputCellsContainer::New() );
+    }
+  SizeValueType numberOfCells = NumericTraits< SizeValueType >::ZeroValue();
+  for ( SizeValueType index = 0; index + 1 < m_MeshIO->GetCellBufferSize(); )
+    {
+    const auto type = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index] ) );
+    const auto numberOfPoints = static_cast< SizeValueType >( buffer[index + 1] );
+    numberOfCells += ( type == MeshIOBase::LINE_CELL && numberOfPoints > 1 ) ? numberOfPoints - 1 : 1;
+    index += 2 + numberOfPoints;
+    }
+  ReserveContainerStorage( output->GetCells(), numberOfCells );
+
   SizeValueType        index = NumericTraits< SizeValueType >::ZeroValue();
   OutputCellIdentifier id = NumericTraits< OutputCellIdentifier >::ZeroValue();
   while ( index < m_MeshIO->GetCellBufferSize() )
@@ -344,67 +403,55 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 ::ReadPointData()
 {
   typename TOutputMesh::Pointer output = this->GetOutput();
+  const SizeValueType numberOfPointPixels = m_MeshIO->GetNumberOfPointPixels();
+
+  // Fill the storage of a VectorContainer in place, other containers
+  // through a temporary buffer
+  OutputPointDataContainer *pointData = output->GetPointData();
+  OutputPointPixelType *outputPointDataBuffer = ResizeContainerStorage( pointData, numberOfPointPixels );
+  std::unique_ptr< OutputPointPixelType[] > temporaryPointDataBuffer;
+  if ( outputPointDataBuffer == nullptr )
+    {
+    temporaryPointDataBuffer.reset( new OutputPointPixelType[numberOfPointPixels] );
+    outputPointDataBuffer = temporaryPointDataBuffer.get();
+    }
 
-  char *                inputPointDataBuffer = nullptr;
-  auto * outputPointDataBuffer = new OutputPointPixelType[m_MeshIO->GetNumberOfPointPixels()];
-
-  try
+  if ( ( m_MeshIO->GetPointPixelComponentType() !=
+         MeshIOBase::MapComponentType< typename ConvertPointPixelTraits::ComponentType >::CType )
+      || ( m_MeshIO->GetNumberOfPointPixelComponents() != ConvertPointPixelTraits::GetNumberOfComponents() ) )
     {
-    if ( ( m_MeshIO->GetPointPixelComponentType() !=
-           MeshIOBase::MapComponentType< typename ConvertPointPixelTraits::ComponentType >::CType )
-        || ( m_MeshIO->GetNumberOfPointPixelComponents() != ConvertPointPixelTraits::GetNumberOfComponents() ) )
-      {
-      // the point pixel types don't match a type conversion needs to be
-      // performed
-      itkDebugMacro( << "Buffer conversion required from: "
-                     << m_MeshIO->GetComponentTypeAsString( m_MeshIO->GetPointPixelComponentType() )
-                     << " to: "
-                     << m_MeshIO->GetComponentTypeAsString(MeshIOBase::MapComponentType< typename ConvertPointPixelTraits::
-                                                                                        ComponentType >::CType)
-                     << "ConvertPointPixelTraits::NumberOfComponents "
-                     << ConvertPointPixelTraits::GetNumberOfComponents()
-                     << " m_MeshIO->NumberOfComponents "
-                     << m_MeshIO->GetNumberOfPointPixelComponents() );
-
-      inputPointDataBuffer =
-        new char[m_MeshIO->GetNumberOfPointPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetPointPixelComponentType() )
-                 * m_MeshIO->GetNumberOfPointPixels()];
-      m_MeshIO->ReadPointData( static_cast< void * >( inputPointDataBuffer ) );
-
-      this->ConvertPointPixelBuffer( static_cast< void * >( inputPointDataBuffer ), outputPointDataBuffer, m_MeshIO->GetNumberOfPointPixels() );
-      }
-    else
-      {
-      itkDebugMacro(<< "No buffer conversion required.");
-      m_MeshIO->ReadPointData( static_cast< void * >( outputPointDataBuffer ) );
-      }
+    // the point pixel types don't match a type conversion needs to be
+    // performed
+    itkDebugMacro( << "Buffer conversion required from: "
+                   << m_MeshIO->GetComponentTypeAsString( m_MeshIO->GetPointPixelComponentType() )
+                   << " to: "
+                   << m_MeshIO->GetComponentTypeAsString(MeshIOBase::MapComponentType< typename ConvertPointPixelTraits::
+                                                                                      ComponentType >::CType)
+                   << "ConvertPointPixelTraits::NumberOfComponents "
+                   << ConvertPointPixelTraits::GetNumberOfComponents()
+                   << " m_MeshIO->NumberOfComponents "
+                   << m_MeshIO->GetNumberOfPointPixelComponents() );
+
+    const std::unique_ptr< char[] > inputPointDataBuffer(
+      new char[m_MeshIO->GetNumberOfPointPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetPointPixelComponentType() )
+               * numberOfPointPixels] );
+    m_MeshIO->ReadPointData( static_cast< void * >( inputPointDataBuffer.get() ) );
+
+    this->ConvertPointPixelBuffer( static_cast< void * >( inputPointDataBuffer.get() ), outputPointDataBuffer, numberOfPointPixels );
     }
-  catch ( ... )
+  else
     {
-    // if an exception is thrown catch it
-
-    // clean up
-    delete[] inputPointDataBuffer;
-    inputPointDataBuffer = nullptr;
-
-    delete[] outputPointDataBuffer;
-    outputPointDataBuffer = nullptr;
-
-    // then rethrow
-    throw;
+    itkDebugMacro(<< "No buffer conversion required.");
+    m_MeshIO->ReadPointData( static_cast< void * >( outputPointDataBuffer ) );
     }
 
-  // clean up
-  delete[] inputPointDataBuffer;
-  inputPointDataBuffer = nullptr;
-
-  for ( OutputPointIdentifier id = 0; id < m_MeshIO->GetNumberOfPointPixels(); id++ )
+  if ( temporaryPointDataBuffer )
     {
-    output->SetPointData(id, outputPointDataBuffer[id]);
+    for ( OutputPointIdentifier id = 0; id < numberOfPointPixels; id++ )
+      {
+      output->SetPointData(id, outputPointDataBuffer[id]);
+      }
     }
-
-  delete[] outputPointDataBuffer;
-  outputPointDataBuffer = nullptr;
 }
 
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
@@ -413,67 +460,59 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 ::ReadCellData()
 {
   typename TOutputMesh::Pointer output = this->GetOutput();
+  const SizeValueType numberOfCellPixels = m_MeshIO->GetNumberOfCellPixels();
 
-  char *               inputCellDataBuffer = nullptr;
-  auto * outputCellDataBuffer = new OutputCellPixelType[m_MeshIO->GetNumberOfCellPixels()];
-
-  try
+  // Fill the storage of a VectorContainer in place, other containers
+  // through a temporary buffer
+  if ( output->GetCellData() == nullptr )
     {
-    if ( ( m_MeshIO->GetCellPixelComponentType() !=
-           MeshIOBase::MapComponentType< typename ConvertCellPixelTraits::ComponentType >::CType )
-        || ( m_MeshIO->GetNumberOfCellPixelComponents() != ConvertCellPixelTraits::GetNumberOfComponents() ) )
-      {
-      // the cell pixel types don't match a type conversion needs to be
-      // performed
-      itkDebugMacro( << "Buffer conversion required from: "
-                     << m_MeshIO->GetComponentTypeAsString( m_MeshIO->GetCellPixelComponentType() )
-                     << " to: "
-                     << m_MeshIO->GetComponentTypeAsString(MeshIOBase::MapComponentType< typename ConvertCellPixelTraits::ComponentType >
-                                                          ::CType)
-                     << "ConvertCellPixelTraits::NumberOfComponents "
-                     << ConvertCellPixelTraits::GetNumberOfComponents()
-                     << " m_MeshIO->NumberOfComponents "
-                     << m_MeshIO->GetNumberOfCellPixelComponents() );
-
-      inputCellDataBuffer =
-        new char[m_MeshIO->GetNumberOfCellPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetCellPixelComponentType() )
-                 * m_MeshIO->GetNumberOfCellPixels()];
-      m_MeshIO->ReadCellData( static_cast< void * >( inputCellDataBuffer ) );
-
-      this->ConvertCellPixelBuffer( static_cast< void * >( inputCellDataBuffer ), outputCellDataBuffer, m_MeshIO->GetNumberOfCellPixels() );
-      }
-    else
-      {
-      itkDebugMacro(<< "No buffer conversion required.");
-      m_MeshIO->ReadCellData( static_cast< void * >( outputCellDataBuffer ) );
-      }
+    output->SetCellData( OutputCellDataContainer::New() );
     }
-  catch ( ... )
+  OutputCellDataContainer *cellData = output->GetCellData();
+  OutputCellPixelType *outputCellDataBuffer = ResizeContainerStorage( cellData, numberOfCellPixels );
+  std::unique_ptr< OutputCellPixelType[] > temporaryCellDataBuffer;
+  if ( outputCellDataBuffer == nullptr )
     {
-    // if an exception is thrown catch it
-
-    // clean up
-    delete[] inputCellDataBuffer;
-    inputCellDataBuffer = nullptr;
-
-    delete[] outputCellDataBuffer;
-    outputCellDataBuffer = nullptr;
-
-    // then rethrow
-    throw;
+    temporaryCellDataBuffer.reset( new OutputCellPixelType[numberOfCellPixels] );
+    outputCellDataBuffer = temporaryCellDataBuffer.get();
     }
 
-  // clean up
-  delete[] inputCellDataBuffer;
-  inputCellDataBuffer = nullptr;
-
-  for ( OutputCellIdentifier id = 0; id < m_MeshIO->GetNumberOfCellPixels(); id++ )
+  if ( ( m_MeshIO->GetCellPixelComponentType() !=
+         MeshIOBase::MapComponentType< typename ConvertCellPixelTraits::ComponentType >::CType )
+      || ( m_MeshIO->GetNumberOfCellPixelComponents() != ConvertCellPixelTraits::GetNumberOfComponents() ) )
     {
-    output->SetCellData(id, outputCellDataBuffer[id]);
+    // the cell pixel types don't match a type conversion needs to be
+    // performed
+    itkDebugMacro( << "Buffer conversion required from: "
+                   << m_MeshIO->GetComponentTypeAsString( m_MeshIO->GetCellPixelComponentType() )
+                   << " to: "
+                   << m_MeshIO->GetComponentTypeAsString(MeshIOBase::MapComponentType< typename ConvertCellPixelTraits::ComponentType >
+                                                        ::CType)
+                   << "ConvertCellPixelTraits::NumberOfComponents "
+                   << ConvertCellPixelTraits::GetNumberOfComponents()
+                   << " m_MeshIO->NumberOfComponents "
+                   << m_MeshIO->GetNumberOfCellPixelComponents() );
+
+    const std::unique_ptr< char[] > inputCellDataBuffer(
+      new char[m_MeshIO->GetNumberOfCellPixelComponents() * m_MeshIO->GetComponentSize( m_MeshIO->GetCellPixelComponentType() )
+               * numberOfCellPixels] );
+    m_MeshIO->ReadCellData( static_cast< void * >( inputCellDataBuffer.get() ) );
+
+    this->ConvertCellPixelBuffer( static_cast< void * >( inputCellDataBuffer.get() ), outputCellDataBuffer, numberOfCellPixels );
+    }
+  else
+    {
+    itkDebugMacro(<< "No buffer conversion required.");
+    m_MeshIO->ReadCellData( static_cast< void * >( outputCellDataBuffer ) );
     }
 
-  delete[] outputCellDataBuffer;
-  outputCellDataBuffer = nullptr;
+  if ( temporaryCellDataBuffer )
+    {
+    for ( OutputCellIdentifier id = 0; id < numberOfCellPixels; id++ )
+      {
+      output->SetCellData(id, outputCellDataBuffer[id]);
+      }
+    }
 }
 
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
@@ -560,8 +599,8 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
   // Get mesh information
   m_MeshIO->ReadMeshInformation();
 
-  // Read points
-  if ( m_MeshIO->GetUpdatePoints() )
+  // Read points, in place if no conversion is required
+  if ( m_MeshIO->GetUpdatePoints() && !this->ReadPointsInPlace() )
     {
     switch ( m_MeshIO->GetPointComponentType() )
       {
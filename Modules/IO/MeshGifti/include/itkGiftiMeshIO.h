@@ -26,12 +26,24 @@
 #include "itkRGBAPixel.h"
 
 #include <fstream>
+#include <future>
 #include <string>
+#include <vector>
 
 namespace itk
 {
 /** \class GiftiMeshIO
  * \brief This class defines how to read and write Gifti file format.
+ *
+ * Data arrays encoded as Base64Binary or GZipBase64Binary are decoded
+ * by this class rather than by the GIFTI library: the first call to one
+ * of the Read methods decodes the points, cells, point data and cell
+ * data arrays concurrently, each one as a job on the ThreadPool, and
+ * each Read method copies its array into the buffer it is given. Other
+ * encodings are read through the GIFTI library. Writing is symmetric:
+ * the data arrays are compressed and encoded concurrently, then written
+ * in the document the GIFTI library writes for the meta data.
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOMeshGifti
  */
@@ -138,6 +150,52 @@ protected:
   }
 
 private:
+  /** Where the encoded values of a data array are in the file, how they
+   * are encoded, and, once decoding has started, the decoded values. */
+  struct DataArrayType
+  {
+    int                 m_DataType{ 0 };
+    int                 m_Encoding{ 0 };
+    int                 m_Endian{ 0 };
+    bool                m_CanDecode{ false };
+    std::streamoff      m_Offset{ 0 };
+    std::streamsize     m_Length{ 0 };
+    SizeValueType       m_NumberOfBytes{ 0 };
+    unsigned int        m_NumberOfReads{ 0 };
+    std::vector< char > m_Data;
+    std::future< void > m_Decoded;
+  };
+
+  /** Locate the encoded values of the data arrays of m_GiftiImage, read
+   * without its data, and select the arrays read by each Read method. */
+  void LocateDataArrays();
+
+  /** Start decoding the selected data arrays, unless already started. */
+  void DecodeDataArrays();
+
+  /** Read and decode the values of a data array. */
+  void DecodeDataArray(DataArrayType & dataArray) const;
+
+  /** Wait for the decoded values of a data array. Returns a null pointer
+   * if the array is read through the GIFTI library instead. */
+  const char * WaitForDataArray(int index);
+
+  /** Release the decoded values of a data array once read as many
+   * times as selected. */
+  void ReleaseDataArray(int index);
+
+  /** Wait for pending decoding and forget the data arrays. */
+  void DropDataArrays();
+
+  /** Copy triangles, stored as in a GIFTI data array, into a cells buffer. */
+  void ReadTriangleCells(const void *triangles, void *buffer);
+
+  /** Compress and encode the data arrays of m_GiftiImage concurrently
+   * and write them in the document written by the GIFTI library. Returns
+   * false, writing nothing, if a data array is encoded as ASCII or
+   * stored in an external file. */
+  bool WriteEncodedDataArrays();
+
   //This proxy class provides a gifti_image pointer interface to the internal implementation
   //of itk::GiftiImageIO, while hiding the gifticlib interface from the external ITK interface.
   class GiftiImageProxy;
@@ -150,6 +208,14 @@ private:
 
   bool          m_ReadPointData;
   DirectionType m_Direction;
+
+  // data arrays of the file read, and the one read by each Read method
+  std::vector< DataArrayType > m_DataArrays;
+  int                          m_PointsDataArray{ -1 };
+  int                          m_CellsDataArray{ -1 };
+  int                          m_PointDataDataArray{ -1 };
+  int                          m_CellDataDataArray{ -1 };
+  bool                         m_DecodingStarted{ false };
 };
 } // end namespace itk
 
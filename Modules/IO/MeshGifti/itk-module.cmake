@@ -9,6 +9,7 @@ itk_module(ITKIOMeshGifti
     ITKMesh
   PRIVATE_DEPENDS
     ITKGIFTI
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
     ITKQuadEdgeMesh
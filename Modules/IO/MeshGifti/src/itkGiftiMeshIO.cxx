@@ -18,12 +18,92 @@
 
 #include "itkGiftiMeshIO.h"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+#include "itkThreadPool.h"
 
 #include <itksys/SystemTools.hxx>
+#include "itksys/Base64.h"
+#include "itk_zlib.h"
 #include "gifti_io.h"
 
+#include <algorithm>
+#include <cctype>
+
 namespace itk
 {
+namespace
+{
+// Locate the contents of the Data elements of a GIFTI document, as
+// offsets and lengths, in document order. Comments, CDATA sections and
+// processing instructions are skipped. Returns false if the document is
+// cut short.
+bool
+FindDataElements(const std::string & xml, std::vector< std::pair< size_t, size_t > > & contents)
+{
+  contents.clear();
+  size_t start = xml.find('<');
+  while ( start != std::string::npos )
+    {
+    size_t end = start;
+    if ( xml.compare(start, 4, "<!--") == 0 )
+      {
+      end = xml.find("-->", start + 4);
+      }
+    else if ( xml.compare(start, 9, "<![CDATA[") == 0 )
+      {
+      end = xml.find("]]>", start + 9);
+      }
+    else if ( xml.compare(start, 2, "<?") == 0 )
+      {
+      end = xml.find("?>", start + 2);
+      }
+    else if ( xml.compare(start, 5, "<Data") == 0 && start + 5 < xml.size()
+              && ( xml[start + 5] == '>' || xml[start + 5] == '/'
+                   || std::isspace( static_cast< unsigned char >( xml[start + 5] ) ) ) )
+      {
+      end = xml.find('>', start + 5);
+      if ( end != std::string::npos && xml[end - 1] == '/' )
+        {
+        contents.emplace_back(end + 1, 0);
+        }
+      else if ( end != std::string::npos )
+        {
+        // the values are text, up to the end tag
+        const size_t close = xml.find('<', end + 1);
+        if ( close == std::string::npos || xml.compare(close, 7, "</Data>") != 0 )
+          {
+          return false;
+          }
+        contents.emplace_back(end + 1, close - end - 1);
+        end = close;
+        }
+      }
+    // any other markup ends before the next '<'
+    if ( end == std::string::npos )
+      {
+      return false;
+      }
+    start = xml.find('<', end + 1);
+    }
+  return true;
+}
+
+bool
+ReadFile(const std::string & fileName, std::string & contents)
+{
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if ( !file )
+    {
+    return false;
+    }
+  file.seekg(0, std::ios::end);
+  contents.resize( static_cast< size_t >( file.tellg() ) );
+  file.seekg(0, std::ios::beg);
+  file.read(&contents[0], contents.size());
+  return static_cast< bool >( file );
+}
+} // end anonymous namespace
+
 //This internal proxy class provides a pointer-like interface to a gifti_image*, by supporting
 //conversions between proxy and gifti_image pointer and arrow syntax (e.g., m_GiftiImage->data).
 class GiftiMeshIO::GiftiImageProxy
@@ -61,7 +141,10 @@ GiftiMeshIO
 }
 
 GiftiMeshIO
-::~GiftiMeshIO() = default;
+::~GiftiMeshIO()
+{
+  this->DropDataArrays();
+}
 
 bool
 GiftiMeshIO
@@ -157,6 +240,8 @@ void
 GiftiMeshIO
 ::ReadMeshInformation()
 {
+  this->DropDataArrays();
+
   // Get gifti image pointer
   m_GiftiImage = gifti_read_image(this->GetFileName(), false);
 
@@ -861,13 +946,237 @@ GiftiMeshIO
         }
       }
     }
+
+  this->LocateDataArrays();
   gifti_free_image( m_GiftiImage );
 }
 
+void
+GiftiMeshIO
+::LocateDataArrays()
+{
+  const int numberOfDataArrays = m_GiftiImage->numDA;
+  m_DataArrays.resize(numberOfDataArrays);
+
+  // The Read methods copy the last data array matching what they read
+  for ( int ii = 0; ii < numberOfDataArrays; ++ii )
+    {
+    const giiDataArray *da = m_GiftiImage->darray[ii];
+    if ( da->intent == NIFTI_INTENT_POINTSET )
+      {
+      m_PointsDataArray = ii;
+      }
+    else if ( da->intent == NIFTI_INTENT_TRIANGLE )
+      {
+      m_CellsDataArray = ii;
+      }
+    else if ( ( da->intent == NIFTI_INTENT_SHAPE || da->intent == NIFTI_INTENT_VECTOR
+                || da->intent == NIFTI_INTENT_LABEL ) && da->num_dim > 0 )
+      {
+      if ( static_cast< SizeValueType >( da->dims[0] ) == this->m_NumberOfPointPixels )
+        {
+        m_PointDataDataArray = ii;
+        }
+      if ( static_cast< SizeValueType >( da->dims[0] ) == this->m_NumberOfCellPixels )
+        {
+        m_CellDataDataArray = ii;
+        }
+      }
+    }
+  if ( this->m_UpdatePoints && m_PointsDataArray >= 0 )
+    {
+    ++m_DataArrays[m_PointsDataArray].m_NumberOfReads;
+    }
+  if ( this->m_UpdateCells && m_CellsDataArray >= 0 )
+    {
+    ++m_DataArrays[m_CellsDataArray].m_NumberOfReads;
+    }
+  if ( this->m_UpdatePointData && m_PointDataDataArray >= 0 )
+    {
+    ++m_DataArrays[m_PointDataDataArray].m_NumberOfReads;
+    }
+  if ( this->m_UpdateCellData && m_CellDataDataArray >= 0 )
+    {
+    ++m_DataArrays[m_CellDataDataArray].m_NumberOfReads;
+    }
+
+  // Data arrays whose Data elements cannot be matched are read through
+  // the GIFTI library
+  std::string                                xml;
+  std::vector< std::pair< size_t, size_t > > contents;
+  if ( !ReadFile(this->m_FileName, xml) || !FindDataElements(xml, contents)
+       || contents.size() != static_cast< size_t >( numberOfDataArrays ) )
+    {
+    return;
+    }
+
+  for ( int ii = 0; ii < numberOfDataArrays; ++ii )
+    {
+    const giiDataArray *da = m_GiftiImage->darray[ii];
+    DataArrayType &     dataArray = m_DataArrays[ii];
+    int                 swapSize = 0;
+    gifti_datatype_sizes(da->datatype, nullptr, &swapSize);
+
+    dataArray.m_DataType = da->datatype;
+    dataArray.m_Encoding = da->encoding;
+    dataArray.m_Endian = da->endian;
+    dataArray.m_Offset = static_cast< std::streamoff >( contents[ii].first );
+    dataArray.m_Length = static_cast< std::streamsize >( contents[ii].second );
+    dataArray.m_NumberOfBytes = static_cast< SizeValueType >( da->nvals * da->nbyper );
+    // the GIFTI library permutes column major arrays to row major ones
+    dataArray.m_CanDecode = ( da->encoding == GIFTI_ENCODING_B64BIN || da->encoding == GIFTI_ENCODING_B64GZ )
+                            && ( da->ext_fname == nullptr || *da->ext_fname == '\0' )
+                            && ( da->num_dim < 2 || da->ind_ord == GIFTI_IND_ORD_ROW_MAJOR )
+                            && swapSize > 0 && dataArray.m_NumberOfBytes > 0;
+    }
+}
+
+void
+GiftiMeshIO
+::DecodeDataArrays()
+{
+  if ( m_DecodingStarted )
+    {
+    return;
+    }
+  m_DecodingStarted = true;
+
+  // A job on the ThreadPool waiting for other jobs could deadlock: decode
+  // each array when it is read instead
+  if ( ThreadPool::IsCurrentThreadInPool() )
+    {
+    return;
+    }
+  for ( auto & dataArray : m_DataArrays )
+    {
+    if ( dataArray.m_CanDecode && dataArray.m_NumberOfReads > 0 )
+      {
+      DataArrayType *decoded = &dataArray;
+      dataArray.m_Decoded = ThreadPool::GetInstance()->AddWork([this, decoded]()
+        {
+        this->DecodeDataArray(*decoded);
+        });
+      }
+    }
+}
+
+void
+GiftiMeshIO
+::DecodeDataArray(DataArrayType & dataArray) const
+{
+  std::ifstream file(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
+  std::string   text( static_cast< size_t >( dataArray.m_Length ), '\0' );
+  file.seekg(dataArray.m_Offset);
+  file.read(&text[0], dataArray.m_Length);
+  if ( !file )
+    {
+    itkExceptionMacro(<< "Could not read the data arrays of " << this->m_FileName);
+    }
+  text.erase(std::remove_if( text.begin(), text.end(), []( char c )
+    {
+    return std::isspace( static_cast< unsigned char >( c ) ) != 0;
+    } ), text.end());
+
+  std::vector< char > decoded(text.size() / 4 * 3 + 3);
+  const size_t        decodedSize = itksysBase64_Decode(reinterpret_cast< const unsigned char * >( text.data() ), 0,
+                                                        reinterpret_cast< unsigned char * >( decoded.data() ),
+                                                        text.size());
+  decoded.resize(decodedSize);
+
+  std::vector< char > values;
+  if ( dataArray.m_Encoding == GIFTI_ENCODING_B64GZ )
+    {
+    values.resize(dataArray.m_NumberOfBytes);
+    uLongf valuesSize = static_cast< uLongf >( values.size() );
+    if ( uncompress(reinterpret_cast< Bytef * >( values.data() ), &valuesSize,
+                    reinterpret_cast< const Bytef * >( decoded.data() ), static_cast< uLong >( decoded.size() ) ) != Z_OK
+         || valuesSize != values.size() )
+      {
+      itkExceptionMacro(<< "Could not uncompress a data array of " << this->m_FileName);
+      }
+    }
+  else
+    {
+    values.swap(decoded);
+    }
+  if ( values.size() != dataArray.m_NumberOfBytes )
+    {
+    itkExceptionMacro(<< "A data array of " << this->m_FileName << " holds " << values.size()
+                      << " bytes instead of " << dataArray.m_NumberOfBytes);
+    }
+
+  int swapSize = 0;
+  gifti_datatype_sizes(dataArray.m_DataType, nullptr, &swapSize);
+  if ( swapSize > 1 )
+    {
+    gifti_check_swap(values.data(), dataArray.m_Endian, static_cast< long long >( values.size() / swapSize ), swapSize);
+    }
+  dataArray.m_Data.swap(values);
+}
+
+const char *
+GiftiMeshIO
+::WaitForDataArray(int index)
+{
+  if ( index < 0 || static_cast< size_t >( index ) >= m_DataArrays.size() || !m_DataArrays[index].m_CanDecode )
+    {
+    return nullptr;
+    }
+  this->DecodeDataArrays();
+
+  DataArrayType & dataArray = m_DataArrays[index];
+  if ( dataArray.m_Decoded.valid() )
+    {
+    dataArray.m_Decoded.get();
+    }
+  else if ( dataArray.m_Data.empty() )
+    {
+    this->DecodeDataArray(dataArray);
+    }
+  return dataArray.m_Data.data();
+}
+
+void
+GiftiMeshIO
+::ReleaseDataArray(int index)
+{
+  DataArrayType & dataArray = m_DataArrays[index];
+  if ( dataArray.m_NumberOfReads > 0 && --dataArray.m_NumberOfReads == 0 )
+    {
+    std::vector< char >().swap(dataArray.m_Data);
+    }
+}
+
+void
+GiftiMeshIO
+::DropDataArrays()
+{
+  for ( auto & dataArray : m_DataArrays )
+    {
+    if ( dataArray.m_Decoded.valid() )
+      {
+      dataArray.m_Decoded.wait();
+      }
+    }
+  m_DataArrays.clear();
+  m_PointsDataArray = -1;
+  m_CellsDataArray = -1;
+  m_PointDataDataArray = -1;
+  m_CellDataDataArray = -1;
+  m_DecodingStarted = false;
+}
+
 void
 GiftiMeshIO
 ::ReadPoints(void *buffer)
 {
+  if ( const char *points = this->WaitForDataArray(m_PointsDataArray) )
+    {
+    memcpy(buffer, points, m_DataArrays[m_PointsDataArray].m_NumberOfBytes);
+    this->ReleaseDataArray(m_PointsDataArray);
+    return;
+    }
+
   // Get gifti image pointer
   m_GiftiImage = gifti_read_image(this->GetFileName(), true);
 
@@ -895,6 +1204,13 @@ void
 GiftiMeshIO
 ::ReadCells(void *buffer)
 {
+  if ( const char *cells = this->WaitForDataArray(m_CellsDataArray) )
+    {
+    this->ReadTriangleCells(cells, buffer);
+    this->ReleaseDataArray(m_CellsDataArray);
+    return;
+    }
+
   // Get gifti image pointer
   m_GiftiImage = gifti_read_image(this->GetFileName(), true);
 
@@ -909,127 +1225,14 @@ GiftiMeshIO
     {
     if ( m_GiftiImage->darray[ii]->intent == NIFTI_INTENT_TRIANGLE )
       {
-      switch ( this->m_CellComponentType )
+      try
         {
-        case CHAR:
-          {
-          this->WriteCellsBuffer(static_cast< char * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< char * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case UCHAR:
-          {
-          this->WriteCellsBuffer(static_cast< unsigned char * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< unsigned char * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case USHORT:
-          {
-          this->WriteCellsBuffer(static_cast< unsigned short * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< unsigned short * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case SHORT:
-          {
-          this->WriteCellsBuffer(static_cast< short * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< short * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case UINT:
-          {
-          this->WriteCellsBuffer(static_cast< unsigned int * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< unsigned int * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case INT:
-          {
-          this->WriteCellsBuffer(static_cast< int * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< int * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case ULONG:
-          {
-          this->WriteCellsBuffer(static_cast< unsigned long * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< unsigned long * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case LONG:
-          {
-          this->WriteCellsBuffer(static_cast< long * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< long * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case LONGLONG:
-          {
-          this->WriteCellsBuffer(static_cast< long long * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< long long * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case ULONGLONG:
-          {
-          this->WriteCellsBuffer(static_cast< unsigned long long * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< unsigned long long * >( buffer ), TRIANGLE_CELL, 3, this->m_NumberOfCells);
-          break;
-          }
-        case FLOAT:
-          {
-          this->WriteCellsBuffer(static_cast< float * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< float * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case DOUBLE:
-          {
-          this->WriteCellsBuffer(static_cast< double * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< double * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        case LDOUBLE:
-          {
-          this->WriteCellsBuffer(static_cast< long double * >( m_GiftiImage->darray[ii]->data ),
-                                 static_cast< long double * >( buffer ),
-                                 TRIANGLE_CELL,
-                                 3,
-                                 this->m_NumberOfCells);
-          break;
-          }
-        default:
-          {
-          gifti_free_image( m_GiftiImage );
-          itkExceptionMacro(<< "Unknown cell data pixel component type" << std::endl);
-          }
+        this->ReadTriangleCells(m_GiftiImage->darray[ii]->data, buffer);
+        }
+      catch ( ExceptionObject & )
+        {
+        gifti_free_image( m_GiftiImage );
+        throw;
         }
       }
     }
@@ -1037,10 +1240,144 @@ GiftiMeshIO
   gifti_free_image( m_GiftiImage );
 }
 
+void
+GiftiMeshIO
+::ReadTriangleCells(const void *triangles, void *buffer)
+{
+  switch ( this->m_CellComponentType )
+    {
+    case CHAR:
+      {
+      this->WriteCellsBuffer(static_cast< const char * >( triangles ),
+                             static_cast< char * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case UCHAR:
+      {
+      this->WriteCellsBuffer(static_cast< const unsigned char * >( triangles ),
+                             static_cast< unsigned char * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case USHORT:
+      {
+      this->WriteCellsBuffer(static_cast< const unsigned short * >( triangles ),
+                             static_cast< unsigned short * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case SHORT:
+      {
+      this->WriteCellsBuffer(static_cast< const short * >( triangles ),
+                             static_cast< short * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case UINT:
+      {
+      this->WriteCellsBuffer(static_cast< const unsigned int * >( triangles ),
+                             static_cast< unsigned int * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case INT:
+      {
+      this->WriteCellsBuffer(static_cast< const int * >( triangles ),
+                             static_cast< int * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case ULONG:
+      {
+      this->WriteCellsBuffer(static_cast< const unsigned long * >( triangles ),
+                             static_cast< unsigned long * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case LONG:
+      {
+      this->WriteCellsBuffer(static_cast< const long * >( triangles ),
+                             static_cast< long * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case LONGLONG:
+      {
+      this->WriteCellsBuffer(static_cast< const long long * >( triangles ),
+                             static_cast< long long * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case ULONGLONG:
+      {
+      this->WriteCellsBuffer(static_cast< const unsigned long long * >( triangles ),
+                             static_cast< unsigned long long * >( buffer ), TRIANGLE_CELL, 3, this->m_NumberOfCells);
+      break;
+      }
+    case FLOAT:
+      {
+      this->WriteCellsBuffer(static_cast< const float * >( triangles ),
+                             static_cast< float * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case DOUBLE:
+      {
+      this->WriteCellsBuffer(static_cast< const double * >( triangles ),
+                             static_cast< double * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    case LDOUBLE:
+      {
+      this->WriteCellsBuffer(static_cast< const long double * >( triangles ),
+                             static_cast< long double * >( buffer ),
+                             TRIANGLE_CELL,
+                             3,
+                             this->m_NumberOfCells);
+      break;
+      }
+    default:
+      {
+      itkExceptionMacro(<< "Unknown cell data pixel component type" << std::endl);
+      }
+    }
+}
+
 void
 GiftiMeshIO
 ::ReadPointData(void *buffer)
 {
+  if ( const char *pointData = this->WaitForDataArray(m_PointDataDataArray) )
+    {
+    memcpy(buffer, pointData, m_DataArrays[m_PointDataDataArray].m_NumberOfBytes);
+    this->ReleaseDataArray(m_PointDataDataArray);
+    return;
+    }
+
   // Get gifti image pointer
   m_GiftiImage = gifti_read_image(this->GetFileName(), true);
 
@@ -1071,6 +1408,13 @@ void
 GiftiMeshIO
 ::ReadCellData(void *buffer)
 {
+  if ( const char *cellData = this->WaitForDataArray(m_CellDataDataArray) )
+    {
+    memcpy(buffer, cellData, m_DataArrays[m_CellDataDataArray].m_NumberOfBytes);
+    this->ReleaseDataArray(m_CellDataDataArray);
+    return;
+    }
+
   // Get gifti image pointer
   m_GiftiImage = gifti_read_image(this->GetFileName(), true);
 
@@ -2053,10 +2397,101 @@ void
 GiftiMeshIO
 ::Write()
 {
-  gifti_write_image(m_GiftiImage, this->m_FileName.c_str(), 1);
+  try
+    {
+    if ( !this->WriteEncodedDataArrays() )
+      {
+      gifti_write_image(m_GiftiImage, this->m_FileName.c_str(), 1);
+      }
+    }
+  catch ( ExceptionObject & )
+    {
+    gifti_free_image( m_GiftiImage );
+    throw;
+    }
   gifti_free_image( m_GiftiImage );
 }
 
+bool
+GiftiMeshIO
+::WriteEncodedDataArrays()
+{
+  const int numberOfDataArrays = m_GiftiImage->numDA;
+  for ( int ii = 0; ii < numberOfDataArrays; ++ii )
+    {
+    const giiDataArray *da = m_GiftiImage->darray[ii];
+    if ( ( da->encoding != GIFTI_ENCODING_B64BIN && da->encoding != GIFTI_ENCODING_B64GZ )
+         || ( da->ext_fname != nullptr && *da->ext_fname != '\0' ) )
+      {
+      return false;
+      }
+    }
+
+  // The GIFTI library writes the values in the byte order of this CPU,
+  // compressed at its compression level
+  const int                  compressionLevel = gifti_get_zlevel();
+  std::vector< std::string > encoded(numberOfDataArrays);
+  std::vector< char >        compressed(numberOfDataArrays, 1);
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray( 0, numberOfDataArrays, [&]( SizeValueType ii )
+    {
+    const giiDataArray *  da = m_GiftiImage->darray[ii];
+    const unsigned char * values = static_cast< const unsigned char * >( da->data );
+    size_t                valuesSize = ( values != nullptr && da->nvals > 0 && da->nbyper > 0 )
+                                       ? static_cast< size_t >( da->nvals * da->nbyper ) : 0;
+
+    std::vector< unsigned char > compressedValues;
+    if ( da->encoding == GIFTI_ENCODING_B64GZ && valuesSize > 0 )
+      {
+      uLongf compressedSize = compressBound( static_cast< uLong >( valuesSize ) );
+      compressedValues.resize(compressedSize);
+      if ( compress2(compressedValues.data(), &compressedSize, values, static_cast< uLong >( valuesSize ),
+                     compressionLevel) != Z_OK )
+        {
+        compressed[ii] = 0;
+        return;
+        }
+      values = compressedValues.data();
+      valuesSize = compressedSize;
+      }
+
+    std::string & text = encoded[ii];
+    text.resize( ( valuesSize + 2 ) / 3 * 4 );
+    if ( valuesSize > 0 )
+      {
+      text.resize(itksysBase64_Encode(values, valuesSize, reinterpret_cast< unsigned char * >( &text[0] ), 0));
+      }
+    }, nullptr );
+  if ( std::find(compressed.begin(), compressed.end(), 0) != compressed.end() )
+    {
+    itkExceptionMacro(<< "Could not compress the data arrays of " << this->m_FileName);
+    }
+
+  // Write the document without the values, then fill its Data elements
+  std::string                                xml;
+  std::vector< std::pair< size_t, size_t > > contents;
+  if ( gifti_write_image(m_GiftiImage, this->m_FileName.c_str(), 0) != 0 || !ReadFile(this->m_FileName, xml)
+       || !FindDataElements(xml, contents) || contents.size() != static_cast< size_t >( numberOfDataArrays ) )
+    {
+    itkExceptionMacro(<< "Could not write " << this->m_FileName);
+    }
+
+  std::ofstream file(this->m_FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  size_t        written = 0;
+  for ( int ii = 0; ii < numberOfDataArrays; ++ii )
+    {
+    file.write(xml.data() + written, contents[ii].first - written);
+    file.write(encoded[ii].data(), encoded[ii].size());
+    written = contents[ii].first + contents[ii].second;
+    }
+  file.write(xml.data() + written, xml.size() - written);
+  if ( !file )
+    {
+    itkExceptionMacro(<< "Could not write " << this->m_FileName);
+    }
+  return true;
+}
+
 void
 GiftiMeshIO
 ::PrintSelf(std::ostream & os, Indent indent) const
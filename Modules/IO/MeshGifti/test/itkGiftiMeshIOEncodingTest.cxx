@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkByteSwapper.h"
+#include "itkGiftiMeshIO.h"
+#include "itkMesh.h"
+#include "itkMeshFileTestHelper.h"
+#include "itkTriangleCell.h"
+#include "itkTestingMacros.h"
+#include "itksys/Base64.h"
+
+// Write a surface with point data as GZipBase64Binary, Base64Binary and
+// ASCII data arrays and read it back, then read a hand written file with
+// big endian data arrays and Data elements in its comments and meta data.
+
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using MeshType = itk::Mesh< float, Dimension >;
+using ReaderType = itk::MeshFileReader< MeshType >;
+using WriterType = itk::MeshFileWriter< MeshType >;
+
+MeshType::Pointer
+MakeSurface(unsigned int columns, unsigned int rows)
+{
+  MeshType::Pointer mesh = MeshType::New();
+  for ( unsigned int row = 0; row < rows; ++row )
+    {
+    for ( unsigned int column = 0; column < columns; ++column )
+      {
+      const MeshType::PointIdentifier id = row * columns + column;
+      MeshType::PointType             point;
+      point[0] = 0.5f * column;
+      point[1] = 0.25f * row;
+      point[2] = std::sin( 0.1f * column ) * std::cos( 0.07f * row );
+      mesh->SetPoint(id, point);
+      // exactly written as ASCII
+      mesh->SetPointData(id, 0.25f * ( id % 97 ) - 0.125f * row);
+      }
+    }
+
+  using TriangleType = itk::TriangleCell< MeshType::CellType >;
+  MeshType::CellIdentifier cellId = 0;
+  for ( unsigned int row = 0; row + 1 < rows; ++row )
+    {
+    for ( unsigned int column = 0; column + 1 < columns; ++column )
+      {
+      const MeshType::PointIdentifier corner = row * columns + column;
+      const MeshType::PointIdentifier triangles[2][3] = { { corner, corner + 1, corner + columns },
+                                                          { corner + 1, corner + columns + 1, corner + columns } };
+      for ( const auto & triangle : triangles )
+        {
+        MeshType::CellAutoPointer cell;
+        cell.TakeOwnership(new TriangleType);
+        for ( unsigned int ii = 0; ii < 3; ++ii )
+          {
+          cell->SetPointId(ii, triangle[ii]);
+          }
+        mesh->SetCell(cellId++, cell);
+        }
+      }
+    }
+  return mesh;
+}
+
+MeshType::Pointer
+ReadSurface(const std::string & fileName)
+{
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetMeshIO(itk::GiftiMeshIO::New());
+  reader->SetFileName(fileName);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+int
+CompareSurfaces(MeshType * mesh, MeshType * readMesh)
+{
+  if ( TestPointsContainer< MeshType >( mesh->GetPoints(), readMesh->GetPoints() ) != EXIT_SUCCESS
+       || TestCellsContainer< MeshType >( mesh->GetCells(), readMesh->GetCells() ) != EXIT_SUCCESS
+       || TestPointDataContainer< MeshType >( mesh->GetPointData(), readMesh->GetPointData() ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
+
+template< typename T >
+std::string
+BigEndianBase64(std::vector< T > values)
+{
+  itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(values.data(), values.size());
+  const size_t size = values.size() * sizeof( T );
+  std::string  text( ( size + 2 ) / 3 * 4, '\0' );
+  text.resize(itksysBase64_Encode(reinterpret_cast< const unsigned char * >( values.data() ), size,
+                                  reinterpret_cast< unsigned char * >( &text[0] ), 0));
+  // line breaks are skipped
+  text.insert(text.size() / 2, "\n      ");
+  return text;
+}
+
+}
+
+int itkGiftiMeshIOEncodingTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkGiftiMeshIOEncodingTest";
+
+  itk::GiftiMeshIO::Pointer io = itk::GiftiMeshIO::New();
+  EXERCISE_BASIC_OBJECT_METHODS( io, GiftiMeshIO, MeshIOBase );
+
+  MeshType::Pointer mesh = MakeSurface(90, 70);
+
+  struct
+  {
+    const char * m_Name;
+    bool         m_Binary;
+    bool         m_UseCompression;
+  } encodings[] = { { "GZipBase64Binary", true, true },
+                    { "Base64Binary", true, false },
+                    { "ASCII", false, false } };
+  for ( const auto & encoding : encodings )
+    {
+    const std::string fileName = directory + encoding.m_Name + ".gii";
+    std::cout << fileName << std::endl;
+
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetMeshIO(itk::GiftiMeshIO::New());
+    if ( encoding.m_Binary )
+      {
+      writer->SetFileTypeAsBINARY();
+      }
+    writer->SetUseCompression(encoding.m_UseCompression);
+    writer->SetInput(mesh);
+    writer->SetFileName(fileName);
+    TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+    std::string xml;
+    std::ifstream file( fileName.c_str() );
+    xml.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+    TEST_EXPECT_TRUE( xml.find(std::string( "Encoding=\"" ) + encoding.m_Name + "\"") != std::string::npos );
+
+    MeshType::Pointer readMesh;
+    TRY_EXPECT_NO_EXCEPTION( readMesh = ReadSurface(fileName) );
+    if ( CompareSurfaces(mesh, readMesh) != EXIT_SUCCESS )
+      {
+      std::cerr << "Failure for " << encoding.m_Name << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Big endian data arrays, with the values on two lines
+  const std::vector< float >   points = { 0.0f, 0.0f, 0.0f, 1.5f, 0.0f, -2.0f, 0.0f, 2.5f, 3.0f, 1.0f, 1.0f, 1.0f };
+  const std::vector< int32_t > triangles = { 0, 1, 2, 1, 3, 2 };
+  const std::string            bigEndianFileName = directory + "BigEndian.gii";
+  {
+  std::ofstream file( bigEndianFileName.c_str() );
+  file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+       << "<GIFTI Version=\"1.0\" NumberOfDataArrays=\"2\">\n"
+       << "  <MetaData>\n"
+       << "    <MD>\n"
+       << "      <Name><![CDATA[Note]]></Name>\n"
+       << "      <Value><![CDATA[<Data>not a data array</Data>]]></Value>\n"
+       << "    </MD>\n"
+       << "  </MetaData>\n"
+       << "  <!-- <Data>nor is this</Data> -->\n"
+       << "  <DataArray Intent=\"NIFTI_INTENT_POINTSET\" DataType=\"NIFTI_TYPE_FLOAT32\""
+       << " ArrayIndexingOrder=\"RowMajorOrder\" Dimensionality=\"2\" Dim0=\"4\" Dim1=\"3\""
+       << " Encoding=\"Base64Binary\" Endian=\"BigEndian\" ExternalFileName=\"\" ExternalFileOffset=\"\">\n"
+       << "    <Data>\n      " << BigEndianBase64(points) << "\n    </Data>\n"
+       << "  </DataArray>\n"
+       << "  <DataArray Intent=\"NIFTI_INTENT_TRIANGLE\" DataType=\"NIFTI_TYPE_INT32\""
+       << " ArrayIndexingOrder=\"RowMajorOrder\" Dimensionality=\"2\" Dim0=\"2\" Dim1=\"3\""
+       << " Encoding=\"Base64Binary\" Endian=\"BigEndian\" ExternalFileName=\"\" ExternalFileOffset=\"\">\n"
+       << "    <Data>" << BigEndianBase64(triangles) << "</Data>\n"
+       << "  </DataArray>\n"
+       << "</GIFTI>\n";
+  }
+
+  MeshType::Pointer readMesh;
+  TRY_EXPECT_NO_EXCEPTION( readMesh = ReadSurface(bigEndianFileName) );
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfPoints(), 4 );
+  TEST_EXPECT_EQUAL( readMesh->GetNumberOfCells(), 2 );
+  for ( unsigned int id = 0; id < 4; ++id )
+    {
+    for ( unsigned int dd = 0; dd < Dimension; ++dd )
+      {
+      TEST_EXPECT_EQUAL( readMesh->GetPoint(id)[dd], points[id * Dimension + dd] );
+      }
+    }
+  for ( MeshType::CellIdentifier id = 0; id < 2; ++id )
+    {
+    MeshType::CellAutoPointer cell;
+    TEST_EXPECT_TRUE( readMesh->GetCell(id, cell) );
+    TEST_EXPECT_EQUAL( cell->GetNumberOfPoints(), 3 );
+    for ( unsigned int ii = 0; ii < 3; ++ii )
+      {
+      TEST_EXPECT_EQUAL( static_cast< int32_t >( cell->GetPointIds()[ii] ), triangles[id * 3 + ii] );
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
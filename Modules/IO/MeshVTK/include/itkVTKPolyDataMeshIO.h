@@ -25,7 +25,10 @@
 #include "itkVectorContainer.h"
 #include "itkNumberToString.h"
 
+#include <algorithm>
 #include <fstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace itk
@@ -33,6 +36,12 @@ namespace itk
 /** \class VTKPolyDataMeshIO
  * \brief This class defines how to read and write vtk legacy file format.
  *
+ * ReadMeshInformation locates the data of each section of the file, so
+ * that the Read methods seek straight to it. BINARY data are read in one
+ * block into the output buffer and byte swapped in place; ASCII data are
+ * read in one block and parsed without going through the stream locale.
+ * The ASCII output is formatted in memory and written in large blocks.
+ *
  * \author Wanlin Zhu. Uviversity of New South Wales, Australia.
  * \ingroup IOFilters
  * \ingroup ITKIOMeshVTK
@@ -168,47 +177,21 @@ protected:
     return;
   }
 
+  /** The Read*BufferAsASCII methods parse the text of a data section, as
+   * returned by ReadSectionText. Numbers are parsed without going through
+   * the stream locale. */
   template< typename T >
-  void ReadPointsBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadPointsBufferAsASCII(const std::string & text, T *buffer)
   {
-    std::string line;
-
-    while ( !inputFile.eof() )
-      {
-      std::getline(inputFile, line, '\n');
-
-      if ( line.find("POINTS") != std::string::npos )
-        {
-        /**  Load the point coordinates into the itk::Mesh */
-        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
-        }
-      }
+    this->ReadASCIIValues(text, buffer, this->m_NumberOfPoints * this->m_PointDimension, "POINTS");
   }
 
+  /** The Read*BufferAsBINARY methods expect the file to be positioned at
+   * the start of the data section. */
   template< typename T >
   void ReadPointsBufferAsBINARY(std::ifstream & inputFile, T *buffer)
   {
-    std::string line;
-
-    while ( !inputFile.eof() )
-      {
-      std::getline(inputFile, line, '\n');
-
-      if ( line.find("POINTS") != std::string::npos )
-        {
-        /**  Load the point coordinates into the itk::Mesh */
-        SizeValueType numberOfComponents = this->m_NumberOfPoints * this->m_PointDimension;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
-        }
-      }
+    this->ReadBINARYValues(inputFile, buffer, this->m_NumberOfPoints * this->m_PointDimension, "POINTS");
   }
 
   void ReadCellsBufferAsASCII(std::ifstream & inputFile, void *buffer);
@@ -216,207 +199,207 @@ protected:
   void ReadCellsBufferAsBINARY(std::ifstream & inputFile, void *buffer);
 
   template< typename T >
-  void ReadPointDataBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadPointDataBufferAsASCII(const std::string & text, T *buffer)
   {
-    StringType line;
-
-    while ( !inputFile.eof() )
-      {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("POINT_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
+    this->ReadASCIIValues(text, buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents,
+                          "POINT_DATA");
+  }
 
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
+  template< typename T >
+  void ReadPointDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
+  {
+    this->ReadBINARYValues(inputFile, buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents,
+                           "POINT_DATA");
+  }
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
-        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
-        }
-      }
+  template< typename T >
+  void ReadCellDataBufferAsASCII(const std::string & text, T *buffer)
+  {
+    this->ReadASCIIValues(text, buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents,
+                          "CELL_DATA");
   }
 
   template< typename T >
-  void ReadPointDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
+  void ReadCellDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
   {
-    StringType line;
+    this->ReadBINARYValues(inputFile, buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents,
+                           "CELL_DATA");
+  }
 
-    while ( !inputFile.eof() )
+  template< typename T >
+  void ReadASCIIValues(const std::string & text, T *buffer, SizeValueType numberOfValues, const char *sectionName)
+  {
+    const char *cursor = text.data();
+    const char *end = cursor + text.size();
+    for ( SizeValueType ii = 0; ii < numberOfValues; ii++ )
       {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("POINT_DATA") != std::string::npos )
+      if ( !ParseASCIIValue(cursor, end, buffer[ii]) )
         {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
-
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
+        itkExceptionMacro(<< "Failed to read value " << ii << " of " << numberOfValues << " of " << sectionName
+                          << " in " << this->m_FileName);
         }
       }
   }
 
+  /** Read big endian values straight into the buffer and swap them in place. */
   template< typename T >
-  void ReadCellDataBufferAsASCII(std::ifstream & inputFile, T *buffer)
+  void ReadBINARYValues(std::ifstream & inputFile, T *buffer, SizeValueType numberOfValues, const char *sectionName)
   {
-    StringType line;
+    const auto numberOfBytes = static_cast< std::streamsize >( numberOfValues * sizeof( T ) );
+    inputFile.read(reinterpret_cast< char * >( buffer ), numberOfBytes);
+    if ( inputFile.gcount() != numberOfBytes )
+      {
+      itkExceptionMacro(<< "Unexpected end of file while reading " << sectionName << " in " << this->m_FileName);
+      }
+    if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
+      {
+      itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfValues);
+      }
+  }
 
-    while ( !inputFile.eof() )
+  /** Parse the next whitespace separated number of [cursor, end) and move
+   * cursor past it. Returns false if there is no number left. Integers
+   * are parsed here, floating point values with the double-conversion
+   * library; neither depends on the global locale. */
+  template< typename T >
+  static bool ParseASCIIValue(const char * & cursor, const char *end, T & value)
+  {
+    while ( cursor != end && IsASCIISpace(*cursor) )
       {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("CELL_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read CELL_DATA");
-          }
+      ++cursor;
+      }
+    bool negative = false;
+    if ( cursor != end && ( *cursor == '-' || *cursor == '+' ) )
+      {
+      negative = ( *cursor == '-' );
+      ++cursor;
+      }
+    if ( cursor == end || *cursor < '0' || *cursor > '9' )
+      {
+      return false;
+      }
+    unsigned long long magnitude = 0;
+    while ( cursor != end && *cursor >= '0' && *cursor <= '9' )
+      {
+      magnitude = magnitude * 10 + static_cast< unsigned long long >( *cursor - '0' );
+      ++cursor;
+      }
+    if ( cursor != end && !IsASCIISpace(*cursor) )
+      {
+      return false;
+      }
+    value = static_cast< T >( negative ? 0ULL - magnitude : magnitude );
+    return true;
+  }
 
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
+  static bool ParseASCIIValue(const char * & cursor, const char *end, float & value);
 
-        /** for VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
-        for ( SizeValueType ii = 0; ii < numberOfComponents; ii++ )
-          {
-          inputFile >> buffer[ii];
-          }
-        }
+  static bool ParseASCIIValue(const char * & cursor, const char *end, double & value);
+
+  static bool ParseASCIIValue(const char * & cursor, const char *end, long double & value);
+
+  static bool IsASCIISpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+  }
+
+  /** Append the text of a value to the ASCII output: integers are
+   * formatted here, floating point values with NumberToString. */
+  template< typename T >
+  static void AppendASCIIValue(StringType & text, T value)
+  {
+    AppendASCIIValue(text, value, std::is_integral< T >());
+  }
+
+  template< typename T >
+  static void AppendASCIIValue(StringType & text, T value, std::true_type)
+  {
+    using UnsignedType = typename std::make_unsigned< T >::type;
+    const bool   negative = NumericTraits< T >::IsNegative(value);
+    UnsignedType magnitude = negative ? static_cast< UnsignedType >( 0 - static_cast< UnsignedType >( value ) )
+                                      : static_cast< UnsignedType >( value );
+    char  digits[24];
+    char *first = digits + sizeof( digits );
+    do
+      {
+      *--first = static_cast< char >( '0' + magnitude % 10 );
+      magnitude /= 10;
       }
+    while ( magnitude );
+    if ( negative )
+      {
+      *--first = '-';
+      }
+    text.append(first, digits + sizeof( digits ));
   }
 
   template< typename T >
-  void ReadCellDataBufferAsBINARY(std::ifstream & inputFile, T *buffer)
+  static void AppendASCIIValue(StringType & text, T value, std::false_type)
   {
-    StringType line;
+    NumberToString< T > convert;
+    text += convert(value);
+  }
+
+  /** The ASCII output is built in memory and written to the file in
+   * blocks of about this many bytes; the BINARY output is swapped in
+   * blocks of this size. */
+  static constexpr std::size_t IOBlockSize = 1 << 20;
 
-    while ( !inputFile.eof() )
+  static void FlushASCIIText(std::ofstream & outputFile, StringType & text, bool force = false)
+  {
+    if ( force || text.size() >= IOBlockSize )
       {
-      std::getline(inputFile, line, '\n');
-      if ( line.find("POINT_DATA") != std::string::npos )
-        {
-        if ( !inputFile.eof() )
-          {
-          std::getline(inputFile, line, '\n');
-          }
-        else
-          {
-          itkExceptionMacro("UnExpected end of line while trying to read POINT_DATA");
-          }
+      outputFile.write(text.data(), static_cast< std::streamsize >( text.size() ));
+      text.clear();
+      }
+  }
 
-        /** For scalars we have to read the next line of LOOKUP_TABLE */
-        if ( line.find("SCALARS") != std::string::npos && line.find("COLOR_SCALARS") == std::string::npos )
-          {
-          if ( !inputFile.eof() )
-            {
-            std::getline(inputFile, line, '\n');
-            if ( line.find("LOOKUP_TABLE") == std::string::npos )
-              {
-              itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-              }
-            }
-          else
-            {
-            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
-            }
-          }
-        /** For VECTORS or NORMALS or TENSORS, we could read them directly */
-        SizeValueType numberOfComponents = this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents;
-        inputFile.read( reinterpret_cast< char * >( buffer ), numberOfComponents * sizeof( T ) );
-        if ( itk::ByteSwapper< T >::SystemIsLittleEndian() )
-          {
-          itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(buffer, numberOfComponents);
-          }
-        }
+  /** Swap values to big endian in blocks and write them. Unlike
+   * ByteSwapper::SwapWriteRangeFromSystemToBigEndian, this writes one
+   * byte values too and does not limit the number of values to an int. */
+  template< typename T >
+  static void WriteBINARYValues(std::ofstream & outputFile, const T *buffer, SizeValueType numberOfValues)
+  {
+    if ( !itk::ByteSwapper< T >::SystemIsLittleEndian() || sizeof( T ) == 1 )
+      {
+      outputFile.write(reinterpret_cast< const char * >( buffer ),
+                       static_cast< std::streamsize >( numberOfValues * sizeof( T ) ));
+      return;
+      }
+    const SizeValueType blockSize = IOBlockSize / sizeof( T );
+    std::vector< T >    block( std::min(blockSize, numberOfValues) );
+    for ( SizeValueType first = 0; first < numberOfValues; first += blockSize )
+      {
+      const SizeValueType count = std::min(blockSize, numberOfValues - first);
+      std::copy(buffer + first, buffer + first + count, block.begin());
+      itk::ByteSwapper< T >::SwapRangeFromSystemToBigEndian(block.data(), count);
+      outputFile.write(reinterpret_cast< const char * >( block.data() ),
+                       static_cast< std::streamsize >( count * sizeof( T ) ));
       }
   }
 
   template< typename T >
   void WritePointsBufferAsASCII(std::ofstream & outputFile, T *buffer, const StringType & pointComponentType)
   {
-    NumberToString<T> convert;
     /** 1. Write number of points */
     outputFile << "POINTS " << this->m_NumberOfPoints;
 
     outputFile << pointComponentType << '\n';
+    StringType text;
+    text.reserve(IOBlockSize + 256);
     for ( SizeValueType ii = 0; ii < this->m_NumberOfPoints; ii++ )
       {
       for ( unsigned int jj = 0; jj < this->m_PointDimension - 1; jj++ )
         {
-        outputFile << convert(buffer[ii * this->m_PointDimension + jj]) << " ";
+        AppendASCIIValue(text, buffer[ii * this->m_PointDimension + jj]);
+        text += ' ';
         }
 
-      outputFile << convert(buffer[ii * this->m_PointDimension + this->m_PointDimension - 1]) << '\n';
+      AppendASCIIValue(text, buffer[ii * this->m_PointDimension + this->m_PointDimension - 1]);
+      text += '\n';
+      FlushASCIIText(outputFile, text);
       }
+    FlushASCIIText(outputFile, text, true);
 
     return;
   }
@@ -427,7 +410,7 @@ protected:
     /** 1. Write number of points */
     outputFile << "POINTS " << this->m_NumberOfPoints;
     outputFile << pointComponentType << "\n";
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer, this->m_NumberOfPoints * this->m_PointDimension, &outputFile);
+    WriteBINARYValues(outputFile, buffer, this->m_NumberOfPoints * this->m_PointDimension);
     outputFile << "\n";
 
     return;
@@ -443,6 +426,8 @@ protected:
     unsigned int         numberOfLineIndices = 0;
     unsigned int         numberOfPolygons = 0;
     unsigned int         numberOfPolygonIndices = 0;
+    StringType           text;
+    text.reserve(IOBlockSize + 256);
 
     /** Write vertices */
     SizeValueType index = 0;
@@ -458,18 +443,21 @@ protected:
         auto nn = static_cast< unsigned int >( buffer[index++] );
         if ( cellType == VERTEX_CELL )
           {
-          outputFile << nn;
+          AppendASCIIValue(text, nn);
           for ( unsigned int jj = 0; jj < nn; jj++ )
             {
-            outputFile << " " << buffer[index++];
+            text += ' ';
+            AppendASCIIValue(text, static_cast< SizeValueType >( buffer[index++] ));
             }
-          outputFile << '\n';
+          text += '\n';
+          FlushASCIIText(outputFile, text);
           }
         else
           {
           index += nn;
           }
         }
+      FlushASCIIText(outputFile, text, true);
       }
 
     /** Write lines */
@@ -533,13 +521,16 @@ protected:
       for ( SizeValueType ii = 0; ii < polylines->Size(); ++ii )
         {
         auto nn = static_cast<unsigned int>( polylines->ElementAt(ii).size() );
-        outputFile << nn;
+        AppendASCIIValue(text, nn);
         for ( unsigned int jj = 0; jj < nn; ++jj )
           {
-          outputFile << " " << polylines->ElementAt(ii)[jj];
+          text += ' ';
+          AppendASCIIValue(text, polylines->ElementAt(ii)[jj]);
           }
-        outputFile << '\n';
+        text += '\n';
+        FlushASCIIText(outputFile, text);
         }
+      FlushASCIIText(outputFile, text, true);
       }
 
     /** Write polygons */
@@ -557,18 +548,21 @@ protected:
              cellType == TRIANGLE_CELL ||
              cellType == QUADRILATERAL_CELL )
           {
-          outputFile << nn;
+          AppendASCIIValue(text, nn);
           for ( unsigned int jj = 0; jj < nn; jj++ )
             {
-            outputFile << " " << buffer[index++];
+            text += ' ';
+            AppendASCIIValue(text, static_cast< SizeValueType >( buffer[index++] ));
             }
-          outputFile << '\n';
+          text += '\n';
+          FlushASCIIText(outputFile, text);
           }
         else
           {
           index += nn;
           }
         }
+      FlushASCIIText(outputFile, text, true);
       }
   }
 
@@ -591,11 +585,11 @@ protected:
       {
       ExposeMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
       outputFile << "VERTICES " << numberOfVertices << " " << numberOfVertexIndices << '\n';
-      auto * data = new unsigned int[numberOfVertexIndices];
-      ReadCellsBuffer(buffer, data);
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfVertexIndices, &outputFile);
+      std::vector< unsigned int > data;
+      data.reserve(numberOfVertexIndices);
+      this->GatherCellsBuffer(buffer, false, data);
+      WriteBINARYValues(outputFile, data.data(), data.size());
       outputFile << "\n";
-      delete[] data;
       }
 
     /** Write lines */
@@ -669,7 +663,7 @@ protected:
           }
         }
 
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfLineIndices, &outputFile);
+      WriteBINARYValues(outputFile, data, numberOfLineIndices);
       outputFile << "\n";
       delete[] data;
       }
@@ -681,18 +675,17 @@ protected:
       {
       ExposeMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
       outputFile << "POLYGONS " << numberOfPolygons << " " << numberOfPolygonIndices << '\n';
-      auto * data = new unsigned int[numberOfPolygonIndices];
-      ReadCellsBuffer(buffer, data);
-      itk::ByteSwapper< unsigned int >::SwapWriteRangeFromSystemToBigEndian(data, numberOfPolygonIndices, &outputFile);
+      std::vector< unsigned int > data;
+      data.reserve(numberOfPolygonIndices);
+      this->GatherCellsBuffer(buffer, true, data);
+      WriteBINARYValues(outputFile, data.data(), data.size());
       outputFile << "\n";
-      delete[] data;
       }
   }
 
   template< typename T >
   void WritePointDataBufferAsASCII(std::ofstream & outputFile, T *buffer, const StringType & pointPixelComponentName)
   {
-    NumberToString<T>    convert;
     MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
     StringType           dataName;
 
@@ -746,7 +739,8 @@ protected:
       outputFile << "LOOKUP_TABLE default" << '\n';
       }
 
-    Indent indent(2);
+    StringType text;
+    text.reserve(IOBlockSize + 256);
     if ( this->m_PointPixelType == SYMMETRICSECONDRANKTENSOR )
       {
       T *ptr = buffer;
@@ -761,17 +755,29 @@ protected:
         while( i < num )
           {
           // row 1
-          outputFile << convert(*ptr++) << indent;
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e12 = *ptr++;
-          outputFile << convert(e12) << indent;
-          outputFile << convert(zero) << '\n';
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += '\n';
           // row 2
-          outputFile << convert(e12) << indent;
-          outputFile << convert(*ptr++) << indent;
-          outputFile << convert(zero) << '\n';
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += '\n';
           // row 3
-          outputFile << convert(zero) << indent << convert(zero) << indent << convert(zero) << "\n\n";
+          AppendASCIIValue(text, zero);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += "\n\n";
           i += 3;
+          FlushASCIIText(outputFile, text);
           }
         }
       else if( this->m_NumberOfPointPixelComponents == 6 )
@@ -782,21 +788,31 @@ protected:
         while( i < num )
           {
           // row 1
-          outputFile << convert(*ptr++) << indent;
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e12 = *ptr++;
-          outputFile << convert(e12) << indent;
+          AppendASCIIValue(text, e12);
+          text += "  ";
           e13 = *ptr++;
-          outputFile << convert(e13) << '\n';
+          AppendASCIIValue(text, e13);
+          text += '\n';
           // row 2
-          outputFile << convert(e12) << indent;
-          outputFile << convert(*ptr++) << indent;
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e23 = *ptr++;
-          outputFile << convert(e23) << '\n';
+          AppendASCIIValue(text, e23);
+          text += '\n';
           // row 3
-          outputFile << convert(e13) << indent;
-          outputFile << convert(e23) << indent;
-          outputFile << convert(*ptr++) << "\n\n";
+          AppendASCIIValue(text, e13);
+          text += "  ";
+          AppendASCIIValue(text, e23);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "\n\n";
           i += 6;
+          FlushASCIIText(outputFile, text);
           }
         }
       else
@@ -814,13 +830,16 @@ protected:
         {
         for ( jj = 0; jj < this->m_NumberOfPointPixelComponents - 1; jj++ )
           {
-          outputFile << convert(buffer[ii * this->m_NumberOfPointPixelComponents + jj]) << indent;
+          AppendASCIIValue(text, buffer[ii * this->m_NumberOfPointPixelComponents + jj]);
+          text += "  ";
           }
-        outputFile << convert(buffer[ii * this->m_NumberOfPointPixelComponents + jj]);
-        outputFile << '\n';
+        AppendASCIIValue(text, buffer[ii * this->m_NumberOfPointPixelComponents + jj]);
+        text += '\n';
+        FlushASCIIText(outputFile, text);
         }
       }
 
+    FlushASCIIText(outputFile, text, true);
     return;
   }
 
@@ -879,9 +898,7 @@ protected:
       outputFile << "LOOKUP_TABLE default\n";
       }
 
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer,
-                                                               this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents,
-                                                               &outputFile);
+    WriteBINARYValues(outputFile, buffer, this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents);
     outputFile << "\n";
     return;
   }
@@ -941,7 +958,8 @@ protected:
       outputFile << "LOOKUP_TABLE default" << '\n';
       }
 
-    Indent indent(2);
+    StringType text;
+    text.reserve(IOBlockSize + 256);
     if ( this->m_CellPixelType == SYMMETRICSECONDRANKTENSOR )
       {
       T *ptr = buffer;
@@ -954,17 +972,29 @@ protected:
         while( i < num )
           {
           // row 1
-          outputFile << *ptr++ << indent;
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e12 = *ptr++;
-          outputFile << e12 << indent;
-          outputFile << zero << '\n';
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += '\n';
           // row 2
-          outputFile << e12 << indent;
-          outputFile << *ptr++ << indent;
-          outputFile << zero << '\n';
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += '\n';
           // row 3
-          outputFile << zero << indent << zero << indent << zero << "\n\n";
+          AppendASCIIValue(text, zero);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += "  ";
+          AppendASCIIValue(text, zero);
+          text += "\n\n";
           i += 3;
+          FlushASCIIText(outputFile, text);
           }
         }
       else if( this->m_NumberOfCellPixelComponents == 3 )
@@ -975,21 +1005,31 @@ protected:
         while( i < num )
           {
           // row 1
-          outputFile << *ptr++ << indent;
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e12 = *ptr++;
-          outputFile << e12 << indent;
+          AppendASCIIValue(text, e12);
+          text += "  ";
           e13 = *ptr++;
-          outputFile << e13 << '\n';
+          AppendASCIIValue(text, e13);
+          text += '\n';
           // row 2
-          outputFile << e12 << indent;
-          outputFile << *ptr++ << indent;
+          AppendASCIIValue(text, e12);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "  ";
           e23 = *ptr++;
-          outputFile << e23 << '\n';
+          AppendASCIIValue(text, e23);
+          text += '\n';
           // row 3
-          outputFile << e13 << indent;
-          outputFile << e23 << indent;
-          outputFile << *ptr++ << "\n\n";
+          AppendASCIIValue(text, e13);
+          text += "  ";
+          AppendASCIIValue(text, e23);
+          text += "  ";
+          AppendASCIIValue(text, *ptr++);
+          text += "\n\n";
           i += 6;
+          FlushASCIIText(outputFile, text);
           }
         }
       else
@@ -1007,13 +1047,16 @@ protected:
         {
         for ( jj = 0; jj < this->m_NumberOfCellPixelComponents - 1; jj++ )
           {
-          outputFile << buffer[ii * this->m_NumberOfCellPixelComponents + jj] << indent;
+          AppendASCIIValue(text, buffer[ii * this->m_NumberOfCellPixelComponents + jj]);
+          text += "  ";
           }
-        outputFile << buffer[ii * this->m_NumberOfCellPixelComponents + jj];
-        outputFile << '\n';
+        AppendASCIIValue(text, buffer[ii * this->m_NumberOfCellPixelComponents + jj]);
+        text += '\n';
+        FlushASCIIText(outputFile, text);
         }
       }
 
+    FlushASCIIText(outputFile, text, true);
     return;
   }
 
@@ -1072,9 +1115,7 @@ protected:
       outputFile << "LOOKUP_TABLE default\n";
       }
 
-    itk::ByteSwapper< T >::SwapWriteRangeFromSystemToBigEndian(buffer,
-                                                               this->m_NumberOfCells * this->m_NumberOfCellPixelComponents,
-                                                               &outputFile);
+    WriteBINARYValues(outputFile, buffer, this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents);
     outputFile << "\n";
     return;
   }
@@ -1085,18 +1126,21 @@ protected:
                                      unsigned int numberOfPixelComponents,
                                      SizeValueType numberOfPixels)
   {
-    NumberToString<float> convert;
     outputFile << numberOfPixelComponents << "\n";
-    Indent indent(2);
+    StringType text;
+    text.reserve(IOBlockSize + 256);
     for ( SizeValueType ii = 0; ii < numberOfPixels; ++ii )
       {
       for ( unsigned int jj = 0; jj < numberOfPixelComponents; ++jj )
         {
-        outputFile << convert(static_cast< float >( buffer[ii * numberOfPixelComponents + jj])) << indent;
+        AppendASCIIValue(text, static_cast< float >( buffer[ii * numberOfPixelComponents + jj] ));
+        text += "  ";
         }
 
-      outputFile << "\n";
+      text += "\n";
+      FlushASCIIText(outputFile, text);
       }
+    FlushASCIIText(outputFile, text, true);
 
     return;
   }
@@ -1122,6 +1166,33 @@ protected:
     return;
   }
 
+  /** Gather the number of points and the point ids of the vertex cells,
+   * or of the polygon cells, in the layout of the VTK file. */
+  template< typename T >
+  void GatherCellsBuffer(const T *buffer, bool polygons, std::vector< unsigned int > & data)
+  {
+    SizeValueType index = 0;
+
+    for ( SizeValueType ii = 0; ii < this->m_NumberOfCells; ii++ )
+      {
+      auto cellType = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
+      auto nn = static_cast< unsigned int >( buffer[index++] );
+      const bool selected = polygons ? ( cellType == POLYGON_CELL ||
+                                         cellType == TRIANGLE_CELL ||
+                                         cellType == QUADRILATERAL_CELL )
+                                     : cellType == VERTEX_CELL;
+      if ( selected )
+        {
+        data.push_back(nn);
+        for ( unsigned int jj = 0; jj < nn; jj++ )
+          {
+          data.push_back( static_cast< unsigned int >( buffer[index + jj] ) );
+          }
+        }
+      index += nn;
+      }
+  }
+
   /** Convert cells buffer for output cells buffer, it's user's responsibility to make sure
   the input cells don't contain any cell type that coule not be written as polygon cell */
   template< typename TInput, typename TOutput >
@@ -1147,6 +1218,42 @@ protected:
 
   /** Convenience method returns the IOComponentType corresponding to a string. */
   IOComponentType GetComponentTypeFromString(const std::string & pixelType);
+
+  /** Byte range of the data of a section of the file. */
+  struct DataSection
+  {
+    std::streamoff m_Begin{ -1 };
+    std::streamoff m_End{ -1 };
+  };
+
+  /** A section of vertices, lines or polygons. */
+  struct CellSection
+  {
+    DataSection      m_Data;
+    CellGeometryType m_CellType;
+    unsigned int     m_NumberOfCells;
+    unsigned int     m_NumberOfIndices;
+  };
+
+  /** The cell sections of the file, in the order of the file. */
+  std::vector< CellSection > GetCellSections() const;
+
+  /** Open the file, positioned at the start of the section. Returns false
+   * if the file has no such section. */
+  bool OpenFileAtSection(std::ifstream & inputFile, const DataSection & section);
+
+  /** Read the text of a section of an ASCII file in a single read. */
+  std::string ReadSectionText(std::ifstream & inputFile, const DataSection & section);
+
+private:
+  /** Found by ReadMeshInformation, so that the Read methods seek straight
+   * to the data they load instead of scanning the file line by line. */
+  DataSection m_PointsSection;
+  DataSection m_VerticesSection;
+  DataSection m_LinesSection;
+  DataSection m_PolygonsSection;
+  DataSection m_PointDataSection;
+  DataSection m_CellDataSection;
 };
 } // end namespace itk
 
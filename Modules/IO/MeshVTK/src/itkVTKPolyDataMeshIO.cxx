@@ -17,9 +17,59 @@
  *=========================================================================*/
 
 #include "itkVTKPolyDataMeshIO.h"
+#include "double-conversion/double-conversion.h"
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <limits>
+
+namespace
+{
+// Recognize the spellings of the special values written by VTK ("nan",
+// "inf") and by NumberToString ("NaN", "Infinity"), with any case.
+bool
+ParseSpecialValue(const char *token, int length, double & value)
+{
+  bool negative = false;
+  if ( length > 0 && ( *token == '-' || *token == '+' ) )
+    {
+    negative = ( *token == '-' );
+    ++token;
+    --length;
+    }
+  if ( length != 3 && length != 8 )
+    {
+    return false;
+    }
+
+  char lower[8];
+  for ( int ii = 0; ii < length; ++ii )
+    {
+    lower[ii] = ( token[ii] >= 'A' && token[ii] <= 'Z' ) ? static_cast< char >( token[ii] - 'A' + 'a' ) : token[ii];
+    }
+  const std::string word(lower, length);
+  if ( word == "nan" )
+    {
+    value = std::numeric_limits< double >::quiet_NaN();
+    return true;
+    }
+  if ( word == "inf" || word == "infinity" )
+    {
+    value = negative ? -std::numeric_limits< double >::infinity() : std::numeric_limits< double >::infinity();
+    return true;
+    }
+  return false;
+}
+
+const double_conversion::StringToDoubleConverter &
+GetStringToDoubleConverter()
+{
+  static const double_conversion::StringToDoubleConverter converter(
+    double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, std::numeric_limits< double >::quiet_NaN(), nullptr,
+    nullptr);
+  return converter;
+}
+}
 
 namespace itk
 {
@@ -140,23 +190,20 @@ void
 VTKPolyDataMeshIO
 ::ReadMeshInformation()
 {
+  // The file is opened in binary mode in both cases, so that the offsets
+  // of the sections are byte offsets
   std::ifstream inputFile;
-
-  // Use default filetype
-  if ( this->m_FileType == ASCII )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-    }
+  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
 
   if ( !inputFile.is_open() )
     {
     itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
     }
 
+  inputFile.seekg(0, std::ios::end);
+  const std::streamoff fileSize = inputFile.tellg();
+  inputFile.seekg(0, std::ios::beg);
+
   unsigned int numLine = 0;
   std::string line;
 
@@ -169,33 +216,11 @@ VTKPolyDataMeshIO
 
   if ( line.find("ASCII") != std::string::npos )
     {
-    if ( this->m_FileType != ASCII )
-      {
-      this->m_FileType = ASCII;
-#ifdef _WIN32
-      inputFile.close();
-      inputFile.open(this->m_FileName.c_str(), std::ios::in);
-      if ( !inputFile.is_open() )
-        {
-        itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-        }
-#endif
-      }
+    this->m_FileType = ASCII;
     }
   else if ( line.find("BINARY") != std::string::npos )
     {
-    if ( this->m_FileType != BINARY )
-      {
-      this->m_FileType = BINARY;
-#ifdef _WIN32
-      inputFile.close();
-      inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-      if ( !inputFile.is_open() )
-        {
-        itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
-        }
-#endif
-      }
+    this->m_FileType = BINARY;
     }
   else
     {
@@ -208,16 +233,60 @@ VTKPolyDataMeshIO
   this->m_CellBufferSize = itk::NumericTraits<SizeValueType>::ZeroValue();
   MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
 
+  this->m_PointsSection = DataSection();
+  this->m_VerticesSection = DataSection();
+  this->m_LinesSection = DataSection();
+  this->m_PolygonsSection = DataSection();
+  this->m_PointDataSection = DataSection();
+  this->m_CellDataSection = DataSection();
+
+  // The data of a BINARY section are skipped, knowing their size from
+  // the section header. An ASCII section ends where the next one starts.
+  DataSection *openSection = nullptr;
+  const auto position = [&inputFile, fileSize]() -> std::streamoff
+    {
+    return inputFile.eof() ? fileSize : static_cast< std::streamoff >( inputFile.tellg() );
+    };
+  const auto endOpenSection = [&]()
+    {
+    if ( openSection )
+      {
+      openSection->m_End = position() - static_cast< std::streamoff >( line.size() ) - ( inputFile.eof() ? 0 : 1 );
+      openSection = nullptr;
+      }
+    };
+  const auto beginSection = [&](DataSection & section, SizeValueType numberOfValues, IOComponentType componentType)
+    {
+    section.m_Begin = position();
+    if ( this->m_FileType == BINARY )
+      {
+      section.m_End = section.m_Begin
+                      + static_cast< std::streamoff >( numberOfValues * this->GetComponentSize(componentType) );
+      inputFile.seekg(section.m_End);
+      }
+    else
+      {
+      openSection = &section;
+      }
+    };
+
   // Searching the vtk file
-  while ( !inputFile.eof() )
+  while ( std::getline(inputFile, line, '\n') )
     {
-    //  Read lines from input file
-    std::getline(inputFile, line, '\n');
+    // Data lines start with a number, section headers with a keyword
+    const std::string::size_type first = line.find_first_not_of(" \t\r");
+    if ( first == std::string::npos || line[first] < 'A' || line[first] > 'Z' )
+      {
+      continue;
+      }
+
     StringType item;
 
     //  If there are points
     if ( line.find("POINTS") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType ss;
       ss << line;
@@ -239,9 +308,13 @@ VTKPolyDataMeshIO
         }
 
       this->m_UpdatePoints = true;
+      beginSection(this->m_PointsSection, this->m_NumberOfPoints * this->m_PointDimension,
+                   this->m_PointComponentType);
       }
     else if ( line.find("VERTICES") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType ss;
       ss << line;
@@ -276,9 +349,12 @@ VTKPolyDataMeshIO
       // Set cell component type
       this->m_CellComponentType = UINT;
       this->m_UpdateCells = true;
+      beginSection(this->m_VerticesSection, numberOfVertexIndices, UINT);
       }
     else if ( line.find("LINES") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType ss;
       ss << line;
@@ -313,9 +389,12 @@ VTKPolyDataMeshIO
       // Set cell component type
       this->m_CellComponentType = UINT;
       this->m_UpdateCells = true;
+      beginSection(this->m_LinesSection, numberOfLineIndices, UINT);
       }
     else if ( line.find("POLYGONS") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType ss;
       ss << line;
@@ -350,9 +429,12 @@ VTKPolyDataMeshIO
       // Set cell component type
       this->m_CellComponentType = UINT;
       this->m_UpdateCells = true;
+      beginSection(this->m_PolygonsSection, numberOfPolygonIndices, UINT);
       }
     else if ( line.find("POINT_DATA") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType pdss;
       pdss << line;
@@ -404,6 +486,12 @@ VTKPolyDataMeshIO
           this->m_PointPixelType  = SCALAR;
           this->m_NumberOfPointPixelComponents = itk::NumericTraits< unsigned int >::OneValue();
           this->m_UpdatePointData = true;
+
+          // The data follow the LOOKUP_TABLE line
+          if ( !std::getline(inputFile, line, '\n') || line.find("LOOKUP_TABLE") == std::string::npos )
+            {
+            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
+            }
           }
         }
 
@@ -485,9 +573,15 @@ VTKPolyDataMeshIO
         this->m_NumberOfPointPixelComponents = this->m_PointDimension * ( this->m_PointDimension + 1 ) / 2;
         this->m_UpdatePointData = true;
         }
+
+      beginSection(this->m_PointDataSection,
+                   this->m_NumberOfPointPixels * this->m_NumberOfPointPixelComponents,
+                   this->m_PointPixelComponentType);
       }
     else if ( line.find("CELL_DATA") != std::string::npos )
       {
+      endOpenSection();
+
       // define string stream and put line into it
       StringStreamType cdss;
       cdss << line;
@@ -539,6 +633,12 @@ VTKPolyDataMeshIO
           this->m_CellPixelType  = SCALAR;
           this->m_NumberOfCellPixelComponents = itk::NumericTraits< unsigned int >::OneValue();
           this->m_UpdateCellData = true;
+
+          // The data follow the LOOKUP_TABLE line
+          if ( !std::getline(inputFile, line, '\n') || line.find("LOOKUP_TABLE") == std::string::npos )
+            {
+            itkExceptionMacro("UnExpected end of line while trying to read LOOKUP_TABLE");
+            }
           }
         }
       if ( line.find("COLOR_SCALARS") != std::string::npos )
@@ -618,9 +718,18 @@ VTKPolyDataMeshIO
         this->m_NumberOfCellPixelComponents = this->m_PointDimension * ( this->m_PointDimension + 1 ) / 2;
         this->m_UpdateCellData = true;
         }
+
+      beginSection(this->m_CellDataSection,
+                   this->m_NumberOfCellPixels * this->m_NumberOfCellPixelComponents,
+                   this->m_CellPixelComponentType);
       }
     }
 
+  if ( openSection )
+    {
+    openSection->m_End = fileSize;
+    }
+
   if ( this->m_CellBufferSize )
     {
     this->m_CellBufferSize += this->m_NumberOfCells;
@@ -696,32 +805,160 @@ case LDOUBLE:                                                       \
   break;                                                            \
   }
 
-void
+bool
 VTKPolyDataMeshIO
-::ReadPoints(void *buffer)
+::ParseASCIIValue(const char * & cursor, const char *end, double & value)
 {
-  std::ifstream inputFile;
+  while ( cursor != end && IsASCIISpace(*cursor) )
+    {
+    ++cursor;
+    }
+  const char *token = cursor;
+  while ( cursor != end && !IsASCIISpace(*cursor) )
+    {
+    ++cursor;
+    }
+  const auto length = static_cast< int >( cursor - token );
+  if ( length == 0 )
+    {
+    return false;
+    }
 
-  if ( this->m_FileType == ASCII )
+  int processed = 0;
+  value = GetStringToDoubleConverter().StringToDouble(token, length, &processed);
+  return processed == length || ParseSpecialValue(token, length, value);
+}
+
+bool
+VTKPolyDataMeshIO
+::ParseASCIIValue(const char * & cursor, const char *end, float & value)
+{
+  while ( cursor != end && IsASCIISpace(*cursor) )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
+    ++cursor;
     }
-  else if ( m_FileType == BINARY )
+  const char *token = cursor;
+  while ( cursor != end && !IsASCIISpace(*cursor) )
+    {
+    ++cursor;
+    }
+  const auto length = static_cast< int >( cursor - token );
+  if ( length == 0 )
+    {
+    return false;
+    }
+
+  int processed = 0;
+  value = GetStringToDoubleConverter().StringToFloat(token, length, &processed);
+  if ( processed == length )
+    {
+    return true;
+    }
+  double special;
+  if ( ParseSpecialValue(token, length, special) )
+    {
+    value = static_cast< float >( special );
+    return true;
+    }
+  return false;
+}
+
+bool
+VTKPolyDataMeshIO
+::ParseASCIIValue(const char * & cursor, const char *end, long double & value)
+{
+  double doubleValue;
+  if ( !ParseASCIIValue(cursor, end, doubleValue) )
+    {
+    return false;
+    }
+  value = doubleValue;
+  return true;
+}
+
+bool
+VTKPolyDataMeshIO
+::OpenFileAtSection(std::ifstream & inputFile, const DataSection & section)
+{
+  if ( section.m_Begin < 0 )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
+    return false;
     }
 
+  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   if ( !inputFile.is_open() )
     {
-    itkExceptionMacro("Unable to open file\n" "inputFilename= " << this->m_FileName);
+    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
     }
 
+  inputFile.seekg(section.m_Begin);
+  return true;
+}
+
+std::string
+VTKPolyDataMeshIO
+::ReadSectionText(std::ifstream & inputFile, const DataSection & section)
+{
+  std::string text( static_cast< std::string::size_type >( section.m_End - section.m_Begin ), '\0' );
+
+  inputFile.clear();
+  inputFile.seekg(section.m_Begin);
+  inputFile.read(&text[0], static_cast< std::streamsize >( text.size() ));
+  text.resize( static_cast< std::string::size_type >( inputFile.gcount() ) );
+  return text;
+}
+
+std::vector< VTKPolyDataMeshIO::CellSection >
+VTKPolyDataMeshIO
+::GetCellSections() const
+{
+  const MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
+  std::vector< CellSection > sections;
+
+  const DataSection * dataSections[] = { &this->m_VerticesSection, &this->m_LinesSection, &this->m_PolygonsSection };
+  const CellGeometryType cellTypes[] = { VERTEX_CELL, LINE_CELL, POLYGON_CELL };
+  const char *numberOfCellsKeys[] = { "numberOfVertices", "numberOfLines", "numberOfPolygons" };
+  const char *numberOfIndicesKeys[] = { "numberOfVertexIndices", "numberOfLineIndices", "numberOfPolygonIndices" };
+
+  for ( unsigned int ii = 0; ii < 3; ii++ )
+    {
+    if ( dataSections[ii]->m_Begin >= 0 )
+      {
+      CellSection section;
+      section.m_Data = *dataSections[ii];
+      section.m_CellType = cellTypes[ii];
+      section.m_NumberOfCells = 0;
+      section.m_NumberOfIndices = 0;
+      ExposeMetaData< unsigned int >(metaDic, numberOfCellsKeys[ii], section.m_NumberOfCells);
+      ExposeMetaData< unsigned int >(metaDic, numberOfIndicesKeys[ii], section.m_NumberOfIndices);
+      sections.push_back(section);
+      }
+    }
+
+  std::sort( sections.begin(), sections.end(), [](const CellSection & a, const CellSection & b)
+    {
+    return a.m_Data.m_Begin < b.m_Data.m_Begin;
+    } );
+  return sections;
+}
+
+void
+VTKPolyDataMeshIO
+::ReadPoints(void *buffer)
+{
+  std::ifstream inputFile;
+
+  if ( !this->OpenFileAtSection(inputFile, this->m_PointsSection) )
+    {
+    return;
+    }
 
   if ( this->m_FileType == ASCII )
     {
+    const std::string text = this->ReadSectionText(inputFile, this->m_PointsSection);
     switch ( this->m_PointComponentType )
       {
-      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII,inputFile)
+      CASE_INVOKE_BY_TYPE(ReadPointsBufferAsASCII, text)
 
       default:
         {
@@ -755,21 +992,12 @@ VTKPolyDataMeshIO
 {
   std::ifstream inputFile;
 
-  if ( this->m_FileType == ASCII )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-    }
-
+  inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
   if ( !inputFile.is_open() )
     {
     itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
     }
 
-
   if ( this->m_FileType == ASCII )
     {
     ReadCellsBufferAsASCII(inputFile, buffer);
@@ -788,62 +1016,32 @@ VTKPolyDataMeshIO
 
 void VTKPolyDataMeshIO::ReadCellsBufferAsASCII(std::ifstream & inputFile, void *buffer)
 {
-  std::string   line;
   SizeValueType index = 0;
   unsigned int  numPoints; // number of point in each cell
 
-  MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
   auto * data = static_cast< unsigned int * >( buffer );
 
-  while ( !inputFile.eof() )
+  for ( const CellSection & section : this->GetCellSections() )
     {
-    std::getline(inputFile, line, '\n');
-    if ( line.find("VERTICES") != std::string::npos )
-      {
-      unsigned int numberOfVertices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
+    const std::string text = this->ReadSectionText(inputFile, section.m_Data);
+    const char *      cursor = text.data();
+    const char *      end = cursor + text.size();
 
-      for ( unsigned int ii = 0; ii < numberOfVertices; ii++ )
-        {
-        inputFile >> numPoints;
-        data[index++] = MeshIOBase::VERTEX_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
-          {
-          inputFile >> data[index++];
-          }
-        }
-      }
-    else if ( line.find("LINES") != std::string::npos )
+    for ( unsigned int ii = 0; ii < section.m_NumberOfCells; ii++ )
       {
-      unsigned int numberOfLines = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-
-      for ( unsigned int ii = 0; ii < numberOfLines; ii++ )
+      if ( !ParseASCIIValue(cursor, end, numPoints) || index + 2 + numPoints > this->m_CellBufferSize )
         {
-        inputFile >> numPoints;
-        data[index++] = MeshIOBase::LINE_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
-          {
-          inputFile >> data[index++];
-          }
+        itkExceptionMacro(<< "Failed to read cell " << ii << " of " << section.m_NumberOfCells
+                          << " in " << this->m_FileName);
         }
-      }
-    else if ( line.find("POLYGONS") != std::string::npos )
-      {
-      unsigned int numberOfPolygons = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-
-      for ( unsigned int ii = 0; ii < numberOfPolygons; ii++ )
+      data[index++] = section.m_CellType;
+      data[index++] = numPoints;
+      for ( unsigned int jj = 0; jj < numPoints; jj++ )
         {
-        inputFile >> numPoints;
-
-        data[index++] = MeshIOBase::POLYGON_CELL;
-        data[index++] = numPoints;
-        for ( unsigned int jj = 0; jj < numPoints; jj++ )
+        if ( !ParseASCIIValue(cursor, end, data[index++]) )
           {
-          inputFile >> data[index++];
+          itkExceptionMacro(<< "Failed to read cell " << ii << " of " << section.m_NumberOfCells
+                            << " in " << this->m_FileName);
           }
         }
       }
@@ -854,82 +1052,44 @@ void
 VTKPolyDataMeshIO
 ::ReadCellsBufferAsBINARY(std::ifstream & inputFile, void *buffer)
 {
-  if ( !this->m_CellBufferSize )
-    {
-    return;
-    }
-
-  auto * inputBuffer = new unsigned int[this->m_CellBufferSize - this->m_NumberOfCells];
-  void *        pv = inputBuffer;
-  auto * startBuffer = static_cast< char * >( pv );
-  auto * outputBuffer = static_cast< unsigned int * >( buffer );
+  SizeValueType index = 0;
 
-  std::string          line;
-  MetaDataDictionary & metaDic = this->GetMetaDataDictionary();
+  auto * data = static_cast< unsigned int * >( buffer );
 
-  while ( !inputFile.eof() )
+  for ( const CellSection & section : this->GetCellSections() )
     {
-    std::getline(inputFile, line, '\n');
-    if ( line.find("VERTICES") != std::string::npos )
+    if ( index + section.m_NumberOfCells + section.m_NumberOfIndices > this->m_CellBufferSize )
       {
-      unsigned int numberOfVertices = 0;
-      unsigned int numberOfVertexIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertices", numberOfVertices);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfVertexIndices", numberOfVertexIndices);
-      inputFile.read( startBuffer, numberOfVertexIndices * sizeof( unsigned int ) );
-
-      pv = startBuffer;
-      auto * data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
-        {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfVertexIndices);
-        }
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::VERTEX_CELL, numberOfVertices);
-      startBuffer += numberOfVertexIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfVertexIndices + numberOfVertices ) * sizeof( unsigned int );
+      itkExceptionMacro(<< "Inconsistent numbers of cells in " << this->m_FileName);
       }
-    else if ( line.find("LINES") != std::string::npos )
+
+    // The section is read at the end of its part of the output buffer,
+    // then spread towards the front as the cell types are inserted. The
+    // output never passes the input, so this can be done in place.
+    unsigned int *input = data + index + section.m_NumberOfCells;
+    inputFile.clear();
+    inputFile.seekg(section.m_Data.m_Begin);
+    this->ReadBINARYValues(inputFile, input, section.m_NumberOfIndices, "cells");
+
+    const unsigned int *inputEnd = input + section.m_NumberOfIndices;
+    unsigned int *      output = data + index;
+    for ( unsigned int ii = 0; ii < section.m_NumberOfCells; ii++ )
       {
-      unsigned int numberOfLines = 0;
-      unsigned int numberOfLineIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLines", numberOfLines);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfLineIndices", numberOfLineIndices);
-      inputFile.read( startBuffer, numberOfLineIndices * sizeof( unsigned int ) );
-
-      pv = startBuffer;
-      auto * data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
+      if ( input == inputEnd || *input >= static_cast< SizeValueType >( inputEnd - input ) )
         {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfLineIndices);
+        itkExceptionMacro(<< "Failed to read cell " << ii << " of " << section.m_NumberOfCells
+                          << " in " << this->m_FileName);
         }
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::LINE_CELL, numberOfLines);
-      startBuffer += numberOfLineIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfLineIndices + numberOfLines ) * sizeof( unsigned int );
-      }
-    else if ( line.find("POLYGONS") != std::string::npos )
-      {
-      unsigned int numberOfPolygons = 0;
-      unsigned int numberOfPolygonIndices = 0;
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygons", numberOfPolygons);
-      ExposeMetaData< unsigned int >(metaDic, "numberOfPolygonIndices", numberOfPolygonIndices);
-      inputFile.read( startBuffer, numberOfPolygonIndices * sizeof( unsigned int ) );
-
-      pv = startBuffer;
-      auto * data = static_cast< unsigned int * >( pv );
-      if ( itk::ByteSwapper< unsigned int >::SystemIsLittleEndian() )
+      const unsigned int numPoints = *input++;
+      *output++ = section.m_CellType;
+      *output++ = numPoints;
+      for ( unsigned int jj = 0; jj < numPoints; jj++ )
         {
-        itk::ByteSwapper< unsigned int >::SwapRangeFromSystemToBigEndian(data, numberOfPolygonIndices);
+        *output++ = *input++;
         }
-
-      this->WriteCellsBuffer(data, outputBuffer, MeshIOBase::POLYGON_CELL, numberOfPolygons);
-      startBuffer += numberOfPolygonIndices * sizeof( unsigned int );
-      outputBuffer += ( numberOfPolygonIndices + numberOfPolygons ) * sizeof( unsigned int );
       }
-    }
 
-  if ( this->m_CellBufferSize )
-    {
-    delete[] inputBuffer;
+    index += section.m_NumberOfCells + section.m_NumberOfIndices;
     }
 }
 
@@ -939,26 +1099,17 @@ VTKPolyDataMeshIO
 {
   std::ifstream inputFile;
 
-  if ( this->m_FileType == ASCII )
+  if ( !this->OpenFileAtSection(inputFile, this->m_PointDataSection) )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-    }
-
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
+    return;
     }
 
-
   if ( this->m_FileType == ASCII )
     {
+    const std::string text = this->ReadSectionText(inputFile, this->m_PointDataSection);
     switch ( this->m_PointPixelComponentType )
       {
-      CASE_INVOKE_BY_TYPE(ReadPointDataBufferAsASCII, inputFile)
+      CASE_INVOKE_BY_TYPE(ReadPointDataBufferAsASCII, text)
 
       default:
         {
@@ -992,26 +1143,17 @@ VTKPolyDataMeshIO
 {
   std::ifstream inputFile;
 
-  if ( this->m_FileType == ASCII )
+  if ( !this->OpenFileAtSection(inputFile, this->m_CellDataSection) )
     {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in);
-    }
-  else if ( m_FileType == BINARY )
-    {
-    inputFile.open(this->m_FileName.c_str(), std::ios::in | std::ios::binary);
-    }
-
-  if ( !inputFile.is_open() )
-    {
-    itkExceptionMacro(<< "Unable to open file\n" "inputFilename= " << this->m_FileName);
+    return;
     }
 
-
   if ( this->m_FileType == ASCII )
     {
+    const std::string text = this->ReadSectionText(inputFile, this->m_CellDataSection);
     switch ( this->m_CellPixelComponentType )
       {
-       CASE_INVOKE_BY_TYPE(ReadCellDataBufferAsASCII, inputFile)
+      CASE_INVOKE_BY_TYPE(ReadCellDataBufferAsASCII, text)
 
       default:
         {
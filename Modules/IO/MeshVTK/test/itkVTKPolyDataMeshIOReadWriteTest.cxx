@@ -0,0 +1,252 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkLineCell.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
+#include "itkVTKPolyDataMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <fstream>
+
+// Write a mesh mixing vertices, lines and triangles, with point and cell
+// data, as ASCII and as BINARY, and check that reading it back gives the
+// same values bit for bit. Then read a hand written ASCII file using the
+// less common spellings of the format.
+
+namespace
+{
+
+using MeshType = itk::Mesh< float, 3 >;
+using ReaderType = itk::MeshFileReader< MeshType >;
+using WriterType = itk::MeshFileWriter< MeshType >;
+using CellAutoPointer = MeshType::CellType::CellAutoPointer;
+
+MeshType::Pointer
+CreateMesh()
+{
+  MeshType::Pointer mesh = MeshType::New();
+
+  // Enough points for the ASCII output to span several blocks
+  const unsigned int numberOfPoints = 60000;
+  for ( unsigned int ii = 0; ii < numberOfPoints; ++ii )
+    {
+    MeshType::PointType point;
+    point[0] = 0.1f * ii;
+    point[1] = 1.0f / ( ii + 1 );
+    point[2] = -1.0e-3f * ii * ii;
+    mesh->SetPoint( ii, point );
+    mesh->SetPointData( ii, static_cast< float >( ii ) / 7.0f );
+    }
+
+  itk::IdentifierType cellId = 0;
+  CellAutoPointer cell;
+  cell.TakeOwnership( new itk::VertexCell< MeshType::CellType > );
+  cell->SetPointId( 0, 0 );
+  mesh->SetCell( cellId++, cell );
+
+  cell.TakeOwnership( new itk::LineCell< MeshType::CellType > );
+  cell->SetPointId( 0, 1 );
+  cell->SetPointId( 1, 2 );
+  mesh->SetCell( cellId++, cell );
+
+  for ( unsigned int ii = 3; ii + 2 < numberOfPoints; ii += 2 )
+    {
+    cell.TakeOwnership( new itk::TriangleCell< MeshType::CellType > );
+    cell->SetPointId( 0, ii );
+    cell->SetPointId( 1, ii + 1 );
+    cell->SetPointId( 2, ii + 2 );
+    mesh->SetCell( cellId++, cell );
+    }
+
+  for ( itk::IdentifierType ii = 0; ii < cellId; ++ii )
+    {
+    mesh->SetCellData( ii, -0.5f * ii );
+    }
+  return mesh;
+}
+
+int
+CompareMeshes( const MeshType * expected, const MeshType * mesh )
+{
+  TEST_EXPECT_EQUAL( mesh->GetNumberOfPoints(), expected->GetNumberOfPoints() );
+  TEST_EXPECT_EQUAL( mesh->GetNumberOfCells(), expected->GetNumberOfCells() );
+
+  for ( itk::IdentifierType ii = 0; ii < expected->GetNumberOfPoints(); ++ii )
+    {
+    const MeshType::PointType expectedPoint = expected->GetPoint( ii );
+    const MeshType::PointType point = mesh->GetPoint( ii );
+    float expectedValue = 0;
+    float value = 1;
+    expected->GetPointData( ii, &expectedValue );
+    mesh->GetPointData( ii, &value );
+    if ( point != expectedPoint || value != expectedValue )
+      {
+      std::cerr << "Wrong point " << ii << ": " << point << " " << value
+                << " expected " << expectedPoint << " " << expectedValue << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  for ( itk::IdentifierType ii = 0; ii < expected->GetNumberOfCells(); ++ii )
+    {
+    CellAutoPointer expectedCell;
+    CellAutoPointer cell;
+    expected->GetCell( ii, expectedCell );
+    mesh->GetCell( ii, cell );
+    float expectedValue = 0;
+    float value = 1;
+    expected->GetCellData( ii, &expectedValue );
+    mesh->GetCellData( ii, &value );
+    if ( cell->GetNumberOfPoints() != expectedCell->GetNumberOfPoints()
+         || !std::equal( expectedCell->PointIdsBegin(), expectedCell->PointIdsEnd(), cell->PointIdsBegin() )
+         || value != expectedValue )
+      {
+      std::cerr << "Wrong cell " << ii << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int
+WriteAndRead( const MeshType * mesh, const std::string & fileName, bool binary )
+{
+  std::cout << fileName << std::endl;
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetMeshIO( itk::VTKPolyDataMeshIO::New() );
+  writer->SetInput( mesh );
+  writer->SetFileName( fileName );
+  if ( binary )
+    {
+    writer->SetFileTypeAsBINARY();
+    }
+  else
+    {
+    writer->SetFileTypeAsASCII();
+    }
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetMeshIO( itk::VTKPolyDataMeshIO::New() );
+  reader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+
+  return CompareMeshes( mesh, reader->GetOutput() );
+}
+
+}
+
+int itkVTKPolyDataMeshIOReadWriteTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkVTKPolyDataMeshIOReadWriteTest";
+
+  MeshType::Pointer mesh = CreateMesh();
+  if ( WriteAndRead( mesh, directory + "ASCII.vtk", false ) != EXIT_SUCCESS
+       || WriteAndRead( mesh, directory + "BINARY.vtk", true ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Windows line ends, exponents, special values, numbers spread over
+  // lines and a LOOKUP_TABLE line
+  const std::string fileName = directory + "HandWritten.vtk";
+  {
+  std::ofstream file( fileName.c_str(), std::ios::out | std::ios::binary );
+  file << "# vtk DataFile Version 3.0\r\n"
+       << "hand written\r\n"
+       << "ASCII\r\n"
+       << "DATASET POLYDATA\r\n"
+       << "POINTS 4 float\r\n"
+       << "0 0 0  1.5e2 -2.5E-1 +3\r\n"
+       << "  1\t2\r\n3\r\n"
+       << "-0.125 .5 7.\r\n"
+       << "POLYGONS 2 8\r\n"
+       << "3 0 1 2\r\n"
+       << "3 1 2 3\r\n"
+       << "\r\n"
+       << "POINT_DATA 4\r\n"
+       << "SCALARS values float 1\r\n"
+       << "LOOKUP_TABLE default\r\n"
+       << "1 nan\r\n"
+       << "-Infinity 4e-3\r\n"
+       << "CELL_DATA 2\r\n"
+       << "SCALARS cellValues float\r\n"
+       << "LOOKUP_TABLE default\r\n"
+       << "-1 1\r\n";
+  }
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  const MeshType * handWritten = reader->GetOutput();
+
+  const float expectedCoordinates[] = { 0, 0, 0, 150, -0.25f, 3, 1, 2, 3, -0.125f, 0.5f, 7 };
+  TEST_EXPECT_EQUAL( handWritten->GetNumberOfPoints(), 4 );
+  TEST_EXPECT_EQUAL( handWritten->GetNumberOfCells(), 2 );
+  for ( unsigned int ii = 0; ii < 4; ++ii )
+    {
+    for ( unsigned int jj = 0; jj < 3; ++jj )
+      {
+      TEST_EXPECT_EQUAL( handWritten->GetPoint( ii )[jj], expectedCoordinates[3 * ii + jj] );
+      }
+    }
+  float value = 0;
+  handWritten->GetPointData( 0, &value );
+  TEST_EXPECT_EQUAL( value, 1.0f );
+  handWritten->GetPointData( 1, &value );
+  TEST_EXPECT_TRUE( value != value );
+  handWritten->GetPointData( 2, &value );
+  TEST_EXPECT_TRUE( value < 0 && std::isinf( value ) );
+  handWritten->GetPointData( 3, &value );
+  TEST_EXPECT_EQUAL( value, 4e-3f );
+  handWritten->GetCellData( 1, &value );
+  TEST_EXPECT_EQUAL( value, 1.0f );
+
+  CellAutoPointer cell;
+  handWritten->GetCell( 1, cell );
+  TEST_EXPECT_EQUAL( cell->GetNumberOfPoints(), 3 );
+  TEST_EXPECT_EQUAL( cell->PointIdsBegin()[2], 3 );
+
+  // A truncated file is reported
+  {
+  std::ofstream file( fileName.c_str(), std::ios::out | std::ios::binary );
+  file << "# vtk DataFile Version 3.0\n"
+       << "truncated\n"
+       << "ASCII\n"
+       << "DATASET POLYDATA\n"
+       << "POINTS 4 float\n"
+       << "0 0 0 1 1 1\n";
+  }
+  reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  TRY_EXPECT_EXCEPTION( reader->Update() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
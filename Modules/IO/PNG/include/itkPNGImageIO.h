@@ -51,6 +51,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(PNGImageIO, ImageIOBase);
 
+  /** Clone() copies the compression level. */
+  bool CanCloneSettings() const override;
+
   /** Set/Get the level of compression for the output images.
    *  0-9; 0 = none, 9 = maximum. */
   itkSetMacro(CompressionLevel, int);
@@ -95,6 +98,9 @@ protected:
   ~PNGImageIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also carry over the compression level. */
+  LightObject::Pointer InternalClone() const override;
+
   void WriteSlice(const std::string & fileName, const void *buffer);
 
   /** Determines the level of compression for written files.
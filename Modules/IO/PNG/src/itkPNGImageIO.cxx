@@ -20,6 +20,7 @@
 #include "itksys/SystemTools.hxx"
 #include <string>
 #include <csetjmp>
+#include <typeinfo>
 
 namespace itk
 {
@@ -324,6 +325,29 @@ void PNGImageIO::PrintSelf(std::ostream & os, Indent indent) const
     }
 }
 
+LightObject::Pointer
+PNGImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_CompressionLevel = m_CompressionLevel;
+
+  return loPtr;
+}
+
+bool
+PNGImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
 void PNGImageIO::ReadImageInformation()
 {
   m_Spacing[0] = 1.0;  // We'll look for PNG pixel size information later,
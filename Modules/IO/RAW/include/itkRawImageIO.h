@@ -61,6 +61,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(RawImageIO, ImageIOBase);
 
+  /** Clone() copies the header size, file dimensionality and image mask. */
+  bool CanCloneSettings() const override;
+
   /** Pixel type alias support Used to declare pixel type in filters
    * or other operations. */
   using PixelType = TPixel;
@@ -138,6 +141,9 @@ protected:
   ~RawImageIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also carry over the header size, file dimensionality and mask. */
+  LightObject::Pointer InternalClone() const override;
+
   //void ComputeInternalFileName(unsigned long slice);
 
 private:
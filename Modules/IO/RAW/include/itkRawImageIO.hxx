@@ -21,6 +21,8 @@
 #include "itkRawImageIO.h"
 #include "itkIntTypes.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 template< typename TPixel, unsigned int VImageDimension >
@@ -59,6 +61,32 @@ void RawImageIO< TPixel, VImageDimension >::PrintSelf(std::ostream & os, Indent
   os << indent << "FileDimensionality: " << m_FileDimensionality << std::endl;
 }
 
+template< typename TPixel, unsigned int VImageDimension >
+LightObject::Pointer RawImageIO< TPixel, VImageDimension >::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  typename Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_FileDimensionality = m_FileDimensionality;
+  rval->m_ManualHeaderSize = m_ManualHeaderSize;
+  rval->m_HeaderSize = m_HeaderSize;
+  rval->m_ImageMask = m_ImageMask;
+
+  return loPtr;
+}
+
+template< typename TPixel, unsigned int VImageDimension >
+bool RawImageIO< TPixel, VImageDimension >::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
 template< typename TPixel, unsigned int VImageDimension >
 SizeValueType RawImageIO< TPixel, VImageDimension >::GetHeaderSize()
 {
@@ -59,6 +59,9 @@ public:
   /** Run-time type information (and related methods). */
   itkTypeMacro(TIFFImageIO, ImageIOBase);
 
+  /** Clone() copies the compression and JPEG quality settings. */
+  bool CanCloneSettings() const override;
+
   /*-------- This part of the interface deals with reading data. ------ */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -144,6 +147,9 @@ protected:
   ~TIFFImageIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Also carry over the compression type and JPEG quality. */
+  LightObject::Pointer InternalClone() const override;
+
   void InternalWrite(const void *buffer);
 
   void InitializeColors();
@@ -23,6 +23,8 @@
 
 #include "itk_tiff.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 
@@ -263,6 +265,30 @@ void TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
     }
 }
 
+LightObject::Pointer
+TIFFImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_Compression = m_Compression;
+  rval->m_JPEGQuality = m_JPEGQuality;
+
+  return loPtr;
+}
+
+bool
+TIFFImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
 void TIFFImageIO::InitializeColors()
 {
   m_ColorRed    = nullptr;
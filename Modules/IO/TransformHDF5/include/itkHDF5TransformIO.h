@@ -81,6 +81,12 @@ struct ITKIOTransformHDF5_EXPORT HDF5CommonPathNames
  *  format, but it is very general and can store pretty much
  *  any sort of data.
  *
+ *  Parameters are written straight from the transform, and converted
+ *  to the storage type by HDF5 as they are written. With UseCompression
+ *  on, they are stored as a chunked dataset, shuffled and deflated.
+ *  The parameters of dense displacement fields are read straight into
+ *  the field image.
+ *
  * \ingroup ITKIOTransformHDF5
  */
 template<typename TParametersValueType>
@@ -122,13 +128,24 @@ public:
    * pointer to the beginning of the image data. */
   void Write() override;
 
+  /** Store the parameters of the transforms written as 32 bit floats,
+   * which halves the size of dense fields written with double
+   * precision. Fixed parameters are always stored as doubles. Default
+   * is off. */
+  itkSetMacro(StoreParametersAsFloat, bool);
+  itkGetConstMacro(StoreParametersAsFloat, bool);
+  itkBooleanMacro(StoreParametersAsFloat);
+
 protected:
   HDF5TransformIOTemplate();
   ~HDF5TransformIOTemplate() override;
 
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
-  /** Read a parameter array from the file location name */
-  ParametersType ReadParameters(const std::string &DataSetName) const;
+  /** Read a parameter array from the file location name into the
+   * parameters of a transform */
+  void ReadParameters(const std::string &DataSetName, TransformType *transform) const;
   FixedParametersType ReadFixedParameters(const std::string &DataSetName) const;
 
   /** Write a parameter array to the file location name */
@@ -145,6 +162,8 @@ private:
 
   std::unique_ptr<H5::H5File> m_H5File;
 
+  bool m_StoreParametersAsFloat{ false };
+
   /** Utility function for infering data storage type
    * from class template.
    * @return H5 code PredType
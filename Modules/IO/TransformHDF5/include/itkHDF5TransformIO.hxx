@@ -36,6 +36,16 @@ template<typename TParametersValueType>
 HDF5TransformIOTemplate<TParametersValueType>
 ::~HDF5TransformIOTemplate() = default;
 
+template<typename TParametersValueType>
+void
+HDF5TransformIOTemplate<TParametersValueType>
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "StoreParametersAsFloat: " << this->m_StoreParametersAsFloat << std::endl;
+}
+
 template<typename TParametersValueType>
 bool
 HDF5TransformIOTemplate<TParametersValueType>
@@ -131,24 +141,23 @@ HDF5TransformIOTemplate<TParametersValueType>
                   const ParametersType &parameters)
 {
   const hsize_t dim(parameters.Size());
-  auto * buf = new ParametersValueType[dim];
-  for(hsize_t i{0}; i < dim; i++)
-    {
-    buf[i] = parameters[i];
-    }
   H5::DataSpace paramSpace(1,&dim);
 
   H5::DataSet paramSet;
 
-  // Set the storage format type
-  const H5::PredType h5StorageIdentifier{ GetH5TypeFromString( ) };
-  if(this->m_UseCompression)
+  // Set the storage format type. The parameters are converted to it by
+  // HDF5 as they are written, a block at a time.
+  const H5::PredType h5MemoryIdentifier{ GetH5TypeFromString( ) };
+  const H5::PredType h5StorageIdentifier{ this->m_StoreParametersAsFloat ?
+                                          H5::PredType::NATIVE_FLOAT : h5MemoryIdentifier };
+  if(this->m_UseCompression && dim > 0)
   {
     // Set compression information
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    // Shuffling the bytes of the values first groups their exponents,
+    // which compress much better than interleaved values.
     H5::DSetCreatPropList plist;
+    plist.setShuffle();
     plist.setDeflate(5); //Set intermediate compression level
     constexpr hsize_t oneMegabyte = 1024*1024;
     const hsize_t chunksize= ( dim > oneMegabyte ) ? oneMegabyte : dim; //Use chunks of 1 MB if large, else use dim
@@ -165,9 +174,11 @@ HDF5TransformIOTemplate<TParametersValueType>
                                              h5StorageIdentifier,
                                              paramSpace);
   }
-  paramSet.write(buf,h5StorageIdentifier);
+  if(dim > 0)
+    {
+    paramSet.write(parameters.data_block(),h5MemoryIdentifier);
+    }
   paramSet.close();
-  delete [] buf;
 }
 
 template<typename TParametersValueType>
@@ -177,25 +188,22 @@ HDF5TransformIOTemplate<TParametersValueType>
                        const FixedParametersType &fixedParameters)
 {
   const hsize_t dim(fixedParameters.Size());
-  auto * buf = new FixedParametersValueType[dim];
-  for(unsigned i(0); i < dim; i++)
-    {
-    buf[i] = fixedParameters[i];
-    }
   H5::DataSpace paramSpace(1,&dim);
   H5::DataSet paramSet = this->m_H5File->createDataSet(name,
     H5::PredType::NATIVE_DOUBLE,
     paramSpace);
-  paramSet.write(buf,H5::PredType::NATIVE_DOUBLE);
+  if(dim > 0)
+    {
+    paramSet.write(fixedParameters.data_block(),H5::PredType::NATIVE_DOUBLE);
+    }
   paramSet.close();
-  delete [] buf;
 }
 
 /** read a parameter array from the location specified by name */
 template<typename TParametersValueType>
-typename HDF5TransformIOTemplate<TParametersValueType>::ParametersType
+void
 HDF5TransformIOTemplate<TParametersValueType>
-::ReadParameters(const std::string &DataSetName) const
+::ReadParameters(const std::string &DataSetName, TransformType *transform) const
 {
 
   H5::DataSet paramSet = this->m_H5File->openDataSet(DataSetName);
@@ -214,32 +222,32 @@ HDF5TransformIOTemplate<TParametersValueType>
     }
   hsize_t dim;
   Space.getSimpleExtentDims(&dim,nullptr);
-  ParametersType ParameterArray;
-  ParameterArray.SetSize(dim);
-  H5::FloatType ParamType = paramSet.getFloatType();
 
-  if( ParamType.getSize() == sizeof(double) )
+  // HDF5 converts the stored values, float or double, as it reads them
+  const H5::PredType h5MemoryIdentifier{ GetH5TypeFromString( ) };
+
+  // The parameters of a displacement field wrap the buffer of the field
+  // allocated by SetFixedParameters: read them in place, which
+  // CopyInParameters then leaves as they are.
+  const ParametersType & transformParameters = transform->GetParameters();
+  if( transform->GetTransformCategory() == TransformType::DisplacementField
+      && transformParameters.Size() == dim && dim > 0 )
     {
-    auto * buf = new double[dim];
-    paramSet.read(buf,H5::PredType::NATIVE_DOUBLE);
-    for(unsigned i = 0; i < dim; i++)
-      {
-      ParameterArray.SetElement(i,static_cast<ParametersValueType>(buf[i]));
-      }
-    delete[] buf;
+    auto * buffer = const_cast< ParametersValueType * >( transformParameters.data_block() );
+    paramSet.read(buffer,h5MemoryIdentifier);
+    transform->CopyInParameters(buffer, buffer + dim);
     }
   else
     {
-    auto * buf = new float[dim];
-    paramSet.read(buf,H5::PredType::NATIVE_FLOAT);
-    for(unsigned i = 0; i < dim; i++)
+    ParametersType ParameterArray;
+    ParameterArray.SetSize(dim);
+    if(dim > 0)
       {
-      ParameterArray.SetElement(i,static_cast<ParametersValueType>(buf[i]));
+      paramSet.read(ParameterArray.data_block(),h5MemoryIdentifier);
       }
-    delete[] buf;
+    transform->SetParametersByValue(ParameterArray);
     }
   paramSet.close();
-  return ParameterArray;
 }
 
   /** read a parameter array from the location specified by name */
@@ -268,27 +276,9 @@ HDF5TransformIOTemplate<TParametersValueType>
   FixedParametersType FixedParameterArray;
 
   FixedParameterArray.SetSize(dim);
-  const H5::FloatType ParamType = paramSet.getFloatType();
-
-  if( ParamType.getSize() == sizeof(double) )
+  if(dim > 0)
     {
-    auto * buf = new double[dim];
-    paramSet.read(buf,H5::PredType::NATIVE_DOUBLE);
-    for(unsigned i = 0; i < dim; i++)
-      {
-      FixedParameterArray.SetElement(i,static_cast<FixedParametersValueType>(buf[i]));
-      }
-    delete[] buf;
-    }
-  else
-    {
-    auto * buf = new float[dim];
-    paramSet.read(buf,H5::PredType::NATIVE_FLOAT);
-    for(unsigned i = 0; i < dim; i++)
-      {
-      FixedParameterArray.SetElement(i,static_cast<FixedParametersValueType>(buf[i]));
-      }
-    delete[] buf;
+    paramSet.read(FixedParameterArray.data_block(),H5::PredType::NATIVE_DOUBLE);
     }
   paramSet.close();
   return FixedParameterArray;
@@ -398,8 +388,7 @@ HDF5TransformIOTemplate<TParametersValueType>
 #endif
           paramsName = transformName + transformParamsNameMisspelled;
         }
-        ParametersType params = this->ReadParameters(paramsName);
-        transform->SetParametersByValue(params);
+        this->ReadParameters(paramsName, transform);
         }
       currentTransformGroup.close();
       }
@@ -442,11 +431,11 @@ HDF5TransformIOTemplate<TParametersValueType>
     {
     //
     // write out Fixed Parameters
-    FixedParametersType FixedtmpArray = curTransform->GetFixedParameters();
+    const FixedParametersType & FixedtmpArray = curTransform->GetFixedParameters();
     const std::string fixedParamsName(transformName + transformFixedName);
     this->WriteFixedParameters(fixedParamsName,FixedtmpArray);
-    // parameters
-    ParametersType tmpArray = curTransform->GetParameters();
+    // parameters, which dense fields share with their image
+    const ParametersType & tmpArray = curTransform->GetParameters();
     const std::string paramsName(transformName + transformParamsName);
     this->WriteParameters(paramsName,tmpArray);
     }
@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkHDF5TransformIO.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_H5Cpp.h"
+
+// Write a composite transform holding a dense displacement field, with
+// and without compression, in double and in float storage, and check
+// that the field read back holds the values written, within float
+// precision for the float storage.
+
+namespace
+{
+
+using ParametersValueType = double;
+using DisplacementTransformType = itk::DisplacementFieldTransform< ParametersValueType, 3 >;
+using FieldType = DisplacementTransformType::DisplacementFieldType;
+using CompositeTransformType = itk::CompositeTransform< ParametersValueType, 3 >;
+using AffineTransformType = itk::AffineTransform< ParametersValueType, 3 >;
+using TransformIOType = itk::HDF5TransformIOTemplate< ParametersValueType >;
+
+// The value read back from a parameter stored with or without float
+// precision
+ParametersValueType
+StoredValue( ParametersValueType value, bool storeParametersAsFloat )
+{
+  return storeParametersAsFloat ? static_cast< ParametersValueType >( static_cast< float >( value ) ) : value;
+}
+
+int
+WriteAndRead( const CompositeTransformType * composite, const FieldType * field, const std::string & fileName,
+              bool useCompression, bool storeParametersAsFloat )
+{
+  std::cout << fileName << std::endl;
+
+  TransformIOType::Pointer transformIO = TransformIOType::New();
+  TEST_SET_GET_BOOLEAN( transformIO, StoreParametersAsFloat, storeParametersAsFloat );
+
+  using WriterType = itk::TransformFileWriterTemplate< ParametersValueType >;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetTransformIO( transformIO );
+  writer->SetInput( composite );
+  writer->SetFileName( fileName );
+  writer->SetUseCompression( useCompression );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  // The field is stored with the type asked for
+  {
+  H5::H5File file( fileName, H5F_ACC_RDONLY );
+  H5::DataSet parameters = file.openDataSet( "/TransformGroup/1/TransformParameters" );
+  TEST_EXPECT_EQUAL( parameters.getFloatType().getSize(),
+                     storeParametersAsFloat ? sizeof( float ) : sizeof( double ) );
+  TEST_EXPECT_EQUAL( parameters.getCreatePlist().getLayout(), useCompression ? H5D_CHUNKED : H5D_CONTIGUOUS );
+  }
+
+  using ReaderType = itk::TransformFileReaderTemplate< ParametersValueType >;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetTransformIO( TransformIOType::New() );
+  reader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+
+  TEST_EXPECT_EQUAL( reader->GetTransformList()->size(), 1 );
+  const auto * readComposite =
+    dynamic_cast< const CompositeTransformType * >( reader->GetTransformList()->front().GetPointer() );
+  TEST_EXPECT_TRUE( readComposite != nullptr );
+  TEST_EXPECT_EQUAL( readComposite->GetNumberOfTransforms(), 2 );
+  const AffineTransformType::ParametersType & affineParameters =
+    composite->GetNthTransformConstPointer( 0 )->GetParameters();
+  const AffineTransformType::ParametersType & readAffineParameters =
+    readComposite->GetNthTransformConstPointer( 0 )->GetParameters();
+  TEST_EXPECT_EQUAL( readAffineParameters.Size(), affineParameters.Size() );
+  for ( unsigned int i = 0; i < affineParameters.Size(); ++i )
+    {
+    TEST_EXPECT_EQUAL( readAffineParameters[i], StoredValue( affineParameters[i], storeParametersAsFloat ) );
+    }
+
+  const auto * readDisplacement =
+    dynamic_cast< const DisplacementTransformType * >( readComposite->GetNthTransformConstPointer( 1 ) );
+  TEST_EXPECT_TRUE( readDisplacement != nullptr );
+  const FieldType * readField = readDisplacement->GetDisplacementField();
+  TEST_EXPECT_EQUAL( readField->GetLargestPossibleRegion(), field->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( readField->GetSpacing(), field->GetSpacing() );
+
+  // The parameters of the read transform still wrap its field
+  TEST_EXPECT_EQUAL( static_cast< const void * >( readDisplacement->GetParameters().data_block() ),
+                     static_cast< const void * >( readField->GetBufferPointer() ) );
+
+  itk::ImageRegionConstIteratorWithIndex< FieldType > it( field, field->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const FieldType::PixelType expected = it.Get();
+    const FieldType::PixelType value = readField->GetPixel( it.GetIndex() );
+    for ( unsigned int d = 0; d < 3; ++d )
+      {
+      if ( value[d] != StoredValue( expected[d], storeParametersAsFloat ) )
+        {
+        std::cerr << "Wrong displacement at " << it.GetIndex() << ": " << value << " expected " << expected
+                  << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkHDF5TransformIODisplacementFieldTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkHDF5TransformIODisplacementFieldTest";
+
+  TransformIOType::Pointer transformIO = TransformIOType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( transformIO, HDF5TransformIOTemplate, TransformIOBaseTemplate );
+
+  // A smooth field, so that it compresses well
+  FieldType::Pointer field = FieldType::New();
+  FieldType::SizeType size;
+  size[0] = 48;
+  size[1] = 40;
+  size[2] = 32;
+  field->SetRegions( size );
+  FieldType::SpacingType spacing;
+  spacing[0] = 1.5;
+  spacing[1] = 2.0;
+  spacing[2] = 2.5;
+  field->SetSpacing( spacing );
+  field->Allocate();
+  itk::ImageRegionIteratorWithIndex< FieldType > it( field, field->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const FieldType::IndexType index = it.GetIndex();
+    FieldType::PixelType displacement;
+    displacement[0] = 0.1 * index[0] + 1.0 / 3.0;
+    displacement[1] = 0.01 * index[0] * index[1];
+    displacement[2] = -0.2 * index[2] + 1e-9;
+    it.Set( displacement );
+    }
+
+  DisplacementTransformType::Pointer displacementTransform = DisplacementTransformType::New();
+  displacementTransform->SetDisplacementField( field );
+
+  AffineTransformType::Pointer affine = AffineTransformType::New();
+  AffineTransformType::ParametersType affineParameters = affine->GetParameters();
+  for ( unsigned int i = 0; i < affineParameters.Size(); ++i )
+    {
+    affineParameters[i] = 0.5 * i + 1.0 / 7.0;
+    }
+  affine->SetParameters( affineParameters );
+
+  CompositeTransformType::Pointer composite = CompositeTransformType::New();
+  composite->AddTransform( affine );
+  composite->AddTransform( displacementTransform );
+
+  const std::string uncompressed = directory + ".h5";
+  const std::string compressed = directory + "Compressed.h5";
+  const std::string compressedFloat = directory + "CompressedFloat.h5";
+  if ( WriteAndRead( composite, field, uncompressed, false, false ) != EXIT_SUCCESS
+       || WriteAndRead( composite, field, directory + "Float.h5", false, true ) != EXIT_SUCCESS
+       || WriteAndRead( composite, field, compressed, true, false ) != EXIT_SUCCESS
+       || WriteAndRead( composite, field, compressedFloat, true, true ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  const unsigned long uncompressedSize = itksys::SystemTools::FileLength( uncompressed );
+  const unsigned long compressedSize = itksys::SystemTools::FileLength( compressed );
+  const unsigned long compressedFloatSize = itksys::SystemTools::FileLength( compressedFloat );
+  std::cout << "File sizes: " << uncompressedSize << " " << compressedSize << " " << compressedFloatSize << std::endl;
+  TEST_EXPECT_TRUE( compressedSize < uncompressedSize / 2 );
+  TEST_EXPECT_TRUE( compressedFloatSize < compressedSize );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
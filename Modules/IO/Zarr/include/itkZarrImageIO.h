@@ -0,0 +1,251 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkZarrImageIO_h
+#define itkZarrImageIO_h
+#include "ITKIOZarrExport.h"
+
+#include "itkImageIOBase.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class ZarrImageIO
+ *
+ * \brief Read and write images stored as a directory of compressed chunks.
+ *
+ * The image is a directory named with a ".zarr" extension, laid out as a
+ * Zarr (version 2) group holding one array per resolution level, with
+ * the OME-NGFF "multiscales" meta data:
+ *
+ * \code
+ * image.zarr/.zgroup
+ * image.zarr/.zattrs       axes, levels, spacing and origin
+ * image.zarr/0/.zarray     shape, chunk shape, type and compressor
+ * image.zarr/0/0.0.0       one file per chunk
+ * image.zarr/1/...         the next level, downsampled by 2
+ * \endcode
+ *
+ * Array axes are listed slowest first, so a 3D image has the axes z, y
+ * and x. The components of multi-component pixels are the last axis,
+ * named c, and every chunk holds all of them. The direction cosines,
+ * which OME-NGFF has no place for, are kept in the "itk" attribute.
+ * A directory holding a single array (a ".zarray" and no multiscales
+ * attribute) is read as a one level image.
+ *
+ * Chunks are compressed with zlib when UseCompression is on. Reading
+ * also accepts gzip and uncompressed chunks, either byte order, and
+ * missing chunks, which hold the fill value.
+ *
+ * The chunks of a region are encoded or decoded concurrently on the
+ * MultiThreader. Reading and writing can be streamed: a region read
+ * only decodes the chunks it touches, and the pieces of a streamed write
+ * are aligned on chunk boundaries. A write that only covers part of a
+ * chunk, such as a paste into an existing image, reads the chunk back
+ * and merges into it.
+ *
+ * When NumberOfLevels is larger than one, the levels after the first
+ * are computed once the image is complete, each one averaging blocks of
+ * two pixels along every dimension of the previous one. Writing a
+ * pasted region updates the part of the levels it covers.
+ *
+ * \ingroup IOFilters
+ * \ingroup ITKIOZarr
+ */
+class ITKIOZarr_EXPORT ZarrImageIO:public ImageIOBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_ASSIGN(ZarrImageIO);
+
+  /** Standard class type aliases. */
+  using Self = ZarrImageIO;
+  using Superclass = ImageIOBase;
+  using Pointer = SmartPointer< Self >;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ZarrImageIO, ImageIOBase);
+
+  /** Clone() copies the chunk size, compression level, number of levels
+   * and level. */
+  bool CanCloneSettings() const override;
+
+  using ChunkSizeType = std::vector< SizeValueType >;
+
+  /** Size of the chunks written, in pixels, fastest dimension first.
+   * Dimensions not given use the default: the same length along every
+   * dimension, for about 2^18 pixels per chunk. Chunks are clipped to
+   * the size of the image. */
+  void SetChunkSize(const ChunkSizeType & chunkSize);
+  const ChunkSizeType & GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /** zlib compression level, from 1 (fastest) to 9 (smallest), used
+   * when UseCompression is on. Default is 1. */
+  itkSetClampMacro(CompressionLevel, int, 1, 9);
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Number of resolution levels written, the first being the image
+   * itself. Levels are only written while they are larger than one
+   * pixel. After ReadImageInformation, the number of levels in the
+   * file. Default is 1. */
+  itkSetClampMacro(NumberOfLevels, unsigned int, 1, 64);
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
+  /** Resolution level read, 0 being the full resolution. Default is 0. */
+  itkSetMacro(Level, unsigned int);
+  itkGetConstMacro(Level, unsigned int);
+
+  /*-------- This part of the interface deals with reading data. ------ */
+
+  /** Determine the file type. Returns true if this ImageIO can read the
+   * file specified. */
+  bool CanReadFile(const char *) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void ReadImageInformation() override;
+
+  /** Reads the data from disk into the memory buffer provided. */
+  void Read(void *buffer) override;
+
+  /** Any region can be read. */
+  bool CanStreamRead() override
+  {
+    return true;
+  }
+
+  /** Return the requested region when streaming is enabled, and the
+   * whole image otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
+  /*-------- This part of the interfaces deals with writing data. ----- */
+
+  /** Determine the file type. Returns true if this ImageIO can write the
+   * file specified. */
+  bool CanWriteFile(const char *) override;
+
+  /** Writes the group and array meta data. Called by the first piece of
+   * a write. */
+  void WriteImageInformation() override;
+
+  /** Writes the data to disk from the memory buffer provided. Make sure
+   * that the IORegion has been set properly. */
+  void Write(const void *buffer) override;
+
+  /** Any region can be written, including into an existing image. */
+  bool CanStreamWrite() override
+  {
+    return true;
+  }
+
+  /** Starts a new write of the paste region. */
+  unsigned int GetActualNumberOfSplitsForWriting(unsigned int numberOfRequestedSplits,
+                                                 const ImageIORegion & pasteRegion,
+                                                 const ImageIORegion & largestPossibleRegion) override;
+
+protected:
+  ZarrImageIO();
+  ~ZarrImageIO() override;
+
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Split the paste region along its slowest dimension spanning more
+   * than one chunk, on chunk boundaries. */
+  unsigned int GetActualNumberOfSplitsForWritingCanStreamWrite(unsigned int numberOfRequestedSplits,
+                                                               const ImageIORegion & pasteRegion) const override;
+
+  ImageIORegion GetSplitRegionForWritingCanStreamWrite(unsigned int ithPiece,
+                                                       unsigned int numberOfActualSplits,
+                                                       const ImageIORegion & pasteRegion) const override;
+
+  /** Carry the chunk size, compression level and levels over. */
+  LightObject::Pointer InternalClone() const override;
+
+private:
+  /** Geometry and encoding of one array, that is one level. Sizes are
+   * in pixels, fastest dimension first, without the component axis. */
+  struct ArrayType
+  {
+    std::string                  m_Path;
+    std::vector< SizeValueType > m_Size;
+    std::vector< SizeValueType > m_ChunkSize;
+    std::vector< double >        m_Spacing;
+    std::vector< double >        m_Origin;
+    IOComponentType              m_ComponentType{ UNKNOWNCOMPONENTTYPE };
+    unsigned int                 m_NumberOfComponents{ 1 };
+    bool                         m_HasComponentAxis{ false };
+    char                         m_DimensionSeparator{ '.' };
+    bool                         m_Compressed{ false };
+    bool                         m_SwapBytes{ false };
+    double                       m_FillValue{ 0.0 };
+  };
+
+  /** Parse the meta data of a store, giving its levels and the direction
+   * cosines of their axes. */
+  void ReadStoreInformation(const std::string & storePath, std::vector< ArrayType > & levels,
+                            std::vector< std::vector< double > > & direction) const;
+
+  void ReadArrayInformation(ArrayType & array, bool hasComponentAxis) const;
+
+  void WriteArrayInformation(const ArrayType & array) const;
+
+  /** The levels written for the image described by the ImageIO. */
+  std::vector< ArrayType > ComputeLevels() const;
+
+  /** Decode the chunks covering a region of an array into a buffer
+   * holding that region. */
+  void ReadRegion(const ArrayType & array, const ImageIORegion & region, void *buffer, bool concurrently) const;
+
+  /** Encode a region of an array held in a buffer into its chunks. */
+  void WriteRegion(const ArrayType & array, const ImageIORegion & region, const void *buffer,
+                   bool concurrently) const;
+
+  /** Compute the part of each level after the first covering a region
+   * of the first level. */
+  void WriteLevels(const ImageIORegion & region) const;
+
+  /** Decode one chunk, or fill it with the fill value when its file is
+   * missing. */
+  void ReadChunk(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex, char *chunk) const;
+
+  /** Encode one chunk. The chunk is byte swapped in place if needed. */
+  void WriteChunk(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex, char *chunk) const;
+
+  std::string GetChunkFileName(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex) const;
+
+  ChunkSizeType m_ChunkSize;
+  int           m_CompressionLevel{ 1 };
+  unsigned int  m_NumberOfLevels{ 1 };
+  unsigned int  m_Level{ 0 };
+
+  std::vector< ArrayType > m_Levels;
+
+  // progress of a write streamed over several calls to Write()
+  ImageIORegion m_PasteRegion;
+  bool          m_Pasting{ false };
+  SizeValueType m_NumberOfPixelsWritten{ 0 };
+};
+} // end namespace itk
+
+#endif // itkZarrImageIO_h
@@ -0,0 +1,19 @@
+set(DOCUMENTATION "This module contains an ImageIO class for reading and
+writing images stored as a directory of independently compressed chunks,
+following the Zarr (version 2) layout with OME-NGFF multiscale meta data.
+Chunks are encoded and decoded in parallel, regions are streamed, and
+downsampled resolution levels can be written along with the image.")
+
+itk_module(ITKIOZarr
+  ENABLE_SHARED
+  DEPENDS
+    ITKIOImageBase
+  PRIVATE_DEPENDS
+    ITKZLIB
+  TEST_DEPENDS
+    ITKTestKernel
+  FACTORY_NAMES
+    ImageIO::Zarr
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
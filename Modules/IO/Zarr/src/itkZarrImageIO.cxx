@@ -0,0 +1,1856 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkZarrImageIO.h"
+#include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
+#include "itkNumberToString.h"
+#include "itkNumericTraits.h"
+#include "itksys/SystemTools.hxx"
+#include "itk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <mutex>
+#include <sstream>
+#include <type_traits>
+#include <typeinfo>
+
+namespace itk
+{
+namespace
+{
+
+// Default number of pixels in a chunk
+constexpr double DefaultChunkNumberOfPixels = 262144.0;
+
+/** A value of a JSON meta data file. The elements of an object are
+ * listed along with their keys. */
+struct JSONValue
+{
+  enum TypeEnum { Null, Boolean, Number, String, Array, Object };
+
+  TypeEnum                   m_Type{ Null };
+  bool                       m_Boolean{ false };
+  double                     m_Number{ 0.0 };
+  std::string                m_String;
+  std::vector< JSONValue >   m_Elements;
+  std::vector< std::string > m_Keys;
+
+  const JSONValue * Find(const std::string & key) const
+  {
+    if ( m_Type == Object )
+      {
+      for ( size_t ii = 0; ii < m_Keys.size(); ++ii )
+        {
+        if ( m_Keys[ii] == key )
+          {
+          return &m_Elements[ii];
+          }
+        }
+      }
+    return nullptr;
+  }
+};
+
+/** Parse JSON text. Also accepts the NaN and Infinity written for
+ * floating point fill values. */
+class JSONParser
+{
+public:
+  JSONParser(const std::string & text, const std::string & fileName):
+    m_Text(text),
+    m_FileName(fileName)
+  {}
+
+  JSONValue Parse()
+  {
+    JSONValue value = this->ParseValue(0);
+    this->SkipWhiteSpace();
+    if ( m_Position != m_Text.size() )
+      {
+      this->Fail("unexpected text after the value");
+      }
+    return value;
+  }
+
+private:
+  void Fail(const char *what) const
+  {
+    itkGenericExceptionMacro( "Could not parse " << m_FileName << ": " << what << " at offset " << m_Position );
+  }
+
+  void SkipWhiteSpace()
+  {
+    while ( m_Position < m_Text.size()
+            && ( m_Text[m_Position] == ' ' || m_Text[m_Position] == '\t'
+                 || m_Text[m_Position] == '\n' || m_Text[m_Position] == '\r' ) )
+      {
+      ++m_Position;
+      }
+  }
+
+  bool Consume(const char *literal)
+  {
+    const size_t length = std::strlen(literal);
+    if ( m_Text.compare(m_Position, length, literal) == 0 )
+      {
+      m_Position += length;
+      return true;
+      }
+    return false;
+  }
+
+  std::string ParseString()
+  {
+    std::string result;
+    ++m_Position; // opening quote
+    while ( m_Position < m_Text.size() )
+      {
+      const char c = m_Text[m_Position++];
+      if ( c == '"' )
+        {
+        return result;
+        }
+      if ( c != '\\' )
+        {
+        result += c;
+        continue;
+        }
+      if ( m_Position >= m_Text.size() )
+        {
+        break;
+        }
+      const char escaped = m_Text[m_Position++];
+      switch ( escaped )
+        {
+        case 'b':
+          result += '\b';
+          break;
+        case 'f':
+          result += '\f';
+          break;
+        case 'n':
+          result += '\n';
+          break;
+        case 'r':
+          result += '\r';
+          break;
+        case 't':
+          result += '\t';
+          break;
+        case 'u':
+          {
+          if ( m_Position + 4 > m_Text.size() )
+            {
+            this->Fail("truncated escape sequence");
+            }
+          unsigned int code = 0;
+          std::istringstream hex( m_Text.substr(m_Position, 4) );
+          if ( !( hex >> std::hex >> code ) )
+            {
+            this->Fail("bad escape sequence");
+            }
+          m_Position += 4;
+          // UTF-8 encoding of the code unit
+          if ( code < 0x80 )
+            {
+            result += static_cast< char >( code );
+            }
+          else if ( code < 0x800 )
+            {
+            result += static_cast< char >( 0xC0 | ( code >> 6 ) );
+            result += static_cast< char >( 0x80 | ( code & 0x3F ) );
+            }
+          else
+            {
+            result += static_cast< char >( 0xE0 | ( code >> 12 ) );
+            result += static_cast< char >( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+            result += static_cast< char >( 0x80 | ( code & 0x3F ) );
+            }
+          break;
+          }
+        default:
+          result += escaped;
+          break;
+        }
+      }
+    this->Fail("unterminated string");
+    return result;
+  }
+
+  JSONValue ParseValue(unsigned int depth)
+  {
+    JSONValue value;
+    if ( depth > 64 )
+      {
+      this->Fail("too deeply nested");
+      }
+    this->SkipWhiteSpace();
+    if ( m_Position >= m_Text.size() )
+      {
+      this->Fail("unexpected end");
+      }
+    const char c = m_Text[m_Position];
+    if ( c == '{' || c == '[' )
+      {
+      const bool isObject = c == '{';
+      const char close = isObject ? '}' : ']';
+      value.m_Type = isObject ? JSONValue::Object : JSONValue::Array;
+      ++m_Position;
+      this->SkipWhiteSpace();
+      if ( m_Position < m_Text.size() && m_Text[m_Position] == close )
+        {
+        ++m_Position;
+        return value;
+        }
+      for (;; )
+        {
+        if ( isObject )
+          {
+          this->SkipWhiteSpace();
+          if ( m_Position >= m_Text.size() || m_Text[m_Position] != '"' )
+            {
+            this->Fail("expected a key");
+            }
+          value.m_Keys.push_back( this->ParseString() );
+          this->SkipWhiteSpace();
+          if ( !this->Consume(":") )
+            {
+            this->Fail("expected ':'");
+            }
+          }
+        value.m_Elements.push_back( this->ParseValue(depth + 1) );
+        this->SkipWhiteSpace();
+        if ( this->Consume(",") )
+          {
+          continue;
+          }
+        if ( m_Position < m_Text.size() && m_Text[m_Position] == close )
+          {
+          ++m_Position;
+          return value;
+          }
+        this->Fail(isObject ? "expected ',' or '}'" : "expected ',' or ']'");
+        }
+      }
+    if ( c == '"' )
+      {
+      value.m_Type = JSONValue::String;
+      value.m_String = this->ParseString();
+      return value;
+      }
+    if ( this->Consume("true") )
+      {
+      value.m_Type = JSONValue::Boolean;
+      value.m_Boolean = true;
+      return value;
+      }
+    if ( this->Consume("false") )
+      {
+      value.m_Type = JSONValue::Boolean;
+      return value;
+      }
+    if ( this->Consume("null") )
+      {
+      return value;
+      }
+    value.m_Type = JSONValue::Number;
+    if ( this->Consume("NaN") )
+      {
+      value.m_Number = std::numeric_limits< double >::quiet_NaN();
+      return value;
+      }
+    if ( this->Consume("Infinity") )
+      {
+      value.m_Number = std::numeric_limits< double >::infinity();
+      return value;
+      }
+    if ( this->Consume("-Infinity") )
+      {
+      value.m_Number = -std::numeric_limits< double >::infinity();
+      return value;
+      }
+    const size_t start = m_Position;
+    while ( m_Position < m_Text.size() && std::strchr("+-0123456789.eE", m_Text[m_Position]) != nullptr )
+      {
+      ++m_Position;
+      }
+    std::istringstream number( m_Text.substr(start, m_Position - start) );
+    number.imbue( std::locale::classic() );
+    if ( start == m_Position || !( number >> value.m_Number ) )
+      {
+      this->Fail("unexpected character");
+      }
+    return value;
+  }
+
+  const std::string & m_Text;
+  const std::string & m_FileName;
+  size_t              m_Position{ 0 };
+};
+
+bool
+ReadTextFile(const std::string & fileName, std::string & text)
+{
+  std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+  if ( !file.is_open() )
+    {
+    return false;
+    }
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  text = contents.str();
+  return true;
+}
+
+void
+WriteTextFile(const std::string & fileName, const std::string & text)
+{
+  std::ofstream file( fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+  file << text;
+  if ( !file )
+    {
+    itkGenericExceptionMacro( "Could not write " << fileName );
+    }
+}
+
+/** The values of a JSON array of numbers, or false. */
+bool
+GetNumbers(const JSONValue *value, std::vector< double > & numbers)
+{
+  if ( value == nullptr || value->m_Type != JSONValue::Array )
+    {
+    return false;
+    }
+  numbers.clear();
+  for ( const auto & element : value->m_Elements )
+    {
+    if ( element.m_Type != JSONValue::Number )
+      {
+      return false;
+      }
+    numbers.push_back(element.m_Number);
+    }
+  return true;
+}
+
+/** The values of a JSON array of sizes, or false. */
+bool
+GetSizes(const JSONValue *value, std::vector< SizeValueType > & sizes)
+{
+  std::vector< double > numbers;
+  if ( !GetNumbers(value, numbers) )
+    {
+    return false;
+    }
+  sizes.clear();
+  for ( double number : numbers )
+    {
+    if ( number < 0 || number != std::floor(number) )
+      {
+      return false;
+      }
+    sizes.push_back( static_cast< SizeValueType >( number ) );
+    }
+  return true;
+}
+
+std::string
+GetString(const JSONValue *value)
+{
+  return value != nullptr && value->m_Type == JSONValue::String ? value->m_String : std::string();
+}
+
+unsigned int
+GetSizeOfComponent(ImageIOBase::IOComponentType componentType)
+{
+  switch ( componentType )
+    {
+    case ImageIOBase::UCHAR:
+    case ImageIOBase::CHAR:
+      return 1;
+    case ImageIOBase::USHORT:
+    case ImageIOBase::SHORT:
+      return sizeof( short );
+    case ImageIOBase::UINT:
+    case ImageIOBase::INT:
+      return sizeof( int );
+    case ImageIOBase::ULONG:
+    case ImageIOBase::LONG:
+      return sizeof( long );
+    case ImageIOBase::ULONGLONG:
+    case ImageIOBase::LONGLONG:
+      return sizeof( long long );
+    case ImageIOBase::FLOAT:
+      return sizeof( float );
+    case ImageIOBase::DOUBLE:
+      return sizeof( double );
+    default:
+      return 0;
+    }
+}
+
+/** The numpy type string of a component type, in little endian order. */
+std::string
+GetDataType(ImageIOBase::IOComponentType componentType)
+{
+  char kind;
+  switch ( componentType )
+    {
+    case ImageIOBase::UCHAR:
+    case ImageIOBase::USHORT:
+    case ImageIOBase::UINT:
+    case ImageIOBase::ULONG:
+    case ImageIOBase::ULONGLONG:
+      kind = 'u';
+      break;
+    case ImageIOBase::CHAR:
+    case ImageIOBase::SHORT:
+    case ImageIOBase::INT:
+    case ImageIOBase::LONG:
+    case ImageIOBase::LONGLONG:
+      kind = 'i';
+      break;
+    case ImageIOBase::FLOAT:
+    case ImageIOBase::DOUBLE:
+      kind = 'f';
+      break;
+    default:
+      return std::string();
+    }
+  const unsigned int size = GetSizeOfComponent(componentType);
+  std::ostringstream dataType;
+  dataType << ( size == 1 ? '|' : '<' ) << kind << size;
+  return dataType.str();
+}
+
+/** The component type of a numpy type string, and whether its bytes
+ * are in the other order than the system's. */
+bool
+ParseDataType(const std::string & dataType, ImageIOBase::IOComponentType & componentType, bool & swapBytes)
+{
+  if ( dataType.size() < 3
+       || ( dataType[0] != '<' && dataType[0] != '>' && dataType[0] != '|' ) )
+    {
+    return false;
+    }
+  const char        kind = dataType[1];
+  const std::string size = dataType.substr(2);
+  componentType = ImageIOBase::UNKNOWNCOMPONENTTYPE;
+  if ( kind == 'u' || ( kind == 'b' && size == "1" ) )
+    {
+    componentType = size == "1" ? ImageIOBase::UCHAR
+      : size == "2" ? ImageIOBase::USHORT
+      : size == "4" ? ImageIOBase::UINT
+      : size == "8" ? ImageIOBase::ULONGLONG
+      : ImageIOBase::UNKNOWNCOMPONENTTYPE;
+    }
+  else if ( kind == 'i' )
+    {
+    componentType = size == "1" ? ImageIOBase::CHAR
+      : size == "2" ? ImageIOBase::SHORT
+      : size == "4" ? ImageIOBase::INT
+      : size == "8" ? ImageIOBase::LONGLONG
+      : ImageIOBase::UNKNOWNCOMPONENTTYPE;
+    }
+  else if ( kind == 'f' )
+    {
+    componentType = size == "4" ? ImageIOBase::FLOAT
+      : size == "8" ? ImageIOBase::DOUBLE
+      : ImageIOBase::UNKNOWNCOMPONENTTYPE;
+    }
+  if ( componentType == ImageIOBase::UNKNOWNCOMPONENTTYPE )
+    {
+    return false;
+    }
+  const bool bigEndian = ByteSwapper< int >::SystemIsBigEndian();
+  swapBytes = GetSizeOfComponent(componentType) > 1
+    && ( ( dataType[0] == '<' && bigEndian ) || ( dataType[0] == '>' && !bigEndian ) );
+  return true;
+}
+
+void
+SwapBytes(char *data, SizeValueType numberOfValues, unsigned int componentSize)
+{
+  for ( SizeValueType ii = 0; ii < numberOfValues; ++ii )
+    {
+    std::reverse(data + ii * componentSize, data + ( ii + 1 ) * componentSize);
+    }
+}
+
+/** Call functor.Run< T >() with the C++ type of a component type. */
+template< typename TFunctor >
+void
+DispatchComponentType(ImageIOBase::IOComponentType componentType, const TFunctor & functor)
+{
+  switch ( componentType )
+    {
+    case ImageIOBase::UCHAR:
+      functor.template Run< unsigned char >();
+      break;
+    case ImageIOBase::CHAR:
+      functor.template Run< signed char >();
+      break;
+    case ImageIOBase::USHORT:
+      functor.template Run< unsigned short >();
+      break;
+    case ImageIOBase::SHORT:
+      functor.template Run< short >();
+      break;
+    case ImageIOBase::UINT:
+      functor.template Run< unsigned int >();
+      break;
+    case ImageIOBase::INT:
+      functor.template Run< int >();
+      break;
+    case ImageIOBase::ULONG:
+      functor.template Run< unsigned long >();
+      break;
+    case ImageIOBase::LONG:
+      functor.template Run< long >();
+      break;
+    case ImageIOBase::ULONGLONG:
+      functor.template Run< unsigned long long >();
+      break;
+    case ImageIOBase::LONGLONG:
+      functor.template Run< long long >();
+      break;
+    case ImageIOBase::FLOAT:
+      functor.template Run< float >();
+      break;
+    case ImageIOBase::DOUBLE:
+      functor.template Run< double >();
+      break;
+    default:
+      itkGenericExceptionMacro( "Unsupported component type: "
+                                << ImageIOBase::GetComponentTypeAsString(componentType) );
+    }
+}
+
+/** Fill a chunk with its fill value. */
+struct ChunkFiller
+{
+  char *        m_Chunk;
+  SizeValueType m_NumberOfValues;
+  double        m_Value;
+
+  template< typename T >
+  void Run() const
+  {
+    std::fill_n(reinterpret_cast< T * >( m_Chunk ), m_NumberOfValues, static_cast< T >( m_Value ) );
+  }
+};
+
+template< typename T >
+T
+GetAverage(double sum, unsigned int count, std::true_type)
+{
+  const double average = std::floor(sum / count + 0.5);
+  return static_cast< T >( std::min( average, static_cast< double >( NumericTraits< T >::max() ) ) );
+}
+
+template< typename T >
+T
+GetAverage(double sum, unsigned int count, std::false_type)
+{
+  return static_cast< T >( sum / count );
+}
+
+/** Average the blocks of pixels of a region of one level giving a region
+ * of the next level, the region of the next level being downsampled by
+ * the factor along each dimension. */
+struct Downsampler
+{
+  const char *                        m_Input;
+  const ImageIORegion *               m_InputRegion;
+  char *                              m_Output;
+  const ImageIORegion *               m_OutputRegion;
+  const std::vector< unsigned int > * m_Factor;
+  unsigned int                        m_NumberOfComponents;
+
+  template< typename T >
+  void Run() const
+  {
+    const unsigned int dimension = m_OutputRegion->GetImageDimension();
+    const auto *       input = reinterpret_cast< const T * >( m_Input );
+    auto *             output = reinterpret_cast< T * >( m_Output );
+
+    std::vector< SizeValueType > inputStride(dimension);
+    SizeValueType               stride = m_NumberOfComponents;
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      inputStride[d] = stride;
+      stride *= m_InputRegion->GetSize(d);
+      }
+
+    const unsigned int           numberOfNeighbors = 1u << dimension;
+    std::vector< SizeValueType > position(dimension, 0);
+    std::vector< double >        sum(m_NumberOfComponents);
+    const SizeValueType          numberOfPixels = m_OutputRegion->GetNumberOfPixels();
+    for ( SizeValueType pixel = 0; pixel < numberOfPixels; ++pixel )
+      {
+      std::fill(sum.begin(), sum.end(), 0.0);
+      unsigned int count = 0;
+      for ( unsigned int neighbor = 0; neighbor < numberOfNeighbors; ++neighbor )
+        {
+        SizeValueType offset = 0;
+        bool          inside = true;
+        for ( unsigned int d = 0; d < dimension && inside; ++d )
+          {
+          const unsigned int step = ( neighbor >> d ) & 1u;
+          const SizeValueType coordinate =
+            ( m_OutputRegion->GetIndex(d) + position[d] ) * ( *m_Factor )[d] + step - m_InputRegion->GetIndex(d);
+          inside = ( step == 0 || ( *m_Factor )[d] > 1 ) && coordinate < m_InputRegion->GetSize(d);
+          offset += coordinate * inputStride[d];
+          }
+        if ( !inside )
+          {
+          continue;
+          }
+        for ( unsigned int c = 0; c < m_NumberOfComponents; ++c )
+          {
+          sum[c] += static_cast< double >( input[offset + c] );
+          }
+        ++count;
+        }
+      for ( unsigned int c = 0; c < m_NumberOfComponents; ++c )
+        {
+        output[pixel * m_NumberOfComponents + c] = GetAverage< T >( sum[c], count, std::is_integral< T >() );
+        }
+      for ( unsigned int d = 0; d < dimension; ++d )
+        {
+        if ( ++position[d] < m_OutputRegion->GetSize(d) )
+          {
+          break;
+          }
+        position[d] = 0;
+        }
+      }
+  }
+};
+
+/** The file name of a store, without the trailing separator of a
+ * directory. */
+std::string
+GetStorePath(const std::string & fileName)
+{
+  std::string path = fileName;
+  while ( path.size() > 1 && ( path.back() == '/' || path.back() == '\\' ) )
+    {
+    path.pop_back();
+    }
+  return path;
+}
+
+/** A region of an array, dropping dimensions the array does not have
+ * and adding the ones the region does not have. */
+ImageIORegion
+GetArrayRegion(const ImageIORegion & region, unsigned int dimension)
+{
+  ImageIORegion arrayRegion(dimension);
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    arrayRegion.SetIndex( d, d < region.GetImageDimension() ? region.GetIndex(d) : 0 );
+    arrayRegion.SetSize( d, d < region.GetImageDimension() ? region.GetSize(d) : 1 );
+    }
+  return arrayRegion;
+}
+
+ImageIORegion
+GetWholeRegion(const std::vector< SizeValueType > & size)
+{
+  ImageIORegion region( static_cast< unsigned int >( size.size() ) );
+  for ( unsigned int d = 0; d < size.size(); ++d )
+    {
+    region.SetSize(d, size[d]);
+    }
+  return region;
+}
+
+ImageIORegion
+Intersect(const ImageIORegion & region1, const ImageIORegion & region2)
+{
+  const unsigned int dimension = region1.GetImageDimension();
+  ImageIORegion      intersection(dimension);
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    const IndexValueType begin = std::max( region1.GetIndex(d), region2.GetIndex(d) );
+    const IndexValueType end = std::min( region1.GetIndex(d) + static_cast< IndexValueType >( region1.GetSize(d) ),
+                                         region2.GetIndex(d) + static_cast< IndexValueType >( region2.GetSize(d) ) );
+    intersection.SetIndex(d, begin);
+    intersection.SetSize( d, end > begin ? static_cast< SizeValueType >( end - begin ) : 0 );
+    }
+  return intersection;
+}
+
+/** Copy a region of pixels between two buffers, each holding a region
+ * containing it. */
+void
+CopyRegion(const char *source, const ImageIORegion & sourceRegion,
+           char *destination, const ImageIORegion & destinationRegion,
+           const ImageIORegion & region, SizeValueType pixelSize)
+{
+  const unsigned int  dimension = region.GetImageDimension();
+  const SizeValueType numberOfPixels = region.GetNumberOfPixels();
+  if ( numberOfPixels == 0 )
+    {
+    return;
+    }
+
+  std::vector< SizeValueType > sourceStride(dimension);
+  std::vector< SizeValueType > destinationStride(dimension);
+  SizeValueType               sourceSize = pixelSize;
+  SizeValueType               destinationSize = pixelSize;
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    sourceStride[d] = sourceSize;
+    destinationStride[d] = destinationSize;
+    sourceSize *= sourceRegion.GetSize(d);
+    destinationSize *= destinationRegion.GetSize(d);
+    }
+
+  // one line along the first dimension at a time
+  const SizeValueType          lineLength = region.GetSize(0) * pixelSize;
+  const SizeValueType          numberOfLines = numberOfPixels / region.GetSize(0);
+  std::vector< SizeValueType > position(dimension, 0);
+  for ( SizeValueType line = 0; line < numberOfLines; ++line )
+    {
+    SizeValueType sourceOffset = 0;
+    SizeValueType destinationOffset = 0;
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      const IndexValueType index = region.GetIndex(d) + static_cast< IndexValueType >( position[d] );
+      sourceOffset += static_cast< SizeValueType >( index - sourceRegion.GetIndex(d) ) * sourceStride[d];
+      destinationOffset += static_cast< SizeValueType >( index - destinationRegion.GetIndex(d) )
+        * destinationStride[d];
+      }
+    std::memcpy(destination + destinationOffset, source + sourceOffset, lineLength);
+    for ( unsigned int d = 1; d < dimension; ++d )
+      {
+      if ( ++position[d] < region.GetSize(d) )
+        {
+        break;
+        }
+      position[d] = 0;
+      }
+    }
+}
+
+/** The chunks overlapping a region: the first chunk and the number of
+ * chunks along each dimension. Returns the number of chunks. */
+SizeValueType
+GetChunkRange(const std::vector< SizeValueType > & chunkSize, const ImageIORegion & region,
+              std::vector< SizeValueType > & firstChunk, std::vector< SizeValueType > & numberOfChunks)
+{
+  const auto dimension = static_cast< unsigned int >( chunkSize.size() );
+  firstChunk.resize(dimension);
+  numberOfChunks.resize(dimension);
+  SizeValueType total = 1;
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    if ( region.GetSize(d) == 0 )
+      {
+      return 0;
+      }
+    const auto begin = static_cast< SizeValueType >( region.GetIndex(d) );
+    firstChunk[d] = begin / chunkSize[d];
+    numberOfChunks[d] = ( begin + region.GetSize(d) - 1 ) / chunkSize[d] - firstChunk[d] + 1;
+    total *= numberOfChunks[d];
+    }
+  return total;
+}
+
+std::vector< SizeValueType >
+GetChunkIndex(SizeValueType chunk, const std::vector< SizeValueType > & firstChunk,
+              const std::vector< SizeValueType > & numberOfChunks)
+{
+  std::vector< SizeValueType > chunkIndex( firstChunk.size() );
+  for ( unsigned int d = 0; d < firstChunk.size(); ++d )
+    {
+    chunkIndex[d] = firstChunk[d] + chunk % numberOfChunks[d];
+    chunk /= numberOfChunks[d];
+    }
+  return chunkIndex;
+}
+
+/** The region of a chunk, as stored, which may extend beyond the
+ * array. */
+ImageIORegion
+GetChunkRegion(const std::vector< SizeValueType > & chunkSize, const std::vector< SizeValueType > & chunkIndex)
+{
+  ImageIORegion region( static_cast< unsigned int >( chunkSize.size() ) );
+  for ( unsigned int d = 0; d < chunkSize.size(); ++d )
+    {
+    region.SetIndex( d, static_cast< IndexValueType >( chunkIndex[d] * chunkSize[d] ) );
+    region.SetSize(d, chunkSize[d]);
+    }
+  return region;
+}
+
+/** The slowest dimension along which a region spans more than one
+ * chunk, and the number of chunks it spans. */
+bool
+GetSplitDimension(const std::vector< SizeValueType > & chunkSize, const ImageIORegion & region,
+                  unsigned int & dimension, SizeValueType & numberOfChunks)
+{
+  for ( auto d = static_cast< unsigned int >( std::min< size_t >( chunkSize.size(), region.GetImageDimension() ) );
+        d-- > 0; )
+    {
+    if ( region.GetSize(d) == 0 )
+      {
+      return false;
+      }
+    const auto          begin = static_cast< SizeValueType >( region.GetIndex(d) );
+    const SizeValueType first = begin / chunkSize[d];
+    const SizeValueType last = ( begin + region.GetSize(d) - 1 ) / chunkSize[d];
+    if ( last > first )
+      {
+      dimension = d;
+      numberOfChunks = last - first + 1;
+      return true;
+      }
+    }
+  return false;
+}
+
+/** Run a job for each chunk, concurrently on the MultiThreader if
+ * requested, and rethrow the first exception of a job. */
+void
+ForEachChunk(SizeValueType numberOfChunks, bool concurrently, const std::function< void( SizeValueType ) > & job)
+{
+  if ( !concurrently || numberOfChunks < 2 )
+    {
+    for ( SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk )
+      {
+      job(chunk);
+      }
+    return;
+    }
+
+  std::mutex         exceptionMutex;
+  std::exception_ptr firstException;
+  std::atomic< bool > failed( false );
+  MultiThreaderBase::Pointer threader = MultiThreaderBase::New();
+  threader->ParallelizeArray( 0, numberOfChunks, [&]( SizeValueType chunk )
+    {
+    if ( failed )
+      {
+      return;
+      }
+    try
+      {
+      job(chunk);
+      }
+    catch ( ... )
+      {
+      std::lock_guard< std::mutex > lock( exceptionMutex );
+      if ( !failed )
+        {
+        firstException = std::current_exception();
+        failed = true;
+        }
+      }
+    }, nullptr );
+  if ( failed )
+    {
+    std::rethrow_exception(firstException);
+    }
+}
+
+bool
+Inflate(const std::vector< char > & input, char *output, SizeValueType outputSize)
+{
+  if ( input.size() > std::numeric_limits< uInt >::max() || outputSize > std::numeric_limits< uInt >::max() )
+    {
+    return false;
+    }
+  z_stream stream;
+  std::memset( &stream, 0, sizeof( stream ) );
+  // accept both zlib and gzip headers
+  if ( inflateInit2(&stream, 15 + 32) != Z_OK )
+    {
+    return false;
+    }
+  stream.next_in = reinterpret_cast< Bytef * >( const_cast< char * >( input.data() ) );
+  stream.avail_in = static_cast< uInt >( input.size() );
+  stream.next_out = reinterpret_cast< Bytef * >( output );
+  stream.avail_out = static_cast< uInt >( outputSize );
+  const bool succeeded = inflate(&stream, Z_FINISH) == Z_STREAM_END && stream.total_out == outputSize;
+  inflateEnd(&stream);
+  return succeeded;
+}
+
+} // end anonymous namespace
+
+ZarrImageIO::ZarrImageIO()
+{
+  this->SetNumberOfDimensions(3);
+  m_UseCompression = false;
+
+  this->AddSupportedWriteExtension(".zarr");
+  this->AddSupportedReadExtension(".zarr");
+}
+
+ZarrImageIO::~ZarrImageIO() = default;
+
+void
+ZarrImageIO::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: [";
+  for ( size_t ii = 0; ii < m_ChunkSize.size(); ++ii )
+    {
+    os << ( ii > 0 ? ", " : "" ) << m_ChunkSize[ii];
+    }
+  os << "]" << std::endl;
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "NumberOfLevels: " << m_NumberOfLevels << std::endl;
+  os << indent << "Level: " << m_Level << std::endl;
+}
+
+LightObject::Pointer
+ZarrImageIO::InternalClone() const
+{
+  LightObject::Pointer loPtr = Superclass::InternalClone();
+
+  Self::Pointer rval = dynamic_cast< Self * >( loPtr.GetPointer() );
+  if ( rval.IsNull() )
+    {
+    itkExceptionMacro(<< "downcast to type "
+                      << this->GetNameOfClass()
+                      << " failed.");
+    }
+  rval->m_ChunkSize = m_ChunkSize;
+  rval->m_CompressionLevel = m_CompressionLevel;
+  rval->m_NumberOfLevels = m_NumberOfLevels;
+  rval->m_Level = m_Level;
+
+  return loPtr;
+}
+
+bool
+ZarrImageIO::CanCloneSettings() const
+{
+  return typeid( *this ) == typeid( Self );
+}
+
+void
+ZarrImageIO::SetChunkSize(const ChunkSizeType & chunkSize)
+{
+  if ( m_ChunkSize != chunkSize )
+    {
+    m_ChunkSize = chunkSize;
+    this->Modified();
+    }
+}
+
+bool
+ZarrImageIO::CanReadFile(const char *filename)
+{
+  const std::string storePath = GetStorePath(filename);
+  if ( storePath.empty() || !itksys::SystemTools::FileIsDirectory(storePath) )
+    {
+    return false;
+    }
+  return itksys::SystemTools::FileExists(storePath + "/.zarray", true)
+    || itksys::SystemTools::FileExists(storePath + "/.zattrs", true);
+}
+
+bool
+ZarrImageIO::CanWriteFile(const char *filename)
+{
+  const std::string storePath = GetStorePath(filename);
+  if ( storePath.empty() )
+    {
+    return false;
+    }
+  return this->HasSupportedWriteExtension(storePath.c_str(), false);
+}
+
+void
+ZarrImageIO::ReadArrayInformation(ArrayType & array, bool hasComponentAxis) const
+{
+  const std::string fileName = array.m_Path + "/.zarray";
+  std::string       text;
+  if ( !ReadTextFile(fileName, text) )
+    {
+    itkExceptionMacro( "Could not read " << fileName );
+    }
+  const JSONValue meta = JSONParser(text, fileName).Parse();
+
+  const JSONValue *format = meta.Find("zarr_format");
+  if ( format != nullptr && ( format->m_Type != JSONValue::Number || format->m_Number != 2 ) )
+    {
+    itkExceptionMacro( "Unsupported zarr_format in " << fileName );
+    }
+
+  std::vector< SizeValueType > shape;
+  std::vector< SizeValueType > chunks;
+  if ( !GetSizes(meta.Find("shape"), shape) || !GetSizes(meta.Find("chunks"), chunks)
+       || shape.size() != chunks.size() || shape.size() < ( hasComponentAxis ? 2u : 1u )
+       || std::find(chunks.begin(), chunks.end(), 0) != chunks.end() )
+    {
+    itkExceptionMacro( "Missing or invalid shape or chunks in " << fileName );
+    }
+
+  const std::string dataType = GetString( meta.Find("dtype") );
+  if ( !ParseDataType(dataType, array.m_ComponentType, array.m_SwapBytes) )
+    {
+    itkExceptionMacro( "Unsupported dtype \"" << dataType << "\" in " << fileName );
+    }
+
+  const JSONValue *order = meta.Find("order");
+  if ( order != nullptr && GetString(order) != "C" )
+    {
+    itkExceptionMacro( "Only the C order is supported, in " << fileName );
+    }
+
+  const JSONValue *filters = meta.Find("filters");
+  if ( filters != nullptr && filters->m_Type != JSONValue::Null
+       && !( filters->m_Type == JSONValue::Array && filters->m_Elements.empty() ) )
+    {
+    itkExceptionMacro( "Filters are not supported, in " << fileName );
+    }
+
+  const JSONValue *compressor = meta.Find("compressor");
+  array.m_Compressed = false;
+  if ( compressor != nullptr && compressor->m_Type != JSONValue::Null )
+    {
+    const std::string id = GetString( compressor->Find("id") );
+    if ( id != "zlib" && id != "gzip" )
+      {
+      itkExceptionMacro( "Unsupported compressor \"" << id << "\" in " << fileName );
+      }
+    array.m_Compressed = true;
+    }
+
+  const JSONValue *separator = meta.Find("dimension_separator");
+  array.m_DimensionSeparator = '.';
+  if ( separator != nullptr )
+    {
+    const std::string value = GetString(separator);
+    if ( value != "." && value != "/" )
+      {
+      itkExceptionMacro( "Invalid dimension_separator in " << fileName );
+      }
+    array.m_DimensionSeparator = value[0];
+    }
+
+  const JSONValue *fillValue = meta.Find("fill_value");
+  array.m_FillValue = 0.0;
+  if ( fillValue != nullptr && fillValue->m_Type == JSONValue::Number )
+    {
+    array.m_FillValue = fillValue->m_Number;
+    }
+  else if ( fillValue != nullptr && fillValue->m_Type == JSONValue::String )
+    {
+    // floating point fill values that JSON numbers cannot hold
+    if ( fillValue->m_String == "NaN" )
+      {
+      array.m_FillValue = std::numeric_limits< double >::quiet_NaN();
+      }
+    else if ( fillValue->m_String == "Infinity" || fillValue->m_String == "-Infinity" )
+      {
+      array.m_FillValue = ( fillValue->m_String[0] == '-' ? -1 : 1 ) * std::numeric_limits< double >::infinity();
+      }
+    }
+  if ( array.m_ComponentType != FLOAT && array.m_ComponentType != DOUBLE && !std::isfinite(array.m_FillValue) )
+    {
+    array.m_FillValue = 0.0;
+    }
+
+  array.m_HasComponentAxis = hasComponentAxis;
+  array.m_NumberOfComponents = 1;
+  if ( hasComponentAxis )
+    {
+    if ( chunks.back() != shape.back() )
+      {
+      itkExceptionMacro( "Chunks holding part of the components are not supported, in " << fileName );
+      }
+    array.m_NumberOfComponents = static_cast< unsigned int >( shape.back() );
+    shape.pop_back();
+    chunks.pop_back();
+    }
+
+  // the axes of the array are listed slowest first
+  array.m_Size.assign( shape.rbegin(), shape.rend() );
+  array.m_ChunkSize.assign( chunks.rbegin(), chunks.rend() );
+  array.m_Spacing.assign(array.m_Size.size(), 1.0);
+  array.m_Origin.assign(array.m_Size.size(), 0.0);
+}
+
+void
+ZarrImageIO::ReadStoreInformation(const std::string & storePath, std::vector< ArrayType > & levels,
+                                  std::vector< std::vector< double > > & direction) const
+{
+  levels.clear();
+
+  JSONValue         attributes;
+  const JSONValue * multiscale = nullptr;
+  const std::string attributesFileName = storePath + "/.zattrs";
+  std::string       text;
+  if ( ReadTextFile(attributesFileName, text) )
+    {
+    attributes = JSONParser(text, attributesFileName).Parse();
+    const JSONValue *multiscales = attributes.Find("multiscales");
+    if ( multiscales != nullptr && multiscales->m_Type == JSONValue::Array && !multiscales->m_Elements.empty() )
+      {
+      multiscale = &multiscales->m_Elements[0];
+      }
+    }
+
+  if ( multiscale == nullptr )
+    {
+    // a plain array
+    ArrayType array;
+    array.m_Path = storePath;
+    this->ReadArrayInformation(array, false);
+    levels.push_back(array);
+    }
+  else
+    {
+    bool             hasComponentAxis = false;
+    const JSONValue *axes = multiscale->Find("axes");
+    if ( axes != nullptr && axes->m_Type == JSONValue::Array )
+      {
+      for ( size_t ii = 0; ii < axes->m_Elements.size(); ++ii )
+        {
+        // axes are objects since version 0.4, and names before
+        const JSONValue & axis = axes->m_Elements[ii];
+        const std::string name = axis.m_Type == JSONValue::String ? axis.m_String : GetString( axis.Find("name") );
+        const std::string type = GetString( axis.Find("type") );
+        if ( type == "channel" || ( type.empty() && name == "c" ) )
+          {
+          if ( ii + 1 != axes->m_Elements.size() )
+            {
+            itkExceptionMacro( "Only a channel axis listed last is supported, in " << attributesFileName );
+            }
+          hasComponentAxis = true;
+          }
+        }
+      }
+
+    const JSONValue *datasets = multiscale->Find("datasets");
+    if ( datasets == nullptr || datasets->m_Type != JSONValue::Array || datasets->m_Elements.empty() )
+      {
+      itkExceptionMacro( "No datasets in " << attributesFileName );
+      }
+    for ( const auto & dataset : datasets->m_Elements )
+      {
+      const std::string path = GetString( dataset.Find("path") );
+      if ( path.empty() )
+        {
+        itkExceptionMacro( "Dataset without a path in " << attributesFileName );
+        }
+      ArrayType array;
+      array.m_Path = storePath + "/" + path;
+      this->ReadArrayInformation(array, hasComponentAxis);
+
+      const size_t     dimension = array.m_Size.size();
+      const JSONValue *transformations = dataset.Find("coordinateTransformations");
+      if ( transformations != nullptr && transformations->m_Type == JSONValue::Array )
+        {
+        for ( const auto & transformation : transformations->m_Elements )
+          {
+          const std::string     type = GetString( transformation.Find("type") );
+          std::vector< double > values;
+          if ( ( type != "scale" && type != "translation" )
+               || !GetNumbers(transformation.Find(type), values) )
+            {
+            continue;
+            }
+          if ( values.size() != dimension + ( hasComponentAxis ? 1 : 0 ) )
+            {
+            itkExceptionMacro( "The " << type << " of " << path << " does not match its array, in "
+                                      << attributesFileName );
+            }
+          std::vector< double > & parameters = type == "scale" ? array.m_Spacing : array.m_Origin;
+          for ( size_t d = 0; d < dimension; ++d )
+            {
+            parameters[d] = values[dimension - 1 - d];
+            }
+          }
+        }
+      levels.push_back(array);
+      }
+    }
+
+  const size_t dimension = levels[0].m_Size.size();
+  for ( const auto & level : levels )
+    {
+    if ( level.m_Size.size() != dimension || level.m_ComponentType != levels[0].m_ComponentType
+         || level.m_NumberOfComponents != levels[0].m_NumberOfComponents )
+      {
+      itkExceptionMacro( "The levels of " << storePath << " have different dimensions or pixel types" );
+      }
+    }
+
+  direction.assign( dimension, std::vector< double >(dimension, 0.0) );
+  for ( size_t d = 0; d < dimension; ++d )
+    {
+    direction[d][d] = 1.0;
+    }
+  const JSONValue *itkAttributes = attributes.Find("itk");
+  const JSONValue *directionValue = itkAttributes != nullptr ? itkAttributes->Find("direction") : nullptr;
+  if ( directionValue != nullptr && directionValue->m_Type == JSONValue::Array
+       && directionValue->m_Elements.size() == dimension )
+    {
+    for ( size_t d = 0; d < dimension; ++d )
+      {
+      std::vector< double > axis;
+      if ( GetNumbers(&directionValue->m_Elements[d], axis) && axis.size() == dimension )
+        {
+        direction[d] = axis;
+        }
+      }
+    }
+}
+
+void
+ZarrImageIO::ReadImageInformation()
+{
+  std::vector< std::vector< double > > direction;
+  this->ReadStoreInformation(GetStorePath(m_FileName), m_Levels, direction);
+
+  m_NumberOfLevels = static_cast< unsigned int >( m_Levels.size() );
+  if ( m_Level >= m_NumberOfLevels )
+    {
+    itkExceptionMacro( "Level " << m_Level << " requested from " << m_FileName << ", which has "
+                                << m_NumberOfLevels << " levels" );
+    }
+  const ArrayType & level = m_Levels[m_Level];
+
+  const auto dimension = static_cast< unsigned int >( level.m_Size.size() );
+  this->SetNumberOfDimensions(dimension);
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    this->SetDimensions(d, level.m_Size[d]);
+    this->SetSpacing(d, level.m_Spacing[d]);
+    this->SetOrigin(d, level.m_Origin[d]);
+    this->SetDirection(d, direction[d]);
+    }
+  this->SetComponentType(level.m_ComponentType);
+  this->SetNumberOfComponents(level.m_NumberOfComponents);
+  this->SetPixelType(level.m_NumberOfComponents > 1 ? VECTOR : SCALAR);
+  this->ComputeStrides();
+}
+
+ImageIORegion
+ZarrImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if ( !m_UseStreamedReading )
+    {
+    return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+    }
+
+  const unsigned int nDims = std::max( this->GetNumberOfDimensions(), requestedRegion.GetImageDimension() );
+  ImageIORegion streamableRegion(nDims);
+  for ( unsigned int i = 0; i < nDims; i++ )
+    {
+    if ( i < requestedRegion.GetImageDimension() )
+      {
+      streamableRegion.SetIndex(i, requestedRegion.GetIndex(i));
+      streamableRegion.SetSize(i, requestedRegion.GetSize(i));
+      }
+    else
+      {
+      streamableRegion.SetIndex(i, 0);
+      streamableRegion.SetSize(i, i < this->GetNumberOfDimensions() ? this->GetDimensions(i) : 1);
+      }
+    }
+  return streamableRegion;
+}
+
+void
+ZarrImageIO::Read(void *buffer)
+{
+  if ( m_Level >= m_Levels.size() )
+    {
+    itkExceptionMacro( "ReadImageInformation must be called before Read, for level " << m_Level );
+    }
+  const ArrayType & level = m_Levels[m_Level];
+  this->ReadRegion( level, GetArrayRegion( m_IORegion, static_cast< unsigned int >( level.m_Size.size() ) ),
+                    buffer, true );
+}
+
+std::vector< ZarrImageIO::ArrayType >
+ZarrImageIO::ComputeLevels() const
+{
+  const std::string  storePath = GetStorePath(m_FileName);
+  const unsigned int dimension = this->GetNumberOfDimensions();
+
+  std::vector< ArrayType > levels;
+  ArrayType                level;
+  level.m_Path = storePath + "/0";
+  level.m_Size.assign( m_Dimensions.begin(), m_Dimensions.begin() + dimension );
+  level.m_ChunkSize.resize(dimension);
+  const auto defaultChunkSize = static_cast< SizeValueType >(
+    std::max( 1l, std::lround( std::pow(DefaultChunkNumberOfPixels, 1.0 / dimension) ) ) );
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    const SizeValueType chunkSize = d < m_ChunkSize.size() && m_ChunkSize[d] > 0 ? m_ChunkSize[d] : defaultChunkSize;
+    level.m_ChunkSize[d] = std::max< SizeValueType >( 1, std::min(chunkSize, level.m_Size[d]) );
+    }
+  level.m_Spacing.assign( m_Spacing.begin(), m_Spacing.begin() + dimension );
+  level.m_Origin.assign( m_Origin.begin(), m_Origin.begin() + dimension );
+  level.m_ComponentType = m_ComponentType;
+  level.m_NumberOfComponents = m_NumberOfComponents;
+  level.m_HasComponentAxis = m_NumberOfComponents > 1;
+  level.m_Compressed = m_UseCompression;
+  // written in little endian order
+  level.m_SwapBytes = ByteSwapper< int >::SystemIsBigEndian() && GetSizeOfComponent(m_ComponentType) > 1;
+  const std::vector< SizeValueType > chunkSize = level.m_ChunkSize;
+  levels.push_back(level);
+
+  while ( levels.size() < m_NumberOfLevels )
+    {
+    const ArrayType & previous = levels.back();
+    if ( std::count(previous.m_Size.begin(), previous.m_Size.end(), 1) == static_cast< long >( dimension ) )
+      {
+      break;
+      }
+    ArrayType next = previous;
+    std::ostringstream path;
+    path << storePath << "/" << levels.size();
+    next.m_Path = path.str();
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      const unsigned int factor = previous.m_Size[d] > 1 ? 2 : 1;
+      next.m_Size[d] = ( previous.m_Size[d] + factor - 1 ) / factor;
+      next.m_ChunkSize[d] = std::min(chunkSize[d], next.m_Size[d]);
+      next.m_Spacing[d] = previous.m_Spacing[d] * factor;
+      // the center of the first block of pixels averaged
+      for ( unsigned int r = 0; r < dimension; ++r )
+        {
+        next.m_Origin[r] += m_Direction[d][r] * 0.5 * ( factor - 1 ) * previous.m_Spacing[d];
+        }
+      }
+    levels.push_back(next);
+    }
+  return levels;
+}
+
+void
+ZarrImageIO::WriteArrayInformation(const ArrayType & array) const
+{
+  std::ostringstream shape;
+  std::ostringstream chunks;
+  for ( size_t d = array.m_Size.size(); d-- > 0; )
+    {
+    shape << array.m_Size[d] << ( d > 0 ? ", " : "" );
+    chunks << array.m_ChunkSize[d] << ( d > 0 ? ", " : "" );
+    }
+  if ( array.m_HasComponentAxis )
+    {
+    shape << ", " << array.m_NumberOfComponents;
+    chunks << ", " << array.m_NumberOfComponents;
+    }
+
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"zarr_format\": 2,\n"
+       << "  \"shape\": [" << shape.str() << "],\n"
+       << "  \"chunks\": [" << chunks.str() << "],\n"
+       << "  \"dtype\": \"" << GetDataType(array.m_ComponentType) << "\",\n";
+  if ( array.m_Compressed )
+    {
+    json << "  \"compressor\": {\"id\": \"zlib\", \"level\": " << m_CompressionLevel << "},\n";
+    }
+  else
+    {
+    json << "  \"compressor\": null,\n";
+    }
+  json << "  \"fill_value\": 0,\n"
+       << "  \"order\": \"C\",\n"
+       << "  \"filters\": null,\n"
+       << "  \"dimension_separator\": \"" << array.m_DimensionSeparator << "\"\n"
+       << "}\n";
+  WriteTextFile(array.m_Path + "/.zarray", json.str());
+}
+
+void
+ZarrImageIO::WriteImageInformation()
+{
+  if ( m_Pasting )
+    {
+    // the store was checked by GetActualNumberOfSplitsForWriting
+    return;
+    }
+
+  if ( GetDataType(m_ComponentType).empty() )
+    {
+    itkExceptionMacro( "Unsupported component type: " << GetComponentTypeAsString(m_ComponentType) );
+    }
+
+  const std::string storePath = GetStorePath(m_FileName);
+  m_Levels = this->ComputeLevels();
+
+  if ( !itksys::SystemTools::MakeDirectory(storePath) )
+    {
+    itkExceptionMacro( "Could not create the directory " << storePath );
+    }
+  // remove the chunks of an image written there before
+  for ( unsigned int ii = 0;; ++ii )
+    {
+    std::ostringstream levelPath;
+    levelPath << storePath << "/" << ii;
+    if ( !itksys::SystemTools::FileIsDirectory( levelPath.str() ) )
+      {
+      break;
+      }
+    itksys::SystemTools::RemoveADirectory( levelPath.str() );
+    }
+  itksys::SystemTools::RemoveFile(storePath + "/.zarray");
+
+  WriteTextFile(storePath + "/.zgroup", "{\n  \"zarr_format\": 2\n}\n");
+
+  const auto       dimension = static_cast< unsigned int >( m_Levels[0].m_Size.size() );
+  const char *     axisNames[] = { "x", "y", "z", "t" };
+  NumberToString< double > convert;
+
+  std::ostringstream axes;
+  for ( unsigned int d = dimension; d-- > 0; )
+    {
+    if ( d < 4 )
+      {
+      axes << "{\"name\": \"" << axisNames[d] << "\", \"type\": \"" << ( d < 3 ? "space" : "time" ) << "\"}";
+      }
+    else
+      {
+      axes << "{\"name\": \"d" << d << "\"}";
+      }
+    axes << ( d > 0 || m_Levels[0].m_HasComponentAxis ? ", " : "" );
+    }
+  if ( m_Levels[0].m_HasComponentAxis )
+    {
+    axes << "{\"name\": \"c\", \"type\": \"channel\"}";
+    }
+
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"multiscales\": [\n"
+       << "    {\n"
+       << "      \"version\": \"0.4\",\n"
+       << "      \"axes\": [" << axes.str() << "],\n"
+       << "      \"datasets\": [\n";
+  for ( size_t ii = 0; ii < m_Levels.size(); ++ii )
+    {
+    std::ostringstream scale;
+    std::ostringstream translation;
+    for ( unsigned int d = dimension; d-- > 0; )
+      {
+      scale << convert(m_Levels[ii].m_Spacing[d]) << ( d > 0 ? ", " : "" );
+      translation << convert(m_Levels[ii].m_Origin[d]) << ( d > 0 ? ", " : "" );
+      }
+    if ( m_Levels[ii].m_HasComponentAxis )
+      {
+      scale << ", 1";
+      translation << ", 0";
+      }
+    json << "        {\"path\": \"" << ii << "\", \"coordinateTransformations\": ["
+         << "{\"type\": \"scale\", \"scale\": [" << scale.str() << "]}, "
+         << "{\"type\": \"translation\", \"translation\": [" << translation.str() << "]}]}"
+         << ( ii + 1 < m_Levels.size() ? "," : "" ) << "\n";
+    }
+  json << "      ]\n"
+       << "    }\n"
+       << "  ],\n"
+       << "  \"itk\": {\n"
+       << "    \"direction\": [";
+  for ( unsigned int d = 0; d < dimension; ++d )
+    {
+    json << "[";
+    for ( unsigned int r = 0; r < dimension; ++r )
+      {
+      json << convert(m_Direction[d][r]) << ( r + 1 < dimension ? ", " : "" );
+      }
+    json << "]" << ( d + 1 < dimension ? ", " : "" );
+    }
+  json << "]\n"
+       << "  }\n"
+       << "}\n";
+  WriteTextFile(storePath + "/.zattrs", json.str());
+
+  for ( const auto & level : m_Levels )
+    {
+    if ( !itksys::SystemTools::MakeDirectory(level.m_Path) )
+      {
+      itkExceptionMacro( "Could not create the directory " << level.m_Path );
+      }
+    this->WriteArrayInformation(level);
+    }
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWriting(unsigned int numberOfRequestedSplits,
+                                               const ImageIORegion & pasteRegion,
+                                               const ImageIORegion & largestPossibleRegion)
+{
+  m_NumberOfPixelsWritten = 0;
+  m_PasteRegion = pasteRegion;
+  m_Pasting = pasteRegion != largestPossibleRegion;
+
+  if ( !m_Pasting )
+    {
+    m_Levels = this->ComputeLevels();
+    return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+    }
+
+  // The region is pasted into the image already in the file, which must
+  // match the one written.
+  std::vector< std::vector< double > > direction;
+  try
+    {
+    this->ReadStoreInformation(GetStorePath(m_FileName), m_Levels, direction);
+    }
+  catch ( ExceptionObject & e )
+    {
+    m_Pasting = false;
+    itkExceptionMacro( "Cannot paste into " << m_FileName << ": " << e.GetDescription() );
+    }
+  const ArrayType & level = m_Levels[0];
+  bool matches = level.m_Size.size() == this->GetNumberOfDimensions()
+    && level.m_ComponentType == m_ComponentType && level.m_NumberOfComponents == m_NumberOfComponents;
+  for ( unsigned int d = 0; matches && d < level.m_Size.size(); ++d )
+    {
+    matches = level.m_Size[d] == m_Dimensions[d];
+    }
+  // the levels are updated assuming each one halves the previous one
+  for ( size_t ii = 1; matches && ii < m_Levels.size(); ++ii )
+    {
+    for ( unsigned int d = 0; matches && d < level.m_Size.size(); ++d )
+      {
+      const SizeValueType previous = m_Levels[ii - 1].m_Size[d];
+      matches = m_Levels[ii].m_Size[d] == ( previous > 1 ? ( previous + 1 ) / 2 : 1 );
+      }
+    }
+  if ( !matches )
+    {
+    m_Pasting = false;
+    itkExceptionMacro( "Cannot paste into " << m_FileName
+                       << ": its size, pixel type or levels do not match the image written" );
+    }
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+}
+
+unsigned int
+ZarrImageIO::GetActualNumberOfSplitsForWritingCanStreamWrite(unsigned int numberOfRequestedSplits,
+                                                             const ImageIORegion & pasteRegion) const
+{
+  if ( m_Levels.empty() )
+    {
+    return Superclass::GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+    }
+  unsigned int  dimension;
+  SizeValueType numberOfChunks;
+  if ( numberOfRequestedSplits < 2
+       || !GetSplitDimension(m_Levels[0].m_ChunkSize, pasteRegion, dimension, numberOfChunks) )
+    {
+    return 1;
+    }
+  return static_cast< unsigned int >( std::min< SizeValueType >( numberOfRequestedSplits, numberOfChunks ) );
+}
+
+ImageIORegion
+ZarrImageIO::GetSplitRegionForWritingCanStreamWrite(unsigned int ithPiece,
+                                                    unsigned int numberOfActualSplits,
+                                                    const ImageIORegion & pasteRegion) const
+{
+  if ( m_Levels.empty() )
+    {
+    return Superclass::GetSplitRegionForWritingCanStreamWrite(ithPiece, numberOfActualSplits, pasteRegion);
+    }
+  ImageIORegion splitRegion = pasteRegion;
+  unsigned int  d;
+  SizeValueType numberOfChunks;
+  if ( numberOfActualSplits < 2
+       || !GetSplitDimension(m_Levels[0].m_ChunkSize, pasteRegion, d, numberOfChunks) )
+    {
+    return splitRegion;
+    }
+  // whole chunks along the split dimension
+  const SizeValueType  chunkSize = m_Levels[0].m_ChunkSize[d];
+  const SizeValueType  firstChunk = static_cast< SizeValueType >( pasteRegion.GetIndex(d) ) / chunkSize;
+  const IndexValueType begin = std::max( pasteRegion.GetIndex(d), static_cast< IndexValueType >(
+    ( firstChunk + ithPiece * numberOfChunks / numberOfActualSplits ) * chunkSize ) );
+  const IndexValueType end = std::min( pasteRegion.GetIndex(d) + static_cast< IndexValueType >( pasteRegion.GetSize(d) ),
+    static_cast< IndexValueType >( ( firstChunk + ( ithPiece + 1 ) * numberOfChunks / numberOfActualSplits )
+                                   * chunkSize ) );
+  splitRegion.SetIndex(d, begin);
+  splitRegion.SetSize( d, static_cast< SizeValueType >( end - begin ) );
+  return splitRegion;
+}
+
+void
+ZarrImageIO::Write(const void *buffer)
+{
+  if ( m_NumberOfPixelsWritten == 0 )
+    {
+    this->WriteImageInformation();
+    }
+  if ( m_Levels.empty() )
+    {
+    m_Levels = this->ComputeLevels();
+    }
+
+  const ArrayType &   level = m_Levels[0];
+  const auto          dimension = static_cast< unsigned int >( level.m_Size.size() );
+  const ImageIORegion region = GetArrayRegion(m_IORegion, dimension);
+  this->WriteRegion(level, region, buffer, true);
+
+  // the levels are computed once every piece is written
+  m_NumberOfPixelsWritten += region.GetNumberOfPixels();
+  const ImageIORegion writtenRegion = m_Pasting ? GetArrayRegion(m_PasteRegion, dimension)
+                                                : GetWholeRegion(level.m_Size);
+  if ( m_NumberOfPixelsWritten >= writtenRegion.GetNumberOfPixels() )
+    {
+    m_NumberOfPixelsWritten = 0;
+    m_Pasting = false;
+    this->WriteLevels(writtenRegion);
+    }
+}
+
+void
+ZarrImageIO::WriteLevels(const ImageIORegion & region) const
+{
+  ImageIORegion levelRegion = region;
+  for ( size_t ii = 1; ii < m_Levels.size(); ++ii )
+    {
+    const ArrayType &  input = m_Levels[ii - 1];
+    const ArrayType &  output = m_Levels[ii];
+    const auto         dimension = static_cast< unsigned int >( output.m_Size.size() );
+    const SizeValueType pixelSize = GetSizeOfComponent(output.m_ComponentType) * output.m_NumberOfComponents;
+
+    // the pixels of this level averaging pixels of the region
+    std::vector< unsigned int > factor(dimension);
+    ImageIORegion               outputRegion(dimension);
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      factor[d] = input.m_Size[d] > 1 ? 2 : 1;
+      const auto          begin = static_cast< SizeValueType >( levelRegion.GetIndex(d) );
+      const SizeValueType end = std::min( ( begin + levelRegion.GetSize(d) + factor[d] - 1 ) / factor[d],
+                                          output.m_Size[d] );
+      outputRegion.SetIndex( d, static_cast< IndexValueType >( begin / factor[d] ) );
+      outputRegion.SetSize(d, end - begin / factor[d]);
+      }
+
+    // Each chunk of the level is computed by a single job, from the
+    // pixels of the previous level it covers.
+    std::vector< SizeValueType > firstChunk;
+    std::vector< SizeValueType > numberOfChunks;
+    const SizeValueType          total = GetChunkRange(output.m_ChunkSize, outputRegion, firstChunk, numberOfChunks);
+    ForEachChunk( total, true, [&]( SizeValueType chunk )
+      {
+      const ImageIORegion chunkRegion =
+        GetChunkRegion( output.m_ChunkSize, GetChunkIndex(chunk, firstChunk, numberOfChunks) );
+      const ImageIORegion outputBox = Intersect(chunkRegion, outputRegion);
+      ImageIORegion       inputBox(dimension);
+      for ( unsigned int d = 0; d < dimension; ++d )
+        {
+        const SizeValueType begin = static_cast< SizeValueType >( outputBox.GetIndex(d) ) * factor[d];
+        const SizeValueType end = std::min( ( outputBox.GetIndex(d) + outputBox.GetSize(d) ) * factor[d],
+                                            input.m_Size[d] );
+        inputBox.SetIndex( d, static_cast< IndexValueType >( begin ) );
+        inputBox.SetSize(d, end - begin);
+        }
+
+      std::vector< char > inputBuffer( inputBox.GetNumberOfPixels() * pixelSize );
+      this->ReadRegion(input, inputBox, inputBuffer.data(), false);
+      std::vector< char > outputBuffer( outputBox.GetNumberOfPixels() * pixelSize );
+      const Downsampler downsampler = { inputBuffer.data(), &inputBox, outputBuffer.data(), &outputBox,
+                                        &factor, output.m_NumberOfComponents };
+      DispatchComponentType(output.m_ComponentType, downsampler);
+      this->WriteRegion(output, outputBox, outputBuffer.data(), false);
+      } );
+
+    levelRegion = outputRegion;
+    }
+}
+
+std::string
+ZarrImageIO::GetChunkFileName(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex) const
+{
+  // the axes of the array are listed slowest first
+  std::ostringstream fileName;
+  fileName << array.m_Path << '/';
+  for ( size_t d = chunkIndex.size(); d-- > 0; )
+    {
+    fileName << chunkIndex[d] << ( d > 0 ? std::string(1, array.m_DimensionSeparator) : std::string() );
+    }
+  if ( array.m_HasComponentAxis )
+    {
+    fileName << array.m_DimensionSeparator << 0;
+    }
+  return fileName.str();
+}
+
+void
+ZarrImageIO::ReadChunk(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex, char *chunk) const
+{
+  const unsigned int componentSize = GetSizeOfComponent(array.m_ComponentType);
+  SizeValueType      numberOfValues = array.m_NumberOfComponents;
+  for ( SizeValueType size : array.m_ChunkSize )
+    {
+    numberOfValues *= size;
+    }
+  const SizeValueType numberOfBytes = numberOfValues * componentSize;
+
+  const std::string fileName = this->GetChunkFileName(array, chunkIndex);
+  std::ifstream     file( fileName.c_str(), std::ios::in | std::ios::binary );
+  if ( !file.is_open() )
+    {
+    // chunks holding only the fill value need not be stored
+    if ( array.m_FillValue == 0.0 )
+      {
+      std::memset(chunk, 0, numberOfBytes);
+      }
+    else
+      {
+      const ChunkFiller filler = { chunk, numberOfValues, array.m_FillValue };
+      DispatchComponentType(array.m_ComponentType, filler);
+      }
+    return;
+    }
+
+  file.seekg(0, std::ios::end);
+  const auto length = static_cast< SizeValueType >( file.tellg() );
+  file.seekg(0, std::ios::beg);
+  if ( !array.m_Compressed )
+    {
+    if ( length != numberOfBytes || !file.read(chunk, numberOfBytes) )
+      {
+      itkExceptionMacro( "Could not read the " << numberOfBytes << " bytes of " << fileName );
+      }
+    }
+  else
+    {
+    std::vector< char > compressed(length);
+    if ( ( length > 0 && !file.read(compressed.data(), length) ) || !Inflate(compressed, chunk, numberOfBytes) )
+      {
+      itkExceptionMacro( "Could not decompress the " << numberOfBytes << " bytes of " << fileName );
+      }
+    }
+
+  if ( array.m_SwapBytes )
+    {
+    SwapBytes(chunk, numberOfValues, componentSize);
+    }
+}
+
+void
+ZarrImageIO::WriteChunk(const ArrayType & array, const std::vector< SizeValueType > & chunkIndex, char *chunk) const
+{
+  const unsigned int componentSize = GetSizeOfComponent(array.m_ComponentType);
+  SizeValueType      numberOfValues = array.m_NumberOfComponents;
+  for ( SizeValueType size : array.m_ChunkSize )
+    {
+    numberOfValues *= size;
+    }
+  const SizeValueType numberOfBytes = numberOfValues * componentSize;
+
+  if ( array.m_SwapBytes )
+    {
+    SwapBytes(chunk, numberOfValues, componentSize);
+    }
+
+  const char *        data = chunk;
+  SizeValueType       length = numberOfBytes;
+  std::vector< char > compressed;
+  const std::string   fileName = this->GetChunkFileName(array, chunkIndex);
+  if ( array.m_Compressed )
+    {
+    uLongf compressedLength = compressBound( static_cast< uLong >( numberOfBytes ) );
+    compressed.resize(compressedLength);
+    if ( compress2(reinterpret_cast< Bytef * >( compressed.data() ), &compressedLength,
+                   reinterpret_cast< const Bytef * >( chunk ), static_cast< uLong >( numberOfBytes ),
+                   m_CompressionLevel) != Z_OK )
+      {
+      itkExceptionMacro( "Could not compress " << fileName );
+      }
+    data = compressed.data();
+    length = compressedLength;
+    }
+
+  if ( array.m_DimensionSeparator == '/' )
+    {
+    itksys::SystemTools::MakeDirectory( itksys::SystemTools::GetFilenamePath(fileName) );
+    }
+  std::ofstream file( fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+  if ( !file.is_open() || !file.write(data, length) )
+    {
+    itkExceptionMacro( "Could not write " << fileName );
+    }
+}
+
+void
+ZarrImageIO::ReadRegion(const ArrayType & array, const ImageIORegion & region, void *buffer,
+                        bool concurrently) const
+{
+  std::vector< SizeValueType > firstChunk;
+  std::vector< SizeValueType > numberOfChunks;
+  const SizeValueType          total = GetChunkRange(array.m_ChunkSize, region, firstChunk, numberOfChunks);
+  const SizeValueType          pixelSize = GetSizeOfComponent(array.m_ComponentType) * array.m_NumberOfComponents;
+  const SizeValueType          chunkBytes = GetWholeRegion(array.m_ChunkSize).GetNumberOfPixels() * pixelSize;
+  auto *                       output = static_cast< char * >( buffer );
+
+  ForEachChunk( total, concurrently, [&]( SizeValueType chunk )
+    {
+    const std::vector< SizeValueType > chunkIndex = GetChunkIndex(chunk, firstChunk, numberOfChunks);
+    const ImageIORegion                chunkRegion = GetChunkRegion(array.m_ChunkSize, chunkIndex);
+    std::vector< char >                chunkBuffer(chunkBytes);
+    this->ReadChunk(array, chunkIndex, chunkBuffer.data());
+    CopyRegion(chunkBuffer.data(), chunkRegion, output, region, Intersect(chunkRegion, region), pixelSize);
+    } );
+}
+
+void
+ZarrImageIO::WriteRegion(const ArrayType & array, const ImageIORegion & region, const void *buffer,
+                         bool concurrently) const
+{
+  std::vector< SizeValueType > firstChunk;
+  std::vector< SizeValueType > numberOfChunks;
+  const SizeValueType          total = GetChunkRange(array.m_ChunkSize, region, firstChunk, numberOfChunks);
+  const SizeValueType          pixelSize = GetSizeOfComponent(array.m_ComponentType) * array.m_NumberOfComponents;
+  const SizeValueType          chunkBytes = GetWholeRegion(array.m_ChunkSize).GetNumberOfPixels() * pixelSize;
+  const ImageIORegion          arrayRegion = GetWholeRegion(array.m_Size);
+  const auto *                 input = static_cast< const char * >( buffer );
+
+  ForEachChunk( total, concurrently, [&]( SizeValueType chunk )
+    {
+    const std::vector< SizeValueType > chunkIndex = GetChunkIndex(chunk, firstChunk, numberOfChunks);
+    const ImageIORegion                chunkRegion = GetChunkRegion(array.m_ChunkSize, chunkIndex);
+    const ImageIORegion                written = Intersect(chunkRegion, region);
+    std::vector< char >                chunkBuffer(chunkBytes);
+    // merge into the pixels of the chunk the region does not cover
+    if ( written != Intersect(chunkRegion, arrayRegion) )
+      {
+      this->ReadChunk(array, chunkIndex, chunkBuffer.data());
+      }
+    CopyRegion(input, region, chunkBuffer.data(), chunkRegion, written, pixelSize);
+    this->WriteChunk(array, chunkIndex, chunkBuffer.data());
+    } );
+}
+
+} // end namespace itk
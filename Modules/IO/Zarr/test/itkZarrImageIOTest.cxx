@@ -0,0 +1,405 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkZarrImageIO.h"
+#include "itkZarrImageIOFactory.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <fstream>
+
+// Write images as chunked stores, in pieces, with resolution levels, and
+// read them back whole, streamed and level by level. Then paste a region
+// into a store and read a hand written big endian array with missing
+// chunks.
+
+namespace
+{
+
+using ImageType = itk::Image< short, 3 >;
+using ReaderType = itk::ImageFileReader< ImageType >;
+using WriterType = itk::ImageFileWriter< ImageType >;
+
+const unsigned int NumberOfDivisions = 4;
+
+itk::ZarrImageIO::Pointer
+CreateImageIO( unsigned int numberOfLevels )
+{
+  itk::ZarrImageIO::Pointer zarrIO = itk::ZarrImageIO::New();
+  itk::ZarrImageIO::ChunkSizeType chunkSize;
+  chunkSize.push_back( 16 );
+  chunkSize.push_back( 8 );
+  chunkSize.push_back( 5 );
+  zarrIO->SetChunkSize( chunkSize );
+  zarrIO->SetNumberOfLevels( numberOfLevels );
+  return zarrIO;
+}
+
+int
+CompareImages( const ImageType * expected, const ImageType * image, const std::string & name )
+{
+  TEST_EXPECT_EQUAL( image->GetLargestPossibleRegion(), expected->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( image->GetSpacing(), expected->GetSpacing() );
+  TEST_EXPECT_EQUAL( image->GetOrigin(), expected->GetOrigin() );
+  TEST_EXPECT_EQUAL( image->GetDirection(), expected->GetDirection() );
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( expected, expected->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( image->GetPixel( it.GetIndex() ) != it.Get() )
+      {
+      std::cerr << name << ": wrong value at " << it.GetIndex() << ": " << image->GetPixel( it.GetIndex() )
+                << " expected " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+ImageType::Pointer
+ReadImage( const std::string & fileName, unsigned int level = 0 )
+{
+  itk::ZarrImageIO::Pointer zarrIO = itk::ZarrImageIO::New();
+  zarrIO->SetLevel( level );
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetImageIO( zarrIO );
+  reader->SetFileName( fileName );
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// The rounded average of the block of pixels of the previous level
+short
+GetAverage( const ImageType * image, const ImageType::IndexType & index )
+{
+  const ImageType::SizeType size = image->GetLargestPossibleRegion().GetSize();
+  double sum = 0;
+  unsigned int count = 0;
+  for ( unsigned int neighbor = 0; neighbor < 8; ++neighbor )
+    {
+    ImageType::IndexType inputIndex;
+    bool inside = true;
+    for ( unsigned int d = 0; d < 3; ++d )
+      {
+      inputIndex[d] = 2 * index[d] + ( ( neighbor >> d ) & 1 );
+      inside = inside && inputIndex[d] < static_cast< itk::IndexValueType >( size[d] );
+      }
+    if ( inside )
+      {
+      sum += image->GetPixel( inputIndex );
+      ++count;
+      }
+    }
+  return static_cast< short >( std::floor( sum / count + 0.5 ) );
+}
+
+int
+CheckLevel( const ImageType * previous, const std::string & fileName, unsigned int level )
+{
+  ImageType::Pointer image;
+  TRY_EXPECT_NO_EXCEPTION( image = ReadImage( fileName, level ) );
+  const ImageType::SizeType previousSize = previous->GetLargestPossibleRegion().GetSize();
+  for ( unsigned int d = 0; d < 3; ++d )
+    {
+    TEST_EXPECT_EQUAL( image->GetLargestPossibleRegion().GetSize()[d], ( previousSize[d] + 1 ) / 2 );
+    TEST_EXPECT_EQUAL( image->GetSpacing()[d], 2.0 * previous->GetSpacing()[d] );
+    }
+  // the center of the first block of the previous level
+  itk::ContinuousIndex< double, 3 > center;
+  center.Fill( 0.5 );
+  ImageType::PointType expectedOrigin;
+  previous->TransformContinuousIndexToPhysicalPoint( center, expectedOrigin );
+  for ( unsigned int d = 0; d < 3; ++d )
+    {
+    TEST_EXPECT_TRUE( std::abs( image->GetOrigin()[d] - expectedOrigin[d] ) < 1e-9 );
+    }
+
+  itk::ImageRegionConstIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != GetAverage( previous, it.GetIndex() ) )
+      {
+      std::cerr << fileName << " level " << level << ": wrong value at " << it.GetIndex() << ": " << it.Get()
+                << " expected " << GetAverage( previous, it.GetIndex() ) << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkZarrImageIOTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkZarrImageIOTest";
+
+  itk::ZarrImageIOFactory::RegisterOneFactory();
+
+  itk::ZarrImageIO::Pointer zarrIO = itk::ZarrImageIO::New();
+  EXERCISE_BASIC_OBJECT_METHODS( zarrIO, ZarrImageIO, ImageIOBase );
+  TEST_EXPECT_TRUE( zarrIO->CanStreamRead() );
+  TEST_EXPECT_TRUE( zarrIO->CanStreamWrite() );
+  TEST_EXPECT_TRUE( zarrIO->CanWriteFile( "image.zarr" ) );
+  TEST_EXPECT_TRUE( !zarrIO->CanWriteFile( "image.mha" ) );
+
+  // An image whose size is not a multiple of the chunk size
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+  size[2] = 23;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.75;
+  spacing[2] = 2.0;
+  image->SetSpacing( spacing );
+  ImageType::PointType origin;
+  origin[0] = -10.0;
+  origin[1] = 3.5;
+  origin[2] = 100.25;
+  image->SetOrigin( origin );
+  ImageType::DirectionType direction;
+  direction.Fill( 0.0 );
+  direction[0][1] = 1.0;
+  direction[1][0] = -1.0;
+  direction[2][2] = 1.0;
+  image->SetDirection( direction );
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< short >( ( index[0] * 7 + index[1] * 131 + index[2] * 1009 ) % 30011 - 15000 ) );
+    }
+
+  // Written in pieces, compressed, with levels
+  const std::string fileName = directory + ".zarr";
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( image );
+  writer->SetImageIO( CreateImageIO( 3 ) );
+  writer->SetFileName( fileName );
+  writer->SetUseCompression( true );
+  writer->SetNumberOfStreamDivisions( NumberOfDivisions );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  TEST_EXPECT_TRUE( zarrIO->CanReadFile( fileName.c_str() ) );
+  TEST_EXPECT_TRUE( zarrIO->CanReadFile( ( fileName + "/" ).c_str() ) );
+  TEST_EXPECT_TRUE( !zarrIO->CanReadFile( ( directory + "Missing.zarr" ).c_str() ) );
+  zarrIO->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( zarrIO->ReadImageInformation() );
+  TEST_EXPECT_EQUAL( zarrIO->GetNumberOfLevels(), 3 );
+
+  // read through the factory
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  TRY_EXPECT_NO_EXCEPTION( reader->Update() );
+  if ( CompareImages( image, reader->GetOutput(), fileName ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  ImageType::Pointer level1;
+  TRY_EXPECT_NO_EXCEPTION( level1 = ReadImage( fileName, 1 ) );
+  if ( CheckLevel( image, fileName, 1 ) != EXIT_SUCCESS || CheckLevel( level1, fileName, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  TRY_EXPECT_EXCEPTION( ReadImage( fileName, 3 ) );
+
+  // Copied uncompressed from a streaming reader to a streaming writer
+  const std::string streamedFileName = directory + "Streamed.zarr";
+  reader = ReaderType::New();
+  reader->SetFileName( fileName );
+  reader->SetUseStreaming( true );
+  using MonitorType = itk::PipelineMonitorImageFilter< ImageType >;
+  MonitorType::Pointer monitor = MonitorType::New();
+  monitor->SetInput( reader->GetOutput() );
+  writer = WriterType::New();
+  writer->SetInput( monitor->GetOutput() );
+  writer->SetImageIO( CreateImageIO( 1 ) );
+  writer->SetFileName( streamedFileName );
+  writer->SetNumberOfStreamDivisions( NumberOfDivisions );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+  TEST_EXPECT_TRUE( monitor->VerifyAllInputCanStream( NumberOfDivisions ) );
+
+  ImageType::Pointer streamed;
+  TRY_EXPECT_NO_EXCEPTION( streamed = ReadImage( streamedFileName ) );
+  if ( CompareImages( image, streamed, streamedFileName ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A region pasted into the store, across chunk boundaries, updates the
+  // levels
+  ImageType::RegionType pasteRegion;
+  pasteRegion.SetIndex( 0, 10 );
+  pasteRegion.SetIndex( 1, 6 );
+  pasteRegion.SetIndex( 2, 3 );
+  pasteRegion.SetSize( 0, 20 );
+  pasteRegion.SetSize( 1, 11 );
+  pasteRegion.SetSize( 2, 14 );
+  ImageType::Pointer pasted = ImageType::New();
+  pasted->CopyInformation( image );
+  pasted->SetRegions( size );
+  pasted->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > pastedIt( pasted, pasted->GetBufferedRegion() );
+  for ( pastedIt.GoToBegin(); !pastedIt.IsAtEnd(); ++pastedIt )
+    {
+    const bool inside = pasteRegion.IsInside( pastedIt.GetIndex() );
+    pastedIt.Set( inside ? static_cast< short >( 4000 + pastedIt.GetIndex()[0] )
+                         : image->GetPixel( pastedIt.GetIndex() ) );
+    }
+  itk::ImageIORegion pasteIORegion( 3 );
+  itk::ImageIORegionAdaptor< 3 >::Convert( pasteRegion, pasteIORegion, pasted->GetLargestPossibleRegion().GetIndex() );
+  writer = WriterType::New();
+  writer->SetInput( pasted );
+  writer->SetImageIO( itk::ZarrImageIO::New() );
+  writer->SetFileName( fileName );
+  writer->SetIORegion( pasteIORegion );
+  writer->SetNumberOfStreamDivisions( NumberOfDivisions );
+  TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+
+  ImageType::Pointer afterPaste;
+  TRY_EXPECT_NO_EXCEPTION( afterPaste = ReadImage( fileName ) );
+  TRY_EXPECT_NO_EXCEPTION( level1 = ReadImage( fileName, 1 ) );
+  if ( CompareImages( pasted, afterPaste, fileName + " pasted" ) != EXIT_SUCCESS
+       || CheckLevel( pasted, fileName, 1 ) != EXIT_SUCCESS || CheckLevel( level1, fileName, 2 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A pasted region must match the image in the store
+  ImageType::Pointer small = ImageType::New();
+  ImageType::SizeType smallSize;
+  smallSize.Fill( 4 );
+  small->SetRegions( smallSize );
+  small->Allocate( true );
+  writer = WriterType::New();
+  writer->SetInput( small );
+  writer->SetImageIO( itk::ZarrImageIO::New() );
+  writer->SetFileName( streamedFileName );
+  itk::ImageIORegion smallIORegion( 3 );
+  smallIORegion.SetSize( 0, 2 );
+  smallIORegion.SetSize( 1, 2 );
+  smallIORegion.SetSize( 2, 2 );
+  writer->SetIORegion( smallIORegion );
+  TRY_EXPECT_EXCEPTION( writer->Update() );
+
+  // Vector pixels, whose components are the last axis of the array
+  {
+  using VectorImageType = itk::VectorImage< float, 2 >;
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  VectorImageType::SizeType vectorSize;
+  vectorSize[0] = 300;
+  vectorSize[1] = 70;
+  vectorImage->SetRegions( vectorSize );
+  vectorImage->SetNumberOfComponentsPerPixel( 3 );
+  vectorImage->Allocate();
+  itk::ImageRegionIteratorWithIndex< VectorImageType > vit( vectorImage, vectorImage->GetBufferedRegion() );
+  for ( vit.GoToBegin(); !vit.IsAtEnd(); ++vit )
+    {
+    VectorImageType::PixelType pixel( 3 );
+    pixel[0] = 0.5f * vit.GetIndex()[0];
+    pixel[1] = -1.0f * vit.GetIndex()[1];
+    pixel[2] = 1e-3f * vit.GetIndex()[0] * vit.GetIndex()[1];
+    vit.Set( pixel );
+    }
+  const std::string vectorFileName = directory + "Vector.zarr";
+  using VectorWriterType = itk::ImageFileWriter< VectorImageType >;
+  VectorWriterType::Pointer vectorWriter = VectorWriterType::New();
+  vectorWriter->SetInput( vectorImage );
+  vectorWriter->SetFileName( vectorFileName );
+  vectorWriter->SetUseCompression( true );
+  TRY_EXPECT_NO_EXCEPTION( vectorWriter->Update() );
+
+  using VectorReaderType = itk::ImageFileReader< VectorImageType >;
+  VectorReaderType::Pointer vectorReader = VectorReaderType::New();
+  vectorReader->SetFileName( vectorFileName );
+  TRY_EXPECT_NO_EXCEPTION( vectorReader->Update() );
+  const VectorImageType * vectorRead = vectorReader->GetOutput();
+  TEST_EXPECT_EQUAL( vectorRead->GetLargestPossibleRegion(), vectorImage->GetLargestPossibleRegion() );
+  TEST_EXPECT_EQUAL( vectorRead->GetNumberOfComponentsPerPixel(), 3 );
+  for ( vit.GoToBegin(); !vit.IsAtEnd(); ++vit )
+    {
+    if ( vectorRead->GetPixel( vit.GetIndex() ) != vit.Get() )
+      {
+      std::cerr << vectorFileName << ": wrong value at " << vit.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A plain array, big endian, with chunks holding only the fill value
+  // left out
+  {
+  const std::string plainFileName = directory + "Plain.zarr";
+  itksys::SystemTools::MakeDirectory( plainFileName );
+  {
+  std::ofstream file( ( plainFileName + "/.zarray" ).c_str() );
+  file << "{\"zarr_format\": 2, \"shape\": [3, 4], \"chunks\": [2, 3], \"dtype\": \">u2\",\n"
+       << " \"compressor\": null, \"fill_value\": 7, \"order\": \"C\", \"filters\": null}\n";
+  }
+  // the chunks of the first two rows, the second one partly outside
+  for ( unsigned int chunk = 0; chunk < 2; ++chunk )
+    {
+    std::ofstream file( ( plainFileName + "/0." + ( chunk == 0 ? "0" : "1" ) ).c_str(),
+                        std::ios::out | std::ios::binary );
+    for ( unsigned int row = 0; row < 2; ++row )
+      {
+      for ( unsigned int column = 0; column < 3; ++column )
+        {
+        const unsigned int value = 100 * row + 3 * chunk + column;
+        file.put( static_cast< char >( value >> 8 ) );
+        file.put( static_cast< char >( value & 0xFF ) );
+        }
+      }
+    }
+
+  using PlainImageType = itk::Image< unsigned short, 2 >;
+  using PlainReaderType = itk::ImageFileReader< PlainImageType >;
+  PlainReaderType::Pointer plainReader = PlainReaderType::New();
+  plainReader->SetFileName( plainFileName );
+  TRY_EXPECT_NO_EXCEPTION( plainReader->Update() );
+  const PlainImageType * plain = plainReader->GetOutput();
+  TEST_EXPECT_EQUAL( plain->GetLargestPossibleRegion().GetSize()[0], 4 );
+  TEST_EXPECT_EQUAL( plain->GetLargestPossibleRegion().GetSize()[1], 3 );
+  for ( unsigned int y = 0; y < 3; ++y )
+    {
+    for ( unsigned int x = 0; x < 4; ++x )
+      {
+      PlainImageType::IndexType index;
+      index[0] = x;
+      index[1] = y;
+      const unsigned short expected = static_cast< unsigned short >( y < 2 ? 100 * y + x : 7 );
+      TEST_EXPECT_EQUAL( plain->GetPixel( index ), expected );
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,9 @@
 #include "itkVideoIOBase.h"
 #include "ITKVideoIOExport.h"
 
+#include <deque>
+#include <future>
+
 namespace itk
 {
 /** \class FileListVideoIO
@@ -33,6 +36,14 @@ namespace itk
  * SplitFileNames(...) static method is made public in order to allow the
  * splitting functionality to be accessed publicly.
  *
+ * When NumberOfPrefetchFrames is not zero, the frames following the one
+ * read are decoded ahead on the threads of the ThreadPool, so that their
+ * decoding overlaps the processing of the frames already read. The
+ * buffers and ImageIOs of the frames read are recycled for the next ones.
+ * Reading the frames in order takes them from those decoded ahead; after
+ * SetNextFrameToRead moves elsewhere, the frames decoded ahead are
+ * dropped.
+ *
  * \ingroup ITKVideoIO
  *
  */
@@ -166,10 +177,29 @@ protected:
   bool VerifyExtensions( const std::vector<std::string>& fileList ) const;
 
 private:
+  /** A frame decoded ahead, with the buffer and ImageIO decoding it. */
+  struct PrefetchedFrame
+  {
+    FrameOffsetType      m_Frame{0};
+    std::vector< char >  m_Buffer;
+    ImageIOBase::Pointer m_ImageIO;
+    std::future< void >  m_Decoded;
+  };
+
+  /** Start decoding the frames from the current one that are not yet
+   * being decoded, up to NumberOfPrefetchFrames of them. */
+  void PrefetchFrames();
+
+  /** Wait for the frames being decoded and recycle them unread. */
+  void DropPrefetchedFrames();
+
   ImageIOBase::Pointer m_ImageIO;
 
   std::vector<std::string> m_FileNames;
 
+  std::deque< PrefetchedFrame >  m_PrefetchedFrames;
+  std::vector< PrefetchedFrame > m_RecycledFrames;
+
 };
 } // end namespace itk
 
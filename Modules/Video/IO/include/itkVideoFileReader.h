@@ -84,6 +84,11 @@ public:
   itkSetMacro(IFrameSafe, bool);
   itkGetMacro(IFrameSafe, bool);
 
+  /** Number of frames after the one read that the VideoIO decodes ahead,
+   * in the background, when it is able to. Default is 0. */
+  itkSetMacro(NumberOfPrefetchFrames, unsigned int);
+  itkGetConstMacro(NumberOfPrefetchFrames, unsigned int);
+
   /** Set up the output information */
   void UpdateOutputInformation() override;
 
@@ -136,6 +141,12 @@ private:
   /** Flag to indicate whether to report the last frame as the last IFrame. On
    * by default. */
   bool m_IFrameSafe;
+
+  unsigned int m_NumberOfPrefetchFrames;
+
+  /** Buffer the frames needing a pixel conversion are read into, kept
+   * from frame to frame. */
+  std::vector< char > m_ConversionBuffer;
 };
 
 } // end namespace itk
@@ -35,6 +35,7 @@ VideoFileReader< TOutputVideoStream >
   m_VideoIO = nullptr;
   m_PixelConversionNeeded = false;
   m_IFrameSafe = true;
+  m_NumberOfPrefetchFrames = 0;
 
   // TemporalProcessObject inherited members
   this->SetUnitOutputNumberOfFrames(1);
@@ -243,6 +244,8 @@ VideoFileReader< TOutputVideoStream >
   requestedTemporalRegion = output->GetRequestedTemporalRegion();
   FrameOffsetType frameNum = requestedTemporalRegion.GetFrameStart();
 
+  m_VideoIO->SetNumberOfPrefetchFrames(m_NumberOfPrefetchFrames);
+
   // Figure out if we need to skip frames
   FrameOffsetType currentIOFrame = m_VideoIO->GetCurrentFrame();
   if (frameNum != currentIOFrame)
@@ -253,16 +256,12 @@ VideoFileReader< TOutputVideoStream >
   // Read a single frame
   if (this->m_PixelConversionNeeded)
     {
-    // Set up temporary buffer for reading
-    size_t bufferSize = m_VideoIO->GetImageSizeInBytes();
-    auto * loadBuffer = new char[bufferSize];
-
-    // Read into a temporary buffer
-    this->m_VideoIO->Read(static_cast<void*>(loadBuffer));
+    // Read into the conversion buffer
+    m_ConversionBuffer.resize(m_VideoIO->GetImageSizeInBytes());
+    this->m_VideoIO->Read(static_cast<void*>(m_ConversionBuffer.data()));
 
     // Convert the buffer into the output buffer location
-    this->DoConvertBuffer(static_cast<void*>(loadBuffer), frameNum);
-    delete[] loadBuffer;
+    this->DoConvertBuffer(static_cast<void*>(m_ConversionBuffer.data()), frameNum);
     }
   else
     {
@@ -365,6 +364,7 @@ VideoFileReader< TOutputVideoStream >
   Superclass::PrintSelf(os, indent);
 
   os << indent << "FileName: " << this->m_FileName << std::endl;
+  os << indent << "NumberOfPrefetchFrames: " << this->m_NumberOfPrefetchFrames << std::endl;
   if (m_VideoIO)
     {
     os << indent << "VideoIO:" << std::endl;
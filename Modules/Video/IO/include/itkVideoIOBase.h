@@ -103,6 +103,11 @@ public:
   virtual FrameOffsetType GetCurrentFrame() const = 0;
   virtual FrameOffsetType GetLastIFrame() const = 0;
 
+  /** Number of frames after the one read that are decoded ahead, in the
+   * background, by the VideoIOs able to. Default is 0. */
+  itkSetMacro(NumberOfPrefetchFrames, unsigned int);
+  itkGetConstMacro(NumberOfPrefetchFrames, unsigned int);
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Set Writer Parameters */
@@ -130,6 +135,7 @@ protected:
   TemporalOffsetType m_PositionInMSec{0.0};
   bool               m_WriterOpen{false};
   bool               m_ReaderOpen{false};
+  unsigned int       m_NumberOfPrefetchFrames{0};
 };
 
 } // end namespace itk
@@ -18,6 +18,9 @@
 #include "itkFileListVideoIO.h"
 
 #include "itkImageIOFactory.h"
+#include "itkThreadPool.h"
+
+#include <cstring>
 
 namespace itk
 {
@@ -58,25 +61,26 @@ FileListVideoIO
 {
   std::vector<std::string> out;
 
-  size_t pos = 0;
-  size_t len = fileList.length();
-  while (pos != std::string::npos && len > 0)
+  if (fileList.empty())
     {
-    // Get the substring
-    std::string str = fileList.substr(pos, len);
+    return out;
+    }
 
-    // Update pos
-    pos = str.find(',');
+  size_t pos = 0;
+  while (true)
+    {
+    // Find the end of the current file name
+    const size_t end = fileList.find(',', pos);
 
     // Add the filename to the list
-    out.push_back( str.substr(0,pos) );
+    out.push_back( fileList.substr(pos, end - pos) );
 
     // Move past the delimiter
-    if (pos != std::string::npos)
+    if (end == std::string::npos)
       {
-      pos++;
+      break;
       }
-    len -= pos;
+    pos = end + 1;
     }
 
   return out;
@@ -206,15 +210,124 @@ void FileListVideoIO::Read(void *buffer)
     this->OpenReader();
     }
 
-  // Read the desired frame
-  m_ImageIO->SetFileName(m_FileNames[m_CurrentFrame]);
-  m_ImageIO->Read(buffer);
+  // Jobs of the pool must not wait for other jobs, so a read nested in
+  // one decodes its frame in place
+  if (m_NumberOfPrefetchFrames > 0 && !ThreadPool::IsCurrentThreadInPool() )
+    {
+    // Frames decoded ahead are only of use when reading in order
+    if (!m_PrefetchedFrames.empty() && m_PrefetchedFrames.front().m_Frame != m_CurrentFrame)
+      {
+      this->DropPrefetchedFrames();
+      }
+    this->PrefetchFrames();
+
+    PrefetchedFrame frame = std::move(m_PrefetchedFrames.front());
+    m_PrefetchedFrames.pop_front();
+    try
+      {
+      frame.m_Decoded.get();
+      }
+    catch (...)
+      {
+      m_RecycledFrames.push_back(std::move(frame));
+      throw;
+      }
+    std::memcpy(buffer, frame.m_Buffer.data(), frame.m_Buffer.size());
+    m_RecycledFrames.push_back(std::move(frame));
+    }
+  else
+    {
+    // Read the desired frame
+    m_ImageIO->SetFileName(m_FileNames[m_CurrentFrame]);
+    m_ImageIO->Read(buffer);
+    }
 
   // Move on to the next frame
   if (m_CurrentFrame < m_FrameTotal - 1)
     {
     m_CurrentFrame++;
+
+    // Keep decoding ahead while the caller processes this frame
+    if (m_NumberOfPrefetchFrames > 0 && !ThreadPool::IsCurrentThreadInPool() )
+      {
+      this->PrefetchFrames();
+      }
+    }
+}
+
+void FileListVideoIO::PrefetchFrames()
+{
+  FrameOffsetType frame = m_CurrentFrame;
+  if (!m_PrefetchedFrames.empty() )
+    {
+    frame = m_PrefetchedFrames.back().m_Frame + 1;
+    }
+  const FrameOffsetType endFrame =
+    std::min< FrameOffsetType >(m_CurrentFrame + m_NumberOfPrefetchFrames, m_FrameTotal);
+  const SizeType frameSizeInBytes = this->GetImageSizeInBytes();
+
+  for (; frame < endFrame; ++frame)
+    {
+    PrefetchedFrame prefetched;
+    if (!m_RecycledFrames.empty() )
+      {
+      prefetched = std::move(m_RecycledFrames.back());
+      m_RecycledFrames.pop_back();
+      }
+    else
+      {
+      prefetched.m_ImageIO = ImageIOFactory::CreateImageIO(
+          m_FileNames[0].c_str(), ImageIOFactory::ReadMode);
+      if (prefetched.m_ImageIO.IsNull() )
+        {
+        itkExceptionMacro("Cannot create an ImageIO to read " << m_FileNames[0]);
+        }
+      }
+    prefetched.m_Frame = frame;
+    prefetched.m_Buffer.resize(frameSizeInBytes);
+
+    ImageIOBase * io = prefetched.m_ImageIO;
+    char * buffer = prefetched.m_Buffer.data();
+    const std::string fileName = m_FileNames[frame];
+    prefetched.m_Decoded = ThreadPool::GetInstance()->AddWork(
+      [io, buffer, fileName, frameSizeInBytes]()
+      {
+      io->SetFileName(fileName);
+      io->ReadImageInformation();
+      if (io->GetImageSizeInBytes() != frameSizeInBytes)
+        {
+        itkGenericExceptionMacro(<< "Frame " << fileName << " does not have the size of the first frame");
+        }
+      ImageIORegion region(io->GetNumberOfDimensions() );
+      for (unsigned int i = 0; i < io->GetNumberOfDimensions(); ++i)
+        {
+        region.SetSize(i, io->GetDimensions(i) );
+        }
+      io->SetIORegion(region);
+      io->Read(buffer);
+      });
+    m_PrefetchedFrames.push_back(std::move(prefetched));
+    }
+}
+
+void FileListVideoIO::DropPrefetchedFrames()
+{
+  for (auto & frame : m_PrefetchedFrames)
+    {
+    if (frame.m_Decoded.valid() )
+      {
+      // The error of a frame that will not be read is not reported
+      try
+        {
+        frame.m_Decoded.get();
+        }
+      catch (...)
+        {
+        }
+      }
+    m_RecycledFrames.push_back(std::move(frame));
     }
+  m_PrefetchedFrames.clear();
 }
 
 bool FileListVideoIO::SetNextFrameToRead(FrameOffsetType frameNumber)
@@ -425,6 +538,8 @@ void FileListVideoIO::OpenWriter()
 
 void FileListVideoIO::ResetMembers()
 {
+  this->DropPrefetchedFrames();
+  m_RecycledFrames.clear();
   m_ImageIO = nullptr;
   m_FileNames.clear();
   m_WriterOpen = false;
@@ -38,6 +38,7 @@ VideoIOBase::~VideoIOBase() = default;
 void VideoIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os,indent);
+  os << indent << "NumberOfPrefetchFrames: " << m_NumberOfPrefetchFrames << std::endl;
 }
 
 } //namespace itk end
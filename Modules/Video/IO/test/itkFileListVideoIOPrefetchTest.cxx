@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFileListVideoIO.h"
+#include "itkFileListVideoIOFactory.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVideoFileReader.h"
+#include "itkTestingMacros.h"
+
+// Write a list of frames, then read them through a FileListVideoIO that
+// decodes frames ahead: in order, after seeking back and forth, with a
+// missing frame, and through a VideoFileReader converting the pixels.
+
+namespace
+{
+
+using PixelType = unsigned short;
+using FrameType = itk::Image< PixelType, 2 >;
+
+const unsigned int NumberOfFrames = 8;
+
+PixelType
+ExpectedValue( unsigned int frame, const FrameType::IndexType & index )
+{
+  return static_cast< PixelType >( 1000 * frame + 40 * index[1] + index[0] );
+}
+
+int
+CheckFrame( unsigned int frame, const std::vector< PixelType > & buffer, const FrameType::SizeType & size )
+{
+  for ( unsigned int y = 0; y < size[1]; ++y )
+    {
+    for ( unsigned int x = 0; x < size[0]; ++x )
+      {
+      FrameType::IndexType index = { { x, y } };
+      if ( buffer[y * size[0] + x] != ExpectedValue( frame, index ) )
+        {
+        std::cerr << "Frame " << frame << ": wrong value at " << index << ": " << buffer[y * size[0] + x]
+                  << " expected " << ExpectedValue( frame, index ) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+int
+ReadFrames( itk::FileListVideoIO * io, const std::vector< unsigned int > & frames, const FrameType::SizeType & size )
+{
+  std::vector< PixelType > buffer( size[0] * size[1] );
+  for ( auto frame : frames )
+    {
+    if ( io->GetCurrentFrame() != frame )
+      {
+      TEST_EXPECT_TRUE( io->SetNextFrameToRead( frame ) );
+      }
+    io->Read( buffer.data() );
+    if ( CheckFrame( frame, buffer, size ) != EXIT_SUCCESS )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkFileListVideoIOPrefetchTest( int argc, char * argv[] )
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = std::string( argv[1] ) + "/itkFileListVideoIOPrefetchTest";
+
+  FrameType::SizeType size;
+  size[0] = 37;
+  size[1] = 23;
+
+  std::string fileList;
+  for ( unsigned int frame = 0; frame < NumberOfFrames; ++frame )
+    {
+    FrameType::Pointer image = FrameType::New();
+    image->SetRegions( size );
+    image->Allocate();
+    itk::ImageRegionIteratorWithIndex< FrameType > it( image, image->GetBufferedRegion() );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set( ExpectedValue( frame, it.GetIndex() ) );
+      }
+
+    const std::string fileName = directory + std::to_string( frame ) + ".mha";
+    using WriterType = itk::ImageFileWriter< FrameType >;
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetInput( image );
+    writer->SetFileName( fileName );
+    TRY_EXPECT_NO_EXCEPTION( writer->Update() );
+    fileList += ( frame > 0 ? "," : "" ) + fileName;
+    }
+
+  itk::FileListVideoIO::Pointer io = itk::FileListVideoIO::New();
+  TEST_SET_GET_VALUE( 0u, io->GetNumberOfPrefetchFrames() );
+  io->SetNumberOfPrefetchFrames( 3 );
+  TEST_SET_GET_VALUE( 3u, io->GetNumberOfPrefetchFrames() );
+  io->SetFileName( fileList );
+  TRY_EXPECT_NO_EXCEPTION( io->ReadImageInformation() );
+
+  // In order, then seeking back, forward, and stopping before the end
+  const std::vector< unsigned int > inOrder = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const std::vector< unsigned int > seeking = { 2, 3, 0, 6, 7, 1, 2, 3 };
+  if ( ReadFrames( io, inOrder, size ) != EXIT_SUCCESS || ReadFrames( io, seeking, size ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  io->FinishReadingOrWriting();
+
+  // A missing frame is reported when it is read, not when decoded ahead
+  std::string missingFileList = directory + "0.mha," + directory + "1.mha," + directory + "Missing.mha,"
+                                + directory + "3.mha";
+  io->SetFileName( missingFileList );
+  TRY_EXPECT_NO_EXCEPTION( io->ReadImageInformation() );
+  if ( ReadFrames( io, { 0, 1 }, size ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  std::vector< PixelType > buffer( size[0] * size[1] );
+  TRY_EXPECT_EXCEPTION( io->Read( buffer.data() ) );
+  if ( ReadFrames( io, { 3 }, size ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  io->FinishReadingOrWriting();
+
+  // Through a reader converting the pixels to float
+  itk::ObjectFactoryBase::RegisterFactory( itk::FileListVideoIOFactory::New() );
+  using VideoType = itk::VideoStream< itk::Image< float, 2 > >;
+  using ReaderType = itk::VideoFileReader< VideoType >;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( fileList );
+  reader->SetNumberOfPrefetchFrames( 2 );
+  TEST_SET_GET_VALUE( 2u, reader->GetNumberOfPrefetchFrames() );
+  TRY_EXPECT_NO_EXCEPTION( reader->UpdateOutputInformation() );
+  for ( unsigned int frame = 0; frame < NumberOfFrames; ++frame )
+    {
+    itk::TemporalRegion requestedRegion;
+    requestedRegion.SetFrameStart( frame );
+    requestedRegion.SetFrameDuration( 1 );
+    reader->GetOutput()->SetRequestedTemporalRegion( requestedRegion );
+    reader->Update();
+
+    const VideoType::FrameType * image = reader->GetOutput()->GetFrame( frame );
+    itk::ImageRegionConstIteratorWithIndex< VideoType::FrameType > it( image, image->GetBufferedRegion() );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      if ( it.Get() != ExpectedValue( frame, it.GetIndex() ) )
+        {
+        std::cerr << "Reader frame " << frame << ": wrong value at " << it.GetIndex() << ": " << it.Get()
+                  << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}